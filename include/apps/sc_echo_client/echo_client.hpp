@@ -5,18 +5,206 @@
 #include <rte_ethdev.h>
 #include <rte_ether.h>
 #include <rte_malloc.h>
+#include <rte_ring.h>
 
 #include "sc_global.hpp"
 #include "sc_utils.hpp"
 #include "sc_utils/pktgen.hpp"
 #include "sc_utils/distribution_gen.hpp"
 #include "sc_utils/timestamp.hpp"
+#include "sc_utils/pcap.hpp"
+#include "sc_utils/flow_pop.hpp"
+#include "sc_utils/pacer.hpp"
+#include "sc_utils/prng.hpp"
+#include "sc_utils/load_schedule.hpp"
+#include "sc_utils/field_mod.hpp"
+#include "sc_utils/cksum.hpp"
+#include "sc_utils/kv_workload.hpp"
+#include "sc_utils/hdr_hist.hpp"
+#include "sc_utils/seq_track.hpp"
+#include "sc_utils/stage_stamp.hpp"
 
 
-#define SC_ECHO_CLIENT_NB_TS_TABLE (1UL << 20)-1
 #define SC_ECHO_CLIENT_BURST_TX_RETRIES 16
 
+/* latency histogram of receive cores, larger latencies are clamped (unit: ns) */
+#define SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS (60UL * 1000000000UL)
+#define SC_ECHO_CLIENT_LATENCY_HIST_TICKS 5     /* ticks per half distance of the .hgrm output */
+
+/* role of each core, a send_recv core sends and polls its own queue */
+enum {
+    SC_ECHO_CLIENT_ROLE_SEND = 0x1,
+    SC_ECHO_CLIENT_ROLE_RECV = 0x2,
+    SC_ECHO_CLIENT_ROLE_SEND_RECV = SC_ECHO_CLIENT_ROLE_SEND | SC_ECHO_CLIENT_ROLE_RECV
+};
+
+/* tick of the control plane for load schedule, rfc2544 search and slo controller (unit: us) */
+#define SC_ECHO_CLIENT_SCHED_TICK_US 1000
+
+/*!
+ * \brief statistics of a phase of load schedule
+ */
+struct _sched_phase_stat {
+    uint64_t nb_send_pkt;
+    uint64_t nb_drop_pkt;
+    uint64_t nb_recv_pkt;
+};
+
+/* rfc2544 throughput search */
+#define SC_ECHO_CLIENT_RFC2544_MAX_NB_SIZES 16
+#define SC_ECHO_CLIENT_RFC2544_MAX_NB_TRIALS 32   /* per packet size */
+
+/* microbenchmark of the software checksum */
+#define SC_ECHO_CLIENT_CKSUM_BENCH_MAX_NB_SIZES 16
+#define SC_ECHO_CLIENT_CKSUM_BENCH_NB_ITERATIONS 100000
+
+enum {
+    SC_ECHO_CLIENT_RFC2544_INIT = 0,
+    SC_ECHO_CLIENT_RFC2544_TRIAL,   /* sending at the trial rate */
+    SC_ECHO_CLIENT_RFC2544_SETTLE,  /* paused, waiting for in-flight responses */
+    SC_ECHO_CLIENT_RFC2544_DONE
+};
+
+/*!
+ * \brief state of the binary search, owned by the control plane
+ */
+struct _rfc2544_search {
+    uint8_t state;
+    uint32_t size_idx;
+    double lo_rate, hi_rate, rate;      /* unit: Mpps */
+    uint64_t state_start_ns;
+    uint64_t base_send_pkt, base_recv_pkt, nb_trial_send_pkt;
+};
+
+/*!
+ * \brief search result of a packet size
+ */
+struct _rfc2544_result {
+    uint32_t nb_trials;
+    bool found;
+    double rate;                /* highest passed offered rate, unit: Mpps */
+    double send_rate;           /* achieved send rate of the highest passed trial, unit: Mpps */
+    double loss_ratio;          /* loss of the highest passed trial, unit: % */
+};
+
+/* slo controller */
+enum {
+    SC_ECHO_CLIENT_SLO_AIMD = 0,
+    SC_ECHO_CLIENT_SLO_PID
+};
+
+/*!
+ * \brief state of the slo controller, owned by the control plane
+ */
+struct _slo_state {
+    uint64_t interval_start_ns;
+    bool pending_read;          /* latencies of the last interval are read at the next tick */
+    bool converged;
+    uint32_t nb_intervals;
+    double rate;                /* offered rate of the current interval, unit: Mpps */
+    double pid_integral;
+    double pid_prev_error;
+    struct sc_hdr_hist hist;    /* latencies of the last interval merged from receive cores, unit: ns */
+
+    /* history of each interval */
+    double *rates;              /* unit: Mpps */
+    double *latencies;          /* latency percentile, unit: us */
+    bool *met;
+};
+
+/* closed-loop mode */
+#define SC_ECHO_CLIENT_CL_MAX_NB_LEVELS 16
+#define SC_ECHO_CLIENT_CL_TAG_MAGIC 0x5C10CA11
+
+/*!
+ * \brief tag of closed-loop request, placed right after the timestamp table of the payload
+ */
+struct _closed_loop_tag {
+    uint64_t send_tsc;
+    uint32_t magic;
+    uint32_t flow_id;
+    uint16_t sender_id;     /* logical index of the send core */
+    uint16_t level;         /* index of the concurrency level */
+};
+
+/*!
+ * \brief window state of a closed-loop flow (virtual client), owned by the send core
+ */
+struct _closed_loop_flow {
+    uint32_t nb_outstanding;
+    uint64_t next_send_tsc;         /* think time after the last response */
+    uint64_t last_progress_tsc;     /* for reclaiming requests of lost responses */
+};
+
+/*!
+ * \brief statistics of a concurrency level, request counters are recorded by send cores,
+ *        response counters and latencies are recorded by receive cores
+ */
+struct _closed_loop_stat {
+    /* send core */
+    uint64_t nb_requests;
+    uint64_t nb_timeouts;
+    uint64_t start_tsc;
+    uint64_t end_tsc;
+
+    /* receive core */
+    uint64_t nb_responses;
+    struct sc_hdr_hist latency_hist;    /* unit: ns */
+};
+
+/* sequence tracking */
+#define SC_ECHO_CLIENT_SEQ_TAG_MAGIC 0x5C5E9A6C
+
+/*!
+ * \brief tag of sequenced packet, placed right after the timestamp table of the payload,
+ *        each flow of each send core is a stream with its own sequence numbers
+ */
+struct _seq_tag {
+    uint64_t seq;
+    uint32_t magic;
+    uint32_t flow_id;
+    uint16_t sender_id;     /* logical index of the send core */
+    uint16_t reserved;
+};
+
+/* stages of the round trip decomposed by the trailer stamped by the server */
+enum {
+    SC_ECHO_CLIENT_STAGE_SERVER = 0,        /* server rx to tx enqueue */
+    SC_ECHO_CLIENT_STAGE_OUTSIDE,           /* round trip excluding the server (only under latency build) */
+    SC_ECHO_CLIENT_NB_STAGES
+};
+
+/* key-value workload */
+#define SC_ECHO_CLIENT_KV_NB_INFLIGHT (1UL << 16)     /* per send core, power of 2 */
+
+/*!
+ * \brief in-flight kv request, written by the send core and matched by receive cores
+ */
+struct _kv_inflight {
+    volatile uint64_t req_id;       /* zero if the slot is free */
+    uint64_t send_tsc;
+    uint8_t op;
+};
+
+/*!
+ * \brief statistics of a kv operation, requests are recorded by send cores,
+ *        responses and latencies are recorded by receive cores
+ */
+struct _kv_op_stat {
+    /* send core */
+    uint64_t nb_requests;
+
+    /* receive core */
+    uint64_t nb_responses;
+    struct sc_hdr_hist latency_hist;    /* unit: ns */
+};
+
 struct _per_core_app_meta {
+    /* role of this core, and its index among send / receive cores */
+    uint8_t role;
+    uint32_t send_rank;
+    uint32_t recv_rank;
+
     /* store rte_mbuf for sending and receiving */
     struct rte_mbuf **send_pkt_bufs; 
     struct rte_mbuf **recv_pkt_bufs;
@@ -31,13 +219,75 @@ struct _per_core_app_meta {
 
     /* last send flow */
     uint64_t last_used_flow;
-    struct sc_pkt_hdr *test_pkts;
+    struct sc_pkt_hdr *test_pkts;   /* index: flow * nb_buckets + size bucket under packet size distribution */
+
+    /* headers, packet mix and flows currently sent (switched by load schedule) */
+    struct sc_pkt_hdr *send_pkts;   /* index: flow * send_pkts_stride + size bucket */
+    uint64_t send_pkts_stride;
+    struct sc_pkt_size_dist *send_pkt_size_dist;    /* NULL for fixed-size packets */
+    uint64_t nb_send_flows;
+
+    /* load schedule */
+    uint32_t sched_phase;           /* index of the applied phase */
+    struct sc_pkt_hdr *sched_pkts;  /* headers of per-phase packet mix */
+    struct _sched_phase_stat *sched_stats;
+
+    /* slo controller */
+    uint32_t slo_rate_version;      /* sender: version of the applied rate */
+    struct sc_hdr_hist slo_hists[2];    /* receiver: latency histogram of each epoch parity (unit: ns) */
+
+    /* rfc2544 throughput search */
+    uint32_t rfc2544_trial;         /* index of the applied trial */
+    uint32_t rfc2544_pkt_len;       /* packet length of rfc2544_pkts */
+    struct sc_pkt_hdr *rfc2544_pkts;
+
+    /* flow population (replaces rotating test_pkts if enabled) */
+    struct sc_flow_pop flow_pop;
+    uint64_t *rand_buf;
+
+    /* protocol stack with per-core header template (replaces test_pkts if enabled) */
+    struct sc_proto_stack proto_stack;
+
+    /* per-packet field modifiers applied right before tx */
+    struct sc_field_mod_state field_mod;
 
     /* send interval */
-    uint64_t last_send_timestamp;
-    uint64_t interval;
-    sc_utils_distribution_uint64_generator* interval_generator;
+    struct sc_pacer pacer;
+    double per_core_pkt_rate;   /* unit: Mpps */
     double payload_copy_latency;
+
+    /* key-value workload (replaces the original payload if enabled) */
+    struct sc_kv_gen kv_gen;
+    struct sc_pkt_hdr *kv_pkts;     /* index: flow * 2 + whether the request carries a value */
+    uint64_t kv_next_req_id;
+    uint64_t kv_nb_unmatched;       /* receiver: responses of reclaimed or unknown requests */
+    struct _kv_op_stat kv_stats[SC_KV_OP_UNKNOWN];
+
+    /* sequence tracking */
+    uint64_t *seq_next;                 /* sender: next sequence number of each flow */
+    uint64_t seq_nb_withdrawn;          /* sender: packets failed to be sent, whose numbers are reused */
+    struct sc_seq_window *seq_windows;  /* receiver: index: logical index of send core * nb_flow_per_core + flow */
+    struct sc_seq_stat seq_stat;        /* receiver */
+    uint64_t seq_nb_untagged;           /* receiver: packets without valid tag */
+
+    /* server-side stage stamps */
+    struct sc_hdr_hist stage_hists[SC_ECHO_CLIENT_NB_STAGES];   /* receiver: unit: ns */
+    uint64_t stage_nb_unstamped;        /* receiver: responses not stamped by the server */
+
+    /* closed-loop mode */
+    struct _closed_loop_flow *cl_flows;
+    uint64_t cl_flow_cursor;
+    uint16_t cl_level;
+    void **cl_completions;          /* sender: dequeued completions */
+    void **cl_batches;              /* receiver: per-sender batches of completions */
+    uint32_t *cl_nb_batched;        /* receiver: length of each per-sender batch */
+    uint64_t cl_nb_ring_drops;
+    struct _closed_loop_stat cl_stats[SC_ECHO_CLIENT_CL_MAX_NB_LEVELS];
+
+    /* pcap replay */
+    struct sc_pcap_trace *pcap_trace;
+    uint64_t pcap_cursor;
+    uint64_t pcap_loop_start_timestamp;
     
     /* for control plane (sender) */
     uint64_t nb_interval_send_pkt;
@@ -49,9 +299,7 @@ struct _per_core_app_meta {
     uint64_t last_recv_record_timestamp;
 
     #if defined(SC_ECHO_CLIENT_GET_LATENCY)
-        uint64_t nb_ts_tables;
-        uint64_t ts_tables_pointer;
-        struct sc_timestamp_table ts_tables[SC_ECHO_CLIENT_NB_TS_TABLE];
+        struct sc_hdr_hist latency_hist;    /* receiver: round-trip latency (unit: ns) */
     #endif
 };
 
@@ -61,16 +309,124 @@ struct _internal_config {
     uint32_t nb_pkt_per_burst;
     uint64_t nb_flow_per_core;
 
+    /* whether flows of each send core are steered into the queue with the same index */
+    bool rss_affinity;
+
+    /* popularity of flows, flows are sampled per packet if enabled */
+    struct sc_flow_pop_conf flow_pop_conf;
+
+    /* distribution of packet size (fixed pkt_len if not enabled) */
+    bool enable_pkt_size_dist;
+    struct sc_pkt_size_dist pkt_size_dist;
+    double mean_pkt_len;        /* unit: bytes */
+
+    /* protocol stack of generated packets (ipv4/udp if not enabled) */
+    bool enable_proto_stack;
+    struct sc_proto_stack proto_stack;
+
+    /* per-packet field modifiers of generated ipv4/udp packets */
+    bool enable_field_mod;
+    struct sc_field_mod_prog field_mod_prog;
+
+    /* udp checksum of generated ipv4/udp packets calculated in software (zero if not enabled) */
+    bool enable_sw_cksum;
+
+    /* packet sizes of the software checksum microbenchmark at start (skipped if not given) */
+    uint32_t nb_cksum_bench_sizes;
+    uint32_t cksum_bench_sizes[SC_ECHO_CLIENT_CKSUM_BENCH_MAX_NB_SIZES];
+
+    /* key-value requests carried inside the payload, responses are matched by request id */
+    bool enable_kv;
+    struct sc_kv_workload_conf kv_conf;
+    struct sc_kv_workload kv_workload;
+    struct _kv_inflight **kv_inflight;  /* index: logical index of send core */
+
+    /* per-flow sequence numbers, for telling losses from reordering and duplication */
+    bool enable_seq;
+    struct sc_seq_stat seq_stat_prev;   /* merged statistics of the previous interval */
+
+    /* trailer asking the server to stamp each stage, for decomposing the round trip */
+    bool enable_stage_stamps;
+
+    /* latency histograms merged from receive cores by the control plane of the first receive core */
+    uint8_t latency_hist_sig_figs;
+    struct sc_hdr_hist latency_hist_merged;
+    struct sc_hdr_hist latency_hist_prev;       /* merged histogram of the previous interval */
+    struct sc_hdr_hist latency_hist_interval;
+
+    /* time-varying offered load, phases are switched by the control plane */
+    bool enable_load_schedule;
+    struct sc_load_schedule load_schedule;
+    volatile uint32_t sched_phase;      /* index of the current phase, published by the control plane */
+    uint64_t sched_start_ns;
+    uint64_t *sched_phase_start_ns;     /* index: phase (end of the schedule at nb_phases) */
+    uint64_t sched_last_print_ns;
+
+    /* rfc2544 throughput search: binary search of the highest rate within rfc2544_loss_ratio per packet size */
+    bool enable_rfc2544;
+    uint32_t nb_rfc2544_sizes;
+    uint32_t rfc2544_sizes[SC_ECHO_CLIENT_RFC2544_MAX_NB_SIZES];
+    uint64_t rfc2544_trial_ms;
+    uint64_t rfc2544_settle_ms;
+    double rfc2544_loss_ratio;          /* unit: % */
+    double rfc2544_min_rate;            /* unit: Mpps */
+    double rfc2544_max_rate;            /* unit: Mpps */
+    double rfc2544_resolution;          /* unit: Mpps */
+    volatile uint32_t rfc2544_trial;    /* index of the current trial, published by the control plane */
+    volatile uint32_t rfc2544_trial_pkt_len;
+    volatile double rfc2544_trial_rate; /* overall rate of the current trial, unit: Mpps */
+    struct _rfc2544_search rfc2544_search;
+    struct _rfc2544_result rfc2544_results[SC_ECHO_CLIENT_RFC2544_MAX_NB_SIZES];
+
+    /* slo controller: adjusts the offered rate every slo_interval_ms to keep the
+       slo_percentile latency within slo_target_us */
+    bool enable_slo;
+    uint8_t slo_controller;
+    double slo_percentile;              /* unit: % */
+    uint64_t slo_target_us;
+    uint64_t slo_interval_ms;
+    double slo_min_rate, slo_max_rate, slo_init_rate;   /* unit: Mpps */
+    double slo_aimd_step;               /* additive increase, unit: Mpps */
+    double slo_aimd_backoff;            /* multiplicative decrease */
+    double slo_pid_kp, slo_pid_ki, slo_pid_kd;
+    uint32_t slo_window;                /* number of intervals to judge convergence */
+    double slo_converge_ratio;          /* relative half-width of 95% confidence interval, unit: % */
+    uint32_t slo_max_intervals;
+    volatile uint32_t slo_rate_version; /* version of the offered rate, published by the control plane */
+    volatile double slo_rate;           /* overall offered rate, unit: Mpps */
+    volatile uint32_t slo_epoch;        /* receivers record latencies into slo_hists[slo_epoch & 1] */
+    struct _slo_state slo_state;
+
+    /* closed-loop mode: each flow keeps at most cl_windows[level] outstanding requests */
+    bool enable_closed_loop;
+    uint32_t nb_cl_levels;
+    uint32_t cl_windows[SC_ECHO_CLIENT_CL_MAX_NB_LEVELS];
+    uint64_t cl_level_duration_ms;
+    uint64_t cl_think_time_us;
+    uint64_t cl_timeout_us;
+    struct rte_ring **cl_rings;     /* completions towards each send core, index: logical index of send core */
+
     /* send flow rate */
     /* when enable pkt rate, bit rate is invalid */
     double bit_rate;
     double pkt_rate;
 
-    /* core dispatching */
+    /* pacing of bursts */
+    uint8_t pacing_arrival;
+    uint64_t pacing_bucket_depth;
+    uint64_t pacing_on_us;
+    uint64_t pacing_off_us;
+
+    /* core dispatching (first half sends and second half receives if core_roles is not given) */
+    uint32_t nb_core_roles;
+    uint8_t core_roles[SC_MAX_NB_CORES];    /* index: logical core id */
     uint32_t nb_send_cores;
     uint32_t nb_recv_cores;
     uint32_t *send_core_idx;
     uint32_t *recv_core_idx;
+    uint32_t *send_core_logical_idx;
+    uint32_t *recv_core_logical_idx;
+    uint64_t recv_last_print_ns;        /* for send_recv cores ticked by the control plane */
 
     /* used echo ports */
     uint32_t nb_send_ports, nb_recv_ports;
@@ -78,6 +434,19 @@ struct _internal_config {
     uint32_t send_port_logical_idx[SC_MAX_NB_PORTS], recv_port_logical_idx[SC_MAX_NB_PORTS];
     char *send_port_mac_address[SC_MAX_NB_PORTS];
     char *recv_port_mac_address[SC_MAX_NB_PORTS];
+
+    /* pcap replay */
+    char *pcap_file;
+    uint8_t pcap_replay_mode;
+    double pcap_replay_speed;
+    uint32_t nb_pcap_dst_macs, nb_pcap_src_ipv4s, nb_pcap_dst_ipv4s;
+    struct rte_ether_addr pcap_dst_mac[SC_MAX_NB_PORTS];
+    rte_be32_t pcap_src_ipv4[SC_MAX_NB_PORTS];
+    rte_be32_t pcap_dst_ipv4[SC_MAX_NB_PORTS];
+    struct rte_ether_addr send_port_mac[SC_MAX_NB_PORTS];
+    struct sc_pcap_trace *pcap_traces;  /* one trace per send core */
+    struct rte_mempool *pcap_mp;
+    uint64_t pcap_duration_ns;
 };
 
 int _init_app(struct sc_config *sc_config);
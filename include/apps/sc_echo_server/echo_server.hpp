@@ -14,11 +14,22 @@
 #include <rte_mempool.h>
 #include <rte_version.h>
 #include <rte_mbuf_core.h>
+#include <rte_hash_crc.h>
 
 #include "sc_global.hpp"
 #include "sc_utils/timestamp.hpp"
+#include "sc_utils/pktgen.hpp"
 
 #define SC_ECHO_SERVER_NB_THROUGHPUT 131072
+#define SC_ECHO_SERVER_MAX_NB_PROTO_STATS 16
+
+/* statistic of received packets with the same protocol stack */
+struct _proto_stat {
+    uint64_t signature;
+    uint64_t nb_pkts;
+    uint64_t nb_parse_cycles;
+    struct sc_proto_stack stack;
+};
 
 struct _per_core_app_meta {
     uint64_t nb_forward_pkt;
@@ -35,6 +46,18 @@ struct _per_core_app_meta {
     uint64_t nb_interval_forward_pkt;
     uint64_t nb_interval_drop_pkt;
     struct timeval last_record_time;
+
+    /* per protocol stack statistics */
+    uint32_t nb_proto_stats;
+    uint64_t nb_unrecorded_proto_pkts;
+    struct _proto_stat proto_stats[SC_ECHO_SERVER_MAX_NB_PROTO_STATS];
+
+    /* payload digest, walked across all segments of each packet */
+    uint64_t nb_digest_pkts;
+    uint64_t nb_digest_segs;
+    uint64_t nb_digest_bytes;
+    uint64_t nb_digest_cycles;
+    uint32_t digest;            /* xor of the digests of all packets */
 };
 
 /* definition of internal config */
@@ -45,6 +68,12 @@ struct _internal_config {
     uint32_t send_port_logical_idx[SC_MAX_NB_PORTS], recv_port_logical_idx[SC_MAX_NB_PORTS];
     char *send_port_mac_address[SC_MAX_NB_PORTS];
     char *recv_port_mac_address[SC_MAX_NB_PORTS];
+
+    /* whether to parse the protocol stack of each received packet */
+    bool enable_proto_stats;
+
+    /* whether to compute the crc32c digest of the udp payload of each received packet */
+    bool enable_payload_digest;
 };
 
 int _init_app(struct sc_config *sc_config);
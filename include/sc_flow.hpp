@@ -0,0 +1,71 @@
+#ifndef _SC_FLOW_H_
+#define _SC_FLOW_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <rte_flow.h>
+#include <rte_mbuf.h>
+#include <rte_ether.h>
+#include <rte_version.h>
+
+/*!
+ * \brief maximum number of pattern items / actions of a single flow rule
+ *        (each list is terminated by an END item)
+ */
+#define SC_FLOW_MAX_NB_PATTERN_ITEMS 4
+#define SC_FLOW_MAX_NB_ACTIONS 4
+
+/*!
+ * \brief a rte_flow steering rule specified inside the configuration file, e.g.
+ *          flow_rule = proto udp dst_port 9000 action queue 3
+ *          flow_rule = proto udp src_ip 10.0.0.1 dst_ip 10.0.0.2 src_port 1 dst_port 2 action drop
+ *          flow_rule = port_mac 04:3F:72:F4:40:4E proto tcp dst_port 80 action mark 7 queue 1
+ */
+struct sc_flow_rule {
+    /* applied port (empty string for all used ports) */
+    char port_mac[RTE_ETHER_ADDR_FMT_SIZE];
+
+    /* pattern, all values are stored in network byte order */
+    uint8_t l4_proto;           // IPPROTO_UDP or IPPROTO_TCP, 0 for matching ipv4 only
+    bool match_src_ip;
+    bool match_dst_ip;
+    bool match_src_port;
+    bool match_dst_port;
+    rte_be32_t src_ip;
+    rte_be32_t dst_ip;
+    rte_be16_t src_port;
+    rte_be16_t dst_port;
+
+    /* actions */
+    bool action_drop;
+    bool action_queue;
+    bool action_mark;
+    uint16_t queue_id;
+    uint32_t mark_id;
+};
+
+int sc_flow_parse_rule(char *rule_str, struct sc_flow_rule *rule);
+int init_flow_isolation(struct sc_config *sc_config, uint16_t port_id);
+int init_flow_rules(struct sc_config *sc_config, uint16_t port_id, uint16_t port_logical_id);
+int destroy_flow_rules(struct sc_config *sc_config, uint16_t port_logical_id);
+
+/*!
+ * \brief   obtain the mark id attached by a rte_flow MARK action
+ * \param   pkt     the received packet
+ * \param   mark_id the obtained mark id
+ * \return  whether the packet carries a mark
+ */
+static inline bool sc_flow_get_mark(struct rte_mbuf *pkt, uint32_t *mark_id){
+    #if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
+        if(!(pkt->ol_flags & RTE_MBUF_F_RX_FDIR_ID))
+            return false;
+    #else
+        if(!(pkt->ol_flags & PKT_RX_FDIR_ID))
+            return false;
+    #endif
+    *mark_id = pkt->hash.fdir.hi;
+    return true;
+}
+
+#endif
@@ -28,7 +28,7 @@ extern volatile bool sc_force_quit;
 #endif // SC_CLOSE_MOCK_MACRO
 
 /* maximum number of parameters to init rte eal */
-#define SC_RTE_ARGC_MAX (RTE_MAX_ETHPORTS << 1) + 7
+#define SC_RTE_ARGC_MAX (RTE_MAX_ETHPORTS << 1) + 16
 
 /* maximum number of ports to used */
 #define SC_MAX_NB_PORTS RTE_MAX_ETHPORTS
@@ -36,6 +36,9 @@ extern volatile bool sc_force_quit;
 /* maximum number of queues per port */
 #define SC_MAX_NB_QUEUE_PER_PORT RTE_MAX_QUEUES_PER_PORT
 
+/* maximum number of flow rules specified in configuration file */
+#define SC_MAX_NB_FLOW_RULES 64
+
 /* maximum number of lcores to used */
 #define SC_MAX_NB_CORES RTE_MAX_LCORE
 
@@ -49,6 +52,8 @@ struct app_config;
 struct doca_config;
 struct per_core_meta;
 struct per_core_worker_func;
+struct sc_flow_rule;
+struct rte_flow;
 
 /*!
  * \brief meta of a dpdk port
@@ -57,6 +62,10 @@ struct sc_port {
     uint16_t port_id;
     uint16_t logical_port_id;
     char port_mac[RTE_ETHER_ADDR_FMT_SIZE];
+
+    /* rte_flow rules installed on this port, destroyed while closing the port */
+    struct rte_flow *flows[SC_MAX_NB_FLOW_RULES];
+    uint16_t nb_flows;
 };
 
 /* global configuration of SoConnect */
@@ -82,12 +91,42 @@ struct sc_config {
     uint32_t tx_queue_len;
     bool enable_promiscuous;
     bool enable_offload;
+    uint16_t mtu;               // 0 for the default mtu of the device
+
+    /* memif */
+    bool enable_memif;
+    bool memif_is_server;       // true: server (master); false: client (slave)
+    bool enable_memif_zero_copy;
+    uint32_t memif_id;
+    char *memif_socket;
+
+    /* vhost-user */
+    bool enable_vhost_user;
+    bool vhost_user_is_backend; // true: backend (net_vhost); false: frontend (net_virtio_user)
+    char *vhost_user_socket;
+
+    /* af_xdp */
+    bool enable_af_xdp;
+    char *af_xdp_iface;
+    char *af_xdp_prog;
+    uint16_t af_xdp_start_queue;
+    uint16_t af_xdp_busy_budget;   // 0 for disabling busy polling
+
+    /* kernel socket backend */
+    bool enable_socket_backend;
+    char *socket_bind_addr;
+    uint16_t socket_bind_port;
 
     /* rss */
     bool enable_rss;
     bool rss_symmetric_mode;    // true: symmetric; false: asymmetric
     uint64_t rss_hash_field;
 
+    /* rte_flow */
+    bool enable_flow_isolation;
+    struct sc_flow_rule *flow_rules[SC_MAX_NB_FLOW_RULES];
+    uint16_t nb_flow_rules;
+
     /* dpdk memory */
     struct rte_mempool **rx_pktmbuf_pool;  // index: port_id * nb_rx_rings_per_port + queue_id
     struct rte_mempool **tx_pktmbuf_pool;  // index: port_id * nb_tx_rings_per_port + queue_id
@@ -117,6 +156,12 @@ struct sc_config {
     struct timeval test_duration_start_time;
     struct timeval test_duration_end_time;
 
+    /* seed of the per-thread random generators (0 for seeding by time) */
+    uint64_t prng_seed;
+
+    /* whether to stamp per-stage tsc into trailers of received packets (server) */
+    bool enable_stage_stamps;
+
     /* doca specific configurations */
     #if defined(SC_HAS_DOCA)
         void *doca_config;
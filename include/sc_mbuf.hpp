@@ -5,6 +5,10 @@
 #include <rte_mempool.h>
 #include <rte_mbuf_core.h>
 
+#include "sc_socket.hpp"
+#include "sc_utils/timestamp.hpp"
+#include "sc_utils/stage_stamp.hpp"
+
 #define NUM_MBUFS 8191
 #define MEMPOOL_CACHE_SIZE 512
 
@@ -28,6 +32,19 @@ inline int sc_flush_tx_queue(
 ){
     int result = SC_SUCCESS;
     uint16_t nb_tx, retry;
+
+    /* stamp tx into trailers of packets as the application hands them over (if enabled) */
+    if(unlikely(sc_stage_stamp_enabled)){
+        sc_util_stage_stamp_burst(queue, nb_flush_pkts, SC_STAGE_TX, sc_util_timestamp_tsc());
+    }
+
+    /* send through kernel socket (if enabled), all packets are freed inside */
+    if(unlikely(sc_socket_backend_enabled)){
+        nb_tx = sc_socket_tx_burst(queue, nb_flush_pkts);
+        *nb_sent_pkts = nb_tx;
+        return nb_tx < nb_flush_pkts ? SC_ERROR_NOT_FINISHED : SC_SUCCESS;
+    }
+
     nb_tx = rte_eth_tx_burst(port_id, queue_id, queue, nb_flush_pkts);
     
     if(unlikely(nb_tx < nb_flush_pkts)){
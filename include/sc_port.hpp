@@ -26,6 +26,7 @@
 extern uint8_t *used_rss_hash_key;
 
 int init_ports(struct sc_config *sc_config);
+int close_ports(struct sc_config *sc_config);
 int get_used_ports_id(struct sc_config *sc_config, uint16_t *nb_used_ports, uint16_t *port_indices);
 
 #endif
\ No newline at end of file
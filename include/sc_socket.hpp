@@ -0,0 +1,39 @@
+#ifndef _SC_SOCKET_H_
+#define _SC_SOCKET_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <rte_mbuf.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+#include <rte_version.h>
+
+/*!
+ * \brief maximum number of datagrams received / sent within a single syscall
+ */
+#define SC_SOCKET_MAX_BURST 64
+
+/*!
+ * \brief length of the headers synthesized in front of the received payload,
+ *        so that applications could parse the packet as eth/ipv4/udp frame
+ */
+#define SC_SOCKET_HDR_LEN \
+    (sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr))
+
+/*!
+ * \brief indicator of whether the kernel socket backend is used,
+ *        checked by sc_flush_tx_queue on the datapath
+ */
+extern bool sc_socket_backend_enabled;
+
+int init_socket_backend(struct sc_config *sc_config);
+int sc_socket_init_worker(struct sc_config *sc_config);
+int sc_socket_exit_worker(struct sc_config *sc_config);
+uint16_t sc_socket_rx_burst(struct sc_config *sc_config, uint16_t queue_id, struct rte_mbuf **pkts, uint16_t nb_pkts);
+uint16_t sc_socket_tx_burst(struct rte_mbuf **pkts, uint16_t nb_pkts);
+
+#endif
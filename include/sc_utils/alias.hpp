@@ -0,0 +1,22 @@
+#ifndef _SC_UTILS_ALIAS_H_
+#define _SC_UTILS_ALIAS_H_
+
+#include <stdint.h>
+
+int sc_util_alias_build(double *weights, uint64_t nb_columns, uint32_t *alias_threshold, uint32_t *alias_index);
+
+/*!
+ * \brief   sample a column from the alias table in O(1)
+ * \param   alias_threshold probability of picking the column itself, scaled by 2^32
+ * \param   alias_index     index of the alias column of each column
+ * \param   nb_columns      number of columns
+ * \param   r               64-bit random value
+ * \return  index of the sampled column
+ */
+static inline uint64_t sc_util_alias_sample(const uint32_t *alias_threshold, const uint32_t *alias_index,
+        uint64_t nb_columns, uint64_t r){
+    uint64_t column = ((r >> 32) * nb_columns) >> 32;
+    return (uint32_t)r < alias_threshold[column] ? column : alias_index[column];
+}
+
+#endif
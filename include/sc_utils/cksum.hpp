@@ -0,0 +1,106 @@
+#ifndef _SC_UTILS_CKSUM_H_
+#define _SC_UTILS_CKSUM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <rte_mbuf.h>
+#include <rte_ip.h>
+
+/*!
+ * \brief implementations of the raw checksum, selected at runtime based on the cpu flags
+ */
+enum {
+    SC_CKSUM_IMPL_SCALAR = 0,
+    SC_CKSUM_IMPL_AVX2,
+    SC_CKSUM_IMPL_AVX512,
+    SC_CKSUM_IMPL_NEON,
+    SC_CKSUM_IMPL_UNKNOWN
+};
+
+bool sc_util_cksum_impl_supported(uint8_t impl);
+const char* sc_util_cksum_impl_name(uint8_t impl);
+uint8_t sc_util_cksum_selected_impl();
+uint32_t sc_util_cksum_raw_by_impl(uint8_t impl, const void *buf, size_t len, uint32_t sum);
+uint32_t sc_util_cksum_raw(const void *buf, size_t len, uint32_t sum);
+int sc_util_cksum_raw_mbuf(const struct rte_mbuf *pkt, uint32_t offset, uint32_t len, uint32_t *sum);
+uint16_t sc_util_cksum_ipv4_udptcp(const struct rte_ipv4_hdr *ipv4_hdr, const void *l4_hdr);
+uint16_t sc_util_cksum_ipv6_udptcp(const struct rte_ipv6_hdr *ipv6_hdr, const void *l4_hdr);
+int sc_util_cksum_ipv4_udptcp_mbuf(const struct rte_mbuf *pkt, const struct rte_ipv4_hdr *ipv4_hdr,
+    uint32_t l4_offset, uint16_t *cksum);
+int sc_util_cksum_ipv6_udptcp_mbuf(const struct rte_mbuf *pkt, const struct rte_ipv6_hdr *ipv6_hdr,
+    uint32_t l4_offset, uint16_t *cksum);
+int sc_util_cksum_bench(const uint32_t *lens, uint32_t nb_lens, uint64_t nb_iterations);
+
+/*!
+ * \brief   fold the 32-bit partial sum into the 16-bit ones' complement sum
+ * \param   sum     the partial sum
+ * \return  the folded sum (not complemented)
+ */
+static inline uint16_t sc_util_cksum_fold(uint32_t sum){
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
+/*!
+ * \brief   calculate the ipv4 header checksum, the header is too short to benefit from
+ *          the vectorized implementations, so the words are summed directly (loaded by
+ *          memcpy as the packed header isn't guaranteed to be 2-byte aligned)
+ * \param   ipv4_hdr    the ipv4 header (with options), the checksum field is skipped
+ * \return  the checksum to be written into the header
+ */
+static inline uint16_t sc_util_cksum_ipv4_hdr(const struct rte_ipv4_hdr *ipv4_hdr){
+    const uint8_t *ptr = (const uint8_t*)ipv4_hdr;
+    uint16_t word;
+    uint32_t i, nb_words = rte_ipv4_hdr_len(ipv4_hdr) / 2, sum = 0;
+
+    for(i=0; i<nb_words; i++){
+        memcpy(&word, ptr + i*2, sizeof(uint16_t));
+        sum += word;
+    }
+    sum -= ipv4_hdr->hdr_checksum;
+    sum = (sum & 0xffff) + (sum >> 16);
+
+    return (uint16_t)~sc_util_cksum_fold(sum);
+}
+
+/*!
+ * \brief   accumulate the change of a 16-bit word into the ones' complement checksum delta (RFC 1624)
+ * \param   delta       the accumulated delta
+ * \param   old_word    the word before change
+ * \param   new_word    the word after change
+ * \return  the new accumulated delta
+ */
+static inline uint32_t sc_util_cksum_delta_16(uint32_t delta, uint16_t old_word, uint16_t new_word){
+    return delta + (uint16_t)~old_word + new_word;
+}
+
+/*!
+ * \brief   accumulate the change of a 32-bit field (e.g., a rewritten ipv4 address under nat)
+ *          into the ones' complement checksum delta, both values are in network byte order
+ * \param   delta       the accumulated delta
+ * \param   old_value   the field before change
+ * \param   new_value   the field after change
+ * \return  the new accumulated delta
+ */
+static inline uint32_t sc_util_cksum_delta_32(uint32_t delta, uint32_t old_value, uint32_t new_value){
+    delta = sc_util_cksum_delta_16(delta, (uint16_t)old_value, (uint16_t)new_value);
+    return sc_util_cksum_delta_16(delta, (uint16_t)(old_value >> 16), (uint16_t)(new_value >> 16));
+}
+
+/*!
+ * \brief   update the checksum incrementally by the accumulated delta, i.e., HC' = ~(~HC + ~m + m')
+ * \param   cksum   the old checksum (raw value inside the header)
+ * \param   delta   the accumulated delta
+ * \return  the new checksum (raw value)
+ */
+static inline uint16_t sc_util_cksum_adjust(uint16_t cksum, uint32_t delta){
+    uint32_t sum = (uint16_t)~cksum + delta;
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+#endif
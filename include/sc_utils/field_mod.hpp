@@ -0,0 +1,97 @@
+#ifndef _SC_UTILS_FIELD_MOD_H_
+#define _SC_UTILS_FIELD_MOD_H_
+
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+
+#include "sc_utils/prng.hpp"
+#include "sc_utils/cksum.hpp"
+
+/*!
+ * \brief maximum number of modifiers inside a single program
+ */
+#define SC_FIELD_MOD_MAX_NB_MODS 8
+
+/*!
+ * \brief maximum number of values of a list / table modifier
+ */
+#define SC_FIELD_MOD_MAX_NB_VALUES (1UL << 26)
+
+/*!
+ * \brief header fields of ipv4/udp packets which could be modified
+ */
+enum {
+    SC_FIELD_IPV4_SRC = 0,
+    SC_FIELD_IPV4_DST,
+    SC_FIELD_IPV4_ID,
+    SC_FIELD_UDP_SRC_PORT,
+    SC_FIELD_UDP_DST_PORT,
+    SC_FIELD_UNKNOWN
+};
+
+/*!
+ * \brief operation of the modifier
+ */
+enum {
+    SC_FIELD_MOD_INC = 0,   /* increase by step within [min, max], wrap around at max */
+    SC_FIELD_MOD_RAND,      /* uniformly random within [min, max] */
+    SC_FIELD_MOD_LIST,      /* cycle through the given values */
+    SC_FIELD_MOD_TABLE      /* cycle through a table of random values within [min, max] */
+};
+
+/*!
+ * \brief a compiled modifier, values are stored in host byte order
+ */
+struct sc_field_mod {
+    uint8_t field;
+    uint8_t op;
+    uint8_t width;              /* 2 or 4 bytes */
+    uint16_t offset;            /* offset of the field since the start of the packet */
+    bool in_ipv4_cksum;         /* whether the field is covered by the ipv4 header checksum */
+    bool in_l4_cksum;           /* whether the field is covered by the udp checksum (including pseudo header) */
+
+    uint32_t min, max, step;
+    uint64_t range;             /* max - min + 1 */
+
+    /* values of list / table modifier */
+    uint32_t *values;
+    uint64_t nb_values;
+};
+
+/*!
+ * \brief a program of modifiers, shared (read-only) by all send cores
+ */
+struct sc_field_mod_prog {
+    uint32_t nb_mods;
+    struct sc_field_mod mods[SC_FIELD_MOD_MAX_NB_MODS];
+    bool update_ipv4_cksum, update_l4_cksum;
+};
+
+/*!
+ * \brief per-core state for applying the program
+ */
+struct sc_field_mod_state {
+    struct sc_field_mod_prog *prog;
+    uint64_t cursors[SC_FIELD_MOD_MAX_NB_MODS];
+
+    /* scratch buffers of a burst */
+    uint32_t nb_pkt_per_burst;
+    uint32_t *values;
+    uint64_t *rand_buf;
+    uint32_t *ipv4_cksum_delta;
+    uint32_t *l4_cksum_delta;
+};
+
+int sc_util_field_mod_parse(const char *desc, struct sc_field_mod_prog *prog);
+void sc_util_field_mod_free(struct sc_field_mod_prog *prog);
+void sc_util_field_mod_print(struct sc_field_mod_prog *prog);
+int sc_util_field_mod_state_init(struct sc_field_mod_state *state, struct sc_field_mod_prog *prog,
+    uint32_t nb_pkt_per_burst, uint32_t stream_id, uint32_t nb_streams);
+void sc_util_field_mod_state_free(struct sc_field_mod_state *state);
+void sc_util_field_mod_apply_burst(struct sc_field_mod_state *state, struct rte_mbuf **pkts_burst, uint32_t nb_pkts);
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef _SC_UTILS_FLOW_POP_H_
+#define _SC_UTILS_FLOW_POP_H_
+
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+
+#include "sc_utils/prng.hpp"
+#include "sc_utils/alias.hpp"
+
+/*!
+ * \brief maximum number of flows inside a single flow population,
+ *        limited by the 32-bit column index of the alias sampler
+ */
+#define SC_FLOW_POP_MAX_NB_FLOWS UINT32_MAX
+
+/*!
+ * \brief popularity distribution of flows
+ */
+enum {
+    SC_FLOW_POP_NONE = 0,   /* disable flow population */
+    SC_FLOW_POP_UNIFORM,    /* every flow is equally likely */
+    SC_FLOW_POP_ZIPF,       /* probability of the i-th flow is proportional to 1/i^skew */
+    SC_FLOW_POP_HOTCOLD     /* a small hot set of flows receives most of the traffic */
+};
+
+/*!
+ * \brief configuration of the flow population
+ */
+struct sc_flow_pop_conf {
+    uint8_t distribution;
+    double zipf_skew;
+    double hot_set_ratio;       /* fraction of flows inside the hot set */
+    double hot_traffic_ratio;   /* fraction of traffic sent to the hot set */
+};
+
+/*!
+ * \brief flow table stored as structure of arrays, along with the alias table
+ *        which samples flow index by the popularity distribution in O(1)
+ */
+struct sc_flow_pop {
+    uint64_t nb_flows;
+
+    /* flow table, all addresses are stored in network byte order */
+    rte_be32_t *src_ipv4;
+    rte_be32_t *dst_ipv4;
+    rte_be16_t *src_port;
+    rte_be16_t *dst_port;
+    uint32_t *rss_hash;         /* precomputed toeplitz hash */
+
+    /* alias table */
+    uint32_t *alias_threshold;  /* probability of picking the column itself, scaled by 2^32 */
+    uint32_t *alias_index;      /* index of the alias flow of the column */
+};
+
+int sc_util_flow_pop_create(struct sc_flow_pop *pop, uint64_t nb_flows, struct sc_flow_pop_conf *conf,
+    uint64_t rss_hash_field, bool rss_affinity, uint32_t nb_queues, uint32_t used_queue_id);
+void sc_util_flow_pop_free(struct sc_flow_pop *pop);
+
+/*!
+ * \brief   sample a flow index based on the popularity distribution, using the given random value
+ * \param   pop     the flow population
+ * \param   r       the random value
+ * \return  index of the sampled flow
+ */
+static inline uint64_t sc_util_flow_pop_sample_by(struct sc_flow_pop *pop, uint64_t r){
+    return sc_util_alias_sample(pop->alias_threshold, pop->alias_index, pop->nb_flows, r);
+}
+
+/*!
+ * \brief   sample a flow index based on the popularity distribution
+ * \param   pop     the flow population
+ * \return  index of the sampled flow
+ */
+static inline uint64_t sc_util_flow_pop_sample(struct sc_flow_pop *pop){
+    return sc_util_flow_pop_sample_by(pop, sc_util_rand());
+}
+
+/*!
+ * \brief   write the addresses of the given flow into an ipv4/udp packet
+ * \param   pop     the flow population
+ * \param   flow_id index of the flow
+ * \param   pkt     the packet to be written
+ */
+static inline void sc_util_flow_pop_apply_v4_udp(struct sc_flow_pop *pop, uint64_t flow_id, struct rte_mbuf *pkt){
+    struct rte_ipv4_hdr *ipv4_hdr
+        = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+    struct rte_udp_hdr *udp_hdr = (struct rte_udp_hdr*)(ipv4_hdr + 1);
+
+    ipv4_hdr->src_addr = pop->src_ipv4[flow_id];
+    ipv4_hdr->dst_addr = pop->dst_ipv4[flow_id];
+    ipv4_hdr->hdr_checksum = 0;
+    ipv4_hdr->hdr_checksum = rte_ipv4_cksum(ipv4_hdr);
+
+    udp_hdr->src_port = pop->src_port[flow_id];
+    udp_hdr->dst_port = pop->dst_port[flow_id];
+    udp_hdr->dgram_cksum = 0;
+
+    pkt->hash.rss = pop->rss_hash[flow_id];
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _SC_UTILS_HDR_HIST_H_
+#define _SC_UTILS_HDR_HIST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_branch_prediction.h>
+
+/*!
+ * \brief range of significant figures of the histogram, same as HdrHistogram
+ */
+#define SC_HDR_HIST_MIN_SIG_FIGS 1
+#define SC_HDR_HIST_MAX_SIG_FIGS 5
+
+/*!
+ * \brief log-linear (hdr) histogram, values below 2^sub_bits are recorded exactly,
+ *        others are recorded within 2^sub_bits linear sub-buckets of their power of 2
+ */
+struct sc_hdr_hist {
+    uint8_t sub_bits;
+    uint32_t nb_buckets;
+    uint64_t max_trackable;     /* larger values are clamped into the last bucket */
+    uint64_t total_count;
+    uint64_t min_value;
+    uint64_t max_value;
+    uint64_t *counts;
+};
+
+int sc_util_hdr_hist_init(struct sc_hdr_hist *hist, uint64_t max_trackable, uint8_t sig_figs);
+void sc_util_hdr_hist_free(struct sc_hdr_hist *hist);
+void sc_util_hdr_hist_reset(struct sc_hdr_hist *hist);
+int sc_util_hdr_hist_merge(struct sc_hdr_hist *dst, const struct sc_hdr_hist *src);
+int sc_util_hdr_hist_diff(struct sc_hdr_hist *dst, const struct sc_hdr_hist *cur, const struct sc_hdr_hist *prev);
+uint64_t sc_util_hdr_hist_value_at_percentile(const struct sc_hdr_hist *hist, double percentile);
+double sc_util_hdr_hist_mean(const struct sc_hdr_hist *hist);
+double sc_util_hdr_hist_stddev(const struct sc_hdr_hist *hist);
+int sc_util_hdr_hist_output_percentiles(const struct sc_hdr_hist *hist, FILE *fp,
+    uint32_t ticks_per_half_distance, double value_scale);
+
+/*!
+ * \brief   obtain the index of the bucket which holds the value
+ * \param   hist    the histogram
+ * \param   value   the value
+ * \return  index of the bucket
+ */
+static inline uint32_t sc_util_hdr_hist_index(const struct sc_hdr_hist *hist, uint64_t value){
+    uint32_t msb, index;
+
+    if(value < (1UL << hist->sub_bits)){ return (uint32_t)value; }
+    msb = 63 - __builtin_clzll(value);
+    index = ((msb - hist->sub_bits + 1) << hist->sub_bits)
+        + (uint32_t)((value >> (msb - hist->sub_bits)) & ((1UL << hist->sub_bits) - 1));
+    return index < hist->nb_buckets ? index : hist->nb_buckets - 1;
+}
+
+/*!
+ * \brief   obtain the lowest value of the bucket
+ * \param   hist    the histogram
+ * \param   index   index of the bucket
+ * \return  the lowest value
+ */
+static inline uint64_t sc_util_hdr_hist_lowest_value(const struct sc_hdr_hist *hist, uint32_t index){
+    uint32_t group = index >> hist->sub_bits;
+    uint64_t sub = index & ((1UL << hist->sub_bits) - 1);
+
+    if(group == 0){ return sub; }
+    return ((1UL << hist->sub_bits) + sub) << (group - 1);
+}
+
+/*!
+ * \brief   obtain the highest value which is equivalent to values of the bucket
+ * \param   hist    the histogram
+ * \param   index   index of the bucket
+ * \return  the highest equivalent value
+ */
+static inline uint64_t sc_util_hdr_hist_highest_value(const struct sc_hdr_hist *hist, uint32_t index){
+    uint32_t group = index >> hist->sub_bits;
+    return sc_util_hdr_hist_lowest_value(hist, index) + (group == 0 ? 0 : (1UL << (group - 1)) - 1);
+}
+
+/*!
+ * \brief   record a value, the histogram is owned by a single core
+ * \param   hist    the histogram
+ * \param   value   the value
+ */
+static inline void sc_util_hdr_hist_record(struct sc_hdr_hist *hist, uint64_t value){
+    hist->counts[sc_util_hdr_hist_index(hist, value)] += 1;
+    hist->total_count += 1;
+    if(unlikely(value < hist->min_value)){ hist->min_value = value; }
+    if(unlikely(value > hist->max_value)){ hist->max_value = value; }
+}
+
+#endif
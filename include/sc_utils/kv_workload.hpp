@@ -0,0 +1,185 @@
+#ifndef _SC_UTILS_KV_WORKLOAD_H_
+#define _SC_UTILS_KV_WORKLOAD_H_
+
+#include <stdint.h>
+
+#include <rte_byteorder.h>
+
+#include "sc_utils/prng.hpp"
+#include "sc_utils/alias.hpp"
+
+/*!
+ * \brief magic number of kv requests, to tell them from other payloads
+ */
+#define SC_KV_MAGIC 0x5C4B5652
+
+/*!
+ * \brief limits of the key space and request shape
+ */
+#define SC_KV_MAX_NB_KEYS UINT32_MAX
+#define SC_KV_MAX_KEY_LEN 250       /* same as memcached */
+#define SC_KV_MAX_SCAN_LEN 1000
+
+/*!
+ * \brief type of kv operations, inserts and read-modify-writes are told
+ *        apart from updates (sets) to report their latencies separately
+ */
+enum {
+    SC_KV_OP_GET = 0,
+    SC_KV_OP_SET,       /* update an existing key */
+    SC_KV_OP_INSERT,    /* set a new key, which grows the key space */
+    SC_KV_OP_DEL,
+    SC_KV_OP_SCAN,      /* read a range of records starting at the key */
+    SC_KV_OP_RMW,       /* read-modify-write of a key */
+    SC_KV_OP_UNKNOWN
+};
+
+/*!
+ * \brief workloads, presets follow the core workloads of YCSB
+ */
+enum {
+    SC_KV_WORKLOAD_A = 0,   /* update heavy: 50% get, 50% set, zipf */
+    SC_KV_WORKLOAD_B,       /* read mostly: 95% get, 5% set, zipf */
+    SC_KV_WORKLOAD_C,       /* read only: 100% get, zipf */
+    SC_KV_WORKLOAD_D,       /* read latest: 95% get, 5% insert, latest */
+    SC_KV_WORKLOAD_E,       /* short ranges: 95% scan, 5% insert, zipf */
+    SC_KV_WORKLOAD_F,       /* read-modify-write: 50% get, 50% rmw, zipf */
+    SC_KV_WORKLOAD_CUSTOM,  /* mix and key distribution given by the configuration */
+    SC_KV_WORKLOAD_UNKNOWN
+};
+
+/*!
+ * \brief popularity distribution of keys
+ */
+enum {
+    SC_KV_KEY_DIST_UNIFORM = 0,
+    SC_KV_KEY_DIST_ZIPF,    /* zipf over ranks, ranks are scattered across the key space */
+    SC_KV_KEY_DIST_LATEST,  /* zipf over recency, the latest inserted key is the most popular */
+    SC_KV_KEY_DIST_UNKNOWN
+};
+
+/*!
+ * \brief configuration of the kv workload
+ */
+struct sc_kv_workload_conf {
+    uint8_t workload;
+    double op_ratios[SC_KV_OP_UNKNOWN];     /* only for custom workload */
+    uint8_t key_dist;                       /* only for custom workload */
+    double zipf_skew;
+    uint64_t nb_keys;                       /* number of keys loaded before the run */
+    uint16_t key_len;
+    uint32_t value_len;
+    uint32_t max_scan_len;
+};
+
+/*!
+ * \brief request header of the kv protocol, placed inside the udp payload
+ *        and followed by the key (and the value for set / insert / rmw),
+ *        all fields are stored in network byte order
+ */
+struct sc_kv_req_hdr {
+    rte_be32_t magic;
+    uint8_t op;
+    uint8_t reserved;
+    rte_be16_t key_len;
+    rte_be32_t value_len;   /* length of the value, or number of records to scan */
+    rte_be32_t sender_id;
+    rte_be64_t req_id;
+} __attribute__((__packed__));
+
+/*!
+ * \brief a generated request
+ */
+struct sc_kv_req {
+    uint8_t op;
+    uint64_t key_id;
+    uint32_t value_len;     /* length of the value, or number of records to scan */
+};
+
+/*!
+ * \brief the compiled workload, shared (read-only) by all send cores
+ */
+struct sc_kv_workload {
+    struct sc_kv_workload_conf conf;
+    uint8_t key_dist;
+    uint64_t op_thresholds[SC_KV_OP_UNKNOWN];   /* cumulative ratio of each operation, scaled by 2^32 */
+    uint64_t scatter_mult;                      /* coprime with nb_keys, scatters zipf ranks across keys */
+
+    /* alias table of zipf ranks (unused under uniform distribution) */
+    uint32_t *alias_threshold;
+    uint32_t *alias_index;
+};
+
+/*!
+ * \brief per-core state of the generator, keys inserted by different
+ *        cores are interleaved so that they never collide
+ */
+struct sc_kv_gen {
+    struct sc_kv_workload *workload;
+    uint32_t stream_id;
+    uint32_t nb_streams;
+    uint64_t nb_inserted;
+};
+
+int sc_util_kv_workload_parse_name(const char *name, uint8_t *workload);
+int sc_util_kv_key_dist_parse_name(const char *name, uint8_t *key_dist);
+int sc_util_kv_op_mix_parse(const char *desc, double *op_ratios);
+const char* sc_util_kv_op_name(uint8_t op);
+int sc_util_kv_workload_create(struct sc_kv_workload *workload, struct sc_kv_workload_conf *conf);
+void sc_util_kv_workload_free(struct sc_kv_workload *workload);
+void sc_util_kv_workload_print(struct sc_kv_workload *workload);
+void sc_util_kv_gen_init(struct sc_kv_gen *gen, struct sc_kv_workload *workload, uint32_t stream_id, uint32_t nb_streams);
+void sc_util_kv_gen_next(struct sc_kv_gen *gen, struct sc_kv_req *req);
+
+/*!
+ * \brief   whether the request of the operation carries a value
+ * \param   op  the operation
+ * \return  whether the value is carried
+ */
+static inline bool sc_util_kv_op_has_value(uint8_t op){
+    return op == SC_KV_OP_SET || op == SC_KV_OP_INSERT || op == SC_KV_OP_RMW;
+}
+
+/*!
+ * \brief   length of the encoded request
+ * \param   workload    the workload
+ * \param   has_value   whether the request carries a value
+ * \return  length of the request (unit: bytes)
+ */
+static inline uint32_t sc_util_kv_req_len(struct sc_kv_workload *workload, bool has_value){
+    return sizeof(struct sc_kv_req_hdr) + workload->conf.key_len + (has_value ? workload->conf.value_len : 0);
+}
+
+/*!
+ * \brief   encode the header and the key of the request, keys are the lowercase
+ *          hex of the key id, left-padded with '0' to key_len bytes
+ * \note    the value (if any) is left as the original payload of the packet
+ * \param   dst         the destination, with at least sizeof(sc_kv_req_hdr) + key_len bytes
+ * \param   req         the request
+ * \param   key_len     length of the key
+ * \param   sender_id   index of the sender
+ * \param   req_id      id of the request, for matching the response
+ */
+static inline void sc_util_kv_encode_req(uint8_t *dst, struct sc_kv_req *req, uint16_t key_len,
+        uint32_t sender_id, uint64_t req_id){
+    static const char hex[] = "0123456789abcdef";
+    struct sc_kv_req_hdr *hdr = (struct sc_kv_req_hdr*)dst;
+    uint8_t *key = dst + sizeof(struct sc_kv_req_hdr);
+    uint64_t key_id = req->key_id;
+    int i;
+
+    hdr->magic = rte_cpu_to_be_32(SC_KV_MAGIC);
+    hdr->op = req->op;
+    hdr->reserved = 0;
+    hdr->key_len = rte_cpu_to_be_16(key_len);
+    hdr->value_len = rte_cpu_to_be_32(req->value_len);
+    hdr->sender_id = rte_cpu_to_be_32(sender_id);
+    hdr->req_id = rte_cpu_to_be_64(req_id);
+
+    for(i=key_len-1; i>=0; i--){
+        key[i] = hex[key_id & 0xf];
+        key_id >>= 4;
+    }
+}
+
+#endif
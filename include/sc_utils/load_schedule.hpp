@@ -0,0 +1,52 @@
+#ifndef _SC_UTILS_LOAD_SCHEDULE_H_
+#define _SC_UTILS_LOAD_SCHEDULE_H_
+
+#include <stdint.h>
+
+#include "sc_utils/pkt_size.hpp"
+
+/*!
+ * \brief default number of steps a ramp phase is expanded into
+ */
+#define SC_LOAD_SCHED_DEFAULT_RAMP_STEPS 10
+
+/*!
+ * \brief a phase of the offered load
+ */
+struct sc_load_phase {
+    uint64_t duration_ms;
+    uint64_t end_ms;            /* offset of the end of this phase since the start of the schedule */
+    double pkt_rate;            /* overall packet rate, unit: Mpps (0 for idle phase) */
+    uint64_t nb_flows;          /* number of flows of each core (0 for all flows) */
+
+    /* packet mix of this phase (configured mix of the application if not enabled) */
+    bool enable_pkt_size_dist;
+    struct sc_pkt_size_dist pkt_size_dist;
+};
+
+/*!
+ * \brief time-varying offered load, made of consecutive phases
+ */
+struct sc_load_schedule {
+    uint32_t nb_phases;
+    struct sc_load_phase *phases;
+    uint64_t total_duration_ms;
+};
+
+int sc_util_load_schedule_parse(const char *path, struct sc_load_schedule *sched);
+void sc_util_load_schedule_free(struct sc_load_schedule *sched);
+void sc_util_load_schedule_print(struct sc_load_schedule *sched);
+
+/*!
+ * \brief   obtain the index of the phase at the given offset
+ * \param   sched       the load schedule
+ * \param   offset_ms   offset since the start of the schedule (unit: ms)
+ * \param   hint        index of the phase to start searching from
+ * \return  index of the phase, nb_phases if the schedule is finished
+ */
+static inline uint32_t sc_util_load_schedule_phase_at(struct sc_load_schedule *sched, uint64_t offset_ms, uint32_t hint){
+    while(hint < sched->nb_phases && offset_ms >= sched->phases[hint].end_ms){ hint += 1; }
+    return hint;
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef _SC_UTILS_PACER_H_
+#define _SC_UTILS_PACER_H_
+
+#include <stdint.h>
+#include <math.h>
+
+#include <rte_branch_prediction.h>
+#include <rte_cycles.h>
+
+#include "sc_utils/prng.hpp"
+
+/*!
+ * \brief arrival process of bursts
+ */
+enum {
+    SC_PACER_CONSTANT = 0,  /* constant gap between bursts */
+    SC_PACER_POISSON,       /* exponentially distributed gap between bursts */
+    SC_PACER_ONOFF          /* constant gap within on-period, silent within off-period */
+};
+
+/*!
+ * \brief per-core pacer, bursts are released by a token bucket which is refilled
+ *        by the tsc, the refilling time of each token is decided by the arrival process
+ */
+struct sc_pacer {
+    uint8_t arrival;
+    uint64_t tsc_hz;
+    uint32_t nb_pkt_per_burst;
+
+    /* mean gap between bursts (unit: cycles) */
+    double burst_gap_cycles;
+
+    /* token bucket: tsc when the next token is refilled, along with the bucket depth */
+    double next_token_tsc;
+    uint64_t bucket_depth;
+
+    /* on/off period (unit: cycles) */
+    uint64_t on_cycles;
+    uint64_t off_cycles;
+    uint64_t onoff_start_tsc;
+
+    /* statistics */
+    uint64_t start_tsc;
+    uint64_t nb_released_bursts;
+    uint64_t nb_dropped_tokens;
+    double sum_lateness_cycles;
+    uint64_t max_lateness_cycles;
+};
+
+int sc_util_pacer_init(struct sc_pacer *pacer, uint8_t arrival, double pkt_rate_mpps,
+    uint32_t nb_pkt_per_burst, uint64_t bucket_depth, uint64_t on_us, uint64_t off_us);
+void sc_util_pacer_set_rate(struct sc_pacer *pacer, double pkt_rate_mpps);
+void sc_util_pacer_report(struct sc_pacer *pacer, double target_pkt_rate_mpps);
+
+/*!
+ * \brief   obtain the gap before the next token based on the arrival process
+ * \param   pacer   the pacer
+ * \return  the gap (unit: cycles)
+ */
+static inline double _sc_util_pacer_next_gap(struct sc_pacer *pacer){
+    double u;
+
+    if(pacer->arrival == SC_PACER_POISSON){
+        /* uniform value within (0, 1] */
+        u = (double)((sc_util_rand() >> 11) + 1) * (1.0 / 9007199254740992.0);
+        return -log(u) * pacer->burst_gap_cycles;
+    }
+
+    return pacer->burst_gap_cycles;
+}
+
+/*!
+ * \brief   try to release a burst from the pacer
+ * \param   pacer   the pacer
+ * \param   now_tsc current tsc
+ * \return  whether a burst could be sent
+ */
+static inline bool sc_util_pacer_try_release(struct sc_pacer *pacer, uint64_t now_tsc){
+    double lateness;
+    uint64_t phase;
+
+    if((double)now_tsc < pacer->next_token_tsc)
+        return false;
+
+    /* on/off: skip the whole off-period */
+    if(pacer->arrival == SC_PACER_ONOFF){
+        phase = ((uint64_t)pacer->next_token_tsc - pacer->onoff_start_tsc) % (pacer->on_cycles + pacer->off_cycles);
+        if(phase >= pacer->on_cycles){
+            pacer->next_token_tsc += (double)(pacer->on_cycles + pacer->off_cycles - phase);
+            if((double)now_tsc < pacer->next_token_tsc)
+                return false;
+        }
+    }
+
+    /* tokens exceeding the bucket depth are dropped, to avoid sending a huge burst after stall */
+    lateness = (double)now_tsc - pacer->next_token_tsc;
+    if(unlikely(lateness > pacer->burst_gap_cycles * (double)pacer->bucket_depth)){
+        pacer->nb_dropped_tokens += (uint64_t)(lateness / pacer->burst_gap_cycles) - pacer->bucket_depth;
+        pacer->next_token_tsc = (double)now_tsc - pacer->burst_gap_cycles * (double)pacer->bucket_depth;
+        lateness = pacer->burst_gap_cycles * (double)pacer->bucket_depth;
+    }
+
+    /* consume a token, the next token is scheduled from the previous one to avoid drifting */
+    pacer->next_token_tsc += _sc_util_pacer_next_gap(pacer);
+
+    pacer->nb_released_bursts += 1;
+    pacer->sum_lateness_cycles += lateness;
+    if((uint64_t)lateness > pacer->max_lateness_cycles)
+        pacer->max_lateness_cycles = (uint64_t)lateness;
+
+    return true;
+}
+
+#endif
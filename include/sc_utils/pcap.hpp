@@ -0,0 +1,62 @@
+#ifndef _SC_UTILS_PCAP_H_
+#define _SC_UTILS_PCAP_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+
+/*!
+ * \brief magic numbers of pcap / pcapng files
+ */
+#define SC_PCAP_MAGIC_US        0xA1B2C3D4
+#define SC_PCAP_MAGIC_NS        0xA1B23C4D
+#define SC_PCAPNG_BLOCK_SHB     0x0A0D0D0A
+#define SC_PCAPNG_BLOCK_IDB     0x00000001
+#define SC_PCAPNG_BLOCK_SPB     0x00000003
+#define SC_PCAPNG_BLOCK_EPB     0x00000006
+#define SC_PCAPNG_BYTE_ORDER    0x1A2B3C4D
+
+/*!
+ * \brief link type of ethernet frames
+ */
+#define SC_PCAP_LINKTYPE_ETHERNET 1
+
+/*!
+ * \brief maximum number of interfaces described inside a pcapng section
+ */
+#define SC_PCAPNG_MAX_NB_IFACES 16
+
+/*!
+ * \brief maximum length of a captured frame that could be loaded
+ */
+#define SC_PCAP_MAX_SNAPLEN (UINT16_MAX - RTE_PKTMBUF_HEADROOM)
+
+/*!
+ * \brief replay mode of the loaded trace
+ */
+enum {
+    SC_PCAP_REPLAY_ORIGINAL = 0,    /* replay with the original timing */
+    SC_PCAP_REPLAY_SCALED,          /* replay with the timing scaled by a speed factor */
+    SC_PCAP_REPLAY_TOP_SPEED        /* replay back-to-back, ignore the timing */
+};
+
+/*!
+ * \brief packets loaded from a pcap file and assigned to a single core
+ */
+struct sc_pcap_trace {
+    uint64_t nb_pkts;
+    struct rte_mbuf **pkts;     /* preloaded frames, won't be sent directly */
+    uint64_t *ts_ns;            /* timestamp relative to the first frame of the file */
+};
+
+int sc_util_pcap_load(const char *file_path, uint32_t nb_traces,
+    struct sc_pcap_trace *traces, struct rte_mempool **mp, uint64_t *duration_ns);
+void sc_util_pcap_free(uint32_t nb_traces, struct sc_pcap_trace *traces, struct rte_mempool *mp);
+int sc_util_pcap_rewrite_pkt(struct rte_mbuf *pkt, struct rte_ether_addr *src_mac,
+    struct rte_ether_addr *dst_mac, rte_be32_t src_ipv4, rte_be32_t dst_ipv4);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _SC_UTILS_PKT_SIZE_H_
+#define _SC_UTILS_PKT_SIZE_H_
+
+#include <stdint.h>
+
+#include "sc_utils/alias.hpp"
+
+/*!
+ * \brief maximum number of size buckets, sizes of empirical distributions are
+ *        merged into buckets with (nearly) equal probability mass beyond this
+ */
+#define SC_PKT_SIZE_MAX_NB_BUCKETS 64
+
+/*!
+ * \brief distribution of packet size, sampled by alias table
+ */
+struct sc_pkt_size_dist {
+    uint32_t nb_buckets;
+    uint32_t sizes[SC_PKT_SIZE_MAX_NB_BUCKETS];     /* unit: bytes, ascending */
+    double probs[SC_PKT_SIZE_MAX_NB_BUCKETS];
+
+    /* alias table */
+    uint32_t alias_threshold[SC_PKT_SIZE_MAX_NB_BUCKETS];
+    uint32_t alias_index[SC_PKT_SIZE_MAX_NB_BUCKETS];
+
+    uint32_t min_size;
+    uint32_t max_size;
+    double mean_size;
+};
+
+int sc_util_pkt_size_dist_parse(const char *desc, struct sc_pkt_size_dist *dist);
+int sc_util_pkt_size_dist_init(struct sc_pkt_size_dist *dist, uint32_t *sizes, double *weights, uint32_t nb_sizes);
+void sc_util_pkt_size_dist_print(struct sc_pkt_size_dist *dist);
+
+/*!
+ * \brief   sample a size bucket based on the distribution
+ * \param   dist    the packet size distribution
+ * \param   r       64-bit random value
+ * \return  index of the sampled bucket
+ */
+static inline uint32_t sc_util_pkt_size_sample_bucket(struct sc_pkt_size_dist *dist, uint64_t r){
+    return (uint32_t)sc_util_alias_sample(dist->alias_threshold, dist->alias_index, dist->nb_buckets, r);
+}
+
+#endif
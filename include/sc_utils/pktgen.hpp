@@ -10,6 +10,8 @@
 #include <rte_sctp.h>
 #include <rte_ethdev.h>
 
+#include "sc_utils/pkt_size.hpp"
+
 #define IP_DEFTTL  64   /* from RFC 1340. */
 
 #define IPV4_ADDR(a, b, c, d)(((a & 0xff) << 24) | ((b & 0xff) << 16) | \
@@ -52,6 +54,60 @@ struct sc_pkt_hdr {
 	uint64_t payload_offset;
 };
 
+/* protocol stack */
+#define SC_PROTO_STACK_MAX_NB_LAYERS	12
+#define SC_PROTO_STACK_MAX_HDR_LEN		256
+#define SC_PROTO_VXLAN_UDP_PORT			4789
+#define SC_PROTO_GENEVE_UDP_PORT		6081
+#define SC_PROTO_ETHER_TYPE_TEB			0x6558	/* transparent ethernet bridging */
+
+enum {
+	SC_PROTO_ETH = 0,
+	SC_PROTO_VLAN,		/* 802.1Q c-tag */
+	SC_PROTO_QINQ,		/* 802.1ad s-tag */
+	SC_PROTO_IPV4,
+	SC_PROTO_IPV6,
+	SC_PROTO_UDP,
+	SC_PROTO_TCP,
+	SC_PROTO_VXLAN,
+	SC_PROTO_GRE,
+	SC_PROTO_GENEVE,
+	SC_PROTO_UNKNOWN
+};
+
+/* a single layer inside the protocol stack */
+struct sc_proto_layer {
+	uint8_t type;
+	uint16_t offset;
+	uint16_t len;
+};
+
+/* 
+ * protocol stack described by a compact string (e.g., eth/vlan/ipv6/udp/vxlan/eth/ipv4/tcp),
+ * either built as template for generation, or parsed from a received packet
+ */
+struct sc_proto_stack {
+	uint8_t nb_layers;
+	struct sc_proto_layer layers[SC_PROTO_STACK_MAX_NB_LAYERS];
+
+	/* index of the innermost l3 / l4 layer and the outermost tunnel udp layer (-1 for not exist) */
+	int8_t inner_l3_idx, inner_l4_idx, tunnel_udp_idx;
+
+	/* precomputed template of all headers */
+	uint32_t pkt_len;
+	uint16_t hdr_len;
+	uint8_t hdr_template[SC_PROTO_STACK_MAX_HDR_LEN];
+};
+
+int sc_util_parse_proto_stack_desc(const char *desc, struct sc_proto_stack *stack);
+int sc_util_build_proto_stack_template(struct sc_proto_stack *stack, uint32_t pkt_len,
+		struct rte_ether_addr *src_mac, struct rte_ether_addr *dst_mac);
+int sc_util_generate_packet_burst_mbufs_stack(struct rte_mempool *mp, struct sc_proto_stack *stack,
+		struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst, bool vary_fields);
+int sc_util_parse_pkt_proto_stack(struct rte_mbuf *pkt, struct sc_proto_stack *stack);
+uint64_t sc_util_proto_stack_signature(struct sc_proto_stack *stack);
+void sc_util_proto_stack_to_str(struct sc_proto_stack *stack, char *str, uint32_t str_len);
+
 /* data copier */
 int sc_util_copy_buf_to_pkt(void *buf, unsigned len, struct rte_mbuf *pkt, unsigned offset);
 
@@ -75,6 +131,9 @@ int sc_util_copy_payload_to_packet_burst(void *payload, uint64_t payload_len, ui
 	struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst);
 int sc_util_generate_packet_burst_mbufs_fast_v4_udp(struct rte_mempool *mp, struct sc_pkt_hdr *hdr,
 		struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst);
+int sc_util_generate_packet_burst_mbufs_fast_v4_udp_mixed(struct rte_mempool *mp, struct sc_pkt_hdr *hdrs,
+		struct sc_pkt_size_dist *dist, struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst);
+int sc_util_resize_pkt_hdr_v4_udp(struct sc_pkt_hdr *hdr, uint32_t pkt_len);
 int sc_util_generate_packet_burst_mbufs(struct rte_mempool *mp, struct sc_pkt_hdr *hdr, 
 		struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst);
 int sc_util_initialize_eth_header(struct rte_ether_hdr *eth_hdr,
@@ -0,0 +1,81 @@
+#ifndef _SC_UTILS_PRNG_H_
+#define _SC_UTILS_PRNG_H_
+
+#include <stdint.h>
+
+#include <rte_branch_prediction.h>
+
+/*!
+ * \brief number of interleaved generators used for bulk filling
+ */
+#define SC_PRNG_NB_LANES 4
+
+/*!
+ * \brief xoshiro256** generator, along with interleaved generators for bulk filling
+ */
+struct sc_prng {
+    bool is_seeded;
+    uint64_t s[4];
+    uint64_t lanes[4][SC_PRNG_NB_LANES];    /* index: state word, lane */
+};
+
+/*!
+ * \brief per-thread generator, seeded by the global seed and the index of the thread
+ */
+extern __thread struct sc_prng perthread_prng;
+
+void sc_util_prng_set_global_seed(uint64_t seed);
+uint64_t sc_util_prng_get_global_seed();
+void sc_util_prng_seed(struct sc_prng *prng, uint64_t seed, uint64_t stream_id);
+void sc_util_prng_seed_thread(uint64_t stream_id);
+void sc_util_prng_fill(struct sc_prng *prng, uint64_t *buf, uint64_t nb_values);
+
+/*!
+ * \brief   generate next random value by the given generator
+ * \param   prng    the generator
+ * \return  the generated value
+ */
+static inline uint64_t sc_util_prng_next(struct sc_prng *prng){
+    const uint64_t result = ((prng->s[1] * 5) << 7 | (prng->s[1] * 5) >> 57) * 9;
+    const uint64_t t = prng->s[1] << 17;
+
+    prng->s[2] ^= prng->s[0];
+    prng->s[3] ^= prng->s[1];
+    prng->s[1] ^= prng->s[2];
+    prng->s[0] ^= prng->s[3];
+    prng->s[2] ^= t;
+    prng->s[3] = (prng->s[3] << 45) | (prng->s[3] >> 19);
+
+    return result;
+}
+
+/*!
+ * \brief   generate random value by the generator of current thread
+ * \return  the generated value
+ */
+static inline uint64_t sc_util_rand(){
+    /* threads which are not worker (e.g., main / control-plane thread) are seeded lazily */
+    if(unlikely(!perthread_prng.is_seeded)){
+        sc_util_prng_seed_thread(UINT32_MAX);
+    }
+    return sc_util_prng_next(&perthread_prng);
+}
+
+/*!
+ * \brief   generate random value within [0, bound) by the generator of current thread
+ * \param   bound   the upper bound (exclusive)
+ * \return  the generated value
+ */
+static inline uint64_t sc_util_rand_bounded(uint64_t bound){
+    return (uint64_t)(((unsigned __int128)sc_util_rand() * bound) >> 64);
+}
+
+/*!
+ * \brief   generate random double within [0, 1) by the generator of current thread
+ * \return  the generated value
+ */
+static inline double sc_util_rand_double(){
+    return (double)(sc_util_rand() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
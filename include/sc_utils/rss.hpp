@@ -1,8 +1,67 @@
 #ifndef _SC_UTILS_RSS_H_
 #define _SC_UTILS_RSS_H_
 
+#include <stdint.h>
+
+#include <rte_ethdev.h>
 #include <rte_thash.h>
 
+/*!
+ * \brief maximum size of the emulated redirection table
+ */
+#define SC_RSS_EMU_MAX_RETA_SIZE    512
+
+/*!
+ * \brief maximum length of the emulated rss key (unit: bytes)
+ */
+#define SC_RSS_EMU_MAX_KEY_LEN      52
+
+/*!
+ * \brief number of tuple bits adjusted to steer a flow into the chosen reta entry
+ */
+#define SC_RSS_EMU_NB_ADJUST_BITS   16
+
+/*!
+ * \brief software emulator of the toeplitz rss of a port, the hash is calculated by
+ *        per-byte lookup tables, and flows are steered into the wanted queue by solving
+ *        the linear (over GF(2)) toeplitz function on a 16-bit tuple field
+ */
+struct sc_rss_emulator {
+    bool is_initialized;
+    bool is_l3_only;
+    uint32_t nb_queues;
+
+    /* rss key and redirection table obtained from the port */
+    uint8_t key[SC_RSS_EMU_MAX_KEY_LEN];
+    uint8_t key_len;
+    uint16_t reta_size;
+    uint16_t reta[SC_RSS_EMU_MAX_RETA_SIZE];
+
+    /* reta entries pointed to each queue, grouped by queue */
+    uint16_t queue_entries[SC_RSS_EMU_MAX_RETA_SIZE];
+    uint16_t queue_entry_offset[RTE_MAX_QUEUES_PER_PORT+1];
+
+    /* hash contribution of each byte of the ipv4 tuple */
+    uint32_t v4_lut[RTE_THASH_V4_L4_LEN*4][256];
+
+    /*
+     * basis of the reta index space spanned by the adjusted bits
+     * (source port, or the lower 16 bits of the source address if only l3 is hashed),
+     * indexed by the pivot bit, along with the adjusted bits composing it
+     */
+    uint32_t basis_hash[32];
+    uint16_t basis_bits[32];
+};
+
+extern struct sc_rss_emulator used_rss_emulator;
+
+int sc_util_rss_emu_init(struct sc_rss_emulator *emu, uint16_t port_id, uint32_t nb_queues,
+    uint64_t rss_hash_field, const uint8_t *expected_key, uint8_t expected_key_len);
+uint32_t sc_util_rss_emu_hash_ipv4(struct sc_rss_emulator *emu,
+    uint32_t src_ipv4, uint32_t dst_ipv4, uint16_t sport, uint16_t dport);
+int sc_util_rss_emu_gen_flow_ipv4(struct sc_rss_emulator *emu, uint32_t queue_id,
+    uint32_t *src_ipv4, uint32_t *dst_ipv4, uint16_t *sport, uint16_t *dport, uint32_t *rss_hash);
+
 int sc_util_get_rss_queue_id_ipv4(
     uint32_t src_ipv4, uint32_t dst_ipv4, uint16_t sport, uint16_t dport, 
     uint32_t sctp_tag, uint32_t nb_queues, uint32_t *queue_id, uint64_t rss_hash_field);
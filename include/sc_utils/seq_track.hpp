@@ -0,0 +1,91 @@
+#ifndef _SC_UTILS_SEQ_TRACK_H_
+#define _SC_UTILS_SEQ_TRACK_H_
+
+#include <stdint.h>
+
+#include <rte_branch_prediction.h>
+
+/*!
+ * \brief length of the reorder window (unit: sequence numbers), a packet arriving
+ *        after more than this number of later packets could no longer be told apart
+ *        from a duplicate, and is counted as late
+ */
+#define SC_SEQ_WINDOW_LEN 64
+
+/*!
+ * \brief receive window of a sequenced stream
+ */
+struct sc_seq_window {
+    uint64_t next_seq;  /* highest received sequence number plus one */
+    uint64_t bitmap;    /* bit i is set if sequence number (next_seq - 1 - i) is received */
+};
+
+/*!
+ * \brief statistics of sequenced streams, all counters only grow so that
+ *        statistics of an interval are the difference of two snapshots
+ */
+struct sc_seq_stat {
+    uint64_t nb_received;
+    uint64_t nb_gaps;               /* number of times that sequence numbers are skipped */
+    uint64_t nb_missing;            /* skipped sequence numbers, some could arrive later */
+    uint64_t nb_reordered;          /* skipped sequence numbers which arrived within the window */
+    uint64_t nb_late;               /* skipped sequence numbers which arrived beyond the window */
+    uint64_t nb_duplicated;
+    uint64_t max_reorder_depth;     /* number of later packets which arrived before a reordered one */
+};
+
+void sc_util_seq_stat_merge(struct sc_seq_stat *dst, const struct sc_seq_stat *src);
+void sc_util_seq_stat_diff(struct sc_seq_stat *dst, const struct sc_seq_stat *cur, const struct sc_seq_stat *prev);
+
+/*!
+ * \brief   obtain the number of lost packets, assuming that late packets are not duplicates
+ * \param   stat    the statistics
+ * \return  number of lost packets
+ */
+static inline uint64_t sc_util_seq_stat_nb_lost(const struct sc_seq_stat *stat){
+    uint64_t nb_arrived = stat->nb_reordered + stat->nb_late;
+    return stat->nb_missing > nb_arrived ? stat->nb_missing - nb_arrived : 0;
+}
+
+/*!
+ * \brief   track a received sequence number of the stream
+ * \param   window  receive window of the stream, owned by a single core
+ * \param   stat    statistics to be updated
+ * \param   seq     the received sequence number, starting from zero
+ */
+static inline void sc_util_seq_track(struct sc_seq_window *window, struct sc_seq_stat *stat, uint64_t seq){
+    uint64_t gap, depth, bit;
+
+    stat->nb_received += 1;
+
+    /* in order, or ahead of the window */
+    if(likely(seq >= window->next_seq)){
+        gap = seq - window->next_seq;
+        if(unlikely(gap > 0)){
+            stat->nb_gaps += 1;
+            stat->nb_missing += gap;
+        }
+        window->bitmap = gap + 1 >= SC_SEQ_WINDOW_LEN ? 0 : window->bitmap << (gap + 1);
+        window->bitmap |= 1;
+        window->next_seq = seq + 1;
+        return;
+    }
+
+    /* behind the window */
+    depth = window->next_seq - 1 - seq;
+    if(unlikely(depth >= SC_SEQ_WINDOW_LEN)){
+        stat->nb_late += 1;
+        return;
+    }
+
+    bit = 1UL << depth;
+    if(window->bitmap & bit){
+        stat->nb_duplicated += 1;
+        return;
+    }
+    window->bitmap |= bit;
+    stat->nb_reordered += 1;
+    if(depth > stat->max_reorder_depth){ stat->max_reorder_depth = depth; }
+}
+
+#endif
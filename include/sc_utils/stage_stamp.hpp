@@ -0,0 +1,114 @@
+#ifndef _SC_UTILS_STAGE_STAMP_H_
+#define _SC_UTILS_STAGE_STAMP_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_mbuf.h>
+#include <rte_byteorder.h>
+#include <rte_branch_prediction.h>
+
+#include "sc_utils.hpp"
+
+/*!
+ * \brief magic number of the trailer, placed by the client to ask for server-side stamps
+ */
+#define SC_STAGE_TRAILER_MAGIC 0x5C57A6E5
+
+/*!
+ * \brief stages stamped by the server framework, with one tsc read per burst
+ */
+enum {
+    SC_STAGE_RX = 0,        /* right after the burst is received */
+    SC_STAGE_TX,            /* the burst is handed to tx (sc_flush_tx_queue or the send path of the application) */
+    SC_NB_STAGES
+};
+
+/*!
+ * \brief trailer occupying the last bytes of the packet, all fields are stored in network
+ *        byte order, stamps are tsc of the server, which are converted by its tsc frequency
+ */
+struct sc_stage_trailer {
+    rte_be32_t magic;
+    rte_be32_t reserved;
+    rte_be64_t tsc_hz;                  /* zero until the server stamps the packet */
+    rte_be64_t stamps[SC_NB_STAGES];
+} __attribute__((__packed__));
+
+/*!
+ * \brief indicator of whether the server framework stamps trailers of received packets,
+ *        checked by the worker loop, sc_flush_tx_queue and send paths of applications on the datapath
+ */
+extern bool sc_stage_stamp_enabled;
+
+void sc_util_stage_stamp_rx_burst(struct rte_mbuf **pkts, uint16_t nb_pkts, uint64_t rx_tsc);
+const char* sc_util_stage_name(uint8_t stage);
+
+/*!
+ * \brief   obtain the trailer of the packet
+ * \param   pkt the packet, the trailer should be inside its last segment
+ * \return  the trailer (NULL if the packet doesn't carry one)
+ */
+static inline struct sc_stage_trailer* sc_util_stage_trailer_of(struct rte_mbuf *pkt){
+    struct rte_mbuf *last_seg = rte_pktmbuf_lastseg(pkt);
+    struct sc_stage_trailer *trailer;
+
+    if(unlikely(last_seg->data_len < sizeof(struct sc_stage_trailer))){ return NULL; }
+    trailer = rte_pktmbuf_mtod_offset(last_seg, struct sc_stage_trailer*,
+        last_seg->data_len - sizeof(struct sc_stage_trailer));
+    return trailer->magic == rte_cpu_to_be_32(SC_STAGE_TRAILER_MAGIC) ? trailer : NULL;
+}
+
+/*!
+ * \brief   place an empty trailer at the end of the packet (client side)
+ * \param   pkt the packet
+ * \return  zero for successfully placing
+ */
+static inline int sc_util_stage_init_trailer(struct rte_mbuf *pkt){
+    struct rte_mbuf *last_seg = rte_pktmbuf_lastseg(pkt);
+    struct sc_stage_trailer *trailer;
+
+    if(unlikely(last_seg->data_len < sizeof(struct sc_stage_trailer))){ return SC_ERROR_INVALID_VALUE; }
+    trailer = rte_pktmbuf_mtod_offset(last_seg, struct sc_stage_trailer*,
+        last_seg->data_len - sizeof(struct sc_stage_trailer));
+    memset(trailer, 0, sizeof(struct sc_stage_trailer));
+    trailer->magic = rte_cpu_to_be_32(SC_STAGE_TRAILER_MAGIC);
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   stamp a stage of the burst (server side), packets without trailer
+ *          or not stamped at rx are skipped
+ * \param   pkts    the packets
+ * \param   nb_pkts number of packets
+ * \param   stage   the stage
+ * \param   tsc     tsc of the stage
+ */
+static inline void sc_util_stage_stamp_burst(struct rte_mbuf **pkts, uint64_t nb_pkts, uint8_t stage, uint64_t tsc){
+    uint64_t i;
+    struct sc_stage_trailer *trailer;
+
+    for(i=0; i<nb_pkts; i++){
+        trailer = sc_util_stage_trailer_of(pkts[i]);
+        if(!trailer || trailer->tsc_hz == 0){ continue; }
+        trailer->stamps[stage] = rte_cpu_to_be_64(tsc);
+    }
+}
+
+/*!
+ * \brief   obtain the elapsed time between two stages of the stamped trailer (client side)
+ * \param   trailer the trailer
+ * \param   from    the earlier stage
+ * \param   to      the later stage
+ * \return  elapsed time (unit: ns), zero if either stage isn't stamped
+ */
+static inline uint64_t sc_util_stage_elapsed_ns(const struct sc_stage_trailer *trailer, uint8_t from, uint8_t to){
+    uint64_t tsc_hz = rte_be_to_cpu_64(trailer->tsc_hz);
+    uint64_t from_tsc = rte_be_to_cpu_64(trailer->stamps[from]);
+    uint64_t to_tsc = rte_be_to_cpu_64(trailer->stamps[to]);
+
+    if(tsc_hz == 0 || from_tsc == 0 || to_tsc <= from_tsc){ return 0; }
+    return (uint64_t)((unsigned __int128)(to_tsc - from_tsc) * 1000000000UL / tsc_hz);
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <chrono>
 
+#include <rte_cycles.h>
+
 #include "sc_utils.hpp"
 
 #define SC_UTIL_TIME_INTERVL_US(sec, usec) usec + sec * 1000 * 1000
@@ -12,6 +14,15 @@
 #define SC_HALF_TIMESTAMP_LEN 4     /* 4,294,967,296 ns */
 #define SC_SHORT_TIMESTAMP_LEN 2    /* 65536 ns */
 
+/* duration of calibrating the tsc against the monotonic clock at start (unit: ms) */
+#define SC_TSC_CALIBRATE_MS 100
+
+/* calibrated tsc frequency, and the fixed-point factor of converting cycles to ns (ns = cycles * mult >> 32) */
+extern uint64_t sc_tsc_hz;
+extern uint64_t sc_tsc_ns_mult;
+
+int sc_util_tsc_calibrate(uint32_t duration_ms);
+
 enum {
     SC_TIMESTAMP_FULL_TYPE = 0,
     SC_TIMESTAMP_HALF_TYPE,
@@ -125,4 +136,47 @@ inline uint64_t sc_util_timestamp_ns() {
               (std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
+/*!
+ * \brief   obtain tsc timestamp, which is embedded into packets and converted to ns only while reporting
+ * \note    timestamps taken by different cores are comparable under invariant and synchronized tsc
+ * \return  tsc timestamp (unit: cycles)
+ */
+inline uint64_t sc_util_timestamp_tsc() {
+    return rte_rdtsc();
+}
+
+/*!
+ * \brief   obtain tsc timestamp after all previous instructions are retired
+ * \return  tsc timestamp (unit: cycles)
+ */
+inline uint64_t sc_util_timestamp_tsc_precise() {
+    return rte_rdtsc_precise();
+}
+
+/*!
+ * \brief   obtain the calibrated tsc frequency
+ * \return  tsc frequency (unit: Hz)
+ */
+inline uint64_t sc_util_tsc_hz() {
+    return sc_tsc_hz;
+}
+
+/*!
+ * \brief   convert tsc cycles to nanoseconds
+ * \param   cycles  number of cycles
+ * \return  number of nanoseconds
+ */
+inline uint64_t sc_util_tsc_to_ns(uint64_t cycles) {
+    return (uint64_t)(((unsigned __int128)cycles * sc_tsc_ns_mult) >> 32);
+}
+
+/*!
+ * \brief   convert nanoseconds to tsc cycles
+ * \param   ns  number of nanoseconds
+ * \return  number of cycles
+ */
+inline uint64_t sc_util_ns_to_tsc(uint64_t ns) {
+    return (uint64_t)((unsigned __int128)ns * sc_tsc_hz / 1000000000UL);
+}
+
 #endif
\ No newline at end of file
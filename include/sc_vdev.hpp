@@ -0,0 +1,57 @@
+#ifndef _SC_VDEV_H_
+#define _SC_VDEV_H_
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <sys/time.h>
+
+#include <rte_common.h>
+#include <rte_ethdev.h>
+#include <rte_version.h>
+
+/*!
+ * \brief maximum length of a single generated eal parameter
+ */
+#define SC_VDEV_EAL_ARG_STRLEN 256
+
+/*!
+ * \brief maximum log2 ring size supported by memif PMD
+ */
+#define SC_MEMIF_MAX_LOG2_RING_SIZE 14
+
+/*!
+ * \brief MAC address of the generated memif port, the last three bytes are
+ *        (id >> 8), (id & 0xFF) and role (server: 0, client: 1)
+ */
+#define SC_MEMIF_MAC_FMT "02:4D:46:%02X:%02X:%02X"
+
+/*!
+ * \brief MAC address of the generated virtio-user port (frontend of vhost-user),
+ *        the MAC address of vhost port (backend) is assigned by the PMD
+ *        as 56:48:4F:53:54:<port id>
+ */
+#define SC_VIRTIO_USER_MAC "02:56:49:52:54:00"
+
+/*!
+ * \brief name of the AF_XDP PMD
+ */
+#define SC_AF_XDP_DRIVER_NAME "net_af_xdp"
+
+/*!
+ * \brief MAC address of the null port which represents the kernel socket backend
+ */
+#define SC_SOCKET_PORT_MAC "02:53:4F:43:4B:00"
+
+/*!
+ * \brief maximum number of virtual devices created by SoConnect
+ */
+#define SC_MAX_NB_VDEVS 8
+
+int init_vdev_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv);
+int init_vdev_port(struct sc_config *sc_config, uint16_t port_id);
+bool sc_vdev_is_port_choosed(uint16_t port_id);
+bool sc_vdev_is_af_xdp_port(uint16_t port_id);
+int init_vdev_stats(struct sc_config *sc_config);
+int report_vdev_stats(struct sc_config *sc_config);
+
+#endif
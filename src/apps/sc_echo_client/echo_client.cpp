@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <arpa/inet.h>
 #include "sc_global.hpp"
 #include "sc_worker.hpp"
 #include "sc_app.hpp"
@@ -161,6 +162,27 @@ invalid_pkt_len:
         SC_ERROR_DETAILS("invalid configuration pkt_len\n");
     }
 
+    /* packet size distribution */
+    if(!strcmp(key, "pkt_size_dist")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        /* empty distribution for sending fixed-size packets */
+        if(strlen(value) == 0){
+            goto _parse_app_kv_pair_exit;
+        }
+
+        if(sc_util_pkt_size_dist_parse(value, &INTERNAL_CONF(sc_config)->pkt_size_dist) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pkt_size_dist;
+        }
+        INTERNAL_CONF(sc_config)->enable_pkt_size_dist = true;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pkt_size_dist:
+        SC_ERROR_DETAILS("invalid configuration pkt_size_dist\n");
+    }
+
     /* send bit rate */
     if(!strcmp(key, "bit_rate")){
         value = sc_util_del_both_trim(value);
@@ -193,6 +215,61 @@ invalid_pkt_rate:
         SC_ERROR_DETAILS("invalid configuration pkt_rate\n");
     }
 
+    /* arrival process of bursts */
+    if(!strcmp(key, "pacing_arrival")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(!strcmp(value, "constant")){
+            INTERNAL_CONF(sc_config)->pacing_arrival = SC_PACER_CONSTANT;
+        } else if(!strcmp(value, "poisson")){
+            INTERNAL_CONF(sc_config)->pacing_arrival = SC_PACER_POISSON;
+        } else if(!strcmp(value, "onoff")){
+            INTERNAL_CONF(sc_config)->pacing_arrival = SC_PACER_ONOFF;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pacing_arrival;
+        }
+        goto _parse_app_kv_pair_exit;
+
+invalid_pacing_arrival:
+        SC_ERROR_DETAILS("invalid configuration pacing_arrival\n");
+    }
+
+    /* depth of the token bucket (unit: bursts) */
+    if(!strcmp(key, "pacing_bucket_depth")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t pacing_bucket_depth;
+        if(sc_util_atoui_64(value, &pacing_bucket_depth) != SC_SUCCESS || pacing_bucket_depth == 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pacing_bucket_depth;
+        }
+        INTERNAL_CONF(sc_config)->pacing_bucket_depth = pacing_bucket_depth;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pacing_bucket_depth:
+        SC_ERROR_DETAILS("invalid configuration pacing_bucket_depth\n");
+    }
+
+    /* length of on-period / off-period (unit: us) */
+    if(!strcmp(key, "pacing_on_us") || !strcmp(key, "pacing_off_us")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t pacing_period_us;
+        if(sc_util_atoui_64(value, &pacing_period_us) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pacing_period;
+        }
+        if(!strcmp(key, "pacing_on_us"))
+            INTERNAL_CONF(sc_config)->pacing_on_us = pacing_period_us;
+        else
+            INTERNAL_CONF(sc_config)->pacing_off_us = pacing_period_us;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pacing_period:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
     /* number of packet per burst */
     if(!strcmp(key, "nb_pkt_per_burst")){
         value = sc_util_del_both_trim(value);
@@ -209,6 +286,53 @@ invalid_nb_pkt_per_burst:
         SC_ERROR_DETAILS("invalid configuration nb_pkt_per_burst\n");
     }
     
+    /* role of each used core, in the order of logical core index */
+    if(!strcmp(key, "core_roles")){
+        uint32_t nb_core_roles = 0;
+        char *delim = ",";
+        char *p;
+
+        for(;;){
+            if(nb_core_roles == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            if(nb_core_roles == SC_MAX_NB_CORES){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_core_roles;
+            }
+
+            if(!strcmp(p, "send")){
+                INTERNAL_CONF(sc_config)->core_roles[nb_core_roles] = SC_ECHO_CLIENT_ROLE_SEND;
+            } else if(!strcmp(p, "recv")){
+                INTERNAL_CONF(sc_config)->core_roles[nb_core_roles] = SC_ECHO_CLIENT_ROLE_RECV;
+            } else if(!strcmp(p, "send_recv")){
+                INTERNAL_CONF(sc_config)->core_roles[nb_core_roles] = SC_ECHO_CLIENT_ROLE_SEND_RECV;
+            } else {
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_core_roles;
+            }
+            nb_core_roles += 1;
+        }
+
+        if(nb_core_roles == 0){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_core_roles;
+        }
+
+        INTERNAL_CONF(sc_config)->nb_core_roles = nb_core_roles;
+        goto _parse_app_kv_pair_exit;
+
+invalid_core_roles:
+        SC_ERROR_DETAILS("invalid configuration core_roles\n");
+    }
+
     /* number of flow per core */
     if(!strcmp(key, "nb_flow_per_core")){
         value = sc_util_del_both_trim(value);
@@ -230,775 +354,4545 @@ invalid_nb_flow_per_core:
         SC_ERROR_DETAILS("invalid configuration nb_flow_per_core\n");
     }
 
-_parse_app_kv_pair_exit:
-    return result;
-}
+    /* steer flows of each send core into its own queue */
+    if(!strcmp(key, "rss_affinity")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->rss_affinity = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->rss_affinity = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_rss_affinity;
+        }
 
-/*!
- * \brief   callback while entering application
- * \param   sc_config   the global configuration
- * \return  zero for successfully executing
- */
-int _process_enter_sender(struct sc_config *sc_config){
-    int i, result = SC_SUCCESS;
-    uint16_t queue_id = 0;
-    
-    PER_CORE_APP_META(sc_config).nb_send_pkt = 0;
-    PER_CORE_APP_META(sc_config).nb_confirmed_pkt = 0;
+        goto _parse_app_kv_pair_exit;
 
-    /* initialize interval generator */
-    double per_core_pkt_rate;
-    if(INTERNAL_CONF(sc_config)->pkt_rate != 0) {
-        per_core_pkt_rate = (double)INTERNAL_CONF(sc_config)->pkt_rate 
-                            / (double)1000 / (double)(sc_config->nb_used_cores/2);      /* Gpps */
-    } else {
-        per_core_pkt_rate = (double)INTERNAL_CONF(sc_config)->bit_rate 
-                            / (double)(sc_config->nb_used_cores/2)
-                            / (double) 8.0 / (double)INTERNAL_CONF(sc_config)->pkt_len; /* Gpps */
+invalid_rss_affinity:
+        SC_ERROR_DETAILS("invalid configuration rss_affinity\n");
     }
 
-    double per_core_brust_rate = (double) per_core_pkt_rate / (double)INTERNAL_CONF(sc_config)->nb_pkt_per_burst;
-    double per_core_brust_interval = (double) 1.0 / (double) per_core_brust_rate; /* ns */
-    PER_CORE_APP_META(sc_config).interval_generator 
-        = new sc_util_exponential_uint64_generator((int)per_core_brust_interval);
-    PER_CORE_APP_META(sc_config).interval = PER_CORE_APP_META(sc_config).interval_generator->next();
-    PER_CORE_APP_META(sc_config).last_send_timestamp = sc_util_timestamp_ns();
-    
-    // SC_THREAD_LOG("per core pkt rate: %lf G packet/second", per_core_pkt_rate);    
-    // SC_THREAD_LOG("per core brust rate: %lf G brust/second", per_core_brust_rate);
-    // SC_THREAD_LOG("per core brust interval: %lf ns, (int)%d ns",
-    //    per_core_brust_interval, (int)per_core_brust_interval);
-    // SC_THREAD_LOG("initialize interval: %lu ns", PER_CORE_APP_META(sc_config).interval);
-
-    /* allocate memory for storing generated packet headers */
-    struct sc_pkt_hdr *pkt_hdrs = (struct sc_pkt_hdr*)rte_malloc(
-        NULL, sizeof(struct sc_pkt_hdr)*INTERNAL_CONF(sc_config)->nb_flow_per_core, 0);
-    if(unlikely(!pkt_hdrs)){
-        SC_THREAD_ERROR_DETAILS("failed to allocate memory for pkt_hdrs");
-        result = SC_ERROR_MEMORY;
-        goto _process_enter_exit;
+    /* popularity distribution of flows */
+    if(!strcmp(key, "flow_popularity")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(!strcmp(value, "none")){
+            INTERNAL_CONF(sc_config)->flow_pop_conf.distribution = SC_FLOW_POP_NONE;
+        } else if(!strcmp(value, "uniform")){
+            INTERNAL_CONF(sc_config)->flow_pop_conf.distribution = SC_FLOW_POP_UNIFORM;
+        } else if(!strcmp(value, "zipf")){
+            INTERNAL_CONF(sc_config)->flow_pop_conf.distribution = SC_FLOW_POP_ZIPF;
+        } else if(!strcmp(value, "hotcold")){
+            INTERNAL_CONF(sc_config)->flow_pop_conf.distribution = SC_FLOW_POP_HOTCOLD;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_popularity;
+        }
+        goto _parse_app_kv_pair_exit;
+
+invalid_flow_popularity:
+        SC_ERROR_DETAILS("invalid configuration flow_popularity\n");
     }
-    memset(pkt_hdrs, 0, sizeof(struct sc_pkt_hdr)*INTERNAL_CONF(sc_config)->nb_flow_per_core);
-    PER_CORE_APP_META(sc_config).test_pkts = pkt_hdrs;
-    PER_CORE_APP_META(sc_config).last_used_flow = 0;
 
-    for(i=0; i<sc_config->nb_used_cores; i++){
-        if(sc_config->core_ids[i] == rte_lcore_id()){
-            queue_id = i;
-            /*! 
-                \note:  we allow nb_rings_per_port is less than nb_used_port 
-                        so we have to limit the queue_id within the valid range
-             */
-            if(queue_id != 0){
-                queue_id = queue_id % sc_config->nb_rx_rings_per_port;
-            }
-            
-            SC_THREAD_LOG("core %u is using queue %u", rte_lcore_id(), queue_id);
-            break;
-        }
-        if(i == sc_config->nb_used_cores-1){
-            SC_THREAD_ERROR_DETAILS("unknown queue id for worker thread on lcore %u", rte_lcore_id());
-            result = SC_ERROR_INTERNAL;
-            goto _process_enter_exit;
+    /* skew of zipf distribution */
+    if(!strcmp(key, "flow_zipf_skew")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double flow_zipf_skew;
+        if(sc_util_atolf(value, &flow_zipf_skew) != SC_SUCCESS || flow_zipf_skew < 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_zipf_skew;
         }
+        INTERNAL_CONF(sc_config)->flow_pop_conf.zipf_skew = flow_zipf_skew;
+        goto _parse_app_kv_pair_exit;
+
+invalid_flow_zipf_skew:
+        SC_ERROR_DETAILS("invalid configuration flow_zipf_skew\n");
     }
 
-    /* generate random packet header for each flow */
-    for(i=0; i<INTERNAL_CONF(sc_config)->nb_flow_per_core; i++){
-        result = sc_util_generate_random_pkt_hdr(
-            /* sc_pkt_hdr */ &PER_CORE_APP_META(sc_config).test_pkts[i],
-            /* pkt_len */ INTERNAL_CONF(sc_config)->pkt_len,
-            /* payload_len */ 0,
-            /* nb_queues */ sc_config->nb_rx_rings_per_port,
-            /* used_queue_id */ queue_id,
-            /* l3_type */ RTE_ETHER_TYPE_IPV4,
-            /* l4_type */ IPPROTO_UDP,
-            /* rss_hash_field */ sc_config->rss_hash_field,
-            /* rss_affinity */ false,
-            /* min_pkt_len */ 
-                sizeof(struct sc_timestamp_table) + sizeof(struct rte_ether_hdr) 
-                + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr),
-            /* payload */ nullptr
-        );
-        if(result != SC_SUCCESS){
-            SC_THREAD_ERROR("failed to generate new pkt header");
-            goto _process_enter_exit;
+    /* fraction of flows inside the hot set */
+    if(!strcmp(key, "flow_hot_set_ratio")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double flow_hot_set_ratio;
+        if(sc_util_atolf(value, &flow_hot_set_ratio) != SC_SUCCESS 
+            || flow_hot_set_ratio <= 0 || flow_hot_set_ratio > 1) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_hot_set_ratio;
         }
-    }
-    // SC_THREAD_LOG(
-    //     "generate %lu flow(s)' header, l3_type: %x, l4_type: %d",
-    //     INTERNAL_CONF(sc_config)->nb_flow_per_core,
-    //     PER_CORE_APP_META(sc_config).test_pkts[0].l3_type,
-    //     PER_CORE_APP_META(sc_config).test_pkts[0].l4_type
-    // )
+        INTERNAL_CONF(sc_config)->flow_pop_conf.hot_set_ratio = flow_hot_set_ratio;
+        goto _parse_app_kv_pair_exit;
 
-    /* allocate array for pointers to storing send pkt_bufs */
-    PER_CORE_APP_META(sc_config).send_pkt_bufs = (struct rte_mbuf **)rte_malloc(NULL, 
-        sizeof(struct rte_mbuf*)*INTERNAL_CONF(sc_config)->nb_pkt_per_burst, 0);
-    if(unlikely(!PER_CORE_APP_META(sc_config).send_pkt_bufs)){
-        SC_THREAD_ERROR_DETAILS("failed to allocate memory for send_pkt_bufs");
-        result = SC_ERROR_MEMORY;
-        goto _process_enter_exit;
+invalid_flow_hot_set_ratio:
+        SC_ERROR_DETAILS("invalid configuration flow_hot_set_ratio\n");
     }
 
-    /* initialize the start_time */
-    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).start_time, NULL))){
-        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
-        result =  SC_ERROR_INTERNAL;
-        goto _process_enter_exit;
+    /* fraction of traffic sent to the hot set */
+    if(!strcmp(key, "flow_hot_traffic_ratio")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double flow_hot_traffic_ratio;
+        if(sc_util_atolf(value, &flow_hot_traffic_ratio) != SC_SUCCESS 
+            || flow_hot_traffic_ratio < 0 || flow_hot_traffic_ratio > 1) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_hot_traffic_ratio;
+        }
+        INTERNAL_CONF(sc_config)->flow_pop_conf.hot_traffic_ratio = flow_hot_traffic_ratio;
+        goto _parse_app_kv_pair_exit;
+
+invalid_flow_hot_traffic_ratio:
+        SC_ERROR_DETAILS("invalid configuration flow_hot_traffic_ratio\n");
     }
 
-_process_enter_exit:
-    return result;
-}
+    /* protocol stack of the generated packets */
+    if(!strcmp(key, "proto_stack")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
 
-/*!
- * \brief   callback for client logic
- * \param   sc_config       the global configuration
- * \param   queue_id        the index of the queue for current core to tx/rx packet
- * \param   ready_to_exit   indicator for exiting worker loop
- * \return  zero for successfully executing
- */
-int _process_client_sender(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
-    int i, j, nb_tx = 0, nb_send_pkt = 0, result = SC_SUCCESS, retry;
-    uint64_t current_ns = 0;
+        /* empty stack for generating default ipv4/udp packets */
+        if(strlen(value) == 0){
+            goto _parse_app_kv_pair_exit;
+        }
 
-    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
-        struct sc_timestamp_table sc_ts = {0};
-    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+        if(sc_util_parse_proto_stack_desc(value, &INTERNAL_CONF(sc_config)->proto_stack) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_proto_stack;
+        }
+        INTERNAL_CONF(sc_config)->enable_proto_stack = true;
+        goto _parse_app_kv_pair_exit;
 
-    /* send packet */
-    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_ports; i++){
-        /* avoid endless loop */
-        if(sc_force_quit){ break; }
+invalid_proto_stack:
+        SC_ERROR_DETAILS("invalid configuration proto_stack\n");
+    }
 
-        /* check send interval */
-        /* this will cause 0.4Mpps performance loss under 66 pkt size */
-        current_ns = sc_util_timestamp_ns();
-        if(current_ns - PER_CORE_APP_META(sc_config).last_send_timestamp < PER_CORE_APP_META(sc_config).interval){
-            continue;
+    /* per-packet field modifiers */
+    if(!strcmp(key, "field_modifiers")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        /* empty description for unmodified packets */
+        if(strlen(value) == 0){
+            goto _parse_app_kv_pair_exit;
         }
 
-        /* obtain the packet header currently used, and setup payload info*/
-        struct sc_pkt_hdr *current_used_pkt 
-            = &(PER_CORE_APP_META(sc_config).test_pkts[PER_CORE_APP_META(sc_config).last_used_flow]);
-        
-        /* generate new burst of packets */
-        if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_fast_v4_udp(
-                /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
-                /* hdr */ current_used_pkt,
-                /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
-                /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
-        )){
-            SC_THREAD_ERROR("failed to assemble final packet");
-            result = SC_ERROR_INTERNAL;
-            goto process_client_ready_to_exit;
+        if(sc_util_field_mod_parse(value, &INTERNAL_CONF(sc_config)->field_mod_prog) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_field_modifiers;
         }
+        INTERNAL_CONF(sc_config)->enable_field_mod = true;
+        goto _parse_app_kv_pair_exit;
 
-        #if defined(SC_ECHO_CLIENT_GET_LATENCY)
-            /* set the accuracy as short */
-            sc_ts.timestamp_type = SC_TIMESTAMP_FULL_TYPE;
+invalid_field_modifiers:
+        SC_ERROR_DETAILS("invalid configuration field_modifiers\n");
+    }
 
-            /* 
-             * record the timestamp
-             */
-            sc_util_add_full_timestamp(&sc_ts, sc_util_timestamp_ns());
+    /* calculate udp checksum in software */
+    if(!strcmp(key, "enable_sw_cksum")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_sw_cksum = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_sw_cksum = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_sw_cksum;
+        }
 
-            /* copy timestamp to payload */
-            if(SC_SUCCESS != sc_util_copy_payload_to_packet_burst(
-                /* payload */ &sc_ts,
-                /* payload_len */ sizeof(sc_ts),
-                /* payload_offset */ &(current_used_pkt->payload_offset),
-                /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
-                /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
-            )){
-                SC_THREAD_ERROR("failed to copy payload to final packets");
-                result = SC_ERROR_INTERNAL;
-                goto process_client_ready_to_exit;
-            }
+        goto _parse_app_kv_pair_exit;
 
-            /* we record the copy latency here to fix the latency statistic */
-            PER_CORE_APP_META(sc_config).payload_copy_latency +=
-                (double)(sc_util_timestamp_ns() - current_ns);
-            PER_CORE_APP_META(sc_config).payload_copy_latency /= (double)2.0f;
-        #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+invalid_enable_sw_cksum:
+        SC_ERROR_DETAILS("invalid configuration enable_sw_cksum\n");
+    }
 
-        nb_send_pkt = rte_eth_tx_burst(
-            /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
-            /* queue_id */ queue_id,
-            /* tx_pkts */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
-            /* nb_pkts */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
-        );
-        if(unlikely(nb_send_pkt < INTERNAL_CONF(sc_config)->nb_pkt_per_burst)){
-            retry = 0;
-            while (nb_send_pkt < INTERNAL_CONF(sc_config)->nb_pkt_per_burst 
-                    && retry++ < SC_ECHO_CLIENT_BURST_TX_RETRIES
-            ){
-                nb_send_pkt += rte_eth_tx_burst(
-                    /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
-                    /* queue_id */ queue_id, 
-                    /* tx_pkts */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_send_pkt], 
-                    /* nb_pkts */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst - nb_send_pkt
-                );
+    /* per-flow sequence numbers */
+    if(!strcmp(key, "enable_seq")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_seq = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_seq = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_seq;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_seq:
+        SC_ERROR_DETAILS("invalid configuration enable_seq\n");
+    }
+
+    /* server-side stage stamps */
+    if(!strcmp(key, "server_stage_stamps")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_stage_stamps = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_stage_stamps = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_server_stage_stamps;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_server_stage_stamps:
+        SC_ERROR_DETAILS("invalid configuration server_stage_stamps\n");
+    }
+
+    /* packet sizes of the checksum microbenchmark */
+    if(!strcmp(key, "cksum_bench_pkt_sizes")){
+        uint32_t nb_sizes = 0, size;
+        char *delim = ",";
+        char *p;
+
+        for(;;){
+            if(nb_sizes == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            /* empty list for skipping the microbenchmark */
+            if(nb_sizes == 0 && strlen(p) == 0) break;
+
+            if(nb_sizes == SC_ECHO_CLIENT_CKSUM_BENCH_MAX_NB_SIZES
+                || sc_util_atoui_32(p, &size) != SC_SUCCESS || size == 0){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_cksum_bench_pkt_sizes;
+            }
+            INTERNAL_CONF(sc_config)->cksum_bench_sizes[nb_sizes] = size;
+            nb_sizes += 1;
+        }
+
+        INTERNAL_CONF(sc_config)->nb_cksum_bench_sizes = nb_sizes;
+        goto _parse_app_kv_pair_exit;
+
+invalid_cksum_bench_pkt_sizes:
+        SC_ERROR_DETAILS("invalid configuration cksum_bench_pkt_sizes\n");
+    }
+
+    /* significant figures of latency histograms */
+    if(!strcmp(key, "latency_hist_sig_figs")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint32_t sig_figs;
+        if(sc_util_atoui_32(value, &sig_figs) != SC_SUCCESS 
+            || sig_figs < SC_HDR_HIST_MIN_SIG_FIGS || sig_figs > SC_HDR_HIST_MAX_SIG_FIGS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_latency_hist_sig_figs;
+        }
+        INTERNAL_CONF(sc_config)->latency_hist_sig_figs = (uint8_t)sig_figs;
+        goto _parse_app_kv_pair_exit;
+
+invalid_latency_hist_sig_figs:
+        SC_ERROR_DETAILS("invalid configuration latency_hist_sig_figs\n");
+    }
+
+    /* key-value workload carried inside the payload */
+    if(!strcmp(key, "kv_workload")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(!strcmp(value, "none")){
+            INTERNAL_CONF(sc_config)->enable_kv = false;
+            goto _parse_app_kv_pair_exit;
+        }
+        if(sc_util_kv_workload_parse_name(value, &INTERNAL_CONF(sc_config)->kv_conf.workload) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_kv_workload;
+        }
+        INTERNAL_CONF(sc_config)->enable_kv = true;
+        goto _parse_app_kv_pair_exit;
+
+invalid_kv_workload:
+        SC_ERROR_DETAILS("invalid configuration kv_workload\n");
+    }
+
+    /* operation mix of the custom kv workload */
+    if(!strcmp(key, "kv_op_mix")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(sc_util_kv_op_mix_parse(value, INTERNAL_CONF(sc_config)->kv_conf.op_ratios) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_kv_op_mix;
+        }
+        goto _parse_app_kv_pair_exit;
+
+invalid_kv_op_mix:
+        SC_ERROR_DETAILS("invalid configuration kv_op_mix\n");
+    }
+
+    /* key distribution of the custom kv workload */
+    if(!strcmp(key, "kv_key_dist")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(sc_util_kv_key_dist_parse_name(value, &INTERNAL_CONF(sc_config)->kv_conf.key_dist) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_kv_key_dist;
+        }
+        goto _parse_app_kv_pair_exit;
+
+invalid_kv_key_dist:
+        SC_ERROR_DETAILS("invalid configuration kv_key_dist\n");
+    }
+
+    /* skew of zipf distribution of keys */
+    if(!strcmp(key, "kv_zipf_skew")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double kv_zipf_skew;
+        if(sc_util_atolf(value, &kv_zipf_skew) != SC_SUCCESS || kv_zipf_skew <= 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_kv_zipf_skew;
+        }
+        INTERNAL_CONF(sc_config)->kv_conf.zipf_skew = kv_zipf_skew;
+        goto _parse_app_kv_pair_exit;
+
+invalid_kv_zipf_skew:
+        SC_ERROR_DETAILS("invalid configuration kv_zipf_skew\n");
+    }
+
+    /* key space, key and value sizes (unit: bytes) and scan length of kv workload */
+    if(!strcmp(key, "kv_nb_keys") || !strcmp(key, "kv_key_len")
+        || !strcmp(key, "kv_value_len") || !strcmp(key, "kv_max_scan_len")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t kv_value;
+        if(sc_util_atoui_64(value, &kv_value) != SC_SUCCESS || kv_value == 0 || kv_value > UINT32_MAX) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_kv_uint;
+        }
+        if(!strcmp(key, "kv_nb_keys"))
+            INTERNAL_CONF(sc_config)->kv_conf.nb_keys = kv_value;
+        else if(!strcmp(key, "kv_key_len")){
+            if(kv_value > SC_KV_MAX_KEY_LEN){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_kv_uint;
+            }
+            INTERNAL_CONF(sc_config)->kv_conf.key_len = (uint16_t)kv_value;
+        } else if(!strcmp(key, "kv_value_len"))
+            INTERNAL_CONF(sc_config)->kv_conf.value_len = (uint32_t)kv_value;
+        else
+            INTERNAL_CONF(sc_config)->kv_conf.max_scan_len = (uint32_t)kv_value;
+        goto _parse_app_kv_pair_exit;
+
+invalid_kv_uint:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* load schedule file */
+    if(!strcmp(key, "load_schedule")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        /* empty path for a constant offered load */
+        if(strlen(value) == 0){
+            goto _parse_app_kv_pair_exit;
+        }
+
+        if(sc_util_load_schedule_parse(value, &INTERNAL_CONF(sc_config)->load_schedule) != SC_SUCCESS){
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_load_schedule;
+        }
+        INTERNAL_CONF(sc_config)->enable_load_schedule = true;
+        goto _parse_app_kv_pair_exit;
+
+invalid_load_schedule:
+        SC_ERROR_DETAILS("invalid configuration load_schedule\n");
+    }
+
+    /* whether to enable rfc2544 throughput search */
+    if(!strcmp(key, "enable_rfc2544")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_rfc2544 = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_rfc2544 = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_rfc2544;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_rfc2544:
+        SC_ERROR_DETAILS("invalid configuration enable_rfc2544\n");
+    }
+
+    /* packet sizes searched in order */
+    if(!strcmp(key, "rfc2544_pkt_sizes")){
+        uint32_t nb_sizes = 0, size;
+        char *delim = ",";
+        char *p;
+
+        for(;;){
+            if(nb_sizes == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            if(nb_sizes == SC_ECHO_CLIENT_RFC2544_MAX_NB_SIZES
+                || sc_util_atoui_32(p, &size) != SC_SUCCESS || size == 0){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_rfc2544_pkt_sizes;
+            }
+            INTERNAL_CONF(sc_config)->rfc2544_sizes[nb_sizes] = size;
+            nb_sizes += 1;
+        }
+
+        INTERNAL_CONF(sc_config)->nb_rfc2544_sizes = nb_sizes;
+        goto _parse_app_kv_pair_exit;
+
+invalid_rfc2544_pkt_sizes:
+        SC_ERROR_DETAILS("invalid configuration rfc2544_pkt_sizes\n");
+    }
+
+    /* duration of each trial and the following settle period (unit: ms) */
+    if(!strcmp(key, "rfc2544_trial_ms") || !strcmp(key, "rfc2544_settle_ms")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t rfc2544_period_ms;
+        if(sc_util_atoui_64(value, &rfc2544_period_ms) != SC_SUCCESS || rfc2544_period_ms == 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_rfc2544_period;
+        }
+        if(!strcmp(key, "rfc2544_trial_ms"))
+            INTERNAL_CONF(sc_config)->rfc2544_trial_ms = rfc2544_period_ms;
+        else
+            INTERNAL_CONF(sc_config)->rfc2544_settle_ms = rfc2544_period_ms;
+        goto _parse_app_kv_pair_exit;
+
+invalid_rfc2544_period:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* acceptable loss ratio (unit: %), searched rate range and resolution (unit: Mpps) */
+    if(!strcmp(key, "rfc2544_loss_ratio") || !strcmp(key, "rfc2544_min_rate")
+        || !strcmp(key, "rfc2544_max_rate") || !strcmp(key, "rfc2544_resolution")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double rfc2544_value;
+        if(sc_util_atolf(value, &rfc2544_value) != SC_SUCCESS || rfc2544_value < 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_rfc2544_value;
+        }
+        if(!strcmp(key, "rfc2544_loss_ratio"))
+            INTERNAL_CONF(sc_config)->rfc2544_loss_ratio = rfc2544_value;
+        else if(!strcmp(key, "rfc2544_min_rate"))
+            INTERNAL_CONF(sc_config)->rfc2544_min_rate = rfc2544_value;
+        else if(!strcmp(key, "rfc2544_max_rate"))
+            INTERNAL_CONF(sc_config)->rfc2544_max_rate = rfc2544_value;
+        else
+            INTERNAL_CONF(sc_config)->rfc2544_resolution = rfc2544_value;
+        goto _parse_app_kv_pair_exit;
+
+invalid_rfc2544_value:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* whether to enable slo controller */
+    if(!strcmp(key, "enable_slo")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_slo = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_slo = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_slo;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_slo:
+        SC_ERROR_DETAILS("invalid configuration enable_slo\n");
+    }
+
+    /* control law of slo controller */
+    if(!strcmp(key, "slo_controller")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "aimd")){
+            INTERNAL_CONF(sc_config)->slo_controller = SC_ECHO_CLIENT_SLO_AIMD;
+        } else if (!strcmp(value, "pid")){
+            INTERNAL_CONF(sc_config)->slo_controller = SC_ECHO_CLIENT_SLO_PID;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_slo_controller;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_slo_controller:
+        SC_ERROR_DETAILS("invalid configuration slo_controller\n");
+    }
+
+    /* latency target (unit: us), control interval (unit: ms) and number of intervals */
+    if(!strcmp(key, "slo_target_us") || !strcmp(key, "slo_interval_ms")
+        || !strcmp(key, "slo_window") || !strcmp(key, "slo_max_intervals")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t slo_value;
+        if(sc_util_atoui_64(value, &slo_value) != SC_SUCCESS || slo_value == 0 || slo_value > UINT32_MAX) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_slo_uint;
+        }
+        if(!strcmp(key, "slo_target_us"))
+            INTERNAL_CONF(sc_config)->slo_target_us = slo_value;
+        else if(!strcmp(key, "slo_interval_ms"))
+            INTERNAL_CONF(sc_config)->slo_interval_ms = slo_value;
+        else if(!strcmp(key, "slo_window"))
+            INTERNAL_CONF(sc_config)->slo_window = (uint32_t)slo_value;
+        else
+            INTERNAL_CONF(sc_config)->slo_max_intervals = (uint32_t)slo_value;
+        goto _parse_app_kv_pair_exit;
+
+invalid_slo_uint:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* percentile (unit: %), rates (unit: Mpps) and gains of slo controller */
+    if(!strcmp(key, "slo_percentile") || !strcmp(key, "slo_min_rate") || !strcmp(key, "slo_max_rate")
+        || !strcmp(key, "slo_init_rate") || !strcmp(key, "slo_aimd_step") || !strcmp(key, "slo_aimd_backoff")
+        || !strcmp(key, "slo_pid_kp") || !strcmp(key, "slo_pid_ki") || !strcmp(key, "slo_pid_kd")
+        || !strcmp(key, "slo_converge_ratio")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double slo_value;
+        if(sc_util_atolf(value, &slo_value) != SC_SUCCESS || slo_value < 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_slo_double;
+        }
+        if(!strcmp(key, "slo_percentile")){
+            if(slo_value <= 0 || slo_value >= 100){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_slo_double;
+            }
+            INTERNAL_CONF(sc_config)->slo_percentile = slo_value;
+        } else if(!strcmp(key, "slo_aimd_backoff")){
+            if(slo_value <= 0 || slo_value >= 1){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_slo_double;
+            }
+            INTERNAL_CONF(sc_config)->slo_aimd_backoff = slo_value;
+        } else if(!strcmp(key, "slo_min_rate"))
+            INTERNAL_CONF(sc_config)->slo_min_rate = slo_value;
+        else if(!strcmp(key, "slo_max_rate"))
+            INTERNAL_CONF(sc_config)->slo_max_rate = slo_value;
+        else if(!strcmp(key, "slo_init_rate"))
+            INTERNAL_CONF(sc_config)->slo_init_rate = slo_value;
+        else if(!strcmp(key, "slo_aimd_step"))
+            INTERNAL_CONF(sc_config)->slo_aimd_step = slo_value;
+        else if(!strcmp(key, "slo_pid_kp"))
+            INTERNAL_CONF(sc_config)->slo_pid_kp = slo_value;
+        else if(!strcmp(key, "slo_pid_ki"))
+            INTERNAL_CONF(sc_config)->slo_pid_ki = slo_value;
+        else if(!strcmp(key, "slo_pid_kd"))
+            INTERNAL_CONF(sc_config)->slo_pid_kd = slo_value;
+        else
+            INTERNAL_CONF(sc_config)->slo_converge_ratio = slo_value;
+        goto _parse_app_kv_pair_exit;
+
+invalid_slo_double:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* whether to enable closed-loop mode */
+    if(!strcmp(key, "enable_closed_loop")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_closed_loop = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_closed_loop = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_closed_loop;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_closed_loop:
+        SC_ERROR_DETAILS("invalid configuration enable_closed_loop\n");
+    }
+
+    /* maximum outstanding requests per flow of each concurrency level */
+    if(!strcmp(key, "closed_loop_windows")){
+        uint32_t nb_levels = 0, window;
+        char *delim = ",";
+        char *p;
+
+        for(;;){
+            if(nb_levels == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            if(nb_levels == SC_ECHO_CLIENT_CL_MAX_NB_LEVELS
+                || sc_util_atoui_32(p, &window) != SC_SUCCESS || window == 0){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_closed_loop_windows;
             }
+            INTERNAL_CONF(sc_config)->cl_windows[nb_levels] = window;
+            nb_levels += 1;
+        }
+
+        INTERNAL_CONF(sc_config)->nb_cl_levels = nb_levels;
+        goto _parse_app_kv_pair_exit;
+
+invalid_closed_loop_windows:
+        SC_ERROR_DETAILS("invalid configuration closed_loop_windows\n");
+    }
+
+    /* duration of each concurrency level (unit: ms) */
+    if(!strcmp(key, "closed_loop_level_ms")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t cl_level_duration_ms;
+        if(sc_util_atoui_64(value, &cl_level_duration_ms) != SC_SUCCESS || cl_level_duration_ms == 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_closed_loop_level_ms;
+        }
+        INTERNAL_CONF(sc_config)->cl_level_duration_ms = cl_level_duration_ms;
+        goto _parse_app_kv_pair_exit;
+
+invalid_closed_loop_level_ms:
+        SC_ERROR_DETAILS("invalid configuration closed_loop_level_ms\n");
+    }
+
+    /* think time after response, and timeout of request (unit: us) */
+    if(!strcmp(key, "closed_loop_think_time_us") || !strcmp(key, "closed_loop_timeout_us")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t cl_period_us;
+        if(sc_util_atoui_64(value, &cl_period_us) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_closed_loop_period;
+        }
+        if(!strcmp(key, "closed_loop_think_time_us"))
+            INTERNAL_CONF(sc_config)->cl_think_time_us = cl_period_us;
+        else
+            INTERNAL_CONF(sc_config)->cl_timeout_us = cl_period_us;
+        goto _parse_app_kv_pair_exit;
+
+invalid_closed_loop_period:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+    /* path to the replayed pcap file */
+    if(!strcmp(key, "pcap_file")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        /* empty path for disabling pcap replay */
+        if(strlen(value) == 0){
+            goto _parse_app_kv_pair_exit;
+        }
+
+        INTERNAL_CONF(sc_config)->pcap_file = (char*)malloc(strlen(value)+1);
+        if(unlikely(!INTERNAL_CONF(sc_config)->pcap_file)){
+            SC_ERROR_DETAILS("Failed to allocate memory for pcap_file");
+            result = SC_ERROR_MEMORY;
+            goto invalid_pcap_file;
+        }
+        memset(INTERNAL_CONF(sc_config)->pcap_file, 0, strlen(value)+1);
+        strcpy(INTERNAL_CONF(sc_config)->pcap_file, value);
+        goto _parse_app_kv_pair_exit;
+
+invalid_pcap_file:
+        SC_ERROR_DETAILS("invalid configuration pcap_file\n");
+    }
+
+    /* replay mode of the pcap file */
+    if(!strcmp(key, "pcap_replay_mode")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if(!strcmp(value, "original")){
+            INTERNAL_CONF(sc_config)->pcap_replay_mode = SC_PCAP_REPLAY_ORIGINAL;
+        } else if(!strcmp(value, "scaled")){
+            INTERNAL_CONF(sc_config)->pcap_replay_mode = SC_PCAP_REPLAY_SCALED;
+        } else if(!strcmp(value, "top_speed")){
+            INTERNAL_CONF(sc_config)->pcap_replay_mode = SC_PCAP_REPLAY_TOP_SPEED;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pcap_replay_mode;
         }
+        goto _parse_app_kv_pair_exit;
+
+invalid_pcap_replay_mode:
+        SC_ERROR_DETAILS("invalid configuration pcap_replay_mode\n");
+    }
+
+    /* speed factor of scaled replay */
+    if(!strcmp(key, "pcap_replay_speed")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        double pcap_replay_speed;
+        if(sc_util_atolf(value, &pcap_replay_speed) != SC_SUCCESS || pcap_replay_speed <= 0) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_pcap_replay_speed;
+        }
+        INTERNAL_CONF(sc_config)->pcap_replay_speed = pcap_replay_speed;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pcap_replay_speed:
+        SC_ERROR_DETAILS("invalid configuration pcap_replay_speed\n");
+    }
+
+    /* rewritten destination mac address of replayed frames (per send port) */
+    if(!strcmp(key, "pcap_dst_mac")){
+        uint32_t nb_macs = 0;
+        char *delim = ",";
+        char *p;
+
+        for(;;){
+            if(nb_macs == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            if(nb_macs == SC_MAX_NB_PORTS
+                || rte_ether_unformat_addr(p, &INTERNAL_CONF(sc_config)->pcap_dst_mac[nb_macs]) != 0){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_pcap_dst_mac;
+            }
+            nb_macs += 1;
+        }
+
+        INTERNAL_CONF(sc_config)->nb_pcap_dst_macs = nb_macs;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pcap_dst_mac:
+        SC_ERROR_DETAILS("invalid configuration pcap_dst_mac\n");
+    }
+
+    /* rewritten source / destination ipv4 address of replayed frames (per send port) */
+    if(!strcmp(key, "pcap_src_ipv4") || !strcmp(key, "pcap_dst_ipv4")){
+        uint32_t nb_addrs = 0;
+        char *delim = ",";
+        char *p;
+        bool is_src = !strcmp(key, "pcap_src_ipv4");
+        rte_be32_t *addrs = is_src ? INTERNAL_CONF(sc_config)->pcap_src_ipv4 : INTERNAL_CONF(sc_config)->pcap_dst_ipv4;
+
+        for(;;){
+            if(nb_addrs == 0)
+                p = strtok(value, delim);
+            else
+                p = strtok(NULL, delim);
+            
+            if (!p) break;
+
+            p = sc_util_del_both_trim(p);
+            sc_util_del_change_line(p);
+
+            if(nb_addrs == SC_MAX_NB_PORTS || inet_pton(AF_INET, p, &addrs[nb_addrs]) != 1){
+                result = SC_ERROR_INVALID_VALUE;
+                goto invalid_pcap_ipv4;
+            }
+            nb_addrs += 1;
+        }
+
+        if(is_src)
+            INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s = nb_addrs;
+        else
+            INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s = nb_addrs;
+        goto _parse_app_kv_pair_exit;
+
+invalid_pcap_ipv4:
+        SC_ERROR_DETAILS("invalid configuration %s\n", key);
+    }
+
+_parse_app_kv_pair_exit:
+    return result;
+}
+
+/*!
+ * \brief   apply a phase of load schedule to the pacer, flows and packet mix of current send core
+ * \note    executed by the send core itself once the control plane publishes a new phase
+ * \param   sc_config   the global configuration
+ * \param   phase_id    index of the applied phase
+ * \return  zero for successfully applying
+ */
+static int _load_schedule_apply_phase(struct sc_config *sc_config, uint32_t phase_id){
+    int result = SC_SUCCESS;
+    uint64_t i, b, nb_pkt_hdrs, nb_size_buckets = 1;
+    struct sc_load_phase *phase = &INTERNAL_CONF(sc_config)->load_schedule.phases[phase_id];
+    struct sc_pkt_hdr *hdr;
+
+    if(INTERNAL_CONF(sc_config)->enable_pkt_size_dist){
+        nb_size_buckets = INTERNAL_CONF(sc_config)->pkt_size_dist.nb_buckets;
+    }
+
+    /* offered load is shared by all send cores */
+    PER_CORE_APP_META(sc_config).per_core_pkt_rate = phase->pkt_rate / (double)INTERNAL_CONF(sc_config)->nb_send_cores;
+    sc_util_pacer_set_rate(&PER_CORE_APP_META(sc_config).pacer, PER_CORE_APP_META(sc_config).per_core_pkt_rate);
+
+    /* flow set */
+    PER_CORE_APP_META(sc_config).nb_send_flows = phase->nb_flows > 0
+        ? RTE_MIN(phase->nb_flows, INTERNAL_CONF(sc_config)->nb_flow_per_core)
+        : INTERNAL_CONF(sc_config)->nb_flow_per_core;
+    if(PER_CORE_APP_META(sc_config).last_used_flow >= PER_CORE_APP_META(sc_config).nb_send_flows){
+        PER_CORE_APP_META(sc_config).last_used_flow = 0;
+    }
+
+    /* packet mix, headers are derived from the header of each flow */
+    if(phase->enable_pkt_size_dist){
+        nb_pkt_hdrs = INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE 
+                        ? 1 : INTERNAL_CONF(sc_config)->nb_flow_per_core;
+        for(i=0; i<nb_pkt_hdrs; i++){
+            for(b=0; b<phase->pkt_size_dist.nb_buckets; b++){
+                hdr = &PER_CORE_APP_META(sc_config).sched_pkts[i*SC_PKT_SIZE_MAX_NB_BUCKETS+b];
+                *hdr = PER_CORE_APP_META(sc_config).test_pkts[i*nb_size_buckets];
+                result = sc_util_resize_pkt_hdr_v4_udp(hdr, phase->pkt_size_dist.sizes[b]);
+                if(unlikely(result != SC_SUCCESS)){
+                    SC_THREAD_ERROR("failed to resize pkt header for phase %u", phase_id);
+                    goto _load_schedule_apply_phase_exit;
+                }
+            }
+        }
+        PER_CORE_APP_META(sc_config).send_pkts = PER_CORE_APP_META(sc_config).sched_pkts;
+        PER_CORE_APP_META(sc_config).send_pkts_stride = SC_PKT_SIZE_MAX_NB_BUCKETS;
+        PER_CORE_APP_META(sc_config).send_pkt_size_dist = &phase->pkt_size_dist;
+    } else {
+        PER_CORE_APP_META(sc_config).send_pkts = PER_CORE_APP_META(sc_config).test_pkts;
+        PER_CORE_APP_META(sc_config).send_pkts_stride = nb_size_buckets;
+        PER_CORE_APP_META(sc_config).send_pkt_size_dist 
+            = INTERNAL_CONF(sc_config)->enable_pkt_size_dist ? &INTERNAL_CONF(sc_config)->pkt_size_dist : NULL;
+    }
+
+    PER_CORE_APP_META(sc_config).sched_phase = phase_id;
+
+_load_schedule_apply_phase_exit:
+    return result;
+}
+
+/*!
+ * \brief   apply the trial of rfc2544 throughput search to the pacer and packet length of current send core
+ * \note    executed by the send core itself once the control plane publishes a new trial,
+ *          the trial is re-read in the next loop if it changes while being applied
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully applying
+ */
+static int _rfc2544_apply_trial(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint64_t i, nb_pkt_hdrs;
+    uint32_t trial, pkt_len;
+    double pkt_rate;
+
+    trial = INTERNAL_CONF(sc_config)->rfc2544_trial;
+    rte_smp_rmb();
+    pkt_len = INTERNAL_CONF(sc_config)->rfc2544_trial_pkt_len;
+    pkt_rate = INTERNAL_CONF(sc_config)->rfc2544_trial_rate;
+    rte_smp_rmb();
+    if(unlikely(trial != INTERNAL_CONF(sc_config)->rfc2544_trial)){ goto _rfc2544_apply_trial_exit; }
+
+    /* headers are derived from the header of each flow */
+    if(pkt_len != PER_CORE_APP_META(sc_config).rfc2544_pkt_len){
+        nb_pkt_hdrs = INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE 
+                        ? 1 : INTERNAL_CONF(sc_config)->nb_flow_per_core;
+        for(i=0; i<nb_pkt_hdrs; i++){
+            PER_CORE_APP_META(sc_config).rfc2544_pkts[i] = PER_CORE_APP_META(sc_config).test_pkts[i];
+            result = sc_util_resize_pkt_hdr_v4_udp(&PER_CORE_APP_META(sc_config).rfc2544_pkts[i], pkt_len);
+            if(unlikely(result != SC_SUCCESS)){
+                SC_THREAD_ERROR("failed to resize pkt header to %u bytes for trial %u", pkt_len, trial);
+                goto _rfc2544_apply_trial_exit;
+            }
+        }
+        PER_CORE_APP_META(sc_config).rfc2544_pkt_len = pkt_len;
+        PER_CORE_APP_META(sc_config).send_pkts = PER_CORE_APP_META(sc_config).rfc2544_pkts;
+        PER_CORE_APP_META(sc_config).send_pkts_stride = 1;
+        PER_CORE_APP_META(sc_config).send_pkt_size_dist = NULL;
+    }
+
+    /* offered load is shared by all send cores */
+    PER_CORE_APP_META(sc_config).per_core_pkt_rate = pkt_rate / (double)INTERNAL_CONF(sc_config)->nb_send_cores;
+    sc_util_pacer_set_rate(&PER_CORE_APP_META(sc_config).pacer, PER_CORE_APP_META(sc_config).per_core_pkt_rate);
+
+    PER_CORE_APP_META(sc_config).rfc2544_trial = trial;
+
+_rfc2544_apply_trial_exit:
+    return result;
+}
+
+/*!
+ * \brief   apply the offered rate published by the slo controller to the pacer of current send core
+ * \param   sc_config   the global configuration
+ */
+static void _slo_apply_rate(struct sc_config *sc_config){
+    uint32_t version;
+    double pkt_rate;
+
+    version = INTERNAL_CONF(sc_config)->slo_rate_version;
+    rte_smp_rmb();
+    pkt_rate = INTERNAL_CONF(sc_config)->slo_rate;
+
+    /* offered load is shared by all send cores */
+    PER_CORE_APP_META(sc_config).per_core_pkt_rate = pkt_rate / (double)INTERNAL_CONF(sc_config)->nb_send_cores;
+    sc_util_pacer_set_rate(&PER_CORE_APP_META(sc_config).pacer, PER_CORE_APP_META(sc_config).per_core_pkt_rate);
+
+    PER_CORE_APP_META(sc_config).slo_rate_version = version;
+}
+
+/*!
+ * \brief   callback while entering application
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_enter_sender(struct sc_config *sc_config){
+    int i, result = SC_SUCCESS;
+    uint16_t queue_id = 0;
+    uint64_t nb_pkt_hdrs, nb_size_buckets = 1, b;
+    struct sc_pkt_hdr *pkt_hdrs;
+    
+    PER_CORE_APP_META(sc_config).nb_send_pkt = 0;
+    PER_CORE_APP_META(sc_config).nb_confirmed_pkt = 0;
+
+    /* initialize interval generator */
+    double per_core_pkt_rate;
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544
+        || INTERNAL_CONF(sc_config)->enable_slo){
+        per_core_pkt_rate = (double)0.001f;     /* Gpps, overwritten by the first phase, trial or slo controller */
+    } else if(INTERNAL_CONF(sc_config)->pkt_rate != 0) {
+        per_core_pkt_rate = (double)INTERNAL_CONF(sc_config)->pkt_rate 
+                            / (double)1000 / (double)(INTERNAL_CONF(sc_config)->nb_send_cores);      /* Gpps */
+    } else {
+        per_core_pkt_rate = (double)INTERNAL_CONF(sc_config)->bit_rate 
+                            / (double)(INTERNAL_CONF(sc_config)->nb_send_cores)
+                            / (double) 8.0 / INTERNAL_CONF(sc_config)->mean_pkt_len; /* Gpps */
+    }
+
+    /* initialize tsc-based pacer */
+    PER_CORE_APP_META(sc_config).per_core_pkt_rate = per_core_pkt_rate * (double)1000; /* Mpps */
+    result = sc_util_pacer_init(
+        /* pacer */ &PER_CORE_APP_META(sc_config).pacer,
+        /* arrival */ INTERNAL_CONF(sc_config)->pacing_arrival,
+        /* pkt_rate_mpps */ PER_CORE_APP_META(sc_config).per_core_pkt_rate,
+        /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst,
+        /* bucket_depth */ INTERNAL_CONF(sc_config)->pacing_bucket_depth,
+        /* on_us */ INTERNAL_CONF(sc_config)->pacing_on_us,
+        /* off_us */ INTERNAL_CONF(sc_config)->pacing_off_us
+    );
+    if(result != SC_SUCCESS){
+        SC_THREAD_ERROR("failed to initialize pacer");
+        goto _process_enter_exit;
+    }
+    
+    // SC_THREAD_LOG("per core pkt rate: %lf G packet/second", per_core_pkt_rate);
+
+    /* 
+     * allocate memory for storing generated packet headers,
+     * only a single header is used as template while flow population is enabled,
+     * each flow owns one header per size bucket while packet size distribution is enabled
+     */
+    nb_pkt_hdrs = INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE 
+                    ? 1 : INTERNAL_CONF(sc_config)->nb_flow_per_core;
+    if(INTERNAL_CONF(sc_config)->enable_pkt_size_dist){
+        nb_size_buckets = INTERNAL_CONF(sc_config)->pkt_size_dist.nb_buckets;
+    }
+    pkt_hdrs = (struct sc_pkt_hdr*)rte_malloc(NULL, sizeof(struct sc_pkt_hdr)*nb_pkt_hdrs*nb_size_buckets, 0);
+    if(unlikely(!pkt_hdrs)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for pkt_hdrs");
+        result = SC_ERROR_MEMORY;
+        goto _process_enter_exit;
+    }
+    memset(pkt_hdrs, 0, sizeof(struct sc_pkt_hdr)*nb_pkt_hdrs*nb_size_buckets);
+    PER_CORE_APP_META(sc_config).test_pkts = pkt_hdrs;
+    PER_CORE_APP_META(sc_config).last_used_flow = 0;
+
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        if(sc_config->core_ids[i] == rte_lcore_id()){
+            queue_id = i;
+            /*! 
+                \note:  we allow nb_rings_per_port is less than nb_used_port 
+                        so we have to limit the queue_id within the valid range
+             */
+            if(queue_id != 0){
+                queue_id = queue_id % sc_config->nb_rx_rings_per_port;
+            }
+            
+            SC_THREAD_LOG("core %u is using queue %u", rte_lcore_id(), queue_id);
+            break;
+        }
+        if(i == sc_config->nb_used_cores-1){
+            SC_THREAD_ERROR_DETAILS("unknown queue id for worker thread on lcore %u", rte_lcore_id());
+            result = SC_ERROR_INTERNAL;
+            goto _process_enter_exit;
+        }
+    }
+
+    /* generate random packet header for each flow */
+    for(i=0; i<nb_pkt_hdrs; i++){
+        result = sc_util_generate_random_pkt_hdr(
+            /* sc_pkt_hdr */ &PER_CORE_APP_META(sc_config).test_pkts[i*nb_size_buckets],
+            /* pkt_len */ INTERNAL_CONF(sc_config)->pkt_len,
+            /* payload_len */ 0,
+            /* nb_queues */ sc_config->nb_rx_rings_per_port,
+            /* used_queue_id */ queue_id,
+            /* l3_type */ RTE_ETHER_TYPE_IPV4,
+            /* l4_type */ IPPROTO_UDP,
+            /* rss_hash_field */ sc_config->rss_hash_field,
+            /* rss_affinity */ INTERNAL_CONF(sc_config)->rss_affinity,
+            /* min_pkt_len */ 
+                sizeof(struct sc_timestamp_table) + sizeof(struct rte_ether_hdr) 
+                + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr),
+            /* payload */ nullptr
+        );
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to generate new pkt header");
+            goto _process_enter_exit;
+        }
+
+        /* derive the header of each size bucket from the header of the flow */
+        for(b=nb_size_buckets; b>0; b--){
+            PER_CORE_APP_META(sc_config).test_pkts[i*nb_size_buckets+b-1]
+                = PER_CORE_APP_META(sc_config).test_pkts[i*nb_size_buckets];
+            if(!INTERNAL_CONF(sc_config)->enable_pkt_size_dist){ continue; }
+            result = sc_util_resize_pkt_hdr_v4_udp(
+                /* hdr */ &PER_CORE_APP_META(sc_config).test_pkts[i*nb_size_buckets+b-1],
+                /* pkt_len */ INTERNAL_CONF(sc_config)->pkt_size_dist.sizes[b-1]
+            );
+            if(result != SC_SUCCESS){
+                SC_THREAD_ERROR("failed to resize pkt header");
+                goto _process_enter_exit;
+            }
+        }
+    }
+    /* build the header template of the configured protocol stack */
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack){
+        PER_CORE_APP_META(sc_config).proto_stack = INTERNAL_CONF(sc_config)->proto_stack;
+        result = sc_util_build_proto_stack_template(
+            /* stack */ &PER_CORE_APP_META(sc_config).proto_stack,
+            /* pkt_len */ INTERNAL_CONF(sc_config)->pkt_len,
+            /* src_mac */ NULL,
+            /* dst_mac */ NULL
+        );
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to build header template of protocol stack");
+            goto _process_enter_exit;
+        }
+    }
+
+    /* generate flow population with configured popularity */
+    if(INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+        result = sc_util_flow_pop_create(
+            /* pop */ &PER_CORE_APP_META(sc_config).flow_pop,
+            /* nb_flows */ INTERNAL_CONF(sc_config)->nb_flow_per_core,
+            /* conf */ &INTERNAL_CONF(sc_config)->flow_pop_conf,
+            /* rss_hash_field */ sc_config->rss_hash_field,
+            /* rss_affinity */ INTERNAL_CONF(sc_config)->rss_affinity,
+            /* nb_queues */ sc_config->nb_rx_rings_per_port,
+            /* used_queue_id */ queue_id
+        );
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to generate flow population");
+            goto _process_enter_exit;
+        }
+        SC_THREAD_LOG("generate population of %lu flow(s)", INTERNAL_CONF(sc_config)->nb_flow_per_core);
+
+        /* random values for sampling flows of a burst are filled in bulk */
+        PER_CORE_APP_META(sc_config).rand_buf = (uint64_t*)rte_malloc(NULL,
+            sizeof(uint64_t)*INTERNAL_CONF(sc_config)->nb_pkt_per_burst, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).rand_buf)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for rand_buf");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+    }
+
+    /* state of field modifiers, cursors of send cores start from disjoint positions */
+    if(INTERNAL_CONF(sc_config)->enable_field_mod){
+        result = sc_util_field_mod_state_init(
+            /* state */ &PER_CORE_APP_META(sc_config).field_mod,
+            /* prog */ &INTERNAL_CONF(sc_config)->field_mod_prog,
+            /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst,
+            /* stream_id */ PER_CORE_APP_META(sc_config).send_rank,
+            /* nb_streams */ INTERNAL_CONF(sc_config)->nb_send_cores
+        );
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to initialize state of field modifiers");
+            goto _process_enter_exit;
+        }
+    }
+
+    /* headers of kv requests with and without value of each flow, and the generator */
+    if(INTERNAL_CONF(sc_config)->enable_kv){
+        PER_CORE_APP_META(sc_config).kv_pkts = (struct sc_pkt_hdr*)rte_malloc(NULL,
+            sizeof(struct sc_pkt_hdr)*nb_pkt_hdrs*2, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).kv_pkts)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for headers of kv requests");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+        for(i=0; i<nb_pkt_hdrs*2; i++){
+            PER_CORE_APP_META(sc_config).kv_pkts[i] = PER_CORE_APP_META(sc_config).test_pkts[i/2];
+            result = sc_util_resize_pkt_hdr_v4_udp(
+                /* hdr */ &PER_CORE_APP_META(sc_config).kv_pkts[i],
+                /* pkt_len */ sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) 
+                    + sizeof(struct rte_udp_hdr) + sizeof(struct sc_timestamp_table)
+                    + sc_util_kv_req_len(&INTERNAL_CONF(sc_config)->kv_workload, i % 2 == 1)
+            );
+            if(result != SC_SUCCESS){
+                SC_THREAD_ERROR("failed to resize header of kv request");
+                goto _process_enter_exit;
+            }
+        }
+        sc_util_kv_gen_init(
+            /* gen */ &PER_CORE_APP_META(sc_config).kv_gen,
+            /* workload */ &INTERNAL_CONF(sc_config)->kv_workload,
+            /* stream_id */ PER_CORE_APP_META(sc_config).send_rank,
+            /* nb_streams */ INTERNAL_CONF(sc_config)->nb_send_cores
+        );
+        PER_CORE_APP_META(sc_config).kv_next_req_id = 0;
+    }
+
+    /* sequence numbers of each flow, starting from zero */
+    if(INTERNAL_CONF(sc_config)->enable_seq){
+        PER_CORE_APP_META(sc_config).seq_next = (uint64_t*)rte_zmalloc(NULL,
+            sizeof(uint64_t)*INTERNAL_CONF(sc_config)->nb_flow_per_core, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).seq_next)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for sequence numbers of flows");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+        PER_CORE_APP_META(sc_config).seq_nb_withdrawn = 0;
+    }
+
+    // SC_THREAD_LOG(
+    //     "generate %lu flow(s)' header, l3_type: %x, l4_type: %d",
+    //     INTERNAL_CONF(sc_config)->nb_flow_per_core,
+    //     PER_CORE_APP_META(sc_config).test_pkts[0].l3_type,
+    //     PER_CORE_APP_META(sc_config).test_pkts[0].l4_type
+    // )
+
+    /* allocate array for pointers to storing send pkt_bufs */
+    PER_CORE_APP_META(sc_config).send_pkt_bufs = (struct rte_mbuf **)rte_malloc(NULL, 
+        sizeof(struct rte_mbuf*)*INTERNAL_CONF(sc_config)->nb_pkt_per_burst, 0);
+    if(unlikely(!PER_CORE_APP_META(sc_config).send_pkt_bufs)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for send_pkt_bufs");
+        result = SC_ERROR_MEMORY;
+        goto _process_enter_exit;
+    }
+
+    /* send all flows with the configured packet mix by default */
+    PER_CORE_APP_META(sc_config).send_pkts = PER_CORE_APP_META(sc_config).test_pkts;
+    PER_CORE_APP_META(sc_config).send_pkts_stride = nb_size_buckets;
+    PER_CORE_APP_META(sc_config).send_pkt_size_dist 
+        = INTERNAL_CONF(sc_config)->enable_pkt_size_dist ? &INTERNAL_CONF(sc_config)->pkt_size_dist : NULL;
+    PER_CORE_APP_META(sc_config).nb_send_flows = INTERNAL_CONF(sc_config)->nb_flow_per_core;
+
+    /* prepare per-phase headers and statistics, then apply the first phase of load schedule */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule){
+        PER_CORE_APP_META(sc_config).sched_stats = (struct _sched_phase_stat*)rte_zmalloc(NULL,
+            sizeof(struct _sched_phase_stat)*INTERNAL_CONF(sc_config)->load_schedule.nb_phases, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).sched_stats)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for statistics of load schedule");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+
+        for(i=0; i<INTERNAL_CONF(sc_config)->load_schedule.nb_phases; i++){
+            if(!INTERNAL_CONF(sc_config)->load_schedule.phases[i].enable_pkt_size_dist){ continue; }
+            PER_CORE_APP_META(sc_config).sched_pkts = (struct sc_pkt_hdr*)rte_malloc(NULL,
+                sizeof(struct sc_pkt_hdr)*nb_pkt_hdrs*SC_PKT_SIZE_MAX_NB_BUCKETS, 0);
+            if(unlikely(!PER_CORE_APP_META(sc_config).sched_pkts)){
+                SC_THREAD_ERROR_DETAILS("failed to allocate memory for headers of per-phase packet mix");
+                result = SC_ERROR_MEMORY;
+                goto _process_enter_exit;
+            }
+            break;
+        }
+
+        result = _load_schedule_apply_phase(sc_config, 0);
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to apply the first phase of load schedule");
+            goto _process_enter_exit;
+        }
+    }
+
+    /* prepare headers of searched packet sizes, senders stay paused until the first trial */
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544){
+        PER_CORE_APP_META(sc_config).rfc2544_pkts = (struct sc_pkt_hdr*)rte_malloc(NULL,
+            sizeof(struct sc_pkt_hdr)*nb_pkt_hdrs, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).rfc2544_pkts)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for headers of rfc2544 throughput search");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+
+        result = _rfc2544_apply_trial(sc_config);
+        if(result != SC_SUCCESS){
+            SC_THREAD_ERROR("failed to apply the initial trial of rfc2544 throughput search");
+            goto _process_enter_exit;
+        }
+    }
+
+    /* senders stay paused until the slo controller publishes the initial rate */
+    if(INTERNAL_CONF(sc_config)->enable_slo){
+        _slo_apply_rate(sc_config);
+    }
+
+    /* initialize window state of each flow under closed-loop mode */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        PER_CORE_APP_META(sc_config).cl_flows = (struct _closed_loop_flow*)rte_malloc(NULL,
+            sizeof(struct _closed_loop_flow)*INTERNAL_CONF(sc_config)->nb_flow_per_core, 0);
+        PER_CORE_APP_META(sc_config).cl_completions = (void**)rte_malloc(NULL,
+            sizeof(void*)*SC_MAX_RX_PKT_BURST*2, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).cl_flows || !PER_CORE_APP_META(sc_config).cl_completions)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for closed-loop state");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_exit;
+        }
+        memset(PER_CORE_APP_META(sc_config).cl_flows, 0,
+            sizeof(struct _closed_loop_flow)*INTERNAL_CONF(sc_config)->nb_flow_per_core);
+        PER_CORE_APP_META(sc_config).cl_flow_cursor = 0;
+        PER_CORE_APP_META(sc_config).cl_level = 0;
+        PER_CORE_APP_META(sc_config).cl_stats[0].start_tsc = rte_rdtsc();
+    }
+
+    /* attach the pcap trace replayed by this core */
+    if(INTERNAL_CONF(sc_config)->pcap_file){
+        PER_CORE_APP_META(sc_config).pcap_trace = &INTERNAL_CONF(sc_config)->pcap_traces[PER_CORE_APP_META(sc_config).send_rank];
+        PER_CORE_APP_META(sc_config).pcap_cursor = 0;
+        PER_CORE_APP_META(sc_config).pcap_loop_start_timestamp = sc_util_timestamp_ns();
+    }
+
+    /* initialize the start_time */
+    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).start_time, NULL))){
+        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
+        result =  SC_ERROR_INTERNAL;
+        goto _process_enter_exit;
+    }
+
+_process_enter_exit:
+    return result;
+}
+
+/*!
+ * \brief   generate a burst of kv requests, each request is registered as in-flight
+ *          before it's sent so that its response could be matched by receive cores
+ * \param   sc_config   the global configuration
+ * \param   mp          memory pool of the send port
+ * \param   send_tsc    tsc of sending the burst
+ * \return  zero for successfully generation
+ */
+static int _kv_generate_burst(struct sc_config *sc_config, struct rte_mempool *mp, uint64_t send_tsc){
+    uint32_t j;
+    uint64_t req_id;
+    struct sc_kv_req req;
+    struct sc_pkt_hdr *hdr;
+    struct sc_timestamp_table *sc_ts;
+    struct _kv_inflight *slot;
+    struct _kv_inflight *inflight
+        = INTERNAL_CONF(sc_config)->kv_inflight[PER_CORE_APP_META(sc_config).send_rank];
+
+    for(j=0; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++){
+        sc_util_kv_gen_next(&PER_CORE_APP_META(sc_config).kv_gen, &req);
+        hdr = &PER_CORE_APP_META(sc_config).kv_pkts[
+            PER_CORE_APP_META(sc_config).last_used_flow*2 + (sc_util_kv_op_has_value(req.op) ? 1 : 0)];
+        if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_fast_v4_udp(
+                /* mp */ mp,
+                /* hdr */ hdr,
+                /* pkts_burst */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[j],
+                /* nb_pkt_per_burst */ 1
+        )){
+            for(; j>0; j--){ rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j-1]); }
+            return SC_ERROR_INTERNAL;
+        }
+
+        /* stamp the request, the request header follows the timestamp table */
+        sc_ts = rte_pktmbuf_mtod_offset(PER_CORE_APP_META(sc_config).send_pkt_bufs[j],
+            struct sc_timestamp_table*, hdr->payload_offset);
+        sc_ts->nb_timestamp = 0;
+        sc_ts->timestamp_type = SC_TIMESTAMP_FULL_TYPE;
+        req_id = ++PER_CORE_APP_META(sc_config).kv_next_req_id;
+        sc_util_kv_encode_req((uint8_t*)(sc_ts + 1), &req, INTERNAL_CONF(sc_config)->kv_conf.key_len,
+            PER_CORE_APP_META(sc_config).send_rank, req_id);
+
+        /* the slot of an unanswered request is taken over, whose response becomes unmatched */
+        slot = &inflight[req_id & (SC_ECHO_CLIENT_KV_NB_INFLIGHT-1)];
+        slot->send_tsc = send_tsc;
+        slot->op = req.op;
+        rte_smp_wmb();
+        slot->req_id = req_id;
+        PER_CORE_APP_META(sc_config).kv_stats[req.op].nb_requests += 1;
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   withdraw the kv request which failed to be sent
+ * \param   sc_config   the global configuration
+ * \param   pkt         the unsent request
+ */
+static inline void _kv_withdraw_request(struct sc_config *sc_config, struct rte_mbuf *pkt){
+    /* requests of the burst belong to the same flow, whose templates share the same headers */
+    struct sc_pkt_hdr *hdr = &PER_CORE_APP_META(sc_config).kv_pkts[PER_CORE_APP_META(sc_config).last_used_flow*2];
+    struct sc_kv_req_hdr *req_hdr = rte_pktmbuf_mtod_offset(pkt, struct sc_kv_req_hdr*,
+        hdr->payload_offset + sizeof(struct sc_timestamp_table));
+    uint64_t req_id = rte_be_to_cpu_64(req_hdr->req_id);
+    struct _kv_inflight *slot = &INTERNAL_CONF(sc_config)->kv_inflight[PER_CORE_APP_META(sc_config).send_rank][
+        req_id & (SC_ECHO_CLIENT_KV_NB_INFLIGHT-1)];
+
+    if(slot->req_id == req_id){ slot->req_id = 0; }
+    PER_CORE_APP_META(sc_config).kv_stats[req_hdr->op].nb_requests -= 1;
+}
+
+/*!
+ * \brief   obtain the offset of the payload (i.e., the timestamp table) of packets
+ *          generated by the send path from the header template
+ * \param   sc_config   the global configuration
+ * \param   hdr         the header template currently used
+ * \return  offset of the payload
+ */
+static inline uint64_t _send_payload_offset(struct sc_config *sc_config, struct sc_pkt_hdr *hdr){
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack){
+        return PER_CORE_APP_META(sc_config).proto_stack.hdr_len;
+    }
+    /* both kv templates of the flow share the same headers */
+    if(INTERNAL_CONF(sc_config)->enable_kv){
+        return PER_CORE_APP_META(sc_config).kv_pkts[PER_CORE_APP_META(sc_config).last_used_flow*2].payload_offset;
+    }
+    return hdr->payload_offset;
+}
+
+/*!
+ * \brief   tag each packet of the burst with the next sequence number of its flow
+ * \param   sc_config       the global configuration
+ * \param   payload_offset  offset of the timestamp table, which the tag follows
+ */
+static inline void _seq_tag_burst(struct sc_config *sc_config, uint64_t payload_offset){
+    uint32_t j;
+    uint64_t flow_id = PER_CORE_APP_META(sc_config).last_used_flow;
+    struct sc_timestamp_table *sc_ts;
+    struct _seq_tag *seq_tag;
+
+    for(j=0; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++){
+        /* resampled from the same random value, i.e., the flow whose addresses are applied */
+        if(INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+            flow_id = sc_util_flow_pop_sample_by(
+                &PER_CORE_APP_META(sc_config).flow_pop, PER_CORE_APP_META(sc_config).rand_buf[j]);
+        }
+
+        /* the tag follows the timestamp table, which is overwritten later under latency build */
+        sc_ts = rte_pktmbuf_mtod_offset(PER_CORE_APP_META(sc_config).send_pkt_bufs[j],
+            struct sc_timestamp_table*, payload_offset);
+        sc_ts->nb_timestamp = 0;
+        sc_ts->timestamp_type = SC_TIMESTAMP_FULL_TYPE;
+        seq_tag = (struct _seq_tag*)(sc_ts + 1);
+        seq_tag->seq = PER_CORE_APP_META(sc_config).seq_next[flow_id]++;
+        seq_tag->magic = SC_ECHO_CLIENT_SEQ_TAG_MAGIC;
+        seq_tag->flow_id = (uint32_t)flow_id;
+        seq_tag->sender_id = (uint16_t)PER_CORE_APP_META(sc_config).send_rank;
+        seq_tag->reserved = 0;
+    }
+}
+
+/*!
+ * \brief   withdraw the sequence number of the packet which failed to be sent, unsent
+ *          packets are the tail of the burst so that they hold the latest numbers of their flows
+ * \param   sc_config       the global configuration
+ * \param   pkt             the unsent packet
+ * \param   payload_offset  offset of the timestamp table, which the tag follows
+ */
+static inline void _seq_withdraw(struct sc_config *sc_config, struct rte_mbuf *pkt, uint64_t payload_offset){
+    struct _seq_tag *seq_tag = rte_pktmbuf_mtod_offset(pkt, struct _seq_tag*,
+        payload_offset + sizeof(struct sc_timestamp_table));
+
+    PER_CORE_APP_META(sc_config).seq_next[seq_tag->flow_id] -= 1;
+    PER_CORE_APP_META(sc_config).seq_nb_withdrawn += 1;
+}
+
+/*!
+ * \brief   calculate the udp checksum of the generated ipv4/udp packet in software,
+ *          the payload of jumbo frames spans multiple segments
+ * \param   pkt the packet to be sent
+ */
+static inline void _fill_sw_cksum_v4_udp(struct rte_mbuf *pkt){
+    struct rte_ipv4_hdr *ipv4_hdr
+        = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+    struct rte_udp_hdr *udp_hdr = (struct rte_udp_hdr*)(ipv4_hdr + 1);
+    uint16_t cksum;
+
+    udp_hdr->dgram_cksum = 0;
+    if(likely(sc_util_cksum_ipv4_udptcp_mbuf(pkt, ipv4_hdr,
+            sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr), &cksum) == SC_SUCCESS)){
+        udp_hdr->dgram_cksum = cksum;
+    }
+}
+
+/*!
+ * \brief   callback for client logic
+ * \param   sc_config       the global configuration
+ * \param   queue_id        the index of the queue for current core to tx/rx packet
+ * \param   ready_to_exit   indicator for exiting worker loop
+ * \return  zero for successfully executing
+ */
+int _process_client_sender(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
+    int i, j, nb_tx = 0, nb_send_pkt = 0, result = SC_SUCCESS, retry;
+
+    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+        uint64_t current_tsc = 0;
+        struct sc_timestamp_table sc_ts = {0};
+    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+    /* apply the phase published by the control plane */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule
+        && unlikely(PER_CORE_APP_META(sc_config).sched_phase != INTERNAL_CONF(sc_config)->sched_phase)
+        && INTERNAL_CONF(sc_config)->sched_phase < INTERNAL_CONF(sc_config)->load_schedule.nb_phases){
+        rte_smp_rmb();
+        if(SC_SUCCESS != _load_schedule_apply_phase(sc_config, INTERNAL_CONF(sc_config)->sched_phase)){
+            result = SC_ERROR_INTERNAL;
+            goto process_client_ready_to_exit;
+        }
+    }
+
+    /* apply the trial published by the control plane */
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544
+        && unlikely(PER_CORE_APP_META(sc_config).rfc2544_trial != INTERNAL_CONF(sc_config)->rfc2544_trial)){
+        if(SC_SUCCESS != _rfc2544_apply_trial(sc_config)){
+            result = SC_ERROR_INTERNAL;
+            goto process_client_ready_to_exit;
+        }
+    }
+
+    /* apply the rate published by the slo controller */
+    if(INTERNAL_CONF(sc_config)->enable_slo
+        && unlikely(PER_CORE_APP_META(sc_config).slo_rate_version != INTERNAL_CONF(sc_config)->slo_rate_version)){
+        _slo_apply_rate(sc_config);
+    }
+
+    /* send packet */
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_ports; i++){
+        /* avoid endless loop */
+        if(sc_force_quit){ break; }
+
+        /* check send interval */
+        if(!sc_util_pacer_try_release(&PER_CORE_APP_META(sc_config).pacer, rte_rdtsc())){
+            continue;
+        }
+
+        /* obtain the packet header currently used, and setup payload info*/
+        struct sc_pkt_hdr *current_used_pkt = &(PER_CORE_APP_META(sc_config).send_pkts[
+            PER_CORE_APP_META(sc_config).last_used_flow * PER_CORE_APP_META(sc_config).send_pkts_stride]);
+        #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+            uint64_t payload_offset = current_used_pkt->payload_offset;
+        #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+        
+        /* generate new burst of packets */
+        if(INTERNAL_CONF(sc_config)->enable_proto_stack){
+            if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_stack(
+                    /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                    /* stack */ &PER_CORE_APP_META(sc_config).proto_stack,
+                    /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+                    /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst,
+                    /* vary_fields */ true
+            )){
+                SC_THREAD_ERROR("failed to assemble final packet of protocol stack");
+                result = SC_ERROR_INTERNAL;
+                goto process_client_ready_to_exit;
+            }
+            #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+                payload_offset = PER_CORE_APP_META(sc_config).proto_stack.hdr_len;
+            #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+        } else if(INTERNAL_CONF(sc_config)->enable_kv){
+            if(SC_SUCCESS != _kv_generate_burst(
+                    /* sc_config */ sc_config,
+                    /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                    /* send_tsc */ rte_rdtsc()
+            )){
+                SC_THREAD_ERROR("failed to assemble kv requests");
+                result = SC_ERROR_INTERNAL;
+                goto process_client_ready_to_exit;
+            }
+        } else if(PER_CORE_APP_META(sc_config).send_pkt_size_dist){
+            if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_fast_v4_udp_mixed(
+                    /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                    /* hdrs */ current_used_pkt,
+                    /* dist */ PER_CORE_APP_META(sc_config).send_pkt_size_dist,
+                    /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+                    /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
+            )){
+                SC_THREAD_ERROR("failed to assemble final packet of mixed sizes");
+                result = SC_ERROR_INTERNAL;
+                goto process_client_ready_to_exit;
+            }
+        } else if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_fast_v4_udp(
+                /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                /* hdr */ current_used_pkt,
+                /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+                /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
+        )){
+            SC_THREAD_ERROR("failed to assemble final packet");
+            result = SC_ERROR_INTERNAL;
+            goto process_client_ready_to_exit;
+        }
+
+        /* pick flow of each packet based on the popularity */
+        if(INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+            sc_util_prng_fill(&perthread_prng, PER_CORE_APP_META(sc_config).rand_buf,
+                INTERNAL_CONF(sc_config)->nb_pkt_per_burst);
+            for(j=0; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++){
+                sc_util_flow_pop_apply_v4_udp(
+                    /* pop */ &PER_CORE_APP_META(sc_config).flow_pop,
+                    /* flow_id */ sc_util_flow_pop_sample_by(
+                        &PER_CORE_APP_META(sc_config).flow_pop, PER_CORE_APP_META(sc_config).rand_buf[j]),
+                    /* pkt */ PER_CORE_APP_META(sc_config).send_pkt_bufs[j]
+                );
+            }
+        }
+
+        /* vary header fields of the burst, checksums are updated incrementally */
+        if(INTERNAL_CONF(sc_config)->enable_field_mod){
+            sc_util_field_mod_apply_burst(&PER_CORE_APP_META(sc_config).field_mod,
+                PER_CORE_APP_META(sc_config).send_pkt_bufs, INTERNAL_CONF(sc_config)->nb_pkt_per_burst);
+        }
+
+        /* tag packets with per-flow sequence numbers */
+        if(INTERNAL_CONF(sc_config)->enable_seq){
+            _seq_tag_burst(sc_config, _send_payload_offset(sc_config, current_used_pkt));
+        }
+
+        #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+            current_tsc = sc_util_timestamp_tsc();
+
+            /* set the accuracy as short */
+            sc_ts.timestamp_type = SC_TIMESTAMP_FULL_TYPE;
+
+            /* 
+             * record the timestamp (tsc cycles, converted to ns while reporting)
+             */
+            sc_util_add_full_timestamp(&sc_ts, current_tsc);
+
+            /* copy timestamp to payload */
+            if(SC_SUCCESS != sc_util_copy_payload_to_packet_burst(
+                /* payload */ &sc_ts,
+                /* payload_len */ sizeof(sc_ts),
+                /* payload_offset */ &payload_offset,
+                /* pkts_burst */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+                /* nb_pkt_per_burst */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
+            )){
+                SC_THREAD_ERROR("failed to copy payload to final packets");
+                result = SC_ERROR_INTERNAL;
+                goto process_client_ready_to_exit;
+            }
+
+            /* we record the copy latency here to fix the latency statistic */
+            PER_CORE_APP_META(sc_config).payload_copy_latency +=
+                (double)sc_util_tsc_to_ns(sc_util_timestamp_tsc() - current_tsc);
+            PER_CORE_APP_META(sc_config).payload_copy_latency /= (double)2.0f;
+        #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+        /* place the trailer to be stamped by the server */
+        if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+            for(j=0; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++){
+                sc_util_stage_init_trailer(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]);
+            }
+        }
+
+        /* udp checksum covers the payload, so it's calculated after the timestamp is written */
+        if(INTERNAL_CONF(sc_config)->enable_sw_cksum){
+            for(j=0; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++){
+                _fill_sw_cksum_v4_udp(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]);
+            }
+        }
+
+        nb_send_pkt = rte_eth_tx_burst(
+            /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+            /* queue_id */ queue_id,
+            /* tx_pkts */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+            /* nb_pkts */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst
+        );
+        if(unlikely(nb_send_pkt < INTERNAL_CONF(sc_config)->nb_pkt_per_burst)){
+            retry = 0;
+            while (nb_send_pkt < INTERNAL_CONF(sc_config)->nb_pkt_per_burst 
+                    && retry++ < SC_ECHO_CLIENT_BURST_TX_RETRIES
+            ){
+                nb_send_pkt += rte_eth_tx_burst(
+                    /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+                    /* queue_id */ queue_id, 
+                    /* tx_pkts */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_send_pkt], 
+                    /* nb_pkts */ INTERNAL_CONF(sc_config)->nb_pkt_per_burst - nb_send_pkt
+                );
+            }
+        }
+
+        /* return back un-sent pkt_mbuf */
+        for(j=nb_send_pkt; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++) {
+            if(INTERNAL_CONF(sc_config)->enable_kv){
+                _kv_withdraw_request(sc_config, PER_CORE_APP_META(sc_config).send_pkt_bufs[j]);
+            }
+            if(INTERNAL_CONF(sc_config)->enable_seq){
+                _seq_withdraw(sc_config, PER_CORE_APP_META(sc_config).send_pkt_bufs[j],
+                    _send_payload_offset(sc_config, current_used_pkt));
+            }
+            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]); 
+        }
+
+        nb_tx += nb_send_pkt;
+
+        /* record statistics of current phase */
+        if(INTERNAL_CONF(sc_config)->enable_load_schedule){
+            PER_CORE_APP_META(sc_config).sched_stats[PER_CORE_APP_META(sc_config).sched_phase].nb_send_pkt += nb_send_pkt;
+            PER_CORE_APP_META(sc_config).sched_stats[PER_CORE_APP_META(sc_config).sched_phase].nb_drop_pkt 
+                += INTERNAL_CONF(sc_config)->nb_pkt_per_burst - nb_send_pkt;
+        }
+    }
+
+    /* update metadata */
+    if(nb_tx != 0){
+        // record the #sended packet
+        PER_CORE_APP_META(sc_config).nb_send_pkt += nb_tx;
+        PER_CORE_APP_META(sc_config).nb_interval_send_pkt += nb_tx;
+        PER_CORE_APP_META(sc_config).nb_interval_drop_pkt 
+            += INTERNAL_CONF(sc_config)->nb_pkt_per_burst * INTERNAL_CONF(sc_config)->nb_send_ports;
+        
+        // switch the sended flow (flows are sampled per packet while flow population is enabled)
+        if(INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+            PER_CORE_APP_META(sc_config).last_used_flow = 0;
+        } else if(PER_CORE_APP_META(sc_config).last_used_flow >= PER_CORE_APP_META(sc_config).nb_send_flows-1){
+            PER_CORE_APP_META(sc_config).last_used_flow = 0;
+        } else {
+            PER_CORE_APP_META(sc_config).last_used_flow += 1;
+        }
+    }
+    
+    goto process_client_exit;
+
+process_client_ready_to_exit:
+    *ready_to_exit = true;
+
+process_client_exit:
+    return result;
+}
+
+/*!
+ * \brief   callback for client logic (closed-loop mode)
+ * \note    each flow acts as a virtual client which keeps at most cl_windows[level]
+ *          outstanding requests, completions are passed back by receive cores
+ *          through the ring of this send core
+ * \param   sc_config       the global configuration
+ * \param   queue_id        the index of the queue for current core to tx/rx packet
+ * \param   ready_to_exit   indicator for exiting worker loop
+ * \return  zero for successfully executing
+ */
+int _process_client_sender_closed_loop(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
+    int i, j, nb_tx = 0, nb_send_pkt = 0, result = SC_SUCCESS, retry;
+    uint16_t level;
+    uint32_t nb_ready, nb_completions, window, nb_size_buckets = 1;
+    uint64_t k, flow_id, current_tsc, tsc_hz = sc_util_tsc_hz();
+    struct _closed_loop_flow *flow;
+    struct _closed_loop_stat *stat;
+    struct _closed_loop_tag *cl_tag;
+    struct sc_timestamp_table *sc_ts;
+    struct sc_pkt_hdr *hdr;
+
+    if(INTERNAL_CONF(sc_config)->enable_pkt_size_dist){
+        nb_size_buckets = INTERNAL_CONF(sc_config)->pkt_size_dist.nb_buckets;
+    }
+
+    /* move to the next concurrency level */
+    current_tsc = rte_rdtsc();
+    level = PER_CORE_APP_META(sc_config).cl_level;
+    if(level < INTERNAL_CONF(sc_config)->nb_cl_levels-1
+        && current_tsc - PER_CORE_APP_META(sc_config).cl_stats[level].start_tsc
+            >= INTERNAL_CONF(sc_config)->cl_level_duration_ms * tsc_hz / 1000){
+        PER_CORE_APP_META(sc_config).cl_stats[level].end_tsc = current_tsc;
+        level += 1;
+        PER_CORE_APP_META(sc_config).cl_level = level;
+        PER_CORE_APP_META(sc_config).cl_stats[level].start_tsc = current_tsc;
+    }
+    stat = &PER_CORE_APP_META(sc_config).cl_stats[level];
+    window = INTERNAL_CONF(sc_config)->cl_windows[level];
+
+    /* release window slots of responded requests */
+    nb_completions = rte_ring_sc_dequeue_burst(
+        /* r */ INTERNAL_CONF(sc_config)->cl_rings[PER_CORE_APP_META(sc_config).send_rank],
+        /* obj_table */ PER_CORE_APP_META(sc_config).cl_completions,
+        /* n */ SC_MAX_RX_PKT_BURST*2,
+        /* available */ NULL
+    );
+    for(j=0; j<nb_completions; j++){
+        flow = &PER_CORE_APP_META(sc_config).cl_flows[(uintptr_t)PER_CORE_APP_META(sc_config).cl_completions[j]];
+        if(likely(flow->nb_outstanding > 0)){ flow->nb_outstanding -= 1; }
+        flow->next_send_tsc = current_tsc + INTERNAL_CONF(sc_config)->cl_think_time_us * tsc_hz / 1000000;
+        flow->last_progress_tsc = current_tsc;
+    }
+
+    /* send packet */
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_ports; i++){
+        /* avoid endless loop */
+        if(sc_force_quit){ break; }
+
+        /* pick flows with free window slots */
+        nb_ready = 0;
+        for(k=0; k<INTERNAL_CONF(sc_config)->nb_flow_per_core && nb_ready<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; k++){
+            flow_id = PER_CORE_APP_META(sc_config).cl_flow_cursor;
+            PER_CORE_APP_META(sc_config).cl_flow_cursor
+                = flow_id+1 == INTERNAL_CONF(sc_config)->nb_flow_per_core ? 0 : flow_id+1;
+            flow = &PER_CORE_APP_META(sc_config).cl_flows[flow_id];
+
+            /* reclaim window slots of requests whose responses are lost */
+            if(unlikely(flow->nb_outstanding > 0 && INTERNAL_CONF(sc_config)->cl_timeout_us > 0
+                && current_tsc - flow->last_progress_tsc > INTERNAL_CONF(sc_config)->cl_timeout_us * tsc_hz / 1000000)){
+                stat->nb_timeouts += flow->nb_outstanding;
+                flow->nb_outstanding = 0;
+            }
+
+            /* the virtual client is thinking */
+            if(current_tsc < flow->next_send_tsc){ continue; }
+
+            while(flow->nb_outstanding < window && nb_ready < INTERNAL_CONF(sc_config)->nb_pkt_per_burst){
+                hdr = &PER_CORE_APP_META(sc_config).test_pkts[flow_id*nb_size_buckets 
+                    + (nb_size_buckets > 1 ? sc_util_pkt_size_sample_bucket(
+                        &INTERNAL_CONF(sc_config)->pkt_size_dist, sc_util_rand()) : 0)];
+                if(SC_SUCCESS != sc_util_generate_packet_burst_mbufs_fast_v4_udp(
+                        /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                        /* hdr */ hdr,
+                        /* pkts_burst */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_ready],
+                        /* nb_pkt_per_burst */ 1
+                )){
+                    SC_THREAD_ERROR("failed to assemble closed-loop request");
+                    for(j=0; j<nb_ready; j++){ rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]); }
+                    result = SC_ERROR_INTERNAL;
+                    goto process_client_closed_loop_ready_to_exit;
+                }
+
+                /* stamp the request */
+                sc_ts = rte_pktmbuf_mtod_offset(PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_ready],
+                    struct sc_timestamp_table*, hdr->payload_offset);
+                sc_ts->nb_timestamp = 0;
+                sc_ts->timestamp_type = SC_TIMESTAMP_FULL_TYPE;
+                #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+                    sc_util_add_full_timestamp(sc_ts, current_tsc);
+                #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+                cl_tag = (struct _closed_loop_tag*)(sc_ts + 1);
+                cl_tag->send_tsc = current_tsc;
+                cl_tag->magic = SC_ECHO_CLIENT_CL_TAG_MAGIC;
+                cl_tag->flow_id = (uint32_t)flow_id;
+                cl_tag->sender_id = (uint16_t)PER_CORE_APP_META(sc_config).send_rank;
+                cl_tag->level = level;
+                if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+                    sc_util_stage_init_trailer(PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_ready]);
+                }
+
+                if(flow->nb_outstanding == 0){ flow->last_progress_tsc = current_tsc; }
+                flow->nb_outstanding += 1;
+                nb_ready += 1;
+            }
+        }
+        if(nb_ready == 0){ continue; }
+
+        nb_send_pkt = rte_eth_tx_burst(
+            /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+            /* queue_id */ queue_id,
+            /* tx_pkts */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+            /* nb_pkts */ nb_ready
+        );
+        if(unlikely(nb_send_pkt < nb_ready)){
+            retry = 0;
+            while (nb_send_pkt < nb_ready && retry++ < SC_ECHO_CLIENT_BURST_TX_RETRIES){
+                nb_send_pkt += rte_eth_tx_burst(
+                    /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+                    /* queue_id */ queue_id, 
+                    /* tx_pkts */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_send_pkt], 
+                    /* nb_pkts */ nb_ready - nb_send_pkt
+                );
+            }
+        }
+
+        /* 
+         * return back un-sent pkt_mbuf, along with their window slots, templates of all flows
+         * share the same headers, so the tag is located by the template of the last request
+         */
+        for(j=nb_send_pkt; j<nb_ready; j++) {
+            cl_tag = rte_pktmbuf_mtod_offset(PER_CORE_APP_META(sc_config).send_pkt_bufs[j], struct _closed_loop_tag*,
+                hdr->payload_offset + sizeof(struct sc_timestamp_table));
+            PER_CORE_APP_META(sc_config).cl_flows[cl_tag->flow_id].nb_outstanding -= 1;
+            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]); 
+        }
+
+        stat->nb_requests += nb_send_pkt;
+        PER_CORE_APP_META(sc_config).nb_interval_drop_pkt += nb_ready - nb_send_pkt;
+        nb_tx += nb_send_pkt;
+    }
+
+    /* update metadata */
+    if(nb_tx != 0){
+        PER_CORE_APP_META(sc_config).nb_send_pkt += nb_tx;
+        PER_CORE_APP_META(sc_config).nb_interval_send_pkt += nb_tx;
+    }
+
+    goto process_client_closed_loop_exit;
+
+process_client_closed_loop_ready_to_exit:
+    *ready_to_exit = true;
+
+process_client_closed_loop_exit:
+    return result;
+}
+
+/*!
+ * \brief   callback for client logic (replay pcap trace)
+ * \param   sc_config       the global configuration
+ * \param   queue_id        the index of the queue for current core to tx/rx packet
+ * \param   ready_to_exit   indicator for exiting worker loop
+ * \return  zero for successfully executing
+ */
+int _process_client_sender_pcap(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
+    int i, j, nb_tx = 0, nb_send_pkt = 0, result = SC_SUCCESS, retry;
+    uint64_t current_ns, elapsed_ns, due_ns, loop_duration_ns, start_cursor, nb_due_pkts = 0;
+    struct sc_pcap_trace *trace = PER_CORE_APP_META(sc_config).pcap_trace;
+    struct rte_ether_addr *dst_mac;
+    rte_be32_t src_ipv4, dst_ipv4;
+    uint8_t replay_mode = INTERNAL_CONF(sc_config)->pcap_replay_mode;
+    double replay_speed = replay_mode == SC_PCAP_REPLAY_SCALED ? INTERNAL_CONF(sc_config)->pcap_replay_speed : 1.0;
+
+    /* no frame is assigned to this core */
+    if(unlikely(!trace || trace->nb_pkts == 0)){ goto process_client_pcap_exit; }
+
+    /* collect frames which reach their (scaled) replay time */
+    current_ns = sc_util_timestamp_ns();
+    elapsed_ns = current_ns - PER_CORE_APP_META(sc_config).pcap_loop_start_timestamp;
+    loop_duration_ns = (uint64_t)((double)INTERNAL_CONF(sc_config)->pcap_duration_ns / replay_speed);
+    start_cursor = PER_CORE_APP_META(sc_config).pcap_cursor;
+    while(nb_due_pkts < INTERNAL_CONF(sc_config)->nb_pkt_per_burst){
+        if(replay_mode != SC_PCAP_REPLAY_TOP_SPEED){
+            due_ns = (uint64_t)((double)trace->ts_ns[PER_CORE_APP_META(sc_config).pcap_cursor] / replay_speed);
+            if(due_ns > elapsed_ns) break;
+        }
+
+        nb_due_pkts += 1;
+        PER_CORE_APP_META(sc_config).pcap_cursor += 1;
+
+        /* restart from the beginning of the trace */
+        if(PER_CORE_APP_META(sc_config).pcap_cursor == trace->nb_pkts){
+            PER_CORE_APP_META(sc_config).pcap_cursor = 0;
+            PER_CORE_APP_META(sc_config).pcap_loop_start_timestamp += loop_duration_ns;
+            elapsed_ns -= RTE_MIN(elapsed_ns, loop_duration_ns);
+        }
+    }
+    if(nb_due_pkts == 0){ goto process_client_pcap_exit; }
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_ports; i++){
+        /* avoid endless loop */
+        if(sc_force_quit){ break; }
+
+        dst_mac = INTERNAL_CONF(sc_config)->nb_pcap_dst_macs == 0 ? NULL 
+            : &INTERNAL_CONF(sc_config)->pcap_dst_mac[RTE_MIN(i, INTERNAL_CONF(sc_config)->nb_pcap_dst_macs-1)];
+        src_ipv4 = INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s == 0 ? 0
+            : INTERNAL_CONF(sc_config)->pcap_src_ipv4[RTE_MIN(i, INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s-1)];
+        dst_ipv4 = INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s == 0 ? 0
+            : INTERNAL_CONF(sc_config)->pcap_dst_ipv4[RTE_MIN(i, INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s-1)];
+
+        /* copy preloaded frames into new mbufs, as the preloaded frames are reused in the next loop */
+        for(j=0; j<nb_due_pkts; j++){
+            PER_CORE_APP_META(sc_config).send_pkt_bufs[j] = rte_pktmbuf_copy(
+                /* m */ trace->pkts[(start_cursor + j) % trace->nb_pkts],
+                /* mp */ PER_CORE_TX_MBUF_POOL(sc_config, INTERNAL_CONF(sc_config)->send_port_logical_idx[i]),
+                /* offset */ 0,
+                /* length */ UINT32_MAX
+            );
+            if(unlikely(!PER_CORE_APP_META(sc_config).send_pkt_bufs[j])){
+                SC_THREAD_ERROR("failed to copy preloaded frame");
+                for(j--; j>=0; j--) rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]);
+                result = SC_ERROR_MEMORY;
+                goto process_client_pcap_ready_to_exit;
+            }
+            sc_util_pcap_rewrite_pkt(
+                /* pkt */ PER_CORE_APP_META(sc_config).send_pkt_bufs[j],
+                /* src_mac */ &INTERNAL_CONF(sc_config)->send_port_mac[i],
+                /* dst_mac */ dst_mac,
+                /* src_ipv4 */ src_ipv4,
+                /* dst_ipv4 */ dst_ipv4
+            );
+        }
+
+        nb_send_pkt = rte_eth_tx_burst(
+            /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+            /* queue_id */ queue_id,
+            /* tx_pkts */ PER_CORE_APP_META(sc_config).send_pkt_bufs,
+            /* nb_pkts */ nb_due_pkts
+        );
+        if(unlikely(nb_send_pkt < nb_due_pkts)){
+            retry = 0;
+            while (nb_send_pkt < nb_due_pkts && retry++ < SC_ECHO_CLIENT_BURST_TX_RETRIES){
+                nb_send_pkt += rte_eth_tx_burst(
+                    /* port_id */ INTERNAL_CONF(sc_config)->send_port_idx[i],
+                    /* queue_id */ queue_id, 
+                    /* tx_pkts */ &PER_CORE_APP_META(sc_config).send_pkt_bufs[nb_send_pkt], 
+                    /* nb_pkts */ nb_due_pkts - nb_send_pkt
+                );
+            }
+        }
+
+        /* return back un-sent pkt_mbuf */
+        for(j=nb_send_pkt; j<nb_due_pkts; j++) {
+            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]); 
+        }
+
+        nb_tx += nb_send_pkt;
+    }
+
+    /* update metadata */
+    PER_CORE_APP_META(sc_config).nb_send_pkt += nb_tx;
+    PER_CORE_APP_META(sc_config).nb_interval_send_pkt += nb_tx;
+    PER_CORE_APP_META(sc_config).nb_interval_drop_pkt += nb_due_pkts * INTERNAL_CONF(sc_config)->nb_send_ports - nb_tx;
+
+    goto process_client_pcap_exit;
+
+process_client_pcap_ready_to_exit:
+    *ready_to_exit = true;
+
+process_client_pcap_exit:
+    return result;
+}
+
+/*!
+ * \brief   callback while exiting application
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_exit_sender(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+
+    long total_interval_sec;
+    long total_interval_usec;
+
+    /* initialize the end_time */
+    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).end_time, NULL))){
+        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
+        return SC_ERROR_INTERNAL;
+    }
+
+    /* calculate the total duration */
+    total_interval_sec 
+        = PER_CORE_APP_META(sc_config).end_time.tv_sec - PER_CORE_APP_META(sc_config).start_time.tv_sec;
+    total_interval_usec 
+        = PER_CORE_APP_META(sc_config).end_time.tv_usec - PER_CORE_APP_META(sc_config).start_time.tv_usec;
+    SC_THREAD_LOG("[sender]: send %ld packets in total", PER_CORE_APP_META(sc_config).nb_send_pkt);
+
+    SC_THREAD_LOG("[sender]: copy to payload latency: %lf", PER_CORE_APP_META(sc_config).payload_copy_latency);
+
+    SC_THREAD_LOG("[sender]: send throughput: %f Gbps, %f Mpps",
+        (float)((double)PER_CORE_APP_META(sc_config).nb_send_pkt * INTERNAL_CONF(sc_config)->mean_pkt_len * 8) 
+        / (float)(SC_UTIL_TIME_INTERVL_US(total_interval_sec, total_interval_usec) * 1000),
+        (float)(PER_CORE_APP_META(sc_config).nb_send_pkt)
+        / (float)(SC_UTIL_TIME_INTERVL_US(total_interval_sec, total_interval_usec))
+    );
+
+    /* report achieved rate and pacing error (rates are reported per phase or trial if changed at runtime) */
+    if(!INTERNAL_CONF(sc_config)->pcap_file && !INTERNAL_CONF(sc_config)->enable_load_schedule
+        && !INTERNAL_CONF(sc_config)->enable_rfc2544 && !INTERNAL_CONF(sc_config)->enable_slo){
+        sc_util_pacer_report(&PER_CORE_APP_META(sc_config).pacer, PER_CORE_APP_META(sc_config).per_core_pkt_rate);
+    }
+
+    /* free flow population */
+    if(INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+        sc_util_flow_pop_free(&PER_CORE_APP_META(sc_config).flow_pop);
+        if(PER_CORE_APP_META(sc_config).rand_buf) rte_free(PER_CORE_APP_META(sc_config).rand_buf);
+    }
+
+    /* free state of field modifiers */
+    if(INTERNAL_CONF(sc_config)->enable_field_mod){
+        sc_util_field_mod_state_free(&PER_CORE_APP_META(sc_config).field_mod);
+    }
+
+    /* free headers of kv requests, statistics are freed after reporting */
+    if(PER_CORE_APP_META(sc_config).kv_pkts) rte_free(PER_CORE_APP_META(sc_config).kv_pkts);
+
+    /* free sequence numbers of flows */
+    if(PER_CORE_APP_META(sc_config).seq_next) rte_free(PER_CORE_APP_META(sc_config).seq_next);
+
+    /* free per-phase headers, statistics are freed after reporting */
+    if(PER_CORE_APP_META(sc_config).sched_pkts) rte_free(PER_CORE_APP_META(sc_config).sched_pkts);
+    if(PER_CORE_APP_META(sc_config).rfc2544_pkts) rte_free(PER_CORE_APP_META(sc_config).rfc2544_pkts);
+
+    /* close the current concurrency level, and free closed-loop state */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        PER_CORE_APP_META(sc_config).cl_stats[PER_CORE_APP_META(sc_config).cl_level].end_tsc = rte_rdtsc();
+        if(PER_CORE_APP_META(sc_config).cl_flows) rte_free(PER_CORE_APP_META(sc_config).cl_flows);
+        if(PER_CORE_APP_META(sc_config).cl_completions) rte_free(PER_CORE_APP_META(sc_config).cl_completions);
+    }
+
+_process_exit_exit:
+    return result;
+}
+
+/*!
+ * \brief   callback while entering application
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_enter_receiver(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint32_t i;
+
+    PER_CORE_APP_META(sc_config).nb_send_pkt = 0;
+    PER_CORE_APP_META(sc_config).nb_confirmed_pkt = 0;
+
+    /* allocate array for pointers to storing received pkt_bufs */
+    PER_CORE_APP_META(sc_config).recv_pkt_bufs = (struct rte_mbuf **)rte_malloc(NULL, 
+        sizeof(struct rte_mbuf*)*SC_MAX_RX_PKT_BURST*2, 0);
+    if(unlikely(!PER_CORE_APP_META(sc_config).recv_pkt_bufs)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for recv_pkt_bufs");
+        result = SC_ERROR_MEMORY;
+        goto _process_enter_receiver_exit;
+    }
+
+    /* allocate per-sender completion batches and latency histograms under closed-loop mode */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        PER_CORE_APP_META(sc_config).cl_batches = (void**)rte_malloc(NULL,
+            sizeof(void*)*SC_MAX_RX_PKT_BURST*INTERNAL_CONF(sc_config)->nb_send_cores, 0);
+        PER_CORE_APP_META(sc_config).cl_nb_batched = (uint32_t*)rte_zmalloc(NULL,
+            sizeof(uint32_t)*INTERNAL_CONF(sc_config)->nb_send_cores, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).cl_batches || !PER_CORE_APP_META(sc_config).cl_nb_batched)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for closed-loop completions");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_receiver_exit;
+        }
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_cl_levels; i++){
+            result = sc_util_hdr_hist_init(&PER_CORE_APP_META(sc_config).cl_stats[i].latency_hist,
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+            if(unlikely(result != SC_SUCCESS)){
+                SC_THREAD_ERROR_DETAILS("failed to allocate closed-loop latency histogram");
+                goto _process_enter_receiver_exit;
+            }
+        }
+    }
+
+    /* allocate latency histograms of both epoch parities for slo controller */
+    if(INTERNAL_CONF(sc_config)->enable_slo){
+        for(i=0; i<2; i++){
+            result = sc_util_hdr_hist_init(&PER_CORE_APP_META(sc_config).slo_hists[i],
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+            if(unlikely(result != SC_SUCCESS)){
+                SC_THREAD_ERROR_DETAILS("failed to allocate latency histogram of slo controller");
+                goto _process_enter_receiver_exit;
+            }
+        }
+    }
+
+    /* allocate latency histogram of this core */
+    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+        result = sc_util_hdr_hist_init(&PER_CORE_APP_META(sc_config).latency_hist,
+            SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate latency histogram");
+            goto _process_enter_receiver_exit;
+        }
+    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+    /* allocate histogram of each stage decomposed by the server-side stamps */
+    if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+        for(i=0; i<SC_ECHO_CLIENT_NB_STAGES; i++){
+            result = sc_util_hdr_hist_init(&PER_CORE_APP_META(sc_config).stage_hists[i],
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+            if(unlikely(result != SC_SUCCESS)){
+                SC_THREAD_ERROR_DETAILS("failed to allocate histogram of stage");
+                goto _process_enter_receiver_exit;
+            }
+        }
+        PER_CORE_APP_META(sc_config).stage_nb_unstamped = 0;
+    }
+
+    /* allocate latency histogram of each kv operation */
+    if(INTERNAL_CONF(sc_config)->enable_kv){
+        for(i=0; i<SC_KV_OP_UNKNOWN; i++){
+            result = sc_util_hdr_hist_init(&PER_CORE_APP_META(sc_config).kv_stats[i].latency_hist,
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+            if(unlikely(result != SC_SUCCESS)){
+                SC_THREAD_ERROR_DETAILS("failed to allocate latency histogram of kv operations");
+                goto _process_enter_receiver_exit;
+            }
+        }
+        PER_CORE_APP_META(sc_config).kv_nb_unmatched = 0;
+    }
+
+    /* allocate receive window of each flow of each send core */
+    if(INTERNAL_CONF(sc_config)->enable_seq){
+        PER_CORE_APP_META(sc_config).seq_windows = (struct sc_seq_window*)rte_zmalloc(NULL,
+            sizeof(struct sc_seq_window)*INTERNAL_CONF(sc_config)->nb_send_cores*INTERNAL_CONF(sc_config)->nb_flow_per_core, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).seq_windows)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for receive windows of flows");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_receiver_exit;
+        }
+        memset(&PER_CORE_APP_META(sc_config).seq_stat, 0, sizeof(struct sc_seq_stat));
+        PER_CORE_APP_META(sc_config).seq_nb_untagged = 0;
+    }
+
+    /* allocate per-phase statistics under load schedule (already allocated on send_recv core) */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule && !PER_CORE_APP_META(sc_config).sched_stats){
+        PER_CORE_APP_META(sc_config).sched_stats = (struct _sched_phase_stat*)rte_zmalloc(NULL,
+            sizeof(struct _sched_phase_stat)*INTERNAL_CONF(sc_config)->load_schedule.nb_phases, 0);
+        if(unlikely(!PER_CORE_APP_META(sc_config).sched_stats)){
+            SC_THREAD_ERROR_DETAILS("failed to allocate memory for statistics of load schedule");
+            result = SC_ERROR_MEMORY;
+            goto _process_enter_receiver_exit;
+        }
+    }
+
+    /* initialize the start_time */
+    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).start_time, NULL))){
+        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
+        result =  SC_ERROR_INTERNAL;
+        goto _process_enter_receiver_exit;
+    }
+
+_process_enter_receiver_exit:
+    return result;
+}
+
+/*!
+ * \brief   record the response of closed-loop request, and batch its completion
+ *          towards the send core which owns the flow
+ * \note    latency is measured by tsc of different cores, which relies on invariant tsc
+ * \param   sc_config   the global configuration
+ * \param   cl_tag      tag carried by the response
+ * \param   recv_tsc    tsc when the response is received
+ */
+static inline void _closed_loop_record_response(
+    struct sc_config *sc_config, struct _closed_loop_tag *cl_tag, uint64_t recv_tsc
+){
+    struct _closed_loop_stat *stat;
+    uint64_t latency_cycles;
+    uint32_t nb_completions;
+
+    if(unlikely(cl_tag->magic != SC_ECHO_CLIENT_CL_TAG_MAGIC
+        || cl_tag->sender_id >= INTERNAL_CONF(sc_config)->nb_send_cores
+        || cl_tag->flow_id >= INTERNAL_CONF(sc_config)->nb_flow_per_core
+        || cl_tag->level >= INTERNAL_CONF(sc_config)->nb_cl_levels)){
+        return;
+    }
+
+    stat = &PER_CORE_APP_META(sc_config).cl_stats[cl_tag->level];
+    latency_cycles = recv_tsc > cl_tag->send_tsc ? recv_tsc - cl_tag->send_tsc : 0;
+    stat->nb_responses += 1;
+    sc_util_hdr_hist_record(&stat->latency_hist, sc_util_tsc_to_ns(latency_cycles));
+
+    nb_completions = PER_CORE_APP_META(sc_config).cl_nb_batched[cl_tag->sender_id];
+    PER_CORE_APP_META(sc_config).cl_batches[cl_tag->sender_id*SC_MAX_RX_PKT_BURST + nb_completions]
+        = (void*)(uintptr_t)cl_tag->flow_id;
+    PER_CORE_APP_META(sc_config).cl_nb_batched[cl_tag->sender_id] = nb_completions + 1;
+}
+
+/*!
+ * \brief   pass the batched completions back to send cores
+ * \param   sc_config   the global configuration
+ */
+static inline void _closed_loop_flush_completions(struct sc_config *sc_config){
+    uint32_t i, nb_completions, nb_enqueued;
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+        nb_completions = PER_CORE_APP_META(sc_config).cl_nb_batched[i];
+        if(nb_completions == 0){ continue; }
+
+        nb_enqueued = rte_ring_mp_enqueue_burst(
+            /* r */ INTERNAL_CONF(sc_config)->cl_rings[i],
+            /* obj_table */ &PER_CORE_APP_META(sc_config).cl_batches[i*SC_MAX_RX_PKT_BURST],
+            /* n */ nb_completions,
+            /* free_space */ NULL
+        );
+
+        /* window slots of dropped completions are reclaimed by timeout of the send core */
+        PER_CORE_APP_META(sc_config).cl_nb_ring_drops += nb_completions - nb_enqueued;
+        PER_CORE_APP_META(sc_config).cl_nb_batched[i] = 0;
+    }
+}
+
+/*!
+ * \brief   match the kv response with its in-flight request, and record its latency
+ * \note    latency is measured by tsc of different cores, which relies on invariant tsc
+ * \param   sc_config   the global configuration
+ * \param   req_hdr     request header carried by the response
+ * \param   recv_tsc    tsc when the response is received
+ */
+static inline void _kv_record_response(
+    struct sc_config *sc_config, struct sc_kv_req_hdr *req_hdr, uint64_t recv_tsc
+){
+    struct _kv_op_stat *stat;
+    struct _kv_inflight *slot;
+    uint64_t req_id, send_tsc, latency_cycles;
+    uint32_t sender_id;
+    uint8_t op;
+
+    sender_id = rte_be_to_cpu_32(req_hdr->sender_id);
+    if(unlikely(rte_be_to_cpu_32(req_hdr->magic) != SC_KV_MAGIC
+        || sender_id >= INTERNAL_CONF(sc_config)->nb_send_cores)){
+        PER_CORE_APP_META(sc_config).kv_nb_unmatched += 1;
+        return;
+    }
+
+    req_id = rte_be_to_cpu_64(req_hdr->req_id);
+    slot = &INTERNAL_CONF(sc_config)->kv_inflight[sender_id][req_id & (SC_ECHO_CLIENT_KV_NB_INFLIGHT-1)];
+    if(unlikely(slot->req_id != req_id)){
+        PER_CORE_APP_META(sc_config).kv_nb_unmatched += 1;
+        return;
+    }
+    rte_smp_rmb();
+    send_tsc = slot->send_tsc;
+    op = slot->op;
+
+    /* release the slot, duplicated responses are then unmatched */
+    if(unlikely(!__sync_bool_compare_and_swap(&slot->req_id, req_id, 0))){
+        PER_CORE_APP_META(sc_config).kv_nb_unmatched += 1;
+        return;
+    }
+
+    stat = &PER_CORE_APP_META(sc_config).kv_stats[op];
+    latency_cycles = recv_tsc > send_tsc ? recv_tsc - send_tsc : 0;
+    stat->nb_responses += 1;
+    sc_util_hdr_hist_record(&stat->latency_hist, sc_util_tsc_to_ns(latency_cycles));
+}
+
+/*!
+ * \brief   track the sequence number carried by the response
+ * \note    responses of a flow are assumed to be steered into the same receive core
+ * \param   sc_config   the global configuration
+ * \param   seq_tag     sequence tag carried by the response
+ */
+static inline void _seq_record_response(struct sc_config *sc_config, struct _seq_tag *seq_tag){
+    if(unlikely(seq_tag->magic != SC_ECHO_CLIENT_SEQ_TAG_MAGIC
+        || seq_tag->sender_id >= INTERNAL_CONF(sc_config)->nb_send_cores
+        || seq_tag->flow_id >= INTERNAL_CONF(sc_config)->nb_flow_per_core)){
+        PER_CORE_APP_META(sc_config).seq_nb_untagged += 1;
+        return;
+    }
+
+    sc_util_seq_track(
+        /* window */ &PER_CORE_APP_META(sc_config).seq_windows[
+            seq_tag->sender_id * INTERNAL_CONF(sc_config)->nb_flow_per_core + seq_tag->flow_id],
+        /* stat */ &PER_CORE_APP_META(sc_config).seq_stat,
+        /* seq */ seq_tag->seq
+    );
+}
+
+/*!
+ * \brief   decompose the round trip of the response by the trailer stamped by the server
+ * \note    stamps of the server are converted by its own tsc frequency carried in the trailer
+ * \param   sc_config   the global configuration
+ * \param   pkt         the response
+ * \param   rtt_ns      round-trip latency of the response (zero if not measured)
+ */
+static inline void _stage_record_response(struct sc_config *sc_config, struct rte_mbuf *pkt, uint64_t rtt_ns){
+    uint64_t server_ns;
+    struct sc_hdr_hist *hists = PER_CORE_APP_META(sc_config).stage_hists;
+    struct sc_stage_trailer *trailer = sc_util_stage_trailer_of(pkt);
+
+    if(unlikely(!trailer || trailer->tsc_hz == 0 || trailer->stamps[SC_STAGE_TX] == 0)){
+        PER_CORE_APP_META(sc_config).stage_nb_unstamped += 1;
+        return;
+    }
+
+    server_ns = sc_util_stage_elapsed_ns(trailer, SC_STAGE_RX, SC_STAGE_TX);
+    sc_util_hdr_hist_record(&hists[SC_ECHO_CLIENT_STAGE_SERVER], server_ns);
+    if(rtt_ns > 0){
+        sc_util_hdr_hist_record(&hists[SC_ECHO_CLIENT_STAGE_OUTSIDE], rtt_ns - RTE_MIN(rtt_ns, server_ns));
+    }
+}
+
+/*!
+ * \brief   callback for client logic
+ * \param   sc_config       the global configuration
+ * \param   queue_id        the index of the queue for current core to tx/rx packet
+ * \param   ready_to_exit   indicator for exiting worker loop
+ * \return  zero for successfully executing
+ */
+int _process_client_receiver(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
+    int i, j, k, nb_rx = 0, nb_recv_pkt = 0, result = SC_SUCCESS;
+    struct sc_timestamp_table *payload_timestamp;
+    uint64_t current_tsc;
+
+    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+        uint64_t latency_ns;
+    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_ports; i++){
+        memset(PER_CORE_APP_META(sc_config).recv_pkt_bufs, 0, sizeof(struct rte_mbuf*)*SC_MAX_RX_PKT_BURST*2);
+
+        nb_recv_pkt = rte_eth_rx_burst(
+            /* port_id */ INTERNAL_CONF(sc_config)->recv_port_idx[i], 
+            /* queue_id */ queue_id, 
+            /* rx_pkts */ PER_CORE_APP_META(sc_config).recv_pkt_bufs, 
+            /* nb_pkts */ SC_MAX_RX_PKT_BURST
+        );
+
+        /* record the receiving timestamp */
+        current_tsc = sc_util_timestamp_tsc();
+
+        if(nb_recv_pkt == 0) { continue; }
+        
+        PER_CORE_APP_META(sc_config).nb_confirmed_pkt += nb_recv_pkt;
+        PER_CORE_APP_META(sc_config).nb_interval_recv_pkt += nb_recv_pkt;
+
+        /* responses are attributed to the phase in which they are received */
+        if(INTERNAL_CONF(sc_config)->enable_load_schedule){
+            PER_CORE_APP_META(sc_config).sched_stats[RTE_MIN(INTERNAL_CONF(sc_config)->sched_phase,
+                INTERNAL_CONF(sc_config)->load_schedule.nb_phases-1)].nb_recv_pkt += nb_recv_pkt;
+        }
+        
+        for(j=0; j<nb_recv_pkt; j++) {
+            /* extract the timestamp struct */
+            payload_timestamp = rte_pktmbuf_mtod_offset(
+                PER_CORE_APP_META(sc_config).recv_pkt_bufs[j], struct sc_timestamp_table*, 
+                INTERNAL_CONF(sc_config)->enable_proto_stack
+                    ? INTERNAL_CONF(sc_config)->proto_stack.hdr_len
+                    : sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+            );
+            
+            /* skip wrong payload packet */
+            if(unlikely(payload_timestamp->timestamp_type != SC_TIMESTAMP_FULL_TYPE)){
+                continue;
+            }
+
+            /* match the kv response */
+            if(INTERNAL_CONF(sc_config)->enable_kv){
+                _kv_record_response(sc_config, (struct sc_kv_req_hdr*)(payload_timestamp + 1), current_tsc);
+            }
+
+            /* complete the closed-loop request */
+            if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+                _closed_loop_record_response(sc_config, (struct _closed_loop_tag*)(payload_timestamp + 1), current_tsc);
+            }
+
+            /* track losses, duplicates and reordering of the flow */
+            if(INTERNAL_CONF(sc_config)->enable_seq){
+                _seq_record_response(sc_config, (struct _seq_tag*)(payload_timestamp + 1));
+            }
+
+            #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+                latency_ns = sc_util_tsc_to_ns(
+                    current_tsc - RTE_MIN(current_tsc, sc_util_get_full_timestamp(payload_timestamp, 0)));
+
+                /* record latency of current epoch for slo controller */
+                if(INTERNAL_CONF(sc_config)->enable_slo){
+                    sc_util_hdr_hist_record(
+                        &PER_CORE_APP_META(sc_config).slo_hists[INTERNAL_CONF(sc_config)->slo_epoch & 1], latency_ns);
+                }
+
+                /* record latency into the histogram of this core */
+                sc_util_hdr_hist_record(&PER_CORE_APP_META(sc_config).latency_hist, latency_ns);
+            #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+            /* decompose the round trip by stamps of the server */
+            if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+                #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+                    _stage_record_response(sc_config, PER_CORE_APP_META(sc_config).recv_pkt_bufs[j], latency_ns);
+                #else
+                    _stage_record_response(sc_config, PER_CORE_APP_META(sc_config).recv_pkt_bufs[j], 0);
+                #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+            }
+
+free_recv_pkt_mbuf:
+            /* return back recv pkt_mbuf */
+            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).recv_pkt_bufs[j]); 
+        }
+
+        if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+            _closed_loop_flush_completions(sc_config);
+        }
+    }
+
+    goto process_client_receiver_exit;
+
+process_client_receiver_ready_to_exit:
+    *ready_to_exit = true;
+
+process_client_receiver_exit:
+    return result;
+}
+
+/*!
+ * \brief   callback while exiting application
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_exit_receiver(struct sc_config *sc_config){
+    /* initialize the end_time */
+    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).end_time, NULL))){
+        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
+        return SC_ERROR_INTERNAL;
+    }
+
+    SC_THREAD_LOG("[receiver] confirmed pkt: %lu", PER_CORE_APP_META(sc_config).nb_confirmed_pkt);
+
+    /* latency samples and histograms are freed after reporting */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        if(PER_CORE_APP_META(sc_config).cl_batches) rte_free(PER_CORE_APP_META(sc_config).cl_batches);
+        if(PER_CORE_APP_META(sc_config).cl_nb_batched) rte_free(PER_CORE_APP_META(sc_config).cl_nb_batched);
+    }
+
+    /* free receive windows, statistics are kept for reporting */
+    if(PER_CORE_APP_META(sc_config).seq_windows){
+        rte_free(PER_CORE_APP_META(sc_config).seq_windows);
+        PER_CORE_APP_META(sc_config).seq_windows = NULL;
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   callback while entering application (for core which both sends and receives)
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_enter_sender_receiver(struct sc_config *sc_config){
+    int result;
+
+    result = _process_enter_sender(sc_config);
+    if(result != SC_SUCCESS){ return result; }
+    return _process_enter_receiver(sc_config);
+}
+
+/*!
+ * \brief   callback for client logic (for core which both sends and receives),
+ *          the core polls responses of its own requests from the same queue
+ * \param   sc_config       the global configuration
+ * \param   queue_id        the index of the queue for current core to tx/rx packet
+ * \param   ready_to_exit   indicator for exiting worker loop
+ * \return  zero for successfully executing
+ */
+int _process_client_sender_receiver(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
+    int result;
+
+    if(INTERNAL_CONF(sc_config)->pcap_file){
+        result = _process_client_sender_pcap(sc_config, queue_id, ready_to_exit);
+    } else if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        result = _process_client_sender_closed_loop(sc_config, queue_id, ready_to_exit);
+    } else {
+        result = _process_client_sender(sc_config, queue_id, ready_to_exit);
+    }
+    if(result != SC_SUCCESS || *ready_to_exit){ return result; }
+
+    return _process_client_receiver(sc_config, queue_id, ready_to_exit);
+}
+
+/*!
+ * \brief   callback while exiting application (for core which both sends and receives)
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _process_exit_sender_receiver(struct sc_config *sc_config){
+    int result;
+
+    result = _process_exit_sender(sc_config);
+    if(result != SC_SUCCESS){ return result; }
+    return _process_exit_receiver(sc_config);
+}
+
+/*!
+ * \brief   report throughput and latency of each concurrency level under closed-loop mode
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _closed_loop_report(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint32_t i, l, nb_send_cores = INTERNAL_CONF(sc_config)->nb_send_cores;
+    uint64_t nb_requests, nb_responses, nb_timeouts, nb_ring_drops = 0;
+    uint64_t duration_cycles;
+    double cycles_per_us = (double)sc_util_tsc_hz() / (double)1000000.0f;
+    struct _closed_loop_stat *stat;
+    struct sc_hdr_hist merged;
+
+    result = sc_util_hdr_hist_init(&merged, SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS,
+        INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+    if(unlikely(result != SC_SUCCESS)){
+        SC_ERROR_DETAILS("failed to allocate histogram for merging closed-loop latencies");
+        goto closed_loop_report_free;
+    }
+
+    for(l=0; l<INTERNAL_CONF(sc_config)->nb_cl_levels; l++){
+        nb_requests = nb_responses = nb_timeouts = duration_cycles = 0;
+        sc_util_hdr_hist_reset(&merged);
+
+        /* requests are recorded by send cores */
+        for(i=0; i<nb_send_cores; i++){
+            stat = &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->send_core_logical_idx[i]).cl_stats[l];
+            if(stat->start_tsc == 0 || stat->end_tsc < stat->start_tsc){ continue; }
+            nb_requests += stat->nb_requests;
+            nb_timeouts += stat->nb_timeouts;
+            duration_cycles = RTE_MAX(duration_cycles, stat->end_tsc - stat->start_tsc);
+        }
+
+        /* responses are recorded by receive cores */
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+            stat = &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).cl_stats[l];
+            if(!stat->latency_hist.counts){ continue; }
+            nb_responses += stat->nb_responses;
+            sc_util_hdr_hist_merge(&merged, &stat->latency_hist);
+        }
+
+        if(duration_cycles == 0){
+            SC_LOG("[closed-loop] level %u (window %u): not reached", l, INTERNAL_CONF(sc_config)->cl_windows[l]);
+            continue;
+        }
+
+        SC_LOG("[closed-loop] level %u: window %u, concurrency %lu, duration %lf us, "
+               "requests %lu, responses %lu, timeouts %lu, throughput %lf Mrps",
+            l, INTERNAL_CONF(sc_config)->cl_windows[l],
+            (uint64_t)INTERNAL_CONF(sc_config)->cl_windows[l] * INTERNAL_CONF(sc_config)->nb_flow_per_core * nb_send_cores,
+            (double)duration_cycles / cycles_per_us,
+            nb_requests, nb_responses, nb_timeouts,
+            (double)nb_responses / ((double)duration_cycles / cycles_per_us)
+        );
+        if(merged.total_count > 0){
+            SC_LOG("[closed-loop] level %u: latency avg %lf us, p50 %lf us, p99 %lf us, p99.9 %lf us, max %lf us",
+                l,
+                sc_util_hdr_hist_mean(&merged) / 1000.0,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 50) / 1000.0,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 99) / 1000.0,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 99.9) / 1000.0,
+                (double)merged.max_value / 1000.0
+            );
+        }
+    }
+
+    sc_util_hdr_hist_free(&merged);
+
+closed_loop_report_free:
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        nb_ring_drops += PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).cl_nb_ring_drops;
+        for(l=0; l<INTERNAL_CONF(sc_config)->nb_cl_levels; l++){
+            sc_util_hdr_hist_free(&PER_CORE_APP_META_BY_CORE_ID(
+                sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).cl_stats[l].latency_hist);
+        }
+    }
+    if(nb_ring_drops > 0){
+        SC_WARNING_DETAILS("%lu closed-loop completion(s) are dropped due to full ring", nb_ring_drops);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief   report offered and achieved load of each phase under load schedule
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _load_schedule_report(struct sc_config *sc_config){
+    uint32_t i, p;
+    uint64_t nb_send_pkt, nb_drop_pkt, nb_recv_pkt, start_ns, end_ns;
+    double duration_us;
+    struct sc_load_schedule *sched = &INTERNAL_CONF(sc_config)->load_schedule;
+    struct _sched_phase_stat *stat;
+
+    for(p=0; p<sched->nb_phases; p++){
+        start_ns = INTERNAL_CONF(sc_config)->sched_phase_start_ns[p];
+        if(start_ns == 0){
+            SC_LOG("[schedule] phase %u: not reached", p);
+            continue;
+        }
+        /* a phase ends when any later phase (or the end of schedule) is entered */
+        for(i=p+1, end_ns=0; i<=sched->nb_phases && end_ns==0; i++){
+            end_ns = INTERNAL_CONF(sc_config)->sched_phase_start_ns[i];
+        }
+        if(end_ns == 0){ end_ns = sc_util_timestamp_ns(); }
+        duration_us = (double)(end_ns - start_ns) / (double)1000.0f;
+
+        nb_send_pkt = nb_drop_pkt = nb_recv_pkt = 0;
+        for(i=0; i<sc_config->nb_used_cores; i++){
+            stat = PER_CORE_APP_META_BY_CORE_ID(sc_config, i).sched_stats;
+            if(!stat){ continue; }
+            nb_send_pkt += stat[p].nb_send_pkt;
+            nb_drop_pkt += stat[p].nb_drop_pkt;
+            nb_recv_pkt += stat[p].nb_recv_pkt;
+        }
+
+        SC_LOG("[schedule] phase %u: duration %lf us, target %lf Mpps, send %lf Mpps, recv %lf Mpps, "
+               "tx drops %lu, loss ratio %lf%%",
+            p, duration_us, sched->phases[p].pkt_rate,
+            duration_us > 0 ? (double)nb_send_pkt / duration_us : 0,
+            duration_us > 0 ? (double)nb_recv_pkt / duration_us : 0,
+            nb_drop_pkt,
+            nb_send_pkt > 0 && nb_send_pkt > nb_recv_pkt
+                ? (double)(nb_send_pkt - nb_recv_pkt) / (double)nb_send_pkt * 100.0 : 0
+        );
+    }
+
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        if(PER_CORE_APP_META_BY_CORE_ID(sc_config, i).sched_stats){
+            rte_free(PER_CORE_APP_META_BY_CORE_ID(sc_config, i).sched_stats);
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, i).sched_stats = NULL;
+        }
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   report the highest rate within the acceptable loss of each packet size
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _rfc2544_report(struct sc_config *sc_config){
+    uint32_t i, pkt_len;
+    struct _rfc2544_result *res;
+
+    SC_LOG("[rfc2544] throughput within %lf%% loss (trial %lu ms, settle %lu ms, resolution %lf Mpps)",
+        INTERNAL_CONF(sc_config)->rfc2544_loss_ratio, INTERNAL_CONF(sc_config)->rfc2544_trial_ms,
+        INTERNAL_CONF(sc_config)->rfc2544_settle_ms, INTERNAL_CONF(sc_config)->rfc2544_resolution);
+    SC_LOG("| Size (B) | Trials |  Rate (Mpps)  |  Sent (Mpps)  |  Sent (Gbps)  |   Loss (%%)   |");
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_rfc2544_sizes; i++){
+        res = &INTERNAL_CONF(sc_config)->rfc2544_results[i];
+        pkt_len = INTERNAL_CONF(sc_config)->rfc2544_sizes[i];
+        if(res->nb_trials == 0){
+            SC_LOG("| %8u | %6u |  not searched |               |               |               |", pkt_len, 0);
+        } else if(!res->found){
+            SC_LOG("| %8u | %6u | < %11lf |               |               |               |",
+                pkt_len, res->nb_trials, INTERNAL_CONF(sc_config)->rfc2544_min_rate);
+        } else {
+            SC_LOG("| %8u | %6u | %13lf | %13lf | %13lf | %13lf |",
+                pkt_len, res->nb_trials, res->rate, res->send_rate,
+                res->send_rate * (double)pkt_len * 8.0 / 1000.0, res->loss_ratio);
+        }
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   report the sustainable rate found by the slo controller, with its 95% confidence interval
+ *          over the intervals meeting the target within the last window
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _slo_report(struct sc_config *sc_config){
+    uint32_t i, j, start, nb_met = 0;
+    double mean = 0, var = 0, half_width, max_met_rate = 0, sum_latency = 0;
+    struct _slo_state *state = &INTERNAL_CONF(sc_config)->slo_state;
+
+    start = state->nb_intervals > INTERNAL_CONF(sc_config)->slo_window
+            ? state->nb_intervals - INTERNAL_CONF(sc_config)->slo_window : 0;
+    for(i=0; i<state->nb_intervals; i++){
+        if(state->met[i]){ max_met_rate = RTE_MAX(max_met_rate, state->rates[i]); }
+        if(i < start || !state->met[i]){ continue; }
+        mean += state->rates[i];
+        sum_latency += state->latencies[i];
+        nb_met += 1;
+    }
+
+    if(nb_met == 0){
+        SC_LOG("[slo] no interval within the last %u meets p%lf latency <= %lu us (%u interval(s) in total)",
+            state->nb_intervals - start, INTERNAL_CONF(sc_config)->slo_percentile,
+            INTERNAL_CONF(sc_config)->slo_target_us, state->nb_intervals);
+        goto slo_report_free;
+    }
+
+    mean /= (double)nb_met;
+    for(i=start; i<state->nb_intervals; i++){
+        if(state->met[i]){ var += (state->rates[i] - mean) * (state->rates[i] - mean); }
+    }
+    var /= (double)(nb_met > 1 ? nb_met - 1 : 1);
+    half_width = 1.96 * sqrt(var / (double)nb_met);
+
+    SC_LOG("[slo] sustainable rate: %lf Mpps (95%% CI [%lf, %lf] Mpps over %u interval(s)), "
+           "mean p%lf latency %lf us, target %lu us, %s after %u interval(s)",
+        mean, mean - half_width, mean + half_width, nb_met,
+        INTERNAL_CONF(sc_config)->slo_percentile, sum_latency / (double)nb_met,
+        INTERNAL_CONF(sc_config)->slo_target_us, state->converged ? "converged" : "not converged", state->nb_intervals);
+    SC_LOG("[slo] highest rate meeting the target: %lf Mpps", max_met_rate);
+
+slo_report_free:
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        for(j=0; j<2; j++){
+            sc_util_hdr_hist_free(&PER_CORE_APP_META_BY_CORE_ID(sc_config, i).slo_hists[j]);
+        }
+    }
+    sc_util_hdr_hist_free(&state->hist);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   report requests and latency of each kv operation
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _kv_report(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint8_t op;
+    uint32_t i;
+    uint64_t nb_requests, nb_responses, nb_unmatched = 0;
+    struct _kv_op_stat *stat;
+    struct sc_hdr_hist merged;
+
+    result = sc_util_hdr_hist_init(&merged, SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS,
+        INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+    if(unlikely(result != SC_SUCCESS)){
+        SC_ERROR_DETAILS("failed to allocate histogram for merging latencies of kv operations");
+        goto kv_report_free;
+    }
+
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+        nb_requests = nb_responses = 0;
+        sc_util_hdr_hist_reset(&merged);
+
+        /* requests are recorded by send cores */
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+            nb_requests += PER_CORE_APP_META_BY_CORE_ID(sc_config, 
+                INTERNAL_CONF(sc_config)->send_core_logical_idx[i]).kv_stats[op].nb_requests;
+        }
+
+        /* responses are recorded by receive cores */
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+            stat = &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).kv_stats[op];
+            if(!stat->latency_hist.counts){ continue; }
+            nb_responses += stat->nb_responses;
+            sc_util_hdr_hist_merge(&merged, &stat->latency_hist);
+        }
+
+        if(nb_requests == 0){ continue; }
+
+        SC_LOG("[kv] %s: requests %lu, responses %lu, lost %lu",
+            sc_util_kv_op_name(op), nb_requests, nb_responses,
+            nb_requests > nb_responses ? nb_requests - nb_responses : 0);
+        if(merged.total_count == 0){ continue; }
+
+        SC_LOG("[kv] %s: latency avg %lf us, p50 %lf us, p99 %lf us, p99.9 %lf us, max %lf us",
+            sc_util_kv_op_name(op),
+            sc_util_hdr_hist_mean(&merged) / 1000.0,
+            (double)sc_util_hdr_hist_value_at_percentile(&merged, 50) / 1000.0,
+            (double)sc_util_hdr_hist_value_at_percentile(&merged, 99) / 1000.0,
+            (double)sc_util_hdr_hist_value_at_percentile(&merged, 99.9) / 1000.0,
+            (double)merged.max_value / 1000.0
+        );
+    }
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        nb_unmatched += PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).kv_nb_unmatched;
+    }
+    if(nb_unmatched > 0){
+        SC_WARNING_DETAILS("%lu kv response(s) couldn't be matched with in-flight requests", nb_unmatched);
+    }
+
+    sc_util_hdr_hist_free(&merged);
+
+kv_report_free:
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+            sc_util_hdr_hist_free(&PER_CORE_APP_META_BY_CORE_ID(sc_config, i).kv_stats[op].latency_hist);
+        }
+    }
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+        rte_free(INTERNAL_CONF(sc_config)->kv_inflight[i]);
+    }
+    rte_free(INTERNAL_CONF(sc_config)->kv_inflight);
+    INTERNAL_CONF(sc_config)->kv_inflight = NULL;
+    sc_util_kv_workload_free(&INTERNAL_CONF(sc_config)->kv_workload);
+
+    return result;
+}
+
+#if defined(SC_ECHO_CLIENT_GET_LATENCY)
+/*!
+ * \brief   merge latency histograms of all receive cores
+ * \param   sc_config   the global configuration
+ * \param   dst         the merged histogram, which is cleared before merging
+ */
+static void _latency_hist_merge(struct sc_config *sc_config, struct sc_hdr_hist *dst){
+    uint32_t i;
+    struct sc_hdr_hist *hist;
+
+    sc_util_hdr_hist_reset(dst);
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        hist = &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).latency_hist;
+        if(!hist->counts){ continue; }
+        sc_util_hdr_hist_merge(dst, hist);
+    }
+}
+
+/*!
+ * \brief   log percentiles of the latency histogram
+ * \param   title   title of the log
+ * \param   hist    the histogram (unit: ns)
+ */
+static void _latency_hist_log(const char *title, struct sc_hdr_hist *hist){
+    if(hist->total_count == 0){
+        SC_LOG("%s latency: no response", title);
+        return;
+    }
+    SC_LOG("%s latency of %lu responses: avg %lf us, p50 %lf us, p99 %lf us, p99.9 %lf us, p99.99 %lf us, max %lf us",
+        title, hist->total_count,
+        sc_util_hdr_hist_mean(hist) / 1000.0,
+        (double)sc_util_hdr_hist_value_at_percentile(hist, 50) / 1000.0,
+        (double)sc_util_hdr_hist_value_at_percentile(hist, 99) / 1000.0,
+        (double)sc_util_hdr_hist_value_at_percentile(hist, 99.9) / 1000.0,
+        (double)sc_util_hdr_hist_value_at_percentile(hist, 99.99) / 1000.0,
+        (double)hist->max_value / 1000.0
+    );
+}
+#endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+/*!
+ * \brief   merge sequence statistics of all receive cores
+ * \param   sc_config   the global configuration
+ * \param   dst         the merged statistics, which is cleared before merging
+ */
+static void _seq_stat_merge(struct sc_config *sc_config, struct sc_seq_stat *dst){
+    uint32_t i;
+
+    memset(dst, 0, sizeof(struct sc_seq_stat));
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        sc_util_seq_stat_merge(dst,
+            &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).seq_stat);
+    }
+}
+
+/*!
+ * \brief   log losses, reordering and duplicates of the sequence statistics
+ * \param   title   title of the log
+ * \param   stat    the statistics
+ */
+static void _seq_stat_log(const char *title, struct sc_seq_stat *stat){
+    uint64_t nb_lost = sc_util_seq_stat_nb_lost(stat);
+    uint64_t nb_expected = stat->nb_received - RTE_MIN(stat->nb_received, stat->nb_duplicated) + nb_lost;
+
+    SC_LOG("%s sequence of %lu responses: lost %lu (%lf%%) in %lu gap(s), reordered %lu (max depth %lu), "
+        "late %lu, duplicated %lu",
+        title, stat->nb_received, nb_lost, nb_expected > 0 ? (double)nb_lost / (double)nb_expected * 100.0 : 0.0,
+        stat->nb_gaps, stat->nb_reordered, stat->max_reorder_depth, stat->nb_late, stat->nb_duplicated
+    );
+}
+
+/*!
+ * \brief   report overall sequence statistics, and attribute losses to where they could happen
+ * \note    unsent packets of send cores never take sequence numbers, and packets still
+ *          in flight at exit leave no gap, so that gaps are losses after the client nic
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _seq_report(struct sc_config *sc_config){
+    int ret;
+    uint32_t i;
+    uint64_t nb_lost, nb_withdrawn = 0, nb_untagged = 0, nb_nic_missed = 0;
+    struct sc_seq_stat total;
+    struct rte_eth_stats stats;
+
+    _seq_stat_merge(sc_config, &total);
+    _seq_stat_log("[TOTAL]", &total);
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+        nb_withdrawn += PER_CORE_APP_META_BY_CORE_ID(
+            sc_config, INTERNAL_CONF(sc_config)->send_core_logical_idx[i]).seq_nb_withdrawn;
+    }
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        nb_untagged += PER_CORE_APP_META_BY_CORE_ID(
+            sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).seq_nb_untagged;
+    }
+
+    /* responses dropped by the receive ports of client, including those of untagged packets */
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_ports; i++){
+        ret = rte_eth_stats_get(INTERNAL_CONF(sc_config)->recv_port_idx[i], &stats);
+        if(ret != 0){
+            SC_WARNING_DETAILS("failed to obtain statistics of port %u: %s",
+                INTERNAL_CONF(sc_config)->recv_port_idx[i], rte_strerror(-ret));
+            continue;
+        }
+        nb_nic_missed += stats.imissed + stats.rx_nombuf;
+    }
+
+    nb_lost = sc_util_seq_stat_nb_lost(&total);
+    SC_LOG("[TOTAL] loss attribution: client tx drops %lu (not sequenced), client rx misses %lu (of receive ports), "
+        "server / network drops %lu (estimated), untagged responses %lu",
+        nb_withdrawn, nb_nic_missed, nb_lost - RTE_MIN(nb_lost, nb_nic_missed), nb_untagged
+    );
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   report the distribution of each stage decomposed by the server-side stamps,
+ *          and free histograms of all receive cores
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+static int _stage_report(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint32_t i, j;
+    uint64_t nb_unstamped = 0;
+    struct sc_hdr_hist merged, *hist;
+    static const char *stage_names[SC_ECHO_CLIENT_NB_STAGES] = {
+        "server rx -> tx", "outside server (network + client)"
+    };
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        nb_unstamped += PER_CORE_APP_META_BY_CORE_ID(
+            sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).stage_nb_unstamped;
+    }
+
+    for(j=0; j<SC_ECHO_CLIENT_NB_STAGES; j++){
+        result = sc_util_hdr_hist_init(&merged, SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS,
+            INTERNAL_CONF(sc_config)->latency_hist_sig_figs);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to allocate histogram for merging stage %s", stage_names[j]);
+            goto _stage_report_exit;
+        }
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+            hist = &PER_CORE_APP_META_BY_CORE_ID(
+                sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).stage_hists[j];
+            if(!hist->counts){ continue; }
+            sc_util_hdr_hist_merge(&merged, hist);
+        }
+
+        if(merged.total_count > 0){
+            SC_LOG("[TOTAL] stage %s of %lu responses: avg %lf us, p50 %lf us, p99 %lf us, p99.9 %lf us, max %lf us",
+                stage_names[j], merged.total_count,
+                sc_util_hdr_hist_mean(&merged) / (double)1000.0f,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 50) / (double)1000.0f,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 99) / (double)1000.0f,
+                (double)sc_util_hdr_hist_value_at_percentile(&merged, 99.9) / (double)1000.0f,
+                (double)merged.max_value / (double)1000.0f
+            );
+        }
+        sc_util_hdr_hist_free(&merged);
+    }
+
+    SC_LOG("[TOTAL] responses not stamped by the server: %lu", nb_unstamped);
+
+_stage_report_exit:
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        for(j=0; j<SC_ECHO_CLIENT_NB_STAGES; j++){
+            sc_util_hdr_hist_free(&PER_CORE_APP_META_BY_CORE_ID(sc_config, i).stage_hists[j]);
+        }
+    }
+    return result;
+}
+
+/*!
+ * \brief   callback while all worker thread exit
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully executing
+ */
+int _worker_all_exit(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint8_t nb_timestamp = 0;
+    uint32_t i, j, k;
+    struct sc_timestamp_table* sc_ts;
+    size_t nb_send_pkt = 0, nb_confirmed_pkt = 0;
+    double per_core_avg_latency, per_core_payload_copy_latency, all_core_avg_latency;
+    long worker_max_interval_sec = 0, worker_max_interval_usec = 0;
+    char profiling_file_name[512] = {0};
+    FILE * fp;
+
+    /* calculate the average payload copy latency to fix the RTT statistic */
+    per_core_payload_copy_latency = (double)0.0f;
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        per_core_payload_copy_latency += (double)PER_CORE_APP_META_BY_CORE_ID(sc_config, i).payload_copy_latency;
+        per_core_payload_copy_latency /= (double)2.0f;
+    }
+
+    // record latency data
+    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+        _latency_hist_merge(sc_config, &INTERNAL_CONF(sc_config)->latency_hist_merged);
+        _latency_hist_log("[TOTAL]", &INTERNAL_CONF(sc_config)->latency_hist_merged);
+
+        /* percentile distribution in the format of HdrHistogram (unit: us) */
+        sprintf(profiling_file_name, "latency.hgrm");
+        fp = fopen(profiling_file_name, "w");
+        if (!fp) {
+            SC_ERROR("failed to create/open log file to store latency statistics");
+            result = SC_ERROR_INTERNAL;
+            goto worker_all_exit_exit;
+        }
+        sc_util_hdr_hist_output_percentiles(&INTERNAL_CONF(sc_config)->latency_hist_merged, fp,
+            SC_ECHO_CLIENT_LATENCY_HIST_TICKS, 1000.0);
+        fclose(fp);
+
+        for(i=0; i<sc_config->nb_used_cores; i++){
+            sc_util_hdr_hist_free(&PER_CORE_APP_META_BY_CORE_ID(sc_config, i).latency_hist);
+        }
+        sc_util_hdr_hist_free(&INTERNAL_CONF(sc_config)->latency_hist_merged);
+        sc_util_hdr_hist_free(&INTERNAL_CONF(sc_config)->latency_hist_prev);
+        sc_util_hdr_hist_free(&INTERNAL_CONF(sc_config)->latency_hist_interval);
+    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        /* reduce number of packet */
+        nb_send_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_send_pkt;
+        nb_confirmed_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_confirmed_pkt;
+    }
+    SC_LOG("[TOTAL] number of send packet: %ld, number of confirm packet: %ld",
+        nb_send_pkt, nb_confirmed_pkt
+    );
+
+    /* record maximum duration */
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        long interval_sec, interval_usec;
+        interval_sec
+            = PER_CORE_APP_META_BY_CORE_ID(sc_config, i).end_time.tv_sec 
+            - PER_CORE_APP_META_BY_CORE_ID(sc_config, i).start_time.tv_sec;
+        interval_usec
+            = PER_CORE_APP_META_BY_CORE_ID(sc_config, i).end_time.tv_usec 
+            - PER_CORE_APP_META_BY_CORE_ID(sc_config, i).start_time.tv_usec;
+        if(SC_UTIL_TIME_INTERVL_US(interval_sec, interval_usec) >
+                SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec)){
+            worker_max_interval_sec = interval_sec;
+            worker_max_interval_usec = interval_usec;
+        }
+    }
+
+    SC_THREAD_LOG("[TOTAL] duration: %lu us",
+        SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec)
+    );
+    SC_THREAD_LOG("[TOTAL] packet length: %lf bytes (mean)",
+        INTERNAL_CONF(sc_config)->mean_pkt_len
+    );
+    SC_THREAD_LOG("[TOTAL] send throughput: %f Gbps",
+        (float)((double)nb_send_pkt * INTERNAL_CONF(sc_config)->mean_pkt_len * 8) 
+        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec) * 1000)
+    );
+    SC_THREAD_LOG("[TOTAL] confirm throughput: %f Gbps",
+        (float)((double)nb_confirmed_pkt * INTERNAL_CONF(sc_config)->mean_pkt_len * 8) 
+        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec) * 1000)
+    );
+    SC_THREAD_LOG("[TOTAL] send throughput: %f Mpps",
+        (float)(nb_send_pkt) 
+        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec))
+    );
+    SC_THREAD_LOG("[TOTAL] confirm throughput: %f Mpps",
+        (float)(nb_confirmed_pkt) 
+        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec))
+    );
+
+    /* report each concurrency level */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        _closed_loop_report(sc_config);
+    }
+
+    /* report each phase of load schedule */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule){
+        _load_schedule_report(sc_config);
+    }
+
+    /* report throughput of each searched packet size */
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544){
+        _rfc2544_report(sc_config);
+    }
+
+    /* report the sustainable rate under latency target */
+    if(INTERNAL_CONF(sc_config)->enable_slo){
+        _slo_report(sc_config);
+    }
+
+    /* report latency of each kv operation */
+    if(INTERNAL_CONF(sc_config)->enable_kv){
+        _kv_report(sc_config);
+    }
+
+    /* report losses, reordering and duplicates */
+    if(INTERNAL_CONF(sc_config)->enable_seq){
+        _seq_report(sc_config);
+    }
+
+    /* report the distribution of each server-side stage */
+    if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+        _stage_report(sc_config);
+    }
+
+worker_all_exit_exit:
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   callback while entering control-plane thread (for sender)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully initialization
+ */
+int _control_enter_sender(struct sc_config *sc_config, uint32_t worker_core_id){
+    return SC_ERROR_NOT_IMPLEMENTED;
+}
+
+/*!
+ * \brief   switch the phase of load schedule based on the elapsed time
+ * \note    the control plane only publishes the index of current phase,
+ *          each send core applies the phase to its own pacer within its next loop
+ * \param   sc_config   the global configuration
+ */
+static void _load_schedule_tick(struct sc_config *sc_config){
+    uint32_t current_phase, next_phase;
+    uint64_t current_ns = sc_util_timestamp_ns();
+    struct sc_load_schedule *sched = &INTERNAL_CONF(sc_config)->load_schedule;
+
+    /* the schedule starts at the first tick */
+    if(unlikely(INTERNAL_CONF(sc_config)->sched_start_ns == 0)){
+        INTERNAL_CONF(sc_config)->sched_start_ns = current_ns;
+        INTERNAL_CONF(sc_config)->sched_phase_start_ns[0] = current_ns;
+        SC_LOG("[schedule] enter phase 0: %lf Mpps", sched->phases[0].pkt_rate);
+    }
+
+    current_phase = INTERNAL_CONF(sc_config)->sched_phase;
+    if(current_phase >= sched->nb_phases){ return; }
+
+    next_phase = sc_util_load_schedule_phase_at(
+        sched, (current_ns - INTERNAL_CONF(sc_config)->sched_start_ns) / 1000000, current_phase);
+    if(next_phase == current_phase){ return; }
+
+    /* record the start of each passed phase, skipped phases are marked as not reached */
+    INTERNAL_CONF(sc_config)->sched_phase_start_ns[next_phase] = current_ns;
+
+    /* publish the phase to send cores */
+    rte_smp_wmb();
+    INTERNAL_CONF(sc_config)->sched_phase = next_phase;
+
+    if(next_phase < sched->nb_phases){
+        SC_LOG("[schedule] enter phase %u: %lf Mpps", next_phase, sched->phases[next_phase].pkt_rate);
+    } else {
+        SC_LOG("[schedule] all %u phase(s) finished, stop sending", sched->nb_phases);
+        sc_force_quit = true;
+    }
+}
+
+/*!
+ * \brief   sum up the number of sent and received packets of all cores
+ * \param   sc_config       the global configuration
+ * \param   nb_send_pkt     number of packets sent by all send cores
+ * \param   nb_recv_pkt     number of packets received by all receive cores
+ */
+static void _rfc2544_read_counters(struct sc_config *sc_config, uint64_t *nb_send_pkt, uint64_t *nb_recv_pkt){
+    uint32_t i;
+
+    *nb_send_pkt = *nb_recv_pkt = 0;
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        *nb_send_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_send_pkt;
+        *nb_recv_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_confirmed_pkt;
+    }
+}
+
+/*!
+ * \brief   publish a new trial to send cores
+ * \param   sc_config   the global configuration
+ * \param   pkt_rate    overall rate of the trial (unit: Mpps, 0 for pausing)
+ * \param   pkt_len     packet length of the trial (unit: bytes)
+ */
+static void _rfc2544_publish_trial(struct sc_config *sc_config, double pkt_rate, uint32_t pkt_len){
+    INTERNAL_CONF(sc_config)->rfc2544_trial_rate = pkt_rate;
+    INTERNAL_CONF(sc_config)->rfc2544_trial_pkt_len = pkt_len;
+    rte_smp_wmb();
+    INTERNAL_CONF(sc_config)->rfc2544_trial += 1;
+}
+
+/*!
+ * \brief   start a trial of the current packet size at the given rate
+ * \param   sc_config   the global configuration
+ * \param   pkt_rate    overall rate of the trial (unit: Mpps)
+ * \param   current_ns  current timestamp
+ */
+static void _rfc2544_start_trial(struct sc_config *sc_config, double pkt_rate, uint64_t current_ns){
+    struct _rfc2544_search *search = &INTERNAL_CONF(sc_config)->rfc2544_search;
+    uint64_t nb_send_pkt, nb_recv_pkt;
+
+    /* senders are paused, so all previous responses are counted before the trial */
+    _rfc2544_read_counters(sc_config, &nb_send_pkt, &nb_recv_pkt);
+    search->base_send_pkt = nb_send_pkt;
+    search->base_recv_pkt = nb_recv_pkt;
+    search->rate = pkt_rate;
+    search->state = SC_ECHO_CLIENT_RFC2544_TRIAL;
+    search->state_start_ns = current_ns;
+
+    _rfc2544_publish_trial(sc_config, pkt_rate, INTERNAL_CONF(sc_config)->rfc2544_sizes[search->size_idx]);
+}
+
+/*!
+ * \brief   drive the rfc2544 throughput search: each trial sends at a fixed rate for rfc2544_trial_ms,
+ *          then pauses for rfc2544_settle_ms to collect in-flight responses before its loss is judged
+ * \note    the control plane only publishes rate and packet length of each trial,
+ *          each send core applies them to its own pacer within its next loop
+ * \param   sc_config   the global configuration
+ */
+static void _rfc2544_tick(struct sc_config *sc_config){
+    uint64_t current_ns = sc_util_timestamp_ns();
+    uint64_t nb_send_pkt, nb_recv_pkt, nb_trial_recv_pkt;
+    double loss_ratio, send_rate;
+    bool passed;
+    struct _rfc2544_search *search = &INTERNAL_CONF(sc_config)->rfc2544_search;
+    struct _rfc2544_result *res;
+
+    switch(search->state){
+    case SC_ECHO_CLIENT_RFC2544_INIT:
+        /* the first trial of each packet size is sent at the maximum rate */
+        search->size_idx = 0;
+        search->lo_rate = INTERNAL_CONF(sc_config)->rfc2544_min_rate;
+        search->hi_rate = INTERNAL_CONF(sc_config)->rfc2544_max_rate;
+        _rfc2544_start_trial(sc_config, search->hi_rate, current_ns);
+        break;
+
+    case SC_ECHO_CLIENT_RFC2544_TRIAL:
+        if(current_ns - search->state_start_ns < INTERNAL_CONF(sc_config)->rfc2544_trial_ms * 1000000UL){ break; }
+
+        /* pause senders, and wait for in-flight responses */
+        _rfc2544_publish_trial(sc_config, 0, INTERNAL_CONF(sc_config)->rfc2544_sizes[search->size_idx]);
+        _rfc2544_read_counters(sc_config, &nb_send_pkt, &nb_recv_pkt);
+        search->nb_trial_send_pkt = nb_send_pkt - search->base_send_pkt;
+        search->state = SC_ECHO_CLIENT_RFC2544_SETTLE;
+        search->state_start_ns = current_ns;
+        break;
+
+    case SC_ECHO_CLIENT_RFC2544_SETTLE:
+        if(current_ns - search->state_start_ns < INTERNAL_CONF(sc_config)->rfc2544_settle_ms * 1000000UL){ break; }
+
+        /* judge the trial, packets sent within the last loop of senders are counted as well */
+        _rfc2544_read_counters(sc_config, &nb_send_pkt, &nb_recv_pkt);
+        search->nb_trial_send_pkt = nb_send_pkt - search->base_send_pkt;
+        nb_trial_recv_pkt = nb_recv_pkt - search->base_recv_pkt;
+        loss_ratio = search->nb_trial_send_pkt > nb_trial_recv_pkt
+            ? (double)(search->nb_trial_send_pkt - nb_trial_recv_pkt) / (double)search->nb_trial_send_pkt * 100.0 : 0;
+        send_rate = (double)search->nb_trial_send_pkt / (double)(INTERNAL_CONF(sc_config)->rfc2544_trial_ms * 1000);
+        passed = search->nb_trial_send_pkt > 0 && loss_ratio <= INTERNAL_CONF(sc_config)->rfc2544_loss_ratio;
+
+        res = &INTERNAL_CONF(sc_config)->rfc2544_results[search->size_idx];
+        res->nb_trials += 1;
+        SC_LOG("[rfc2544] size %u bytes, trial %u: offered %lf Mpps, sent %lu (%lf Mpps), received %lu, loss %lf%%: %s",
+            INTERNAL_CONF(sc_config)->rfc2544_sizes[search->size_idx], res->nb_trials, search->rate,
+            search->nb_trial_send_pkt, send_rate, nb_trial_recv_pkt, loss_ratio, passed ? "pass" : "fail");
+
+        if(passed){
+            res->found = true;
+            res->rate = search->rate;
+            res->send_rate = send_rate;
+            res->loss_ratio = loss_ratio;
+            search->lo_rate = search->rate;
+        } else {
+            search->hi_rate = search->rate;
+        }
+
+        /* bisect until the resolution is reached, the maximum rate passed directly ends the search */
+        if(!(passed && res->nb_trials == 1)
+            && search->hi_rate - search->lo_rate > INTERNAL_CONF(sc_config)->rfc2544_resolution
+            && res->nb_trials < SC_ECHO_CLIENT_RFC2544_MAX_NB_TRIALS){
+            _rfc2544_start_trial(sc_config, (search->lo_rate + search->hi_rate) / 2.0, current_ns);
+            break;
+        }
+
+        /* next packet size */
+        search->size_idx += 1;
+        if(search->size_idx < INTERNAL_CONF(sc_config)->nb_rfc2544_sizes){
+            search->lo_rate = INTERNAL_CONF(sc_config)->rfc2544_min_rate;
+            search->hi_rate = INTERNAL_CONF(sc_config)->rfc2544_max_rate;
+            _rfc2544_start_trial(sc_config, search->hi_rate, current_ns);
+            break;
+        }
+
+        SC_LOG("[rfc2544] search of all %u packet size(s) finished, stop sending", INTERNAL_CONF(sc_config)->nb_rfc2544_sizes);
+        search->state = SC_ECHO_CLIENT_RFC2544_DONE;
+        sc_force_quit = true;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*!
+ * \brief   publish the offered rate of slo controller to send cores
+ * \param   sc_config   the global configuration
+ * \param   pkt_rate    overall offered rate (unit: Mpps)
+ */
+static void _slo_publish_rate(struct sc_config *sc_config, double pkt_rate){
+    INTERNAL_CONF(sc_config)->slo_rate = pkt_rate;
+    rte_smp_wmb();
+    INTERNAL_CONF(sc_config)->slo_rate_version += 1;
+}
+
+/*!
+ * \brief   merge the latency histograms of the given epoch parity from all receive cores,
+ *          then reset them for reuse
+ * \param   sc_config   the global configuration
+ * \param   parity      epoch parity of the merged histograms
+ * \param   nb_samples  number of merged latencies
+ * \return  the latency of slo_percentile (unit: us)
+ */
+static double _slo_read_percentile(struct sc_config *sc_config, uint32_t parity, uint64_t *nb_samples){
+    uint32_t i;
+    struct sc_hdr_hist *hist, *merged = &INTERNAL_CONF(sc_config)->slo_state.hist;
+
+    sc_util_hdr_hist_reset(merged);
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+        hist = &PER_CORE_APP_META_BY_CORE_ID(sc_config, INTERNAL_CONF(sc_config)->recv_core_logical_idx[i]).slo_hists[parity];
+        if(!hist->counts){ continue; }
+        sc_util_hdr_hist_merge(merged, hist);
+        sc_util_hdr_hist_reset(hist);
+    }
+
+    *nb_samples = merged->total_count;
+    return (double)sc_util_hdr_hist_value_at_percentile(merged, INTERNAL_CONF(sc_config)->slo_percentile) / 1000.0;
+}
+
+/*!
+ * \brief   drive the slo controller: at the end of each interval, the latency percentile of the interval
+ *          is compared against the target, and the offered rate is adjusted by aimd or pid steps
+ * \note    receivers switch to the histograms of the next epoch within their next loop,
+ *          so the histograms of the last interval are read one tick after the epoch is switched
+ * \param   sc_config   the global configuration
+ */
+static void _slo_tick(struct sc_config *sc_config){
+    uint32_t i, n, nb_met;
+    uint64_t nb_samples, current_ns = sc_util_timestamp_ns();
+    double latency_us, error, derivative, next_rate, mean, var, half_width;
+    bool met;
+    struct _slo_state *state = &INTERNAL_CONF(sc_config)->slo_state;
+
+    if(state->converged || state->nb_intervals >= INTERNAL_CONF(sc_config)->slo_max_intervals){ return; }
+
+    /* the first interval starts at the first tick */
+    if(unlikely(state->interval_start_ns == 0)){
+        state->interval_start_ns = current_ns;
+        state->rate = INTERNAL_CONF(sc_config)->slo_init_rate;
+        _slo_publish_rate(sc_config, state->rate);
+        SC_LOG("[slo] start at %lf Mpps, target p%lf latency %lu us",
+            state->rate, INTERNAL_CONF(sc_config)->slo_percentile, INTERNAL_CONF(sc_config)->slo_target_us);
+        return;
+    }
 
-        /* return back un-sent pkt_mbuf */
-        for(j=nb_send_pkt; j<INTERNAL_CONF(sc_config)->nb_pkt_per_burst; j++) {
-            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).send_pkt_bufs[j]); 
+    if(!state->pending_read){
+        if(current_ns - state->interval_start_ns < INTERNAL_CONF(sc_config)->slo_interval_ms * 1000000UL){ return; }
+        INTERNAL_CONF(sc_config)->slo_epoch = INTERNAL_CONF(sc_config)->slo_epoch + 1;
+        state->pending_read = true;
+        return;
+    }
+    state->pending_read = false;
+
+    /* latency percentile of the last interval, interval without any response violates the target */
+    latency_us = _slo_read_percentile(sc_config, (INTERNAL_CONF(sc_config)->slo_epoch - 1) & 1, &nb_samples);
+    met = nb_samples > 0 && latency_us <= (double)INTERNAL_CONF(sc_config)->slo_target_us;
+
+    state->rates[state->nb_intervals] = state->rate;
+    state->latencies[state->nb_intervals] = latency_us;
+    state->met[state->nb_intervals] = met;
+    state->nb_intervals += 1;
+
+    /* adjust the offered rate */
+    if(INTERNAL_CONF(sc_config)->slo_controller == SC_ECHO_CLIENT_SLO_AIMD){
+        next_rate = met ? state->rate + INTERNAL_CONF(sc_config)->slo_aimd_step
+                        : state->rate * INTERNAL_CONF(sc_config)->slo_aimd_backoff;
+    } else {
+        /* relative error, bounded within [-1, 1] */
+        error = nb_samples > 0
+            ? ((double)INTERNAL_CONF(sc_config)->slo_target_us - latency_us) / (double)INTERNAL_CONF(sc_config)->slo_target_us
+            : -1.0;
+        error = RTE_MAX(RTE_MIN(error, 1.0), -1.0);
+        state->pid_integral = RTE_MAX(RTE_MIN(state->pid_integral + error, 10.0), -10.0);
+        derivative = state->nb_intervals > 1 ? error - state->pid_prev_error : 0;
+        state->pid_prev_error = error;
+        next_rate = state->rate * (1.0 + INTERNAL_CONF(sc_config)->slo_pid_kp * error
+            + INTERNAL_CONF(sc_config)->slo_pid_ki * state->pid_integral
+            + INTERNAL_CONF(sc_config)->slo_pid_kd * derivative);
+    }
+    next_rate = RTE_MAX(RTE_MIN(next_rate, INTERNAL_CONF(sc_config)->slo_max_rate), INTERNAL_CONF(sc_config)->slo_min_rate);
+
+    SC_LOG("[slo] interval %u: %lf Mpps, p%lf latency %lf us over %lu response(s): %s, next %lf Mpps",
+        state->nb_intervals, state->rate, INTERNAL_CONF(sc_config)->slo_percentile, latency_us, nb_samples,
+        met ? "met" : "violated", next_rate);
+
+    /* converge while the 95% confidence interval of rates within the window is narrow enough */
+    n = INTERNAL_CONF(sc_config)->slo_window;
+    if(state->nb_intervals >= n){
+        mean = var = 0;
+        nb_met = 0;
+        for(i=state->nb_intervals-n; i<state->nb_intervals; i++){
+            mean += state->rates[i];
+            nb_met += state->met[i] ? 1 : 0;
+        }
+        mean /= (double)n;
+        for(i=state->nb_intervals-n; i<state->nb_intervals; i++){
+            var += (state->rates[i] - mean) * (state->rates[i] - mean);
+        }
+        var /= (double)(n > 1 ? n - 1 : 1);
+        half_width = 1.96 * sqrt(var / (double)n);
+        if(nb_met > 0 && half_width <= mean * INTERNAL_CONF(sc_config)->slo_converge_ratio / 100.0){
+            SC_LOG("[slo] converged after %u interval(s), stop sending", state->nb_intervals);
+            state->converged = true;
+            sc_force_quit = true;
+            return;
         }
+    }
 
-        nb_tx += nb_send_pkt;
+    if(state->nb_intervals >= INTERNAL_CONF(sc_config)->slo_max_intervals){
+        SC_LOG("[slo] not converged within %u interval(s), stop sending", state->nb_intervals);
+        sc_force_quit = true;
+        return;
+    }
+
+    state->rate = next_rate;
+    state->interval_start_ns = current_ns;
+    _slo_publish_rate(sc_config, next_rate);
+}
+
+/*!
+ * \brief   callback during control-plane thread runtime (for sender)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully execution
+ */
+int _control_infly_sender(struct sc_config *sc_config, uint32_t worker_core_id){
+    uint64_t i;
+    uint64_t current_ns;
+    uint64_t record_interval, nb_interval_send_pkt, nb_interval_drop_pkt;
+    uint32_t target_core_id, target_logical_core_id;
+    double send_throughput, drop_throughput;
+    double overall_send_throughput=0.0f, overall_drop_throughput=0.0f, overall_theory_throughput=0.0f;
 
-        /* update sending timestamp and interval */
-        PER_CORE_APP_META(sc_config).last_send_timestamp = current_ns;
+    char print_title[2048] = {0};
+    char print_send_statistics[2048] = {0};
+    char print_drop_statistics[2048] = {0};
+    char print_theory_statistics[2048] = {0};
+    
+    sprintf(print_title,                "| Core Index |");
+    sprintf(print_send_statistics,      "| Send Thrpt |");
+    sprintf(print_drop_statistics,      "| Drop Thrpt |");
+    sprintf(print_theory_statistics,    "| Theo Thrpt |");
 
-        /* FIXME: use timer to control the interval (according to a parameter) */
-        PER_CORE_APP_META(sc_config).interval = PER_CORE_APP_META(sc_config).interval_generator->next();
+    // switch phase of load schedule / trial of rfc2544 search / rate of slo controller
+    // by first sender core's control function, statistics are still printed every second
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544
+        || INTERNAL_CONF(sc_config)->enable_slo){
+        if(worker_core_id != INTERNAL_CONF(sc_config)->send_core_idx[0]){ return SC_SUCCESS; }
+        if(INTERNAL_CONF(sc_config)->enable_load_schedule)
+            _load_schedule_tick(sc_config);
+        else if(INTERNAL_CONF(sc_config)->enable_rfc2544)
+            _rfc2544_tick(sc_config);
+        else
+            _slo_tick(sc_config);
+        current_ns = sc_util_timestamp_ns();
+        if(current_ns - INTERNAL_CONF(sc_config)->sched_last_print_ns < 1000000000UL){ return SC_SUCCESS; }
+        INTERNAL_CONF(sc_config)->sched_last_print_ns = current_ns;
     }
 
-    /* update metadata */
-    if(nb_tx != 0){
-        // record the #sended packet
-        PER_CORE_APP_META(sc_config).nb_send_pkt += nb_tx;
-        PER_CORE_APP_META(sc_config).nb_interval_send_pkt += nb_tx;
-        PER_CORE_APP_META(sc_config).nb_interval_drop_pkt 
-            += INTERNAL_CONF(sc_config)->nb_pkt_per_burst * INTERNAL_CONF(sc_config)->nb_send_ports;
-        
-        // switch the sended flow
-        if(PER_CORE_APP_META(sc_config).last_used_flow == INTERNAL_CONF(sc_config)->nb_flow_per_core-1){
-            PER_CORE_APP_META(sc_config).last_used_flow = 0;
-        } else {
-            PER_CORE_APP_META(sc_config).last_used_flow += 1;
+    // print statistics by first sender core's control function
+    if(worker_core_id == INTERNAL_CONF(sc_config)->send_core_idx[0]){
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+            current_ns = sc_util_timestamp_ns();
+
+            // obtain both the logical and physical core id
+            target_core_id = INTERNAL_CONF(sc_config)->send_core_idx[i];
+            sc_util_get_logical_core_id_by_core_id(sc_config, target_core_id, &target_logical_core_id);
+
+            // calculate interval
+            record_interval = current_ns 
+                - PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_send_record_timestamp;
+            
+            // calculate #send-pkts and #drop-pkts within the pass interval,
+            // then reset metadata
+            nb_interval_send_pkt 
+                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_send_pkt;
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_send_pkt = 0;
+            nb_interval_drop_pkt 
+                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_drop_pkt;
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_drop_pkt = 0;
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_send_record_timestamp = current_ns;
+
+            // calculate throughput
+            send_throughput = ((double)nb_interval_send_pkt) / ((double)record_interval) * ((double)1000.f);
+            drop_throughput = ((double)nb_interval_drop_pkt) / ((double)record_interval) * ((double)1000.f);
+
+            overall_send_throughput += send_throughput;
+            overall_drop_throughput += drop_throughput;
+            overall_theory_throughput += send_throughput + drop_throughput;
+
+            // insert log string 
+            if(target_core_id < 10)
+                sprintf(print_title, "%s     Core %u    |", print_title, target_core_id);
+            else
+                sprintf(print_title, "%s    Core %u    |", print_title, target_core_id);
+            sprintf(print_send_statistics, "%s %lf Mpps |", print_send_statistics, send_throughput);
+            sprintf(print_drop_statistics, "%s %lf Mpps |", print_drop_statistics, drop_throughput);
+            sprintf(print_theory_statistics, "%s %lf Mpps |", print_theory_statistics, send_throughput+drop_throughput);
         }
+
+        sprintf(print_title, "%s    Overall    |", print_title);
+        sprintf(print_send_statistics, "%s %lf Mpps |", print_send_statistics, overall_send_throughput);
+        sprintf(print_drop_statistics, "%s %lf Mpps |", print_drop_statistics, overall_drop_throughput);
+        sprintf(print_theory_statistics, "%s %lf Mpps |", print_theory_statistics, overall_theory_throughput);
+
+        // print log
+        SC_LOG("Sender Throughput\n%s\n%s\n%s\n%s",
+            print_title, print_send_statistics, print_drop_statistics, print_theory_statistics);
     }
-    
-    goto process_client_exit;
 
-process_client_ready_to_exit:
-    *ready_to_exit = true;
+    return SC_SUCCESS;
+}
 
-process_client_exit:
-    return result;
+/*!
+ * \brief   callback while exiting control-plane thread (for sender)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully execution
+ */
+int _control_exit_sender(struct sc_config *sc_config, uint32_t worker_core_id){
+    return SC_ERROR_NOT_IMPLEMENTED;
 }
 
 /*!
- * \brief   callback while exiting application
- * \param   sc_config   the global configuration
- * \return  zero for successfully executing
+ * \brief   callback while entering control-plane thread (for receiver)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully initialization
  */
-int _process_exit_sender(struct sc_config *sc_config){
-    int result = SC_SUCCESS;
+int _control_enter_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
+    return SC_ERROR_NOT_IMPLEMENTED;
+}
 
-    long total_interval_sec;
-    long total_interval_usec;
+/*!
+ * \brief   callback during control-plane thread runtime (for receiver)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully execution
+ */
+int _control_infly_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
+    uint64_t i;
+    uint64_t current_ns;
+    uint64_t record_interval, nb_interval_recv_pkt;
+    uint32_t target_core_id, target_logical_core_id;
+    double recv_throughput;
+    struct sc_seq_stat seq_stat, seq_interval;
 
-    /* initialize the end_time */
-    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).end_time, NULL))){
-        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
-        return SC_ERROR_INTERNAL;
+    char print_title[2048] = {0};
+    char print_recv_statistics[2048] = {0};
+    
+    sprintf(print_title,                "| Core Index |");
+    sprintf(print_recv_statistics,      "| Recv Thrpt |");
+
+    // print statistics by first receiver core's control function
+    if(worker_core_id == INTERNAL_CONF(sc_config)->recv_core_idx[0]){
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
+            current_ns = sc_util_timestamp_ns();
+
+            // obtain both the logical and physical core id
+            target_core_id = INTERNAL_CONF(sc_config)->recv_core_idx[i];
+            sc_util_get_logical_core_id_by_core_id(sc_config, target_core_id, &target_logical_core_id);
+
+            // calculate interval
+            record_interval = current_ns 
+                - PER_CORE_APP_META_BY_CORE_ID(sc_config,target_logical_core_id).last_recv_record_timestamp;
+
+            // calculate #pkts within the pass interval
+            nb_interval_recv_pkt 
+                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_recv_pkt;
+
+            // reset metadata
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_recv_pkt = 0;
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_recv_record_timestamp = current_ns;
+
+            // calculate throughput
+            recv_throughput = ((double)nb_interval_recv_pkt) / ((double)record_interval) * ((double)1000.f);
+
+            // insert log string
+            if(target_core_id < 10)
+                sprintf(print_title, "%s     Core %u    |", print_title, target_core_id);
+            else
+                sprintf(print_title, "%s    Core %u    |", print_title, target_core_id);
+            sprintf(print_recv_statistics, "%s %lf Mpps |", print_recv_statistics, recv_throughput);
+        }
+
+        // print log
+        SC_LOG("Receiver Throughput\n%s\n%s\n", print_title, print_recv_statistics);
+
+        #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+            /* percentiles of the last interval, from the difference of merged histograms */
+            _latency_hist_merge(sc_config, &INTERNAL_CONF(sc_config)->latency_hist_merged);
+            if(SC_SUCCESS == sc_util_hdr_hist_diff(&INTERNAL_CONF(sc_config)->latency_hist_interval,
+                    &INTERNAL_CONF(sc_config)->latency_hist_merged, &INTERNAL_CONF(sc_config)->latency_hist_prev)){
+                _latency_hist_log("[interval]", &INTERNAL_CONF(sc_config)->latency_hist_interval);
+            }
+            std::swap(INTERNAL_CONF(sc_config)->latency_hist_merged, INTERNAL_CONF(sc_config)->latency_hist_prev);
+        #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+        /* losses, reordering and duplicates of the last interval */
+        if(INTERNAL_CONF(sc_config)->enable_seq){
+            _seq_stat_merge(sc_config, &seq_stat);
+            sc_util_seq_stat_diff(&seq_interval, &seq_stat, &INTERNAL_CONF(sc_config)->seq_stat_prev);
+            _seq_stat_log("[interval]", &seq_interval);
+            INTERNAL_CONF(sc_config)->seq_stat_prev = seq_stat;
+        }
     }
 
-    /* calculate the total duration */
-    total_interval_sec 
-        = PER_CORE_APP_META(sc_config).end_time.tv_sec - PER_CORE_APP_META(sc_config).start_time.tv_sec;
-    total_interval_usec 
-        = PER_CORE_APP_META(sc_config).end_time.tv_usec - PER_CORE_APP_META(sc_config).start_time.tv_usec;
-    SC_THREAD_LOG("[sender]: send %ld packets in total", PER_CORE_APP_META(sc_config).nb_send_pkt);
+    return SC_SUCCESS;
+}
 
-    SC_THREAD_LOG("[sender]: copy to payload latency: %lf", PER_CORE_APP_META(sc_config).payload_copy_latency);
+/*!
+ * \brief   callback during control-plane thread runtime (for core which both sends and receives)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully execution
+ */
+int _control_infly_sender_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
+    int result;
 
-    SC_THREAD_LOG("[sender]: send throughput: %f Gbps, %f Mpps",
-        (float)(PER_CORE_APP_META(sc_config).nb_send_pkt * INTERNAL_CONF(sc_config)->pkt_len * 8) 
-        / (float)(SC_UTIL_TIME_INTERVL_US(total_interval_sec, total_interval_usec) * 1000),
-        (float)(PER_CORE_APP_META(sc_config).nb_send_pkt)
-        / (float)(SC_UTIL_TIME_INTERVL_US(total_interval_sec, total_interval_usec))
-    );
+    uint64_t current_ns;
 
-_process_exit_exit:
-    return result;
+    result = _control_infly_sender(sc_config, worker_core_id);
+    if(result != SC_SUCCESS){ return result; }
+
+    /* receive statistics are still printed every second while the control plane ticks faster */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544
+        || INTERNAL_CONF(sc_config)->enable_slo){
+        current_ns = sc_util_timestamp_ns();
+        if(current_ns - INTERNAL_CONF(sc_config)->recv_last_print_ns < 1000000000UL){ return SC_SUCCESS; }
+        INTERNAL_CONF(sc_config)->recv_last_print_ns = current_ns;
+    }
+
+    return _control_infly_receiver(sc_config, worker_core_id);
 }
 
 /*!
- * \brief   callback while entering application
+ * \brief   callback while exiting control-plane thread (for receiver)
+ * \param   sc_config       the global configuration
+ * \param   worker_core_id  the core id of the worker
+ * \return  zero for successfully execution
+ */
+int _control_exit_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
+    return SC_ERROR_NOT_IMPLEMENTED;
+}
+
+/*!
+ * \brief   preload the replayed pcap file and prepare the rewritten addresses
  * \param   sc_config   the global configuration
- * \return  zero for successfully executing
+ * \return  zero for successfully initialization
  */
-int _process_enter_receiver(struct sc_config *sc_config){
+static int _init_pcap_replay(struct sc_config *sc_config){
     int result = SC_SUCCESS;
+    uint32_t i, nb_send_ports = INTERNAL_CONF(sc_config)->nb_send_ports;
 
-    PER_CORE_APP_META(sc_config).nb_send_pkt = 0;
-    PER_CORE_APP_META(sc_config).nb_confirmed_pkt = 0;
+    if(INTERNAL_CONF(sc_config)->nb_pcap_dst_macs > 1 && INTERNAL_CONF(sc_config)->nb_pcap_dst_macs != nb_send_ports){
+        SC_ERROR_DETAILS("number of pcap_dst_mac (%u) should be either 1 or number of send ports (%u)",
+            INTERNAL_CONF(sc_config)->nb_pcap_dst_macs, nb_send_ports);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s > 1 && INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s != nb_send_ports){
+        SC_ERROR_DETAILS("number of pcap_src_ipv4 (%u) should be either 1 or number of send ports (%u)",
+            INTERNAL_CONF(sc_config)->nb_pcap_src_ipv4s, nb_send_ports);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s > 1 && INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s != nb_send_ports){
+        SC_ERROR_DETAILS("number of pcap_dst_ipv4 (%u) should be either 1 or number of send ports (%u)",
+            INTERNAL_CONF(sc_config)->nb_pcap_dst_ipv4s, nb_send_ports);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(INTERNAL_CONF(sc_config)->pcap_replay_mode == SC_PCAP_REPLAY_SCALED
+        && INTERNAL_CONF(sc_config)->pcap_replay_speed <= 0){
+        SC_ERROR_DETAILS("pcap_replay_speed should be specified under scaled replay mode");
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-    /* allocate array for pointers to storing received pkt_bufs */
-    PER_CORE_APP_META(sc_config).recv_pkt_bufs = (struct rte_mbuf **)rte_malloc(NULL, 
-        sizeof(struct rte_mbuf*)*SC_MAX_RX_PKT_BURST*2, 0);
-    if(unlikely(!PER_CORE_APP_META(sc_config).recv_pkt_bufs)){
-        SC_THREAD_ERROR_DETAILS("failed to allocate memory for recv_pkt_bufs");
-        result = SC_ERROR_MEMORY;
-        goto _process_enter_receiver_exit;
+    /* source mac address of replayed frames is the mac of the send port */
+    for(i=0; i<nb_send_ports; i++){
+        if(rte_ether_unformat_addr(INTERNAL_CONF(sc_config)->send_port_mac_address[i], 
+                &INTERNAL_CONF(sc_config)->send_port_mac[i]) != 0){
+            SC_ERROR_DETAILS("invalid send port mac %s", INTERNAL_CONF(sc_config)->send_port_mac_address[i]);
+            return SC_ERROR_INVALID_VALUE;
+        }
     }
 
-    /* initialize the start_time */
-    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).start_time, NULL))){
-        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
-        result =  SC_ERROR_INTERNAL;
-        goto _process_enter_receiver_exit;
+    INTERNAL_CONF(sc_config)->pcap_traces = (struct sc_pcap_trace*)rte_malloc(NULL, 
+        sizeof(struct sc_pcap_trace)*INTERNAL_CONF(sc_config)->nb_send_cores, 0);
+    if(unlikely(!INTERNAL_CONF(sc_config)->pcap_traces)){
+        SC_ERROR_DETAILS("failed to allocate memory for pcap_traces");
+        return SC_ERROR_MEMORY;
+    }
+
+    result = sc_util_pcap_load(
+        /* file_path */ INTERNAL_CONF(sc_config)->pcap_file,
+        /* nb_traces */ INTERNAL_CONF(sc_config)->nb_send_cores,
+        /* traces */ INTERNAL_CONF(sc_config)->pcap_traces,
+        /* mp */ &INTERNAL_CONF(sc_config)->pcap_mp,
+        /* duration_ns */ &INTERNAL_CONF(sc_config)->pcap_duration_ns
+    );
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to load pcap file %s", INTERNAL_CONF(sc_config)->pcap_file);
+        rte_free(INTERNAL_CONF(sc_config)->pcap_traces);
+        INTERNAL_CONF(sc_config)->pcap_traces = NULL;
     }
 
-_process_enter_receiver_exit:
     return result;
 }
 
 /*!
- * \brief   callback for client logic
- * \param   sc_config       the global configuration
- * \param   queue_id        the index of the queue for current core to tx/rx packet
- * \param   ready_to_exit   indicator for exiting worker loop
- * \return  zero for successfully executing
+ * \brief   validate closed-loop configuration, and create completion ring of each send core
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
  */
-int _process_client_receiver(struct sc_config *sc_config, uint16_t queue_id, bool *ready_to_exit){
-    int i, j, k, nb_rx = 0, nb_recv_pkt = 0, result = SC_SUCCESS;
-    struct sc_timestamp_table *payload_timestamp;
-    uint64_t current_ns;
+static int _init_closed_loop(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint32_t i, max_window = 0;
+    uint64_t ring_size;
+    char ring_name[RTE_RING_NAMESIZE];
 
-    for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_ports; i++){
-        memset(PER_CORE_APP_META(sc_config).recv_pkt_bufs, 0, sizeof(struct rte_mbuf*)*SC_MAX_RX_PKT_BURST*2);
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_proto_stack
+        || INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+        SC_ERROR_DETAILS("closed-loop mode couldn't be used together with pcap_file, proto_stack or flow_popularity");
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-        nb_recv_pkt = rte_eth_rx_burst(
-            /* port_id */ INTERNAL_CONF(sc_config)->recv_port_idx[i], 
-            /* queue_id */ queue_id, 
-            /* rx_pkts */ PER_CORE_APP_META(sc_config).recv_pkt_bufs, 
-            /* nb_pkts */ SC_MAX_RX_PKT_BURST
-        );
+    if(INTERNAL_CONF(sc_config)->nb_flow_per_core > UINT32_MAX){
+        SC_ERROR_DETAILS("too many flows (%lu) under closed-loop mode", INTERNAL_CONF(sc_config)->nb_flow_per_core);
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-        /* record the receiving timestamp */
-        current_ns = sc_util_timestamp_ns();
+    /* request carries the closed-loop tag right after the timestamp table */
+    if((INTERNAL_CONF(sc_config)->enable_pkt_size_dist 
+            ? INTERNAL_CONF(sc_config)->pkt_size_dist.min_size : INTERNAL_CONF(sc_config)->pkt_len)
+        < sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+            + sizeof(struct sc_timestamp_table) + sizeof(struct _closed_loop_tag)){
+        SC_ERROR_DETAILS("packet length should be no less than %lu under closed-loop mode",
+            sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+            + sizeof(struct sc_timestamp_table) + sizeof(struct _closed_loop_tag));
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-        if(nb_recv_pkt == 0) { continue; }
-        
-        PER_CORE_APP_META(sc_config).nb_confirmed_pkt += nb_recv_pkt;
-        PER_CORE_APP_META(sc_config).nb_interval_recv_pkt += nb_recv_pkt;
-        
-        for(j=0; j<nb_recv_pkt; j++) {
-            /* extract the timestamp struct */
-            payload_timestamp = rte_pktmbuf_mtod_offset(
-                PER_CORE_APP_META(sc_config).recv_pkt_bufs[j], struct sc_timestamp_table*, 
-                sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
-            );
-            
-            /* skip wrong payload packet */
-            if(unlikely(payload_timestamp->timestamp_type != SC_TIMESTAMP_FULL_TYPE)){
-                continue;
-            }
+    /* a single window of 1 request per flow by default */
+    if(INTERNAL_CONF(sc_config)->nb_cl_levels == 0){
+        INTERNAL_CONF(sc_config)->nb_cl_levels = 1;
+        INTERNAL_CONF(sc_config)->cl_windows[0] = 1;
+    }
+    if(INTERNAL_CONF(sc_config)->cl_level_duration_ms == 0){
+        INTERNAL_CONF(sc_config)->cl_level_duration_ms = 1000;
+    }
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_cl_levels; i++){
+        max_window = RTE_MAX(max_window, INTERNAL_CONF(sc_config)->cl_windows[i]);
+    }
 
-            #if defined(SC_ECHO_CLIENT_GET_LATENCY)
-                /* add receive timestamp to the timestamp table */
-                sc_util_add_full_timestamp(payload_timestamp, current_ns);
-
-                /* copy the timestamp table to local collection */                
-                rte_memcpy(
-                    /* dst */ PER_CORE_APP_META(sc_config).ts_tables 
-                        + PER_CORE_APP_META(sc_config).ts_tables_pointer,
-                    /* src */ payload_timestamp,
-                    /* size */ sizeof(struct sc_timestamp_table)
-                );
+    /* the ring could hold completions of all outstanding requests of the send core */
+    ring_size = RTE_MIN(
+        (uint64_t)max_window * INTERNAL_CONF(sc_config)->nb_flow_per_core + SC_MAX_RX_PKT_BURST, (uint64_t)RTE_RING_SZ_MASK);
+    ring_size = rte_align64pow2(ring_size);
 
-                PER_CORE_APP_META(sc_config).ts_tables_pointer += 1;
-                if(PER_CORE_APP_META(sc_config).ts_tables_pointer == SC_ECHO_CLIENT_NB_TS_TABLE){
-                    PER_CORE_APP_META(sc_config).ts_tables_pointer = 0;
-                }
-                if(PER_CORE_APP_META(sc_config).nb_ts_tables < SC_ECHO_CLIENT_NB_TS_TABLE){
-                    PER_CORE_APP_META(sc_config).nb_ts_tables += 1;
-                }
-            #endif defined(SC_ECHO_CLIENT_GET_LATENCY)
+    INTERNAL_CONF(sc_config)->cl_rings = (struct rte_ring**)rte_zmalloc(NULL, 
+        sizeof(struct rte_ring*)*INTERNAL_CONF(sc_config)->nb_send_cores, 0);
+    if(unlikely(!INTERNAL_CONF(sc_config)->cl_rings)){
+        SC_ERROR_DETAILS("failed to allocate memory for closed-loop rings");
+        return SC_ERROR_MEMORY;
+    }
 
-free_recv_pkt_mbuf:
-            /* return back recv pkt_mbuf */
-            rte_pktmbuf_free(PER_CORE_APP_META(sc_config).recv_pkt_bufs[j]); 
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+        sprintf(ring_name, "sc_cl_ring_%u", i);
+        /* multiple receive cores enqueue, the single send core dequeues */
+        INTERNAL_CONF(sc_config)->cl_rings[i] = rte_ring_create(
+            /* name */ ring_name,
+            /* count */ (unsigned)ring_size,
+            /* socket_id */ rte_socket_id(),
+            /* flags */ RING_F_SC_DEQ
+        );
+        if(unlikely(!INTERNAL_CONF(sc_config)->cl_rings[i])){
+            SC_ERROR_DETAILS("failed to create closed-loop ring for send core %u: %s", i, rte_strerror(rte_errno));
+            result = SC_ERROR_MEMORY;
+            goto _init_closed_loop_exit;
         }
     }
 
-    goto process_client_receiver_exit;
-
-process_client_receiver_ready_to_exit:
-    *ready_to_exit = true;
+    SC_LOG("closed-loop mode: %u concurrency level(s), %lu ms per level, think time %lu us, timeout %lu us",
+        INTERNAL_CONF(sc_config)->nb_cl_levels, INTERNAL_CONF(sc_config)->cl_level_duration_ms,
+        INTERNAL_CONF(sc_config)->cl_think_time_us, INTERNAL_CONF(sc_config)->cl_timeout_us);
 
-process_client_receiver_exit:
+_init_closed_loop_exit:
     return result;
 }
 
 /*!
- * \brief   callback while exiting application
+ * \brief   validate per-flow sequence tracking
  * \param   sc_config   the global configuration
- * \return  zero for successfully executing
+ * \return  zero for successfully initialization
  */
-int _process_exit_receiver(struct sc_config *sc_config){
-    /* initialize the end_time */
-    if(unlikely(-1 == gettimeofday(&PER_CORE_APP_META(sc_config).end_time, NULL))){
-        SC_THREAD_ERROR_DETAILS("failed to obtain current time");
-        return SC_ERROR_INTERNAL;
+static int _init_seq(struct sc_config *sc_config){
+    uint32_t i, min_pkt_len;
+
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_proto_stack
+        || INTERNAL_CONF(sc_config)->enable_closed_loop || INTERNAL_CONF(sc_config)->enable_kv){
+        SC_ERROR_DETAILS("enable_seq couldn't be used together with pcap_file, proto_stack, closed-loop mode or kv_workload");
+        return SC_ERROR_INVALID_VALUE;
     }
 
-    SC_THREAD_LOG("[receiver] confirmed pkt: %lu", PER_CORE_APP_META(sc_config).nb_confirmed_pkt);
+    /* modified fields spread a flow across receive queues, whose windows are tracked separately */
+    if(INTERNAL_CONF(sc_config)->enable_field_mod && INTERNAL_CONF(sc_config)->nb_recv_cores > 1){
+        SC_ERROR_DETAILS("enable_seq couldn't be used together with field_modifiers under multiple receive cores");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    if(INTERNAL_CONF(sc_config)->nb_flow_per_core > UINT32_MAX || INTERNAL_CONF(sc_config)->nb_send_cores > UINT16_MAX){
+        SC_ERROR_DETAILS("too many flows (%lu) or send cores (%u) for sequence tracking",
+            INTERNAL_CONF(sc_config)->nb_flow_per_core, INTERNAL_CONF(sc_config)->nb_send_cores);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* packet carries the sequence tag right after the timestamp table */
+    min_pkt_len = INTERNAL_CONF(sc_config)->enable_pkt_size_dist 
+        ? INTERNAL_CONF(sc_config)->pkt_size_dist.min_size : INTERNAL_CONF(sc_config)->pkt_len;
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544){
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_rfc2544_sizes; i++){
+            min_pkt_len = RTE_MIN(min_pkt_len, INTERNAL_CONF(sc_config)->rfc2544_sizes[i]);
+        }
+    }
+    if(min_pkt_len < sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+            + sizeof(struct sc_timestamp_table) + sizeof(struct _seq_tag)){
+        SC_ERROR_DETAILS("packet length should be no less than %lu under sequence tracking",
+            sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+            + sizeof(struct sc_timestamp_table) + sizeof(struct _seq_tag));
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    SC_LOG("per-flow sequence tracking: %u send core(s) x %lu flow(s), reorder window of %u packets, "
+        "%lu bytes of receive windows per receive core",
+        INTERNAL_CONF(sc_config)->nb_send_cores, INTERNAL_CONF(sc_config)->nb_flow_per_core, SC_SEQ_WINDOW_LEN,
+        sizeof(struct sc_seq_window) * INTERNAL_CONF(sc_config)->nb_send_cores * INTERNAL_CONF(sc_config)->nb_flow_per_core);
 
     return SC_SUCCESS;
 }
 
 /*!
- * \brief   callback while all worker thread exit
+ * \brief   validate server-side stage stamps
  * \param   sc_config   the global configuration
- * \return  zero for successfully executing
+ * \return  zero for successfully initialization
  */
-int _worker_all_exit(struct sc_config *sc_config){
-    int result = SC_SUCCESS;
-    uint8_t nb_timestamp = 0;
-    uint32_t i, j, k;
-    struct sc_timestamp_table* sc_ts;
-    size_t nb_send_pkt = 0, nb_confirmed_pkt = 0;
-    double per_core_avg_latency, per_core_payload_copy_latency, all_core_avg_latency;
-    long worker_max_interval_sec = 0, worker_max_interval_usec = 0;
-    char profiling_file_name[512] = {0};
-    FILE * fp;
+static int _init_stage_stamps(struct sc_config *sc_config){
+    uint32_t i, min_pkt_len, min_required_len;
 
-    /* calculate the average payload copy latency to fix the RTT statistic */
-    per_core_payload_copy_latency = (double)0.0f;
-    for(i=0; i<sc_config->nb_used_cores; i++){
-        per_core_payload_copy_latency += (double)PER_CORE_APP_META_BY_CORE_ID(sc_config, i).payload_copy_latency;
-        per_core_payload_copy_latency /= (double)2.0f;
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_proto_stack
+        || INTERNAL_CONF(sc_config)->enable_kv){
+        SC_ERROR_DETAILS("server_stage_stamps couldn't be used together with pcap_file, proto_stack or kv_workload");
+        return SC_ERROR_INVALID_VALUE;
     }
 
-    // record latency data
-    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
-        sprintf(profiling_file_name, "latency.txt");
-        fp = fopen(profiling_file_name, "w");
-        if (!fp) {
-            SC_ERROR("failed to create/open log file to store latency statistics");
-            result = SC_ERROR_INTERNAL;
-            goto worker_all_exit_exit;
-        }
-        for(i=sc_config->nb_used_cores/2; i<sc_config->nb_used_cores; i++){
-            for(j=0; j<PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_ts_tables; j++){
-                sc_ts = &(PER_CORE_APP_META_BY_CORE_ID(sc_config, i).ts_tables[j]);
-                fprintf(
-                    /* fd */ fp, "%u\t%lu\t%lu\n", 
-                    /* core_id */ i,
-                    /* t1 */ sc_util_get_full_timestamp(sc_ts, 0),
-                    /* t2 */ sc_util_get_full_timestamp(sc_ts, 1)
-                );
-            }
+    /* the trailer shouldn't overlap the timestamp table and the tags following it */
+    min_required_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+        + sizeof(struct sc_timestamp_table) + sizeof(struct sc_stage_trailer);
+    if(INTERNAL_CONF(sc_config)->enable_seq){ min_required_len += sizeof(struct _seq_tag); }
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){ min_required_len += sizeof(struct _closed_loop_tag); }
+
+    min_pkt_len = INTERNAL_CONF(sc_config)->enable_pkt_size_dist 
+        ? INTERNAL_CONF(sc_config)->pkt_size_dist.min_size : INTERNAL_CONF(sc_config)->pkt_len;
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544){
+        for(i=0; i<INTERNAL_CONF(sc_config)->nb_rfc2544_sizes; i++){
+            min_pkt_len = RTE_MIN(min_pkt_len, INTERNAL_CONF(sc_config)->rfc2544_sizes[i]);
         }
-    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
-
-    for(i=0; i<sc_config->nb_used_cores; i++){
-        /* reduce number of packet */
-        nb_send_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_send_pkt;
-        nb_confirmed_pkt += PER_CORE_APP_META_BY_CORE_ID(sc_config, i).nb_confirmed_pkt;
     }
-    SC_LOG("[TOTAL] number of send packet: %ld, number of confirm packet: %ld",
-        nb_send_pkt, nb_confirmed_pkt
-    );
-
-    /* record maximum duration */
-    for(i=0; i<sc_config->nb_used_cores; i++){
-        long interval_sec, interval_usec;
-        interval_sec
-            = PER_CORE_APP_META_BY_CORE_ID(sc_config, i).end_time.tv_sec 
-            - PER_CORE_APP_META_BY_CORE_ID(sc_config, i).start_time.tv_sec;
-        interval_usec
-            = PER_CORE_APP_META_BY_CORE_ID(sc_config, i).end_time.tv_usec 
-            - PER_CORE_APP_META_BY_CORE_ID(sc_config, i).start_time.tv_usec;
-        if(SC_UTIL_TIME_INTERVL_US(interval_sec, interval_usec) >
-                SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec)){
-            worker_max_interval_sec = interval_sec;
-            worker_max_interval_usec = interval_usec;
-        }
+    if(min_pkt_len < min_required_len){
+        SC_ERROR_DETAILS("packet length should be no less than %u under server-side stage stamps", min_required_len);
+        return SC_ERROR_INVALID_VALUE;
     }
 
-    SC_THREAD_LOG("[TOTAL] duration: %lu us",
-        SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec)
-    );
-    SC_THREAD_LOG("[TOTAL] packet length: %u bytes",
-        INTERNAL_CONF(sc_config)->pkt_len
-    );
-    SC_THREAD_LOG("[TOTAL] send throughput: %f Gbps",
-        (float)(nb_send_pkt * INTERNAL_CONF(sc_config)->pkt_len * 8) 
-        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec) * 1000)
-    );
-    SC_THREAD_LOG("[TOTAL] confirm throughput: %f Gbps",
-        (float)(nb_confirmed_pkt * INTERNAL_CONF(sc_config)->pkt_len * 8) 
-        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec) * 1000)
-    );
-    SC_THREAD_LOG("[TOTAL] send throughput: %f Mpps",
-        (float)(nb_send_pkt) 
-        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec))
-    );
-    SC_THREAD_LOG("[TOTAL] confirm throughput: %f Mpps",
-        (float)(nb_confirmed_pkt) 
-        / (float)(SC_UTIL_TIME_INTERVL_US(worker_max_interval_sec, worker_max_interval_usec))
-    );
+    SC_LOG("server-side stage stamps: %lu bytes of trailer at the end of each packet, "
+        "the server should be started with enable_stage_stamps", sizeof(struct sc_stage_trailer));
 
-worker_all_exit_exit:
     return SC_SUCCESS;
 }
 
 /*!
- * \brief   callback while entering control-plane thread (for sender)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
+ * \brief   validate the kv workload, create the workload and in-flight tables of send cores
+ * \param   sc_config   the global configuration
  * \return  zero for successfully initialization
  */
-int _control_enter_sender(struct sc_config *sc_config, uint32_t worker_core_id){
-    return SC_ERROR_NOT_IMPLEMENTED;
-}
+static int _init_kv(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint8_t op;
+    uint32_t i, hdr_len, max_pkt_len;
+    struct sc_kv_workload *workload = &INTERNAL_CONF(sc_config)->kv_workload;
+    uint64_t prev = 0;
+
+    /* requests are carried by the default ipv4/udp packets of the open-loop sender */
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack || INTERNAL_CONF(sc_config)->pcap_file
+        || INTERNAL_CONF(sc_config)->enable_closed_loop || INTERNAL_CONF(sc_config)->enable_pkt_size_dist
+        || INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544){
+        SC_ERROR_DETAILS("kv_workload couldn't be used together with proto_stack, pcap_file, closed-loop mode, "
+            "pkt_size_dist, load_schedule or rfc2544");
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-/*!
- * \brief   callback during control-plane thread runtime (for sender)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
- * \return  zero for successfully execution
- */
-int _control_infly_sender(struct sc_config *sc_config, uint32_t worker_core_id){
-    uint64_t i;
-    uint64_t current_ns;
-    uint64_t record_interval, nb_interval_send_pkt, nb_interval_drop_pkt;
-    uint32_t target_core_id, target_logical_core_id;
-    double send_throughput, drop_throughput;
-    double overall_send_throughput=0.0f, overall_drop_throughput=0.0f, overall_theory_throughput=0.0f;
+    /* defaults of the key space and request shape */
+    if(INTERNAL_CONF(sc_config)->kv_conf.nb_keys == 0){
+        INTERNAL_CONF(sc_config)->kv_conf.nb_keys = 1000000;
+    }
+    if(INTERNAL_CONF(sc_config)->kv_conf.key_len == 0){
+        INTERNAL_CONF(sc_config)->kv_conf.key_len = 16;
+    }
+    if(INTERNAL_CONF(sc_config)->kv_conf.value_len == 0){
+        INTERNAL_CONF(sc_config)->kv_conf.value_len = 100;
+    }
+    if(INTERNAL_CONF(sc_config)->kv_conf.zipf_skew == 0){
+        INTERNAL_CONF(sc_config)->kv_conf.zipf_skew = 0.99;
+    }
+    if(INTERNAL_CONF(sc_config)->kv_conf.max_scan_len == 0){
+        INTERNAL_CONF(sc_config)->kv_conf.max_scan_len = 100;
+    }
 
-    char print_title[2048] = {0};
-    char print_send_statistics[2048] = {0};
-    char print_drop_statistics[2048] = {0};
-    char print_theory_statistics[2048] = {0};
-    
-    sprintf(print_title,                "| Core Index |");
-    sprintf(print_send_statistics,      "| Send Thrpt |");
-    sprintf(print_drop_statistics,      "| Drop Thrpt |");
-    sprintf(print_theory_statistics,    "| Theo Thrpt |");
+    /* the request header and the key are written into the first segment */
+    hdr_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+        + sizeof(struct sc_timestamp_table) + sizeof(struct sc_kv_req_hdr);
+    max_pkt_len = hdr_len + INTERNAL_CONF(sc_config)->kv_conf.key_len;
+    if((uint64_t)max_pkt_len + INTERNAL_CONF(sc_config)->kv_conf.value_len > RTE_ETHER_MAX_JUMBO_FRAME_LEN
+        || max_pkt_len > RTE_MBUF_DEFAULT_DATAROOM){
+        SC_ERROR_DETAILS("kv request with key of %u bytes and value of %u bytes exceeds the maximum packet length %u",
+            INTERNAL_CONF(sc_config)->kv_conf.key_len, INTERNAL_CONF(sc_config)->kv_conf.value_len,
+            RTE_ETHER_MAX_JUMBO_FRAME_LEN);
+        return SC_ERROR_INVALID_VALUE;
+    }
 
-    // print statistics by first sender core's control function
-    if(worker_core_id == INTERNAL_CONF(sc_config)->send_core_idx[0]){
-        for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
-            current_ns = sc_util_timestamp_ns();
+    result = sc_util_kv_workload_create(workload, &INTERNAL_CONF(sc_config)->kv_conf);
+    if(unlikely(result != SC_SUCCESS)){
+        SC_ERROR_DETAILS("failed to create kv workload");
+        return result;
+    }
 
-            // obtain both the logical and physical core id
-            target_core_id = INTERNAL_CONF(sc_config)->send_core_idx[i];
-            sc_util_get_logical_core_id_by_core_id(sc_config, target_core_id, &target_logical_core_id);
+    INTERNAL_CONF(sc_config)->kv_inflight = (struct _kv_inflight**)rte_zmalloc(NULL,
+        sizeof(struct _kv_inflight*)*INTERNAL_CONF(sc_config)->nb_send_cores, 0);
+    if(unlikely(!INTERNAL_CONF(sc_config)->kv_inflight)){
+        SC_ERROR_DETAILS("failed to allocate memory for in-flight kv requests");
+        result = SC_ERROR_MEMORY;
+        goto _init_kv_exit;
+    }
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+        INTERNAL_CONF(sc_config)->kv_inflight[i] = (struct _kv_inflight*)rte_zmalloc(NULL,
+            sizeof(struct _kv_inflight)*SC_ECHO_CLIENT_KV_NB_INFLIGHT, 0);
+        if(unlikely(!INTERNAL_CONF(sc_config)->kv_inflight[i])){
+            SC_ERROR_DETAILS("failed to allocate memory for in-flight kv requests of send core %u", i);
+            result = SC_ERROR_MEMORY;
+            goto _init_kv_exit;
+        }
+    }
 
-            // calculate interval
-            record_interval = current_ns 
-                - PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_send_record_timestamp;
-            
-            // calculate #send-pkts and #drop-pkts within the pass interval,
-            // then reset metadata
-            nb_interval_send_pkt 
-                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_send_pkt;
-            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_send_pkt = 0;
-            nb_interval_drop_pkt 
-                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_drop_pkt;
-            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_drop_pkt = 0;
-            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_send_record_timestamp = current_ns;
+    /* packet length varies with whether the request carries a value */
+    INTERNAL_CONF(sc_config)->mean_pkt_len = 0;
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+        INTERNAL_CONF(sc_config)->mean_pkt_len += (double)(workload->op_thresholds[op] - prev) / 4294967296.0
+            * (double)(hdr_len - sizeof(struct sc_kv_req_hdr) + sc_util_kv_req_len(workload, sc_util_kv_op_has_value(op)));
+        prev = workload->op_thresholds[op];
+    }
 
-            // calculate throughput
-            send_throughput = ((double)nb_interval_send_pkt) / ((double)record_interval) * ((double)1000.f);
-            drop_throughput = ((double)nb_interval_drop_pkt) / ((double)record_interval) * ((double)1000.f);
+    sc_util_kv_workload_print(workload);
+    SC_LOG("pkt_len is overwritten by the length of kv requests (mean: %lf bytes)",
+        INTERNAL_CONF(sc_config)->mean_pkt_len);
 
-            overall_send_throughput += send_throughput;
-            overall_drop_throughput += drop_throughput;
-            overall_theory_throughput += send_throughput + drop_throughput;
+_init_kv_exit:
+    if(result != SC_SUCCESS){
+        if(INTERNAL_CONF(sc_config)->kv_inflight){
+            for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_cores; i++){
+                if(INTERNAL_CONF(sc_config)->kv_inflight[i]) rte_free(INTERNAL_CONF(sc_config)->kv_inflight[i]);
+            }
+            rte_free(INTERNAL_CONF(sc_config)->kv_inflight);
+            INTERNAL_CONF(sc_config)->kv_inflight = NULL;
+        }
+        sc_util_kv_workload_free(workload);
+    }
+    return result;
+}
 
-            // insert log string 
-            if(target_core_id < 10)
-                sprintf(print_title, "%s     Core %u    |", print_title, target_core_id);
-            else
-                sprintf(print_title, "%s    Core %u    |", print_title, target_core_id);
-            sprintf(print_send_statistics, "%s %lf Mpps |", print_send_statistics, send_throughput);
-            sprintf(print_drop_statistics, "%s %lf Mpps |", print_drop_statistics, drop_throughput);
-            sprintf(print_theory_statistics, "%s %lf Mpps |", print_theory_statistics, send_throughput+drop_throughput);
+/*!
+ * \brief   validate the load schedule against other configurations
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
+ */
+static int _init_load_schedule(struct sc_config *sc_config){
+    uint32_t i;
+    uint64_t min_pkt_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) 
+                            + sizeof(struct rte_udp_hdr) + sizeof(struct sc_timestamp_table);
+    struct sc_load_phase *phase;
+
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_closed_loop){
+        SC_ERROR_DETAILS("load_schedule couldn't be used together with pcap_file or closed-loop mode");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    for(i=0; i<INTERNAL_CONF(sc_config)->load_schedule.nb_phases; i++){
+        phase = &INTERNAL_CONF(sc_config)->load_schedule.phases[i];
+
+        /* flows are sampled per packet while flow population is enabled */
+        if(phase->nb_flows > 0 && INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+            SC_ERROR_DETAILS("flows of phase %u couldn't be used together with flow_popularity", i);
+            return SC_ERROR_INVALID_VALUE;
         }
 
-        sprintf(print_title, "%s    Overall    |", print_title);
-        sprintf(print_send_statistics, "%s %lf Mpps |", print_send_statistics, overall_send_throughput);
-        sprintf(print_drop_statistics, "%s %lf Mpps |", print_drop_statistics, overall_drop_throughput);
-        sprintf(print_theory_statistics, "%s %lf Mpps |", print_theory_statistics, overall_theory_throughput);
+        if(!phase->enable_pkt_size_dist){ continue; }
+
+        if(INTERNAL_CONF(sc_config)->enable_proto_stack){
+            SC_ERROR_DETAILS("pkt_mix of phase %u couldn't be used together with proto_stack", i);
+            return SC_ERROR_INVALID_VALUE;
+        }
 
-        // print log
-        SC_LOG("Sender Throughput\n%s\n%s\n%s\n%s",
-            print_title, print_send_statistics, print_drop_statistics, print_theory_statistics);
+        if(phase->pkt_size_dist.min_size < min_pkt_len || phase->pkt_size_dist.max_size > RTE_ETHER_MAX_JUMBO_FRAME_LEN){
+            SC_ERROR_DETAILS("packet sizes of pkt_mix of phase %u should be within [%lu, %u]",
+                i, min_pkt_len, RTE_ETHER_MAX_JUMBO_FRAME_LEN);
+            return SC_ERROR_INVALID_VALUE;
+        }
     }
 
-    return SC_SUCCESS;
-}
+    /* start time of each phase, and the end of the schedule */
+    INTERNAL_CONF(sc_config)->sched_phase_start_ns = (uint64_t*)rte_zmalloc(NULL,
+        sizeof(uint64_t)*(INTERNAL_CONF(sc_config)->load_schedule.nb_phases+1), 0);
+    if(unlikely(!INTERNAL_CONF(sc_config)->sched_phase_start_ns)){
+        SC_ERROR_DETAILS("failed to allocate memory for start time of phases");
+        return SC_ERROR_MEMORY;
+    }
 
-/*!
- * \brief   callback while exiting control-plane thread (for sender)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
- * \return  zero for successfully execution
- */
-int _control_exit_sender(struct sc_config *sc_config, uint32_t worker_core_id){
-    return SC_ERROR_NOT_IMPLEMENTED;
+    sc_util_load_schedule_print(&INTERNAL_CONF(sc_config)->load_schedule);
+
+    return SC_SUCCESS;
 }
 
 /*!
- * \brief   callback while entering control-plane thread (for receiver)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
+ * \brief   check that no queue is owned by more than one send / receive core,
+ *          then record send and receive cores along with their ranks
+ * \note    queue of each core follows the assignment of the worker loop
+ * \param   sc_config   the global configuration
  * \return  zero for successfully initialization
  */
-int _control_enter_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
-    return SC_ERROR_NOT_IMPLEMENTED;
-}
+static int _init_core_roles(struct sc_config *sc_config){
+    int result = SC_SUCCESS;
+    uint32_t i, queue_id, core_id, nb_send_cores = 0, nb_recv_cores = 0;
+    uint32_t *tx_owner = NULL, *rx_owner = NULL;
+    uint8_t role;
+
+    INTERNAL_CONF(sc_config)->send_core_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores, 0);
+    INTERNAL_CONF(sc_config)->recv_core_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores, 0);
+    INTERNAL_CONF(sc_config)->send_core_logical_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores, 0);
+    INTERNAL_CONF(sc_config)->recv_core_logical_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores, 0);
+    tx_owner = (uint32_t*)malloc(sizeof(uint32_t)*sc_config->nb_tx_rings_per_port);
+    rx_owner = (uint32_t*)malloc(sizeof(uint32_t)*sc_config->nb_rx_rings_per_port);
+    if(unlikely(!INTERNAL_CONF(sc_config)->send_core_idx || !INTERNAL_CONF(sc_config)->recv_core_idx
+        || !INTERNAL_CONF(sc_config)->send_core_logical_idx || !INTERNAL_CONF(sc_config)->recv_core_logical_idx
+        || !tx_owner || !rx_owner)){
+        SC_ERROR_DETAILS("failed to allocate memory for core dispatching");
+        result = SC_ERROR_MEMORY;
+        goto _init_core_roles_exit;
+    }
+    memset(tx_owner, 0xff, sizeof(uint32_t)*sc_config->nb_tx_rings_per_port);
+    memset(rx_owner, 0xff, sizeof(uint32_t)*sc_config->nb_rx_rings_per_port);
 
-/*!
- * \brief   callback during control-plane thread runtime (for receiver)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
- * \return  zero for successfully execution
- */
-int _control_infly_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
-    uint64_t i;
-    uint64_t current_ns;
-    uint64_t record_interval, nb_interval_recv_pkt;
-    uint32_t target_core_id, target_logical_core_id;
-    double recv_throughput;
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        role = INTERNAL_CONF(sc_config)->core_roles[i];
+        queue_id = i % sc_config->nb_rx_rings_per_port;
 
-    char print_title[2048] = {0};
-    char print_recv_statistics[2048] = {0};
-    
-    sprintf(print_title,                "| Core Index |");
-    sprintf(print_recv_statistics,      "| Recv Thrpt |");
+        // obtain the physical core id
+        result = sc_util_get_core_id_by_logical_core_id(sc_config, i, &core_id);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to get core id by logical core id %u", i);
+            goto _init_core_roles_exit;
+        }
 
-    // print statistics by first receiver core's control function
-    if(worker_core_id == INTERNAL_CONF(sc_config)->recv_core_idx[0]){
-        for(i=0; i<INTERNAL_CONF(sc_config)->nb_recv_cores; i++){
-            current_ns = sc_util_timestamp_ns();
+        if(role & SC_ECHO_CLIENT_ROLE_SEND){
+            if(queue_id >= sc_config->nb_tx_rings_per_port){
+                SC_ERROR_DETAILS("core %u sends through tx queue %u, but only %u tx queues are configured",
+                    core_id, queue_id, sc_config->nb_tx_rings_per_port);
+                result = SC_ERROR_INVALID_VALUE;
+                goto _init_core_roles_exit;
+            }
+            if(tx_owner[queue_id] != UINT32_MAX){
+                SC_ERROR_DETAILS("both core %u and core %u send through tx queue %u", tx_owner[queue_id], core_id, queue_id);
+                result = SC_ERROR_INVALID_VALUE;
+                goto _init_core_roles_exit;
+            }
+            tx_owner[queue_id] = core_id;
 
-            // obtain both the logical and physical core id
-            target_core_id = INTERNAL_CONF(sc_config)->recv_core_idx[i];
-            sc_util_get_logical_core_id_by_core_id(sc_config, target_core_id, &target_logical_core_id);
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, i).send_rank = nb_send_cores;
+            INTERNAL_CONF(sc_config)->send_core_idx[nb_send_cores] = core_id;
+            INTERNAL_CONF(sc_config)->send_core_logical_idx[nb_send_cores] = i;
+            nb_send_cores += 1;
+        }
 
-            // calculate interval
-            record_interval = current_ns 
-                - PER_CORE_APP_META_BY_CORE_ID(sc_config,target_logical_core_id).last_recv_record_timestamp;
+        if(role & SC_ECHO_CLIENT_ROLE_RECV){
+            if(rx_owner[queue_id] != UINT32_MAX){
+                SC_ERROR_DETAILS("both core %u and core %u poll rx queue %u", rx_owner[queue_id], core_id, queue_id);
+                result = SC_ERROR_INVALID_VALUE;
+                goto _init_core_roles_exit;
+            }
+            rx_owner[queue_id] = core_id;
 
-            // calculate #pkts within the pass interval
-            nb_interval_recv_pkt 
-                = PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_recv_pkt;
+            PER_CORE_APP_META_BY_CORE_ID(sc_config, i).recv_rank = nb_recv_cores;
+            INTERNAL_CONF(sc_config)->recv_core_idx[nb_recv_cores] = core_id;
+            INTERNAL_CONF(sc_config)->recv_core_logical_idx[nb_recv_cores] = i;
+            nb_recv_cores += 1;
+        }
 
-            // reset metadata
-            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).nb_interval_recv_pkt = 0;
-            PER_CORE_APP_META_BY_CORE_ID(sc_config, target_logical_core_id).last_recv_record_timestamp = current_ns;
+        PER_CORE_APP_META_BY_CORE_ID(sc_config, i).role = role;
+        SC_LOG("core %u: %s on queue %u", core_id,
+            role == SC_ECHO_CLIENT_ROLE_SEND ? "send" : (role == SC_ECHO_CLIENT_ROLE_RECV ? "recv" : "send_recv"),
+            queue_id);
+    }
 
-            // calculate throughput
-            recv_throughput = ((double)nb_interval_recv_pkt) / ((double)record_interval) * ((double)1000.f);
+    if(nb_send_cores == 0 || nb_recv_cores == 0){
+        SC_ERROR_DETAILS("at least one send core and one receive core are required");
+        result = SC_ERROR_INVALID_VALUE;
+        goto _init_core_roles_exit;
+    }
 
-            // insert log string
-            if(target_core_id < 10)
-                sprintf(print_title, "%s     Core %u    |", print_title, target_core_id);
-            else
-                sprintf(print_title, "%s    Core %u    |", print_title, target_core_id);
-            sprintf(print_recv_statistics, "%s %lf Mpps |", print_recv_statistics, recv_throughput);
+    /* echoed packets steered into a queue without receive core are never polled */
+    for(i=0; i<sc_config->nb_rx_rings_per_port; i++){
+        if(rx_owner[i] == UINT32_MAX){
+            SC_WARNING_DETAILS("rx queue %u isn't polled by any receive core", i);
         }
-
-        // print log
-        SC_LOG("Receiver Throughput\n%s\n%s\n", print_title, print_recv_statistics);
     }
 
-    return SC_SUCCESS;
+    INTERNAL_CONF(sc_config)->nb_send_cores = nb_send_cores;
+    INTERNAL_CONF(sc_config)->nb_recv_cores = nb_recv_cores;
+
+_init_core_roles_exit:
+    if(tx_owner) free(tx_owner);
+    if(rx_owner) free(rx_owner);
+    return result;
 }
 
 /*!
- * \brief   callback while exiting control-plane thread (for receiver)
- * \param   sc_config       the global configuration
- * \param   worker_core_id  the core id of the worker
- * \return  zero for successfully execution
+ * \brief   validate configuration of rfc2544 throughput search, and apply the defaults
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
  */
-int _control_exit_receiver(struct sc_config *sc_config, uint32_t worker_core_id){
-    return SC_ERROR_NOT_IMPLEMENTED;
+static int _init_rfc2544(struct sc_config *sc_config){
+    uint32_t i;
+    uint64_t min_pkt_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) 
+                            + sizeof(struct rte_udp_hdr) + sizeof(struct sc_timestamp_table);
+
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_closed_loop
+        || INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_proto_stack
+        || INTERNAL_CONF(sc_config)->enable_pkt_size_dist){
+        SC_ERROR_DETAILS("rfc2544 throughput search couldn't be used together with pcap_file, closed-loop mode, "
+            "load_schedule, proto_stack or pkt_size_dist");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* search the configured pkt_len by default */
+    if(INTERNAL_CONF(sc_config)->nb_rfc2544_sizes == 0){
+        INTERNAL_CONF(sc_config)->nb_rfc2544_sizes = 1;
+        INTERNAL_CONF(sc_config)->rfc2544_sizes[0] = INTERNAL_CONF(sc_config)->pkt_len;
+    }
+    for(i=0; i<INTERNAL_CONF(sc_config)->nb_rfc2544_sizes; i++){
+        if(INTERNAL_CONF(sc_config)->rfc2544_sizes[i] < min_pkt_len
+            || INTERNAL_CONF(sc_config)->rfc2544_sizes[i] > RTE_ETHER_MAX_JUMBO_FRAME_LEN){
+            SC_ERROR_DETAILS("searched packet size %u should be within [%lu, %u]",
+                INTERNAL_CONF(sc_config)->rfc2544_sizes[i], min_pkt_len, RTE_ETHER_MAX_JUMBO_FRAME_LEN);
+            return SC_ERROR_INVALID_VALUE;
+        }
+    }
+
+    if(INTERNAL_CONF(sc_config)->rfc2544_trial_ms == 0){
+        INTERNAL_CONF(sc_config)->rfc2544_trial_ms = 2000;
+    }
+    if(INTERNAL_CONF(sc_config)->rfc2544_settle_ms == 0){
+        INTERNAL_CONF(sc_config)->rfc2544_settle_ms = 500;
+    }
+    if(INTERNAL_CONF(sc_config)->rfc2544_max_rate == 0){
+        INTERNAL_CONF(sc_config)->rfc2544_max_rate = INTERNAL_CONF(sc_config)->pkt_rate;
+    }
+    if(INTERNAL_CONF(sc_config)->rfc2544_resolution == 0){
+        INTERNAL_CONF(sc_config)->rfc2544_resolution = INTERNAL_CONF(sc_config)->rfc2544_max_rate / 1000.0;
+    }
+
+    if(INTERNAL_CONF(sc_config)->rfc2544_max_rate <= INTERNAL_CONF(sc_config)->rfc2544_min_rate){
+        SC_ERROR_DETAILS("rfc2544_max_rate (%lf Mpps) should be larger than rfc2544_min_rate (%lf Mpps)",
+            INTERNAL_CONF(sc_config)->rfc2544_max_rate, INTERNAL_CONF(sc_config)->rfc2544_min_rate);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* senders are paused until the first trial */
+    INTERNAL_CONF(sc_config)->rfc2544_trial_rate = 0;
+    INTERNAL_CONF(sc_config)->rfc2544_trial_pkt_len = INTERNAL_CONF(sc_config)->rfc2544_sizes[0];
+
+    SC_LOG("rfc2544 throughput search: %u packet size(s), [%lf, %lf] Mpps, resolution %lf Mpps, "
+           "acceptable loss %lf%%, trial %lu ms, settle %lu ms",
+        INTERNAL_CONF(sc_config)->nb_rfc2544_sizes, INTERNAL_CONF(sc_config)->rfc2544_min_rate,
+        INTERNAL_CONF(sc_config)->rfc2544_max_rate, INTERNAL_CONF(sc_config)->rfc2544_resolution,
+        INTERNAL_CONF(sc_config)->rfc2544_loss_ratio, INTERNAL_CONF(sc_config)->rfc2544_trial_ms,
+        INTERNAL_CONF(sc_config)->rfc2544_settle_ms);
+
+    return SC_SUCCESS;
 }
 
 /*!
- * \brief   initialize application (internal)
+ * \brief   validate configuration of slo controller, apply the defaults and allocate its history
  * \param   sc_config   the global configuration
  * \return  zero for successfully initialization
  */
-int _init_app(struct sc_config *sc_config){
-    int i, result = SC_SUCCESS;
-    uint32_t nb_recorded_send_core = 0, nb_recorded_recv_core = 0, core_id;
+static int _init_slo(struct sc_config *sc_config){
+    #if !defined(SC_ECHO_CLIENT_GET_LATENCY)
+        SC_ERROR_DETAILS("slo controller relies on latency stamping, please build with SC_ECHO_CLIENT_GET_LATENCY");
+        return SC_ERROR_INVALID_VALUE;
+    #endif // !defined(SC_ECHO_CLIENT_GET_LATENCY)
 
-    if(sc_config->nb_used_cores % 2 != 0){
-        SC_ERROR_DETAILS("number of used cores (%u) should be a power of 2",
-            sc_config->nb_used_cores
-        );
+    if(INTERNAL_CONF(sc_config)->pcap_file || INTERNAL_CONF(sc_config)->enable_closed_loop
+        || INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544){
+        SC_ERROR_DETAILS("slo controller couldn't be used together with pcap_file, closed-loop mode, "
+            "load_schedule or rfc2544 throughput search");
         return SC_ERROR_INVALID_VALUE;
     }
 
-    if(sc_config->nb_used_cores != sc_config->nb_rx_rings_per_port*2){
-        SC_ERROR_DETAILS("number of rx queues (%u) should be half of the number of used cores (%u)",
-            sc_config->nb_rx_rings_per_port,
-            sc_config->nb_used_cores
-        );
+    if(INTERNAL_CONF(sc_config)->slo_target_us == 0){
+        SC_ERROR_DETAILS("slo_target_us should be specified for slo controller");
         return SC_ERROR_INVALID_VALUE;
     }
 
-    if(sc_config->nb_used_cores != sc_config->nb_tx_rings_per_port*2){
-        SC_ERROR_DETAILS("number of tx queues (%u) should be half of the number of used cores (%u)",
-            sc_config->nb_tx_rings_per_port,
-            sc_config->nb_used_cores
-        );
+    if(INTERNAL_CONF(sc_config)->slo_percentile == 0){
+        INTERNAL_CONF(sc_config)->slo_percentile = 99;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_interval_ms == 0){
+        INTERNAL_CONF(sc_config)->slo_interval_ms = 1000;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_max_rate == 0){
+        INTERNAL_CONF(sc_config)->slo_max_rate = INTERNAL_CONF(sc_config)->pkt_rate;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_init_rate == 0){
+        INTERNAL_CONF(sc_config)->slo_init_rate = RTE_MAX(
+            INTERNAL_CONF(sc_config)->slo_max_rate / 10.0, INTERNAL_CONF(sc_config)->slo_min_rate);
+    }
+    if(INTERNAL_CONF(sc_config)->slo_aimd_step == 0){
+        INTERNAL_CONF(sc_config)->slo_aimd_step = INTERNAL_CONF(sc_config)->slo_max_rate / 100.0;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_aimd_backoff == 0){
+        INTERNAL_CONF(sc_config)->slo_aimd_backoff = 0.9;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_pid_kp == 0 && INTERNAL_CONF(sc_config)->slo_pid_ki == 0
+        && INTERNAL_CONF(sc_config)->slo_pid_kd == 0){
+        INTERNAL_CONF(sc_config)->slo_pid_kp = 0.5;
+        INTERNAL_CONF(sc_config)->slo_pid_ki = 0.05;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_window == 0){
+        INTERNAL_CONF(sc_config)->slo_window = 10;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_converge_ratio == 0){
+        INTERNAL_CONF(sc_config)->slo_converge_ratio = 2;
+    }
+    if(INTERNAL_CONF(sc_config)->slo_max_intervals == 0){
+        INTERNAL_CONF(sc_config)->slo_max_intervals = 300;
+    }
+
+    if(INTERNAL_CONF(sc_config)->slo_max_rate <= INTERNAL_CONF(sc_config)->slo_min_rate
+        || INTERNAL_CONF(sc_config)->slo_init_rate > INTERNAL_CONF(sc_config)->slo_max_rate){
+        SC_ERROR_DETAILS("rates of slo controller should satisfy slo_min_rate (%lf) <= slo_init_rate (%lf) "
+            "<= slo_max_rate (%lf), and slo_min_rate < slo_max_rate",
+            INTERNAL_CONF(sc_config)->slo_min_rate, INTERNAL_CONF(sc_config)->slo_init_rate,
+            INTERNAL_CONF(sc_config)->slo_max_rate);
         return SC_ERROR_INVALID_VALUE;
     }
 
-    // FIXME: should this managed by configuration file? (i.e., dynamically control #cores for sending and recving)
-    INTERNAL_CONF(sc_config)->send_core_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores/2, NULL);
-    INTERNAL_CONF(sc_config)->recv_core_idx = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*sc_config->nb_used_cores/2, NULL);
-    assert(INTERNAL_CONF(sc_config)->send_core_idx != NULL);
-    assert(INTERNAL_CONF(sc_config)->recv_core_idx != NULL);
+    INTERNAL_CONF(sc_config)->slo_state.rates = (double*)rte_zmalloc(NULL,
+        sizeof(double)*INTERNAL_CONF(sc_config)->slo_max_intervals, 0);
+    INTERNAL_CONF(sc_config)->slo_state.latencies = (double*)rte_zmalloc(NULL,
+        sizeof(double)*INTERNAL_CONF(sc_config)->slo_max_intervals, 0);
+    INTERNAL_CONF(sc_config)->slo_state.met = (bool*)rte_zmalloc(NULL,
+        sizeof(bool)*INTERNAL_CONF(sc_config)->slo_max_intervals, 0);
+    if(unlikely(!INTERNAL_CONF(sc_config)->slo_state.rates || !INTERNAL_CONF(sc_config)->slo_state.latencies
+        || !INTERNAL_CONF(sc_config)->slo_state.met)){
+        SC_ERROR_DETAILS("failed to allocate memory for history of slo controller");
+        return SC_ERROR_MEMORY;
+    }
+    if(SC_SUCCESS != sc_util_hdr_hist_init(&INTERNAL_CONF(sc_config)->slo_state.hist,
+            SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs)){
+        SC_ERROR_DETAILS("failed to allocate latency histogram of slo controller");
+        return SC_ERROR_MEMORY;
+    }
+
+    /* senders are paused until the first tick */
+    INTERNAL_CONF(sc_config)->slo_rate = 0;
 
-    /* 
-        dispatch processing functions:
-        using half of cores for sending, half of cores for receiving
-    */
-    for(i=0; i<sc_config->nb_used_cores; i++){
-        // obtain the physical core id
-        result = sc_util_get_core_id_by_logical_core_id(sc_config, i, &core_id);
-        if(unlikely(result != SC_SUCCESS)){
-            SC_ERROR_DETAILS("failed to get core id by logical core id %u", i);
-            goto _init_app_exit;
+    SC_LOG("slo controller: %s, p%lf latency <= %lu us, [%lf, %lf] Mpps from %lf Mpps, interval %lu ms, "
+           "window %u, converge ratio %lf%%, at most %u intervals",
+        INTERNAL_CONF(sc_config)->slo_controller == SC_ECHO_CLIENT_SLO_AIMD ? "aimd" : "pid",
+        INTERNAL_CONF(sc_config)->slo_percentile, INTERNAL_CONF(sc_config)->slo_target_us,
+        INTERNAL_CONF(sc_config)->slo_min_rate, INTERNAL_CONF(sc_config)->slo_max_rate,
+        INTERNAL_CONF(sc_config)->slo_init_rate, INTERNAL_CONF(sc_config)->slo_interval_ms,
+        INTERNAL_CONF(sc_config)->slo_window, INTERNAL_CONF(sc_config)->slo_converge_ratio,
+        INTERNAL_CONF(sc_config)->slo_max_intervals);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   initialize application (internal)
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
+ */
+int _init_app(struct sc_config *sc_config){
+    int i, result = SC_SUCCESS;
+
+    /* first half of cores send and second half receive by default */
+    if(INTERNAL_CONF(sc_config)->nb_core_roles == 0){
+        if(sc_config->nb_used_cores % 2 != 0){
+            SC_ERROR_DETAILS("number of used cores (%u) should be a power of 2",
+                sc_config->nb_used_cores
+            );
+            return SC_ERROR_INVALID_VALUE;
+        }
+
+        if(sc_config->nb_used_cores != sc_config->nb_rx_rings_per_port*2){
+            SC_ERROR_DETAILS("number of rx queues (%u) should be half of the number of used cores (%u)",
+                sc_config->nb_rx_rings_per_port,
+                sc_config->nb_used_cores
+            );
+            return SC_ERROR_INVALID_VALUE;
         }
 
-        if(i < sc_config->nb_used_cores/2){
+        if(sc_config->nb_used_cores != sc_config->nb_tx_rings_per_port*2){
+            SC_ERROR_DETAILS("number of tx queues (%u) should be half of the number of used cores (%u)",
+                sc_config->nb_tx_rings_per_port,
+                sc_config->nb_used_cores
+            );
+            return SC_ERROR_INVALID_VALUE;
+        }
+
+        for(i=0; i<sc_config->nb_used_cores; i++){
+            INTERNAL_CONF(sc_config)->core_roles[i] = i < sc_config->nb_used_cores/2
+                ? SC_ECHO_CLIENT_ROLE_SEND : SC_ECHO_CLIENT_ROLE_RECV;
+        }
+    } else if(INTERNAL_CONF(sc_config)->nb_core_roles != sc_config->nb_used_cores){
+        SC_ERROR_DETAILS("number of core_roles (%u) should be equal to the number of used cores (%u)",
+            INTERNAL_CONF(sc_config)->nb_core_roles, sc_config->nb_used_cores);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* check queue ownership, and record send / receive cores */
+    result = _init_core_roles(sc_config);
+    if(unlikely(result != SC_SUCCESS)){
+        SC_ERROR_DETAILS("failed to assign roles of cores");
+        goto _init_app_exit;
+    }
+
+    /* dispatch processing functions based on the role of each core */
+    for(i=0; i<sc_config->nb_used_cores; i++){
+        if(INTERNAL_CONF(sc_config)->core_roles[i] == SC_ECHO_CLIENT_ROLE_SEND){
             /* sender (worker functions) */
             PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_enter_func = _process_enter_sender;
-            PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_sender;
+            if(INTERNAL_CONF(sc_config)->pcap_file){
+                PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_sender_pcap;
+            } else if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+                PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_sender_closed_loop;
+            } else {
+                PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_sender;
+            }
             PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_exit_func = _process_exit_sender;
             /* sender (control functions) */
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_enter_func = _control_enter_sender;
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_infly_func = _control_infly_sender;
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_exit_func = _control_exit_sender;
-            PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).infly_interval = 1000000;
-
-            INTERNAL_CONF(sc_config)->send_core_idx[nb_recorded_send_core] = core_id;
-            nb_recorded_send_core += 1;
-        } else {
+        } else if(INTERNAL_CONF(sc_config)->core_roles[i] == SC_ECHO_CLIENT_ROLE_RECV){
             /* receiver (worker functions) */
             PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_enter_func = _process_enter_receiver;
             PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_receiver;
             PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_exit_func = _process_exit_receiver;
-            /* sender (control functions) */
+            /* receiver (control functions) */
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_enter_func = _control_enter_receiver;
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_infly_func = _control_infly_receiver;
             PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_exit_func = _control_exit_receiver;
-            PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).infly_interval = 1000000;
+        } else {
+            /* sender and receiver on the same queue (worker functions) */
+            PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_enter_func = _process_enter_sender_receiver;
+            PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_client_func = _process_client_sender_receiver;
+            PER_CORE_WORKER_FUNC_BY_CORE_ID(sc_config, i).process_exit_func = _process_exit_sender_receiver;
+            /* sender and receiver on the same queue (control functions) */
+            PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_enter_func = _control_enter_sender;
+            PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_infly_func = _control_infly_sender_receiver;
+            PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).control_exit_func = _control_exit_sender;
+        }
+
+        /* phases, trials and rates are switched by the control plane of send cores */
+        PER_CORE_CONTROL_FUNC_BY_CORE_ID(sc_config, i).infly_interval 
+            = (INTERNAL_CONF(sc_config)->core_roles[i] & SC_ECHO_CLIENT_ROLE_SEND)
+                && (INTERNAL_CONF(sc_config)->enable_load_schedule || INTERNAL_CONF(sc_config)->enable_rfc2544
+                    || INTERNAL_CONF(sc_config)->enable_slo)
+            ? SC_ECHO_CLIENT_SCHED_TICK_US : 1000000;
+    }
+
+    /* packets beyond the data room of a single mbuf are generated as chained mbufs */
+    if(INTERNAL_CONF(sc_config)->pkt_len > RTE_ETHER_MAX_JUMBO_FRAME_LEN){
+        SC_ERROR_DETAILS("pkt_len (%u) should be no larger than %u", 
+            INTERNAL_CONF(sc_config)->pkt_len, RTE_ETHER_MAX_JUMBO_FRAME_LEN);
+        result = SC_ERROR_INVALID_VALUE;
+        goto _init_app_exit;
+    }
+    if(INTERNAL_CONF(sc_config)->pkt_len > (sc_config->mtu > 0 ? sc_config->mtu : RTE_ETHER_MTU) + RTE_ETHER_HDR_LEN){
+        SC_WARNING_DETAILS("pkt_len (%u) exceeds the mtu of ports, please configure mtu inside dpdk.conf",
+            INTERNAL_CONF(sc_config)->pkt_len);
+    }
+
+    /* protocol stack is assembled into a single mbuf */
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack && INTERNAL_CONF(sc_config)->pkt_len > RTE_MBUF_DEFAULT_DATAROOM){
+        SC_ERROR_DETAILS("pkt_len (%u) should be no larger than %u under protocol stack",
+            INTERNAL_CONF(sc_config)->pkt_len, RTE_MBUF_DEFAULT_DATAROOM);
+        result = SC_ERROR_INVALID_VALUE;
+        goto _init_app_exit;
+    }
+
+    /* flow population rewrites the fixed ipv4/udp layout */
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack
+        && INTERNAL_CONF(sc_config)->flow_pop_conf.distribution != SC_FLOW_POP_NONE){
+        SC_ERROR_DETAILS("proto_stack couldn't be used together with flow_popularity");
+        result = SC_ERROR_INVALID_VALUE;
+        goto _init_app_exit;
+    }
+
+    if(INTERNAL_CONF(sc_config)->enable_proto_stack
+        && INTERNAL_CONF(sc_config)->pkt_len < INTERNAL_CONF(sc_config)->proto_stack.hdr_len + sizeof(struct sc_timestamp_table)){
+        SC_ERROR_DETAILS("pkt_len (%u) should be no less than %lu under protocol stack",
+            INTERNAL_CONF(sc_config)->pkt_len,
+            INTERNAL_CONF(sc_config)->proto_stack.hdr_len + sizeof(struct sc_timestamp_table));
+        result = SC_ERROR_INVALID_VALUE;
+        goto _init_app_exit;
+    }
+
+    /* packet size distribution only applies to the default ipv4/udp packets */
+    INTERNAL_CONF(sc_config)->mean_pkt_len = (double)INTERNAL_CONF(sc_config)->pkt_len;
+    if(INTERNAL_CONF(sc_config)->enable_pkt_size_dist){
+        if(INTERNAL_CONF(sc_config)->enable_proto_stack){
+            SC_ERROR_DETAILS("pkt_size_dist couldn't be used together with proto_stack");
+            result = SC_ERROR_INVALID_VALUE;
+            goto _init_app_exit;
+        }
+
+        if(INTERNAL_CONF(sc_config)->pkt_size_dist.min_size < sizeof(struct rte_ether_hdr) 
+                + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr) + sizeof(struct sc_timestamp_table)
+            || INTERNAL_CONF(sc_config)->pkt_size_dist.max_size > RTE_ETHER_MAX_JUMBO_FRAME_LEN){
+            SC_ERROR_DETAILS("packet sizes of pkt_size_dist should be within [%lu, %u]",
+                sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) 
+                    + sizeof(struct rte_udp_hdr) + sizeof(struct sc_timestamp_table),
+                RTE_ETHER_MAX_JUMBO_FRAME_LEN);
+            result = SC_ERROR_INVALID_VALUE;
+            goto _init_app_exit;
+        }
+
+        INTERNAL_CONF(sc_config)->mean_pkt_len = INTERNAL_CONF(sc_config)->pkt_size_dist.mean_size;
+        sc_util_pkt_size_dist_print(&INTERNAL_CONF(sc_config)->pkt_size_dist);
+    }
+
+    /* field modifiers rewrite fixed offsets of the default ipv4/udp packets of the open-loop sender */
+    if(INTERNAL_CONF(sc_config)->enable_field_mod){
+        if(INTERNAL_CONF(sc_config)->enable_proto_stack || INTERNAL_CONF(sc_config)->pcap_file
+            || INTERNAL_CONF(sc_config)->enable_closed_loop){
+            SC_ERROR_DETAILS("field_modifiers couldn't be used together with proto_stack, pcap_file or closed-loop mode");
+            result = SC_ERROR_INVALID_VALUE;
+            goto _init_app_exit;
+        }
+        sc_util_field_mod_print(&INTERNAL_CONF(sc_config)->field_mod_prog);
+    }
+
+    /* software checksum writes the fixed ipv4/udp layout of the open-loop sender */
+    if(INTERNAL_CONF(sc_config)->enable_sw_cksum){
+        if(INTERNAL_CONF(sc_config)->enable_proto_stack || INTERNAL_CONF(sc_config)->pcap_file
+            || INTERNAL_CONF(sc_config)->enable_closed_loop){
+            SC_ERROR_DETAILS("enable_sw_cksum couldn't be used together with proto_stack, pcap_file or closed-loop mode");
+            result = SC_ERROR_INVALID_VALUE;
+            goto _init_app_exit;
+        }
+        SC_LOG("udp checksum is calculated in software by %s implementation",
+            sc_util_cksum_impl_name(sc_util_cksum_selected_impl()));
+    }
+
+    if(INTERNAL_CONF(sc_config)->nb_cksum_bench_sizes > 0){
+        result = sc_util_cksum_bench(INTERNAL_CONF(sc_config)->cksum_bench_sizes,
+            INTERNAL_CONF(sc_config)->nb_cksum_bench_sizes, SC_ECHO_CLIENT_CKSUM_BENCH_NB_ITERATIONS);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to run checksum microbenchmark");
+            goto _init_app_exit;
+        }
+    }
+
+    /* histograms for merging latencies of receive cores */
+    if(INTERNAL_CONF(sc_config)->latency_hist_sig_figs == 0){
+        INTERNAL_CONF(sc_config)->latency_hist_sig_figs = 3;
+    }
+    #if defined(SC_ECHO_CLIENT_GET_LATENCY)
+        if(SC_SUCCESS != sc_util_hdr_hist_init(&INTERNAL_CONF(sc_config)->latency_hist_merged,
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs)
+            || SC_SUCCESS != sc_util_hdr_hist_init(&INTERNAL_CONF(sc_config)->latency_hist_prev,
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs)
+            || SC_SUCCESS != sc_util_hdr_hist_init(&INTERNAL_CONF(sc_config)->latency_hist_interval,
+                SC_ECHO_CLIENT_LATENCY_HIST_MAX_NS, INTERNAL_CONF(sc_config)->latency_hist_sig_figs)){
+            SC_ERROR_DETAILS("failed to allocate latency histograms");
+            result = SC_ERROR_MEMORY;
+            goto _init_app_exit;
+        }
+    #endif // defined(SC_ECHO_CLIENT_GET_LATENCY)
+
+    /* compile the kv workload */
+    if(INTERNAL_CONF(sc_config)->enable_kv){
+        result = _init_kv(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize kv workload");
+            goto _init_app_exit;
+        }
+    }
+
+    /* validate the load schedule */
+    if(INTERNAL_CONF(sc_config)->enable_load_schedule){
+        result = _init_load_schedule(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize load schedule");
+            goto _init_app_exit;
+        }
+    }
+
+    /* validate the rfc2544 throughput search */
+    if(INTERNAL_CONF(sc_config)->enable_rfc2544){
+        result = _init_rfc2544(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize rfc2544 throughput search");
+            goto _init_app_exit;
+        }
+    }
+
+    /* validate the slo controller */
+    if(INTERNAL_CONF(sc_config)->enable_slo){
+        result = _init_slo(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize slo controller");
+            goto _init_app_exit;
+        }
+    }
 
-            INTERNAL_CONF(sc_config)->recv_core_idx[nb_recorded_recv_core] = core_id;
-            nb_recorded_recv_core += 1;
+    /* validate per-flow sequence tracking */
+    if(INTERNAL_CONF(sc_config)->enable_seq){
+        result = _init_seq(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize sequence tracking");
+            goto _init_app_exit;
+        }
+    }
+
+    /* validate server-side stage stamps */
+    if(INTERNAL_CONF(sc_config)->enable_stage_stamps){
+        result = _init_stage_stamps(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize server-side stage stamps");
+            goto _init_app_exit;
+        }
+    }
+
+    /* create rings for passing completions back to send cores under closed-loop mode */
+    if(INTERNAL_CONF(sc_config)->enable_closed_loop){
+        result = _init_closed_loop(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize closed-loop mode");
+            goto _init_app_exit;
         }
     }
 
-    INTERNAL_CONF(sc_config)->nb_send_cores = nb_recorded_send_core;
-    INTERNAL_CONF(sc_config)->nb_recv_cores = nb_recorded_recv_core;
+    /* preload the pcap file, one trace per send core */
+    if(INTERNAL_CONF(sc_config)->pcap_file){
+        result = _init_pcap_replay(sc_config);
+        if(unlikely(result != SC_SUCCESS)){
+            SC_ERROR_DETAILS("failed to initialize pcap replay");
+            goto _init_app_exit;
+        }
+    }
 
 _init_app_exit:
     return result;
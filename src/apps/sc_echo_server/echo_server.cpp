@@ -141,6 +141,44 @@ invalid_recv_port_mac:
         SC_ERROR_DETAILS("invalid recv port mac address\n");
     }
 
+    /* parse protocol stack of received packets */
+    if(!strcmp(key, "enable_proto_stats")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_proto_stats = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_proto_stats = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_proto_stats;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_proto_stats:
+        SC_ERROR_DETAILS("invalid configuration enable_proto_stats\n");
+    }
+
+    /* digest payload of received packets */
+    if(!strcmp(key, "enable_payload_digest")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            INTERNAL_CONF(sc_config)->enable_payload_digest = true;
+        } else if (!strcmp(value, "false")){
+            INTERNAL_CONF(sc_config)->enable_payload_digest = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_payload_digest;
+        }
+
+        goto _parse_app_kv_pair_exit;
+
+invalid_enable_payload_digest:
+        SC_ERROR_DETAILS("invalid configuration enable_payload_digest\n");
+    }
+
 _parse_app_kv_pair_exit:
     return result;
 }
@@ -151,9 +189,86 @@ _parse_app_kv_pair_exit:
  * \return  zero for successfully executing
  */
 int _process_enter(struct sc_config *sc_config){
+    PER_CORE_APP_META(sc_config).nb_proto_stats = 0;
+    PER_CORE_APP_META(sc_config).nb_unrecorded_proto_pkts = 0;
+    PER_CORE_APP_META(sc_config).nb_digest_pkts = 0;
+    PER_CORE_APP_META(sc_config).nb_digest_segs = 0;
+    PER_CORE_APP_META(sc_config).nb_digest_bytes = 0;
+    PER_CORE_APP_META(sc_config).nb_digest_cycles = 0;
+    PER_CORE_APP_META(sc_config).digest = 0;
     return SC_SUCCESS;
 }
 
+/*!
+ * \brief   compute the crc32c digest of the udp payload of the received packet,
+ *          the payload of jumbo frames spans multiple chained segments
+ * \param   sc_config   the global configuration
+ * \param   pkt         the received packet
+ */
+static void _digest_payload(struct sc_config *sc_config, struct rte_mbuf *pkt){
+    uint32_t offset, len, crc = 0xffffffff;
+    uint64_t start_cycles, nb_bytes = 0;
+    struct rte_mbuf *seg;
+
+    start_cycles = rte_rdtsc();
+    offset = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr);
+    for(seg = pkt; seg != NULL; seg = seg->next){
+        if(offset >= seg->data_len){
+            offset -= seg->data_len;
+            continue;
+        }
+        len = seg->data_len - offset;
+        crc = rte_hash_crc(rte_pktmbuf_mtod_offset(seg, void*, offset), len, crc);
+        nb_bytes += len;
+        offset = 0;
+    }
+
+    PER_CORE_APP_META(sc_config).digest ^= ~crc;
+    PER_CORE_APP_META(sc_config).nb_digest_pkts += 1;
+    PER_CORE_APP_META(sc_config).nb_digest_segs += pkt->nb_segs;
+    PER_CORE_APP_META(sc_config).nb_digest_bytes += nb_bytes;
+    PER_CORE_APP_META(sc_config).nb_digest_cycles += rte_rdtsc() - start_cycles;
+}
+
+/*!
+ * \brief   parse the protocol stack of the received packet, and record
+ *          the parsing cost under the mix it belongs to
+ * \param   sc_config   the global configuration
+ * \param   pkt         the received packet
+ */
+static void _record_proto_stat(struct sc_config *sc_config, struct rte_mbuf *pkt){
+    uint32_t i;
+    uint64_t start_cycles, signature;
+    struct sc_proto_stack stack;
+    struct _proto_stat *stat;
+
+    start_cycles = rte_rdtsc();
+    if(unlikely(sc_util_parse_pkt_proto_stack(pkt, &stack) != SC_SUCCESS)){
+        return;
+    }
+    signature = sc_util_proto_stack_signature(&stack);
+
+    for(i=0; i<PER_CORE_APP_META(sc_config).nb_proto_stats; i++){
+        if(PER_CORE_APP_META(sc_config).proto_stats[i].signature == signature) break;
+    }
+    if(unlikely(i == PER_CORE_APP_META(sc_config).nb_proto_stats)){
+        if(i == SC_ECHO_SERVER_MAX_NB_PROTO_STATS){
+            PER_CORE_APP_META(sc_config).nb_unrecorded_proto_pkts += 1;
+            return;
+        }
+        stat = &PER_CORE_APP_META(sc_config).proto_stats[i];
+        stat->signature = signature;
+        stat->nb_pkts = 0;
+        stat->nb_parse_cycles = 0;
+        stat->stack = stack;
+        PER_CORE_APP_META(sc_config).nb_proto_stats += 1;
+    }
+
+    stat = &PER_CORE_APP_META(sc_config).proto_stats[i];
+    stat->nb_pkts += 1;
+    stat->nb_parse_cycles += rte_rdtsc() - start_cycles;
+}
+
 /*!
  * \brief   callback for processing packet
  * \param   pkt             the received packet
@@ -177,6 +292,14 @@ int _process_pkt(struct rte_mbuf **pkt, uint64_t nb_recv_pkts, struct sc_config
     #endif // defined(SC_ECHO_SERVER_GET_LATENCY)
 
     for(i=0; i<nb_recv_pkts; i++){
+        if(INTERNAL_CONF(sc_config)->enable_proto_stats){
+            _record_proto_stat(sc_config, pkt[i]);
+        }
+
+        if(INTERNAL_CONF(sc_config)->enable_payload_digest){
+            _digest_payload(sc_config, pkt[i]);
+        }
+
         #if defined(SC_ECHO_SERVER_GET_LATENCY)
             // skip empty payload packet
             if(unlikely(pkt[i]->buf_addr == NULL)){
@@ -278,6 +401,36 @@ int _process_exit(struct sc_config *sc_config){
     SC_THREAD_LOG("average throughput: %lf MOps", PER_CORE_APP_META(sc_config).average_throughput);
     SC_THREAD_LOG("forward %u packets in total", PER_CORE_APP_META(sc_config).nb_forward_pkt);
     SC_THREAD_LOG("drop %u packets in total", PER_CORE_APP_META(sc_config).nb_drop_pkt);
+
+    if(INTERNAL_CONF(sc_config)->enable_proto_stats){
+        char stack_str[SC_PROTO_STACK_MAX_HDR_LEN];
+        struct _proto_stat *stat;
+        for(i=0; i<PER_CORE_APP_META(sc_config).nb_proto_stats; i++){
+            stat = &PER_CORE_APP_META(sc_config).proto_stats[i];
+            sc_util_proto_stack_to_str(&stat->stack, stack_str, sizeof(stack_str));
+            SC_THREAD_LOG("protocol stack %s: %lu packets, %lf cycles/pkt for parsing",
+                stack_str, stat->nb_pkts, (double)stat->nb_parse_cycles / (double)stat->nb_pkts);
+        }
+        if(PER_CORE_APP_META(sc_config).nb_unrecorded_proto_pkts > 0){
+            SC_THREAD_LOG("%lu packets with other protocol stacks are not recorded",
+                PER_CORE_APP_META(sc_config).nb_unrecorded_proto_pkts);
+        }
+    }
+
+    if(INTERNAL_CONF(sc_config)->enable_payload_digest && PER_CORE_APP_META(sc_config).nb_digest_pkts > 0){
+        SC_THREAD_LOG("payload digest: %lu packets, %lf segments/pkt, %lf bytes/pkt, %lf cycles/byte, %lf Gbps (digest: 0x%08x)",
+            PER_CORE_APP_META(sc_config).nb_digest_pkts,
+            (double)PER_CORE_APP_META(sc_config).nb_digest_segs / (double)PER_CORE_APP_META(sc_config).nb_digest_pkts,
+            (double)PER_CORE_APP_META(sc_config).nb_digest_bytes / (double)PER_CORE_APP_META(sc_config).nb_digest_pkts,
+            PER_CORE_APP_META(sc_config).nb_digest_bytes > 0
+                ? (double)PER_CORE_APP_META(sc_config).nb_digest_cycles / (double)PER_CORE_APP_META(sc_config).nb_digest_bytes : 0,
+            PER_CORE_APP_META(sc_config).nb_digest_cycles > 0
+                ? (double)PER_CORE_APP_META(sc_config).nb_digest_bytes * 8.0 * (double)sc_util_tsc_hz()
+                    / (double)PER_CORE_APP_META(sc_config).nb_digest_cycles / 1e9 : 0,
+            PER_CORE_APP_META(sc_config).digest
+        );
+    }
+
     return SC_SUCCESS;
 }
 
@@ -4,6 +4,7 @@
 #include "sc_control_plane.hpp"
 #include "sc_utils/pktgen.hpp"
 #include "sc_utils/timestamp.hpp"
+#include "sc_utils/stage_stamp.hpp"
 
 /*!
  * \brief   parse application-specific key-value configuration pair
@@ -479,6 +480,11 @@ int _process_pkt_doca_openloop(struct rte_mbuf **pkt, uint64_t nb_recv_pkts, str
     PER_CORE_APP_META(sc_config).nb_finished_pkts += nb_finished_pkts;
     PER_CORE_APP_META(sc_config).interval_nb_finished_pkts += nb_finished_pkts;
 
+    // stamp tx into trailers of finished packets (if enabled)
+    if(unlikely(sc_stage_stamp_enabled)){
+        sc_util_stage_stamp_burst(finished_pkts, nb_finished_pkts, SC_STAGE_TX, sc_util_timestamp_tsc());
+    }
+
     // send back packets
     // for(i=0; i<INTERNAL_CONF(sc_config)->nb_send_ports; i++){
     //     if(nb_finished_pkts != 0){
@@ -660,6 +666,11 @@ int doca_result, result = SC_SUCCESS;
     PER_CORE_APP_META(sc_config).nb_finished_pkts += nb_finished_pkts;
     PER_CORE_APP_META(sc_config).interval_nb_finished_pkts += nb_finished_pkts;
 
+    // stamp tx into trailers of finished packets (if enabled)
+    if(unlikely(sc_stage_stamp_enabled)){
+        sc_util_stage_stamp_burst(pkt, nb_finished_pkts, SC_STAGE_TX, sc_util_timestamp_tsc());
+    }
+
     #if defined(SC_SHA_GET_LATENCY)
         send_ns = sc_util_timestamp_ns();
         for(i=0; i<nb_recv_pkts; i++){
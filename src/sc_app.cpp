@@ -28,6 +28,7 @@ int init_app(struct sc_config *sc_config, const char *app_conf_path){
         SC_ERROR_DETAILS("failed to allocate memory for internal_config");
         return SC_ERROR_MEMORY;
     }
+    memset(_internal_config, 0, sizeof(struct _internal_config));
     sc_config->app_config->internal_config = _internal_config;
 
     /* allocate per-core worker function array */
@@ -0,0 +1,395 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_flow.hpp"
+
+static int _parse_flow_rule_ipv4(char *str, rte_be32_t *addr);
+static int _parse_flow_rule_port(char *str, rte_be16_t *port);
+static int _install_single_flow_rule(
+    struct sc_config *sc_config, uint16_t port_id, struct sc_port *port, uint16_t rule_id, struct sc_flow_rule *rule);
+
+/*!
+ * \brief   parse a flow rule from the configuration file
+ * \param   rule_str    the string of the rule (value of flow_rule)
+ * \param   rule        the parsed rule
+ * \return  zero for successfully parsing
+ */
+int sc_flow_parse_rule(char *rule_str, struct sc_flow_rule *rule){
+    const char *delim = " \t";
+    char *token;
+    bool in_actions = false;
+    uint32_t u32_value;
+    uint16_t u16_value;
+
+    memset(rule, 0, sizeof(struct sc_flow_rule));
+
+    rule_str = sc_util_del_both_trim(rule_str);
+    sc_util_del_change_line(rule_str);
+
+    for(token = strtok(rule_str, delim); token != NULL; token = strtok(NULL, delim)){
+        /* patterns */
+        if(!in_actions){
+            if(!strcmp(token, "action")){
+                in_actions = true;
+            } else if(!strcmp(token, "port_mac")){
+                if(!(token = strtok(NULL, delim))) goto invalid_rule;
+                if(strlen(token) != RTE_ETHER_ADDR_FMT_SIZE-1) goto invalid_rule;
+                strcpy(rule->port_mac, token);
+            } else if(!strcmp(token, "proto")){
+                if(!(token = strtok(NULL, delim))) goto invalid_rule;
+                if(!strcmp(token, "udp") || !strcmp(token, "UDP")){
+                    rule->l4_proto = IPPROTO_UDP;
+                } else if(!strcmp(token, "tcp") || !strcmp(token, "TCP")){
+                    rule->l4_proto = IPPROTO_TCP;
+                } else {
+                    goto invalid_rule;
+                }
+            } else if(!strcmp(token, "src_ip")){
+                if(_parse_flow_rule_ipv4(strtok(NULL, delim), &rule->src_ip) != SC_SUCCESS) goto invalid_rule;
+                rule->match_src_ip = true;
+            } else if(!strcmp(token, "dst_ip")){
+                if(_parse_flow_rule_ipv4(strtok(NULL, delim), &rule->dst_ip) != SC_SUCCESS) goto invalid_rule;
+                rule->match_dst_ip = true;
+            } else if(!strcmp(token, "src_port")){
+                if(_parse_flow_rule_port(strtok(NULL, delim), &rule->src_port) != SC_SUCCESS) goto invalid_rule;
+                rule->match_src_port = true;
+            } else if(!strcmp(token, "dst_port")){
+                if(_parse_flow_rule_port(strtok(NULL, delim), &rule->dst_port) != SC_SUCCESS) goto invalid_rule;
+                rule->match_dst_port = true;
+            } else {
+                SC_ERROR_DETAILS("unknown flow rule pattern %s", token);
+                goto invalid_rule;
+            }
+        }
+        /* actions */
+        else {
+            if(!strcmp(token, "drop")){
+                rule->action_drop = true;
+            } else if(!strcmp(token, "queue")){
+                if(!(token = strtok(NULL, delim))) goto invalid_rule;
+                if(sc_util_atoui_16(token, &u16_value) != SC_SUCCESS) goto invalid_rule;
+                rule->queue_id = u16_value;
+                rule->action_queue = true;
+            } else if(!strcmp(token, "mark")){
+                if(!(token = strtok(NULL, delim))) goto invalid_rule;
+                if(sc_util_atoui_32(token, &u32_value) != SC_SUCCESS) goto invalid_rule;
+                rule->mark_id = u32_value;
+                rule->action_mark = true;
+            } else {
+                SC_ERROR_DETAILS("unknown flow rule action %s", token);
+                goto invalid_rule;
+            }
+        }
+    }
+
+    /* at least one action should be specified */
+    if(!rule->action_drop && !rule->action_queue && !rule->action_mark){
+        SC_ERROR_DETAILS("no action is specified inside the flow rule");
+        goto invalid_rule;
+    }
+
+    /* drop and queue are both fate actions, can't be used together */
+    if(rule->action_drop && rule->action_queue){
+        SC_ERROR_DETAILS("drop action can't be combined with queue action");
+        goto invalid_rule;
+    }
+
+    /* matching l4 ports requires specifying the l4 protocol */
+    if((rule->match_src_port || rule->match_dst_port) && rule->l4_proto == 0){
+        SC_ERROR_DETAILS("must specified proto while matching on l4 ports");
+        goto invalid_rule;
+    }
+
+    return SC_SUCCESS;
+
+invalid_rule:
+    return SC_ERROR_INVALID_VALUE;
+}
+
+/*!
+ * \brief   prepare the port for installing flow rules, must be
+ *          invoked before the port is configured
+ * \param   sc_config   the global configuration
+ * \param   port_id     index of the port
+ * \return  zero for successfully initialization
+ */
+int init_flow_isolation(struct sc_config *sc_config, uint16_t port_id){
+    int ret;
+    uint16_t i;
+    bool has_mark_action = false;
+    struct rte_flow_error error;
+
+    /* ask the PMD to deliver MARK id to mbuf->hash.fdir */
+    #if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
+        uint64_t rx_metadata = RTE_ETH_RX_METADATA_USER_MARK;
+        for(i=0; i<sc_config->nb_flow_rules; i++){
+            if(sc_config->flow_rules[i]->action_mark){
+                has_mark_action = true;
+                break;
+            }
+        }
+        if(has_mark_action){
+            ret = rte_eth_rx_metadata_negotiate(port_id, &rx_metadata);
+            if(ret == 0 && !(rx_metadata & RTE_ETH_RX_METADATA_USER_MARK)){
+                SC_WARNING_DETAILS("port %u can't deliver flow mark to application", port_id);
+            } else if(ret != 0 && ret != -ENOTSUP){
+                SC_ERROR_DETAILS("failed to negotiate rx metadata on port %u: %s",
+                    port_id, rte_strerror(-ret));
+                return SC_ERROR_INTERNAL;
+            }
+        }
+    #endif
+
+    /* only receive traffic matched by flow rules (if enabled) */
+    if(sc_config->enable_flow_isolation){
+        memset(&error, 0, sizeof(struct rte_flow_error));
+        ret = rte_flow_isolate(port_id, 1, &error);
+        if(ret != 0){
+            SC_ERROR_DETAILS("failed to set port %u as flow isolated mode: %s",
+                port_id, error.message ? error.message : "(no stated reason)");
+            return SC_ERROR_INTERNAL;
+        }
+        SC_LOG("port %u is set as flow isolated mode", port_id);
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   validate and install all configured flow rules on the
+ *          port, must be invoked after the port is started
+ * \param   sc_config           the global configuration
+ * \param   port_id             index of the port
+ * \param   port_logical_id     logical index of the port, whose installed rules are recorded
+ * \return  zero for successfully installation
+ */
+int init_flow_rules(struct sc_config *sc_config, uint16_t port_id, uint16_t port_logical_id){
+    int ret, result = SC_SUCCESS;
+    uint16_t i;
+    struct rte_ether_addr mac;
+    char ebuf[RTE_ETHER_ADDR_FMT_SIZE];
+    struct rte_flow_error error;
+    struct sc_port *port = &sc_config->sc_port[port_logical_id];
+
+    port->nb_flows = 0;
+    if(sc_config->nb_flow_rules == 0)
+        return SC_SUCCESS;
+
+    ret = rte_eth_macaddr_get(port_id, &mac);
+    if(ret != 0){
+        SC_ERROR_DETAILS("failed to obtain mac address of port %u: %s",
+            port_id, rte_strerror(-ret));
+        return SC_ERROR_INTERNAL;
+    }
+    rte_ether_format_addr(ebuf, sizeof(ebuf), &mac);
+
+    /* remove stale rules */
+    memset(&error, 0, sizeof(struct rte_flow_error));
+    ret = rte_flow_flush(port_id, &error);
+    if(ret != 0){
+        SC_ERROR_DETAILS("failed to flush stale flow rules on port %u: %s",
+            port_id, error.message ? error.message : "(no stated reason)");
+        return SC_ERROR_INTERNAL;
+    }
+
+    for(i=0; i<sc_config->nb_flow_rules; i++){
+        /* skip the rule if it's specified to other port */
+        if(sc_config->flow_rules[i]->port_mac[0] != '\0'
+            && strcmp(ebuf, sc_config->flow_rules[i]->port_mac))
+            continue;
+
+        result = _install_single_flow_rule(sc_config, port_id, port, i, sc_config->flow_rules[i]);
+        if(result != SC_SUCCESS)
+            break;
+    }
+
+    return result;
+}
+
+/*!
+ * \brief   destroy all flow rules installed on the port
+ * \param   sc_config           the global configuration
+ * \param   port_logical_id     logical index of the port
+ * \return  zero for successfully destruction
+ */
+int destroy_flow_rules(struct sc_config *sc_config, uint16_t port_logical_id){
+    int ret, result = SC_SUCCESS;
+    uint16_t i;
+    struct rte_flow_error error;
+    struct sc_port *port = &sc_config->sc_port[port_logical_id];
+
+    for(i=0; i<port->nb_flows; i++){
+        memset(&error, 0, sizeof(struct rte_flow_error));
+        ret = rte_flow_destroy(port->port_id, port->flows[i], &error);
+        if(ret != 0){
+            SC_ERROR_DETAILS("failed to destroy flow rule on port %u: %s",
+                port->port_id, error.message ? error.message : "(no stated reason)");
+            result = SC_ERROR_INTERNAL;
+        }
+        port->flows[i] = NULL;
+    }
+    port->nb_flows = 0;
+
+    return result;
+}
+
+/*!
+ * \brief   validate and install a single flow rule
+ * \param   sc_config   the global configuration
+ * \param   port_id     index of the port
+ * \param   port        the port, which records the handle of the installed rule
+ * \param   rule_id     index of the rule inside the configuration file
+ * \param   rule        the rule to be installed
+ * \return  zero for successfully installation
+ */
+static int _install_single_flow_rule(
+        struct sc_config *sc_config, uint16_t port_id, struct sc_port *port, uint16_t rule_id, struct sc_flow_rule *rule){
+    int ret;
+    uint8_t nb_items = 0, nb_actions = 0;
+    struct rte_flow *flow;
+    struct rte_flow_error error;
+    struct rte_flow_attr attr;
+    struct rte_flow_item pattern[SC_FLOW_MAX_NB_PATTERN_ITEMS];
+    struct rte_flow_action actions[SC_FLOW_MAX_NB_ACTIONS];
+    struct rte_flow_item_ipv4 ipv4_spec, ipv4_mask;
+    struct rte_flow_item_udp udp_spec, udp_mask;
+    struct rte_flow_item_tcp tcp_spec, tcp_mask;
+    struct rte_flow_action_queue queue;
+    struct rte_flow_action_mark mark;
+
+    memset(&attr, 0, sizeof(struct rte_flow_attr));
+    memset(pattern, 0, sizeof(pattern));
+    memset(actions, 0, sizeof(actions));
+    memset(&ipv4_spec, 0, sizeof(ipv4_spec));
+    memset(&ipv4_mask, 0, sizeof(ipv4_mask));
+    memset(&udp_spec, 0, sizeof(udp_spec));
+    memset(&udp_mask, 0, sizeof(udp_mask));
+    memset(&tcp_spec, 0, sizeof(tcp_spec));
+    memset(&tcp_mask, 0, sizeof(tcp_mask));
+    attr.ingress = 1;
+
+    if(rule->action_queue && rule->queue_id >= sc_config->nb_rx_rings_per_port){
+        SC_ERROR_DETAILS("flow rule %u steers to queue %u, while port %u only has %u rx queues",
+            rule_id, rule->queue_id, port_id, sc_config->nb_rx_rings_per_port);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* pattern: eth / ipv4 / (udp | tcp) / end */
+    pattern[nb_items++].type = RTE_FLOW_ITEM_TYPE_ETH;
+
+    if(rule->match_src_ip){
+        ipv4_spec.hdr.src_addr = rule->src_ip;
+        ipv4_mask.hdr.src_addr = RTE_BE32(0xFFFFFFFF);
+    }
+    if(rule->match_dst_ip){
+        ipv4_spec.hdr.dst_addr = rule->dst_ip;
+        ipv4_mask.hdr.dst_addr = RTE_BE32(0xFFFFFFFF);
+    }
+    pattern[nb_items].type = RTE_FLOW_ITEM_TYPE_IPV4;
+    if(rule->match_src_ip || rule->match_dst_ip){
+        pattern[nb_items].spec = &ipv4_spec;
+        pattern[nb_items].mask = &ipv4_mask;
+    }
+    nb_items++;
+
+    if(rule->l4_proto == IPPROTO_UDP){
+        if(rule->match_src_port){
+            udp_spec.hdr.src_port = rule->src_port;
+            udp_mask.hdr.src_port = RTE_BE16(0xFFFF);
+        }
+        if(rule->match_dst_port){
+            udp_spec.hdr.dst_port = rule->dst_port;
+            udp_mask.hdr.dst_port = RTE_BE16(0xFFFF);
+        }
+        pattern[nb_items].type = RTE_FLOW_ITEM_TYPE_UDP;
+        pattern[nb_items].spec = &udp_spec;
+        pattern[nb_items].mask = &udp_mask;
+        nb_items++;
+    } else if(rule->l4_proto == IPPROTO_TCP){
+        if(rule->match_src_port){
+            tcp_spec.hdr.src_port = rule->src_port;
+            tcp_mask.hdr.src_port = RTE_BE16(0xFFFF);
+        }
+        if(rule->match_dst_port){
+            tcp_spec.hdr.dst_port = rule->dst_port;
+            tcp_mask.hdr.dst_port = RTE_BE16(0xFFFF);
+        }
+        pattern[nb_items].type = RTE_FLOW_ITEM_TYPE_TCP;
+        pattern[nb_items].spec = &tcp_spec;
+        pattern[nb_items].mask = &tcp_mask;
+        nb_items++;
+    }
+    pattern[nb_items].type = RTE_FLOW_ITEM_TYPE_END;
+
+    /* actions: [mark] / (drop | queue | passthru) / end */
+    if(rule->action_mark){
+        mark.id = rule->mark_id;
+        actions[nb_actions].type = RTE_FLOW_ACTION_TYPE_MARK;
+        actions[nb_actions].conf = &mark;
+        nb_actions++;
+    }
+    if(rule->action_drop){
+        actions[nb_actions++].type = RTE_FLOW_ACTION_TYPE_DROP;
+    } else if(rule->action_queue){
+        queue.index = rule->queue_id;
+        actions[nb_actions].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+        actions[nb_actions].conf = &queue;
+        nb_actions++;
+    } else {
+        /* mark only, let the packet continue to be distributed by rss */
+        actions[nb_actions++].type = RTE_FLOW_ACTION_TYPE_PASSTHRU;
+    }
+    actions[nb_actions].type = RTE_FLOW_ACTION_TYPE_END;
+
+    /* validate the rule */
+    memset(&error, 0, sizeof(struct rte_flow_error));
+    ret = rte_flow_validate(port_id, &attr, pattern, actions, &error);
+    if(ret != 0){
+        SC_ERROR_DETAILS("flow rule %u isn't supported by port %u: %s",
+            rule_id, port_id, error.message ? error.message : "(no stated reason)");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* install the rule */
+    flow = rte_flow_create(port_id, &attr, pattern, actions, &error);
+    if(!flow){
+        SC_ERROR_DETAILS("failed to create flow rule %u on port %u: %s",
+            rule_id, port_id, error.message ? error.message : "(no stated reason)");
+        return SC_ERROR_INTERNAL;
+    }
+    port->flows[port->nb_flows++] = flow;
+
+    SC_LOG("installed flow rule %u on port %u", rule_id, port_id);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   parse ipv4 address inside the flow rule
+ * \param   str     the address string
+ * \param   addr    the parsed address (network byte order)
+ * \return  zero for successfully parsing
+ */
+static int _parse_flow_rule_ipv4(char *str, rte_be32_t *addr){
+    struct in_addr in;
+    if(!str) return SC_ERROR_INVALID_VALUE;
+    if(inet_pton(AF_INET, str, &in) != 1) return SC_ERROR_INVALID_VALUE;
+    *addr = in.s_addr;
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   parse l4 port inside the flow rule
+ * \param   str     the port string
+ * \param   port    the parsed port (network byte order)
+ * \return  zero for successfully parsing
+ */
+static int _parse_flow_rule_port(char *str, rte_be16_t *port){
+    uint16_t value;
+    if(!str) return SC_ERROR_INVALID_VALUE;
+    if(sc_util_atoui_16(str, &value) != SC_SUCCESS) return SC_ERROR_INVALID_VALUE;
+    *port = rte_cpu_to_be_16(value);
+    return SC_SUCCESS;
+}
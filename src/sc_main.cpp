@@ -10,8 +10,14 @@
 #include "sc_compile_debug.hpp"
 #include "sc_global.hpp"
 #include "sc_port.hpp"
+#include "sc_flow.hpp"
+#include "sc_vdev.hpp"
+#include "sc_socket.hpp"
 #include "sc_mbuf.hpp"
 #include "sc_utils.hpp"
+#include "sc_utils/prng.hpp"
+#include "sc_utils/timestamp.hpp"
+#include "sc_utils/stage_stamp.hpp"
 #include "sc_worker.hpp"
 #include "sc_app.hpp"
 #include "sc_control_plane.hpp"
@@ -38,7 +44,7 @@ static void _signal_handler(int signum);
 int main(int argc, char **argv){
   int result = EXIT_SUCCESS;
   FILE* fp = NULL;
-  struct sc_config *sc_config;
+  struct sc_config *sc_config = NULL;
   #if defined(SC_HAS_DOCA)
     struct doca_config *doca_config;
   #endif
@@ -123,6 +129,13 @@ int main(int argc, char **argv){
   }
   SC_LOG("initialized rte ports");
 
+  /* initailize kernel socket backend (if enabled) */
+  if(init_socket_backend(sc_config) != SC_SUCCESS){
+    SC_ERROR("failed to initialize kernel socket backend, exit\n");
+    result = EXIT_FAILURE;
+    goto sc_exit;
+  }
+
   /* initailize doca (if necessary) */
   #if defined(SC_HAS_DOCA)
     if(init_doca(sc_config, doca_conf_path) != SC_SUCCESS){
@@ -165,6 +178,13 @@ int main(int argc, char **argv){
   }
   SC_LOG("launch logging threads");
 
+  /* reset statistics of virtual devices */
+  if(init_vdev_stats(sc_config) != SC_SUCCESS){
+    SC_ERROR("failed to reset statistics of virtual devices\n");
+    result = EXIT_FAILURE;
+    goto sc_exit;
+  }
+
   /* (sync/async) launch worker threads */
   if(launch_worker_threads(sc_config) != SC_SUCCESS){
     SC_ERROR("failed to launch worker threads\n");
@@ -172,7 +192,15 @@ int main(int argc, char **argv){
     goto sc_exit;
   }
 
+  /* report throughput of virtual devices */
+  report_vdev_stats(sc_config);
+
 sc_exit:
+  /* remove installed flow rules and close ports */
+  if(sc_config){
+    close_ports(sc_config);
+  }
+
   rte_exit(result, "exit\n");
   return 0;
 }
@@ -187,13 +215,17 @@ sc_exit:
 static int _init_env(struct sc_config *sc_config, int argc, char **argv){
   int i, ret, rte_argc = 0;
   char *rte_argv[SC_RTE_ARGC_MAX];
-  char rte_init_str[256] = {0};
+  char rte_init_str[1024] = {0};
   mpz_t cpu_mask;
   char cpu_mask_buf[SC_MAX_NB_PORTS] = {0};
   char mem_channels_buf[8] = "";
   
-  /* reset the random seed */
-  srand((unsigned)time(NULL));
+  /* reset the random seed, every worker derives its own stream from the global seed */
+  if(sc_config->prng_seed == 0){
+    sc_config->prng_seed = ((uint64_t)time(NULL) << 20) ^ (uint64_t)getpid();
+  }
+  sc_util_prng_set_global_seed(sc_config->prng_seed);
+  SC_LOG("random seed: %lu", sc_config->prng_seed);
 
   /* config cpu mask */
   mpz_init(cpu_mask);
@@ -273,6 +305,12 @@ static int _init_env(struct sc_config *sc_config, int argc, char **argv){
     }
   #endif // SC_HAS_DOCA
 
+  /* append parameters for creating virtual devices (e.g. memif) */
+  if(init_vdev_eal_args(sc_config, &rte_argc, rte_argv) != SC_SUCCESS){
+    SC_ERROR_DETAILS("failed to generate eal parameters for virtual devices");
+    return SC_ERROR_INTERNAL;
+  }
+
   for(i=0; i<rte_argc; i++){
     if(i!=0){
       sprintf(rte_init_str, "%s %s", rte_init_str, rte_argv[i]);
@@ -295,6 +333,18 @@ static int _init_env(struct sc_config *sc_config, int argc, char **argv){
 //     free(sf_eal_confs);
 //   #endif
 
+  /* calibrate tsc for timestamping */
+  if(sc_util_tsc_calibrate(SC_TSC_CALIBRATE_MS) != SC_SUCCESS){
+    SC_ERROR_DETAILS("failed to calibrate tsc");
+    return SC_ERROR_INTERNAL;
+  }
+
+  /* per-stage stamps are checked on the datapath through a global indicator */
+  sc_stage_stamp_enabled = sc_config->enable_stage_stamps;
+  if(sc_stage_stamp_enabled){
+    SC_LOG("per-stage tsc stamps into packet trailers are enabled");
+  }
+
   /* register signal handler */
   signal(SIGINT, _signal_handler);
 	signal(SIGTERM, _signal_handler);
@@ -364,6 +414,38 @@ static int _check_configuration(struct sc_config *sc_config, int argc, char **ar
         return SC_ERROR_INVALID_VALUE;
     }
 
+    /* check whether control socket is specified while enabling memif */
+    if(sc_config->enable_memif && !sc_config->memif_socket){
+        SC_ERROR_DETAILS("must specified memif_socket while enabling memif");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* check whether socket is specified while enabling vhost-user */
+    if(sc_config->enable_vhost_user && !sc_config->vhost_user_socket){
+        SC_ERROR_DETAILS("must specified vhost_user_socket while enabling vhost-user");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* check whether interface is specified while enabling af_xdp */
+    if(sc_config->enable_af_xdp && !sc_config->af_xdp_iface){
+        SC_ERROR_DETAILS("must specified af_xdp_iface while enabling af_xdp");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* check whether bind address is specified while enabling kernel socket backend */
+    if(sc_config->enable_socket_backend && !sc_config->socket_bind_addr){
+        SC_ERROR_DETAILS("must specified socket_bind_addr while enabling kernel socket backend");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* memif, vhost-user, af_xdp and kernel socket backend all require a dedicated hugepage file prefix */
+    if((uint8_t)sc_config->enable_memif + (uint8_t)sc_config->enable_vhost_user 
+        + (uint8_t)sc_config->enable_af_xdp + (uint8_t)sc_config->enable_socket_backend > 1){
+        SC_ERROR_DETAILS("only one of memif, vhost-user, af_xdp ports and kernel socket backend "
+            "could be enabled at the same time");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
     /* check whether test duration is specified while enabling test duration limit */
     if(sc_config->enable_test_duration_limit && (sc_config->test_duration == 0)){
         SC_ERROR_DETAILS("must specified test duration while enabling test duration limit");
@@ -591,6 +673,334 @@ invalid_enable_offload:
         SC_ERROR_DETAILS("invalid configuration enable_offload\n");
     }
 
+    /* config: mtu of ports */
+    else if(!strcmp(key, "mtu")){
+        uint16_t mtu;
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (sc_util_atoui_16(value, &mtu) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_mtu;
+        }
+
+        if(mtu != 0 && mtu < RTE_ETHER_MIN_MTU) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_mtu;
+        }
+
+        sc_config->mtu = mtu;
+        goto exit;
+
+invalid_mtu:
+        SC_ERROR_DETAILS("invalid configuration mtu\n");
+    }
+
+    /* config: whether to create memif port */
+    else if(!strcmp(key, "enable_memif")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_memif = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_memif = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_memif;
+        }
+
+        goto exit;
+
+invalid_enable_memif:
+        SC_ERROR_DETAILS("invalid configuration enable_memif\n");
+    }
+
+    /* config: role of the memif port */
+    else if(!strcmp(key, "memif_role")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "server") || !strcmp(value, "master")){
+            sc_config->memif_is_server = true;
+        } else if (!strcmp(value, "client") || !strcmp(value, "slave")){
+            sc_config->memif_is_server = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_memif_role;
+        }
+
+        goto exit;
+
+invalid_memif_role:
+        SC_ERROR_DETAILS("invalid configuration memif_role\n");
+    }
+
+    /* config: id of the memif interface */
+    else if(!strcmp(key, "memif_id")){
+        uint32_t memif_id;
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (sc_util_atoui_32(value, &memif_id) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_memif_id;
+        }
+
+        if(memif_id > UINT16_MAX) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_memif_id;
+        }
+
+        sc_config->memif_id = memif_id;
+        goto exit;
+
+invalid_memif_id:
+        SC_ERROR_DETAILS("invalid configuration memif_id\n");
+    }
+
+    /* config: path to the memif control socket */
+    else if(!strcmp(key, "memif_socket")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        sc_config->memif_socket = (char*)malloc(strlen(value)+1);
+        if(unlikely(!sc_config->memif_socket)){
+            SC_ERROR_DETAILS("Failed to allocate memory for memif_socket");
+            result = SC_ERROR_MEMORY;
+            goto invalid_memif_socket;
+        }
+        memset(sc_config->memif_socket, 0, strlen(value)+1);
+        strcpy(sc_config->memif_socket, value);
+
+        goto exit;
+
+invalid_memif_socket:
+        SC_ERROR_DETAILS("invalid configuration memif_socket\n");
+    }
+
+    /* config: whether to enable memif zero-copy */
+    else if(!strcmp(key, "enable_memif_zero_copy")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_memif_zero_copy = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_memif_zero_copy = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_memif_zero_copy;
+        }
+
+        goto exit;
+
+invalid_enable_memif_zero_copy:
+        SC_ERROR_DETAILS("invalid configuration enable_memif_zero_copy\n");
+    }
+
+    /* config: whether to create vhost-user port */
+    else if(!strcmp(key, "enable_vhost_user")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_vhost_user = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_vhost_user = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_vhost_user;
+        }
+
+        goto exit;
+
+invalid_enable_vhost_user:
+        SC_ERROR_DETAILS("invalid configuration enable_vhost_user\n");
+    }
+
+    /* config: role of the vhost-user port */
+    else if(!strcmp(key, "vhost_user_role")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "backend")){
+            sc_config->vhost_user_is_backend = true;
+        } else if (!strcmp(value, "frontend")){
+            sc_config->vhost_user_is_backend = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_vhost_user_role;
+        }
+
+        goto exit;
+
+invalid_vhost_user_role:
+        SC_ERROR_DETAILS("invalid configuration vhost_user_role\n");
+    }
+
+    /* config: path to the vhost-user socket */
+    else if(!strcmp(key, "vhost_user_socket")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        sc_config->vhost_user_socket = (char*)malloc(strlen(value)+1);
+        if(unlikely(!sc_config->vhost_user_socket)){
+            SC_ERROR_DETAILS("Failed to allocate memory for vhost_user_socket");
+            result = SC_ERROR_MEMORY;
+            goto invalid_vhost_user_socket;
+        }
+        memset(sc_config->vhost_user_socket, 0, strlen(value)+1);
+        strcpy(sc_config->vhost_user_socket, value);
+
+        goto exit;
+
+invalid_vhost_user_socket:
+        SC_ERROR_DETAILS("invalid configuration vhost_user_socket\n");
+    }
+
+    /* config: whether to create af_xdp port */
+    else if(!strcmp(key, "enable_af_xdp")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_af_xdp = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_af_xdp = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_af_xdp;
+        }
+
+        goto exit;
+
+invalid_enable_af_xdp:
+        SC_ERROR_DETAILS("invalid configuration enable_af_xdp\n");
+    }
+
+    /* config: kernel interface bound by the af_xdp port */
+    else if(!strcmp(key, "af_xdp_iface")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        sc_config->af_xdp_iface = (char*)malloc(strlen(value)+1);
+        if(unlikely(!sc_config->af_xdp_iface)){
+            SC_ERROR_DETAILS("Failed to allocate memory for af_xdp_iface");
+            result = SC_ERROR_MEMORY;
+            goto invalid_af_xdp_iface;
+        }
+        memset(sc_config->af_xdp_iface, 0, strlen(value)+1);
+        strcpy(sc_config->af_xdp_iface, value);
+
+        goto exit;
+
+invalid_af_xdp_iface:
+        SC_ERROR_DETAILS("invalid configuration af_xdp_iface\n");
+    }
+
+    /* config: path to the customized xdp program */
+    else if(!strcmp(key, "af_xdp_prog")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        sc_config->af_xdp_prog = (char*)malloc(strlen(value)+1);
+        if(unlikely(!sc_config->af_xdp_prog)){
+            SC_ERROR_DETAILS("Failed to allocate memory for af_xdp_prog");
+            result = SC_ERROR_MEMORY;
+            goto invalid_af_xdp_prog;
+        }
+        memset(sc_config->af_xdp_prog, 0, strlen(value)+1);
+        strcpy(sc_config->af_xdp_prog, value);
+
+        goto exit;
+
+invalid_af_xdp_prog:
+        SC_ERROR_DETAILS("invalid configuration af_xdp_prog\n");
+    }
+
+    /* config: first kernel queue bound by the af_xdp port */
+    else if(!strcmp(key, "af_xdp_start_queue")){
+        uint16_t af_xdp_start_queue;
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (sc_util_atoui_16(value, &af_xdp_start_queue) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_af_xdp_start_queue;
+        }
+
+        sc_config->af_xdp_start_queue = af_xdp_start_queue;
+        goto exit;
+
+invalid_af_xdp_start_queue:
+        SC_ERROR_DETAILS("invalid configuration af_xdp_start_queue\n");
+    }
+
+    /* config: busy polling budget of the af_xdp port */
+    else if(!strcmp(key, "af_xdp_busy_budget")){
+        uint16_t af_xdp_busy_budget;
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (sc_util_atoui_16(value, &af_xdp_busy_budget) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_af_xdp_busy_budget;
+        }
+
+        sc_config->af_xdp_busy_budget = af_xdp_busy_budget;
+        goto exit;
+
+invalid_af_xdp_busy_budget:
+        SC_ERROR_DETAILS("invalid configuration af_xdp_busy_budget\n");
+    }
+
+    /* config: whether to use kernel socket backend */
+    else if(!strcmp(key, "enable_socket_backend")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_socket_backend = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_socket_backend = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_socket_backend;
+        }
+
+        goto exit;
+
+invalid_enable_socket_backend:
+        SC_ERROR_DETAILS("invalid configuration enable_socket_backend\n");
+    }
+
+    /* config: ipv4 address bound by kernel socket backend */
+    else if(!strcmp(key, "socket_bind_addr")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+
+        sc_config->socket_bind_addr = (char*)malloc(strlen(value)+1);
+        if(unlikely(!sc_config->socket_bind_addr)){
+            SC_ERROR_DETAILS("Failed to allocate memory for socket_bind_addr");
+            result = SC_ERROR_MEMORY;
+            goto invalid_socket_bind_addr;
+        }
+        memset(sc_config->socket_bind_addr, 0, strlen(value)+1);
+        strcpy(sc_config->socket_bind_addr, value);
+
+        goto exit;
+
+invalid_socket_bind_addr:
+        SC_ERROR_DETAILS("invalid configuration socket_bind_addr\n");
+    }
+
+    /* config: udp port bound by kernel socket backend */
+    else if(!strcmp(key, "socket_bind_port")){
+        uint16_t socket_bind_port;
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (sc_util_atoui_16(value, &socket_bind_port) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_socket_bind_port;
+        }
+
+        sc_config->socket_bind_port = socket_bind_port;
+        goto exit;
+
+invalid_socket_bind_port:
+        SC_ERROR_DETAILS("invalid configuration socket_bind_port\n");
+    }
+
     /* config: rss symmetric mode */
     else if(!strcmp(key, "rss_symmetric_mode")){
         value = sc_util_del_both_trim(value);
@@ -690,6 +1100,57 @@ invalid_rss_hash_field:
         SC_ERROR_DETAILS("invalid configuration rss_hash_field\n");
     }
 
+    /* config: whether to enable flow isolation */
+    else if(!strcmp(key, "enable_flow_isolation")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_flow_isolation = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_flow_isolation = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_flow_isolation;
+        }
+
+        goto exit;
+
+invalid_enable_flow_isolation:
+        SC_ERROR_DETAILS("invalid configuration enable_flow_isolation\n");
+    }
+
+    /* config: rte_flow rule (could be specified multiple times) */
+    else if(!strcmp(key, "flow_rule")){
+        struct sc_flow_rule *flow_rule;
+
+        if(sc_config->nb_flow_rules >= SC_MAX_NB_FLOW_RULES){
+            SC_ERROR_DETAILS("too many flow rules, try modify macro SC_MAX_NB_FLOW_RULES (%d)",
+                SC_MAX_NB_FLOW_RULES);
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_rule;
+        }
+
+        flow_rule = (struct sc_flow_rule*)malloc(sizeof(struct sc_flow_rule));
+        if(unlikely(!flow_rule)){
+            SC_ERROR_DETAILS("Failed to allocate memory for flow_rule");
+            result = SC_ERROR_MEMORY;
+            goto invalid_flow_rule;
+        }
+
+        if(sc_flow_parse_rule(value, flow_rule) != SC_SUCCESS){
+            free(flow_rule);
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_flow_rule;
+        }
+
+        sc_config->flow_rules[sc_config->nb_flow_rules] = flow_rule;
+        sc_config->nb_flow_rules += 1;
+        goto exit;
+
+invalid_flow_rule:
+        SC_ERROR_DETAILS("invalid configuration flow_rule\n");
+    }
+
     /* config: number of cores to used */
     else if(!strcmp(key, "used_core_ids")){
         uint16_t nb_used_cores = 0;
@@ -801,6 +1262,41 @@ invalid_test_duration:
         SC_ERROR_DETAILS("invalid configuration test_duration\n");
     }
 
+    /* config: seed of random generators */
+    else if(!strcmp(key, "prng_seed")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        uint64_t prng_seed;
+        if(sc_util_atoui_64(value, &prng_seed) != SC_SUCCESS) {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_prng_seed;
+        }
+        sc_config->prng_seed = prng_seed;
+        goto exit;
+
+invalid_prng_seed:
+        SC_ERROR_DETAILS("invalid configuration prng_seed\n");
+    }
+
+    /* config: whether to stamp per-stage tsc into trailers of received packets */
+    else if(!strcmp(key, "enable_stage_stamps")){
+        value = sc_util_del_both_trim(value);
+        sc_util_del_change_line(value);
+        if (!strcmp(value, "true")){
+            sc_config->enable_stage_stamps = true;
+        } else if (!strcmp(value, "false")){
+            sc_config->enable_stage_stamps = false;
+        } else {
+            result = SC_ERROR_INVALID_VALUE;
+            goto invalid_enable_stage_stamps;
+        }
+
+        goto exit;
+
+invalid_enable_stage_stamps:
+        SC_ERROR_DETAILS("invalid configuration enable_stage_stamps\n");
+    }
+
     /* DOCA-specific configurations for DPDK */
     #if defined(SC_HAS_DOCA)
         /* config: whether to enable test duration limit */
@@ -2,6 +2,7 @@
 #include "sc_utils.hpp"
 #include "sc_mbuf.hpp"
 #include "sc_port.hpp"
+#include "sc_vdev.hpp"
 
 /*!
  * \brief   initialize dpdk memory
@@ -10,6 +11,7 @@
  */
 int init_memory(struct sc_config *sc_config){
     int port_logical_id, queue_id;
+    uint32_t nb_rx_mbufs;
     uint16_t nb_used_ports;
     uint16_t port_indices[SC_MAX_USED_PORTS];
     struct rte_mempool *pktmbuf_pool;
@@ -48,17 +50,30 @@ int init_memory(struct sc_config *sc_config){
             /* set the name of the mbuf pool */
             memset(mbuf_pool_name, 0, sizeof(mbuf_pool_name));
             sprintf(mbuf_pool_name, "rx_p%d_q%d", port_logical_id, queue_id);
+
+            /*!
+             * \note: should make sure number of element in the mbuf pool 
+             * is greater or equal to sc_config->rx_queue_len, and at the
+             * same time the dpdk suggest it should be a power of two minus 
+             * one, so we use sc_config->rx_queue_len*2-1
+             */
+            nb_rx_mbufs = sc_config->rx_queue_len*2-1;
+
+            /*!
+             * \note: the rx mbuf pool is used as UMEM of the XSK by af_xdp PMD,
+             * which should hold the fill ring, the rx ring, mbufs in flight 
+             * inside application and the per-core cache at the same time
+             */
+            if(sc_vdev_is_af_xdp_port(port_indices[port_logical_id])){
+                nb_rx_mbufs = sc_config->rx_queue_len*4-1;
+                SC_LOG("UMEM of af_xdp port %d queue %d contains %u frames (%u bytes per frame)",
+                    port_logical_id, queue_id, nb_rx_mbufs, RTE_MBUF_DEFAULT_BUF_SIZE);
+            }
             
             /* allocate mbuf pool */
             pktmbuf_pool = rte_pktmbuf_pool_create(
                 /* name */ mbuf_pool_name, 
-                /*!
-                 * \note: should make sure number of element in the mbuf pool 
-                 * is greater or equal to sc_config->rx_queue_len, and at the
-                 * same time the dpdk suggest it should be a power of two minus 
-                 * one, so we use sc_config->rx_queue_len*2-1
-                 */
-                /* n */ sc_config->rx_queue_len*2-1, 
+                /* n */ nb_rx_mbufs, 
                 /* cache_size */ MEMPOOL_CACHE_SIZE, 
                 /* priv_size */ 0, 
                 /* data_room_size */ RTE_MBUF_DEFAULT_BUF_SIZE, 
@@ -2,6 +2,9 @@
 #include "sc_utils.hpp"
 #include "sc_port.hpp"
 #include "sc_mbuf.hpp"
+#include "sc_flow.hpp"
+#include "sc_vdev.hpp"
+#include "sc_utils/rss.hpp"
 
 int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct sc_config *sc_config);
 static bool _is_port_choosed(uint16_t port_index, struct sc_config *sc_config);
@@ -192,9 +195,56 @@ int init_ports(struct sc_config *sc_config){
     }
 
     sc_config->nb_used_ports = i;
+
+    /* emulate rss of the first port, for steering generated flows into the wanted queue */
+    if(sc_config->enable_rss && sc_config->nb_used_ports > 0 && used_rss_hash_key){
+        if(sc_util_rss_emu_init(&used_rss_emulator, sc_config->port_ids[0], sc_config->nb_rx_rings_per_port,
+                sc_config->rss_hash_field, used_rss_hash_key, RSS_HASH_KEY_LENGTH) != SC_SUCCESS){
+            SC_WARNING_DETAILS("failed to initialize rss emulator of port %u, flows are steered by rejection",
+                sc_config->port_ids[0]);
+        }
+    }
+
     return SC_SUCCESS;
 }
 
+/*!
+ * \brief   destroy installed flow rules, then stop and close all used ports
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully closing
+ */
+int close_ports(struct sc_config *sc_config){
+    int ret, result = SC_SUCCESS;
+    uint16_t i;
+
+    for(i=0; i<sc_config->nb_used_ports; i++){
+        if(destroy_flow_rules(sc_config, i) != SC_SUCCESS){
+            SC_WARNING_DETAILS("failed to destroy flow rules on port %u", sc_config->sc_port[i].port_id);
+            result = SC_ERROR_INTERNAL;
+        }
+
+        /* rte_eth_dev_stop and rte_eth_dev_close return void before 20.11 */
+        #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 0, 0)
+            ret = rte_eth_dev_stop(sc_config->sc_port[i].port_id);
+            if(ret != 0){
+                SC_WARNING_DETAILS("failed to stop port %u: %s", sc_config->sc_port[i].port_id, rte_strerror(-ret));
+                result = SC_ERROR_INTERNAL;
+            }
+            ret = rte_eth_dev_close(sc_config->sc_port[i].port_id);
+            if(ret != 0){
+                SC_WARNING_DETAILS("failed to close port %u: %s", sc_config->sc_port[i].port_id, rte_strerror(-ret));
+                result = SC_ERROR_INTERNAL;
+            }
+        #else
+            rte_eth_dev_stop(sc_config->sc_port[i].port_id);
+            rte_eth_dev_close(sc_config->sc_port[i].port_id);
+        #endif
+    }
+    sc_config->nb_used_ports = 0;
+
+    return result;
+}
+
 /*!
  * \brief   initialize a specified port
  * \param   port_index          the actual index of the init port
@@ -205,6 +255,7 @@ int init_ports(struct sc_config *sc_config){
 int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct sc_config *sc_config){
     int ret;
     uint16_t i;
+    uint32_t max_frame_len;
     struct rte_eth_conf port_conf = port_conf_default;
 	struct rte_ether_addr eth_addr;
     struct rte_eth_dev_info dev_info;
@@ -277,8 +328,61 @@ int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct s
         #endif
     }
 
+    /* configure mtu, frames beyond the data room of a single mbuf are scattered into chained mbufs */
+    if(sc_config->mtu > 0){
+        if(sc_config->mtu < dev_info.min_mtu || sc_config->mtu > dev_info.max_mtu){
+            SC_ERROR_DETAILS("mtu %u isn't supported by port %d, should be within [%u, %u]\n",
+                sc_config->mtu, port_index, dev_info.min_mtu, dev_info.max_mtu);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        max_frame_len = sc_config->mtu + RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN;
+
+        #if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
+            port_conf.rxmode.mtu = sc_config->mtu;
+        #else
+            port_conf.rxmode.max_rx_pkt_len = max_frame_len;
+            if(max_frame_len > RTE_ETHER_MAX_LEN){
+                port_conf.rxmode.offloads |= DEV_RX_OFFLOAD_JUMBO_FRAME;
+            }
+        #endif
+
+        if(max_frame_len > RTE_MBUF_DEFAULT_DATAROOM){
+            #if RTE_VERSION >= RTE_VERSION_NUM(22, 3, 255, 255)
+                if (!(dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_SCATTER)){
+                    SC_ERROR_DETAILS("port %d doesn't support scattered rx, which is required by mtu %u\n",
+                        port_index, sc_config->mtu);
+                    return SC_ERROR_INVALID_VALUE;
+                }
+                port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_SCATTER;
+                if (dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MULTI_SEGS){
+                    port_conf.txmode.offloads |= RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+                } else {
+                    SC_WARNING_DETAILS("port %d doesn't support multi-segment tx, frames beyond %u bytes might be dropped",
+                        port_index, RTE_MBUF_DEFAULT_DATAROOM);
+                }
+            #else
+                if (!(dev_info.rx_offload_capa & DEV_RX_OFFLOAD_SCATTER)){
+                    SC_ERROR_DETAILS("port %d doesn't support scattered rx, which is required by mtu %u\n",
+                        port_index, sc_config->mtu);
+                    return SC_ERROR_INVALID_VALUE;
+                }
+                port_conf.rxmode.offloads |= DEV_RX_OFFLOAD_SCATTER;
+                if (dev_info.tx_offload_capa & DEV_TX_OFFLOAD_MULTI_SEGS){
+                    port_conf.txmode.offloads |= DEV_TX_OFFLOAD_MULTI_SEGS;
+                } else {
+                    SC_WARNING_DETAILS("port %d doesn't support multi-segment tx, frames beyond %u bytes might be dropped",
+                        port_index, RTE_MBUF_DEFAULT_DATAROOM);
+                }
+            #endif
+        }
+    }
+
     /* configure rss */
-    if(sc_config->enable_rss){
+    if(sc_config->enable_rss && !(dev_info.flow_type_rss_offloads & sc_config->rss_hash_field)){
+        /* e.g. virtual devices like memif, vhost and af_xdp */
+        SC_WARNING_DETAILS("port %d doesn't support specified rss hash fields, rss is disabled on it",
+            port_index);
+    } else if(sc_config->enable_rss){
         /* specify using rss */
         #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
             port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
@@ -298,7 +402,17 @@ int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct s
         }
         
         /* specify rss hash fields */
-        port_conf.rx_adv_conf.rss_conf.rss_hf = sc_config->rss_hash_field;
+        port_conf.rx_adv_conf.rss_conf.rss_hf = sc_config->rss_hash_field & dev_info.flow_type_rss_offloads;
+        if(port_conf.rx_adv_conf.rss_conf.rss_hf != sc_config->rss_hash_field){
+            SC_WARNING_DETAILS("port %d only supports part of specified rss hash fields (0x%lx of 0x%lx)",
+                port_index, port_conf.rx_adv_conf.rss_conf.rss_hf, sc_config->rss_hash_field);
+        }
+    }
+
+    /* initialize virtual device specific settings (if it's a virtual device) */
+    if(init_vdev_port(sc_config, port_index) != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to initialize virtual device settings of port %d\n", port_index);
+        return SC_ERROR_INTERNAL;
     }
 
     /* obtain mac address of the port */
@@ -309,6 +423,12 @@ int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct s
         return SC_ERROR_INTERNAL;
     }
 
+    /* prepare flow isolation and rx metadata delivery before configuring the port */
+    if(init_flow_isolation(sc_config, port_index) != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to prepare flow rules on port %d\n", port_index);
+        return SC_ERROR_INTERNAL;
+    }
+
     /* configure the port */
     ret = rte_eth_dev_configure(
         port_index, sc_config->nb_rx_rings_per_port, 
@@ -360,6 +480,12 @@ int _init_single_port(uint16_t port_index, uint16_t port_logical_index, struct s
         return SC_ERROR_INTERNAL;
     }
 
+    /* install rte_flow rules */
+    if(init_flow_rules(sc_config, port_index, port_logical_index) != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to install flow rules on port %d\n", port_index);
+        return SC_ERROR_INTERNAL;
+    }
+
     /* set as promiscuous mode (if enabled) */
     if(sc_config->enable_promiscuous){
 		ret = rte_eth_promiscuous_enable(port_index);
@@ -394,6 +520,10 @@ static bool _is_port_choosed(uint16_t port_index, struct sc_config *sc_config){
     struct rte_ether_addr mac;
     char ebuf[RTE_ETHER_ADDR_FMT_SIZE];
 
+    /* virtual devices created by SoConnect are selected by name */
+    if(sc_vdev_is_port_choosed(port_index))
+        return true;
+
     ret = rte_eth_macaddr_get(port_index, &mac);
     if (ret == 0)
         rte_ether_format_addr(ebuf, sizeof(ebuf), &mac);
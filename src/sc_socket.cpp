@@ -0,0 +1,316 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_socket.hpp"
+
+/* indicator of whether the kernel socket backend is used */
+bool sc_socket_backend_enabled = false;
+
+/*!
+ * \brief address bound by sockets of all worker threads (network byte order)
+ */
+static struct sockaddr_in _bind_addr;
+
+/*!
+ * \brief the (null) port that represents the kernel socket backend
+ */
+static uint16_t _socket_port_id;
+static struct rte_ether_addr _socket_port_mac;
+
+/*!
+ * \brief per-thread socket and message buffers
+ */
+static __thread int _socket_fd = -1;
+static __thread struct rte_mbuf *_rx_mbufs[SC_SOCKET_MAX_BURST];
+static __thread uint16_t _nb_rx_mbufs = 0;
+static __thread uint64_t _nb_rx_truncated = 0;  /* datagrams larger than a receive buffer */
+static __thread struct mmsghdr _rx_msgs[SC_SOCKET_MAX_BURST];
+static __thread struct iovec _rx_iovs[SC_SOCKET_MAX_BURST];
+static __thread struct sockaddr_in _rx_addrs[SC_SOCKET_MAX_BURST];
+static __thread struct mmsghdr _tx_msgs[SC_SOCKET_MAX_BURST];
+static __thread struct iovec _tx_iovs[SC_SOCKET_MAX_BURST];
+static __thread struct sockaddr_in _tx_addrs[SC_SOCKET_MAX_BURST];
+
+static void _fill_socket_pkt_hdr(struct rte_mbuf *pkt, struct sockaddr_in *src_addr, uint16_t payload_len);
+
+/*!
+ * \brief   initialize the kernel socket backend, should be invoked after
+ *          all ports are initialized
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
+ */
+int init_socket_backend(struct sc_config *sc_config){
+    int ret;
+
+    if(!sc_config->enable_socket_backend)
+        return SC_SUCCESS;
+
+    #if defined(ROLE_CLIENT)
+        SC_ERROR_DETAILS("kernel socket backend only supports applications with server role");
+        return SC_ERROR_NOT_IMPLEMENTED;
+    #endif
+
+    /* the null port is the only used port while using kernel socket backend */
+    if(sc_config->nb_used_ports != 1){
+        SC_ERROR_DETAILS("kernel socket backend expects exactly one used port, %u ports are used",
+            sc_config->nb_used_ports);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    _socket_port_id = sc_config->sc_port[0].port_id;
+    ret = rte_eth_macaddr_get(_socket_port_id, &_socket_port_mac);
+    if(ret != 0){
+        SC_ERROR_DETAILS("failed to obtain mac address of port %u: %s",
+            _socket_port_id, rte_strerror(-ret));
+        return SC_ERROR_INTERNAL;
+    }
+
+    memset(&_bind_addr, 0, sizeof(struct sockaddr_in));
+    _bind_addr.sin_family = AF_INET;
+    _bind_addr.sin_port = htons(sc_config->socket_bind_port);
+    if(inet_pton(AF_INET, sc_config->socket_bind_addr, &_bind_addr.sin_addr) != 1){
+        SC_ERROR_DETAILS("invalid socket bind address %s", sc_config->socket_bind_addr);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    sc_socket_backend_enabled = true;
+    SC_LOG("using kernel socket backend, all worker threads bind to %s:%u",
+        sc_config->socket_bind_addr, sc_config->socket_bind_port);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   create the socket of current worker thread, all worker threads bind
+ *          to the same address with SO_REUSEPORT, so that kernel distributes
+ *          flows across worker threads (just like RSS)
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
+ */
+int sc_socket_init_worker(struct sc_config *sc_config){
+    int fd, enable = 1;
+    uint16_t i;
+
+    if(!sc_socket_backend_enabled)
+        return SC_SUCCESS;
+
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if(fd < 0){
+        SC_THREAD_ERROR_DETAILS("failed to create socket: %s", strerror(errno));
+        return SC_ERROR_INTERNAL;
+    }
+
+    if(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0){
+        SC_THREAD_ERROR_DETAILS("failed to set SO_REUSEPORT: %s", strerror(errno));
+        close(fd);
+        return SC_ERROR_INTERNAL;
+    }
+
+    if(bind(fd, (struct sockaddr*)&_bind_addr, sizeof(struct sockaddr_in)) != 0){
+        SC_THREAD_ERROR_DETAILS("failed to bind socket: %s", strerror(errno));
+        close(fd);
+        return SC_ERROR_INTERNAL;
+    }
+
+    /* message headers are reused across bursts */
+    memset(_rx_msgs, 0, sizeof(_rx_msgs));
+    memset(_tx_msgs, 0, sizeof(_tx_msgs));
+    for(i=0; i<SC_SOCKET_MAX_BURST; i++){
+        _rx_msgs[i].msg_hdr.msg_iov = &_rx_iovs[i];
+        _rx_msgs[i].msg_hdr.msg_iovlen = 1;
+        _rx_msgs[i].msg_hdr.msg_name = &_rx_addrs[i];
+        _tx_msgs[i].msg_hdr.msg_iov = &_tx_iovs[i];
+        _tx_msgs[i].msg_hdr.msg_iovlen = 1;
+        _tx_msgs[i].msg_hdr.msg_name = &_tx_addrs[i];
+        _tx_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    _socket_fd = fd;
+    _nb_rx_mbufs = 0;
+    _nb_rx_truncated = 0;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   close the socket of current worker thread
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully closing
+ */
+int sc_socket_exit_worker(struct sc_config *sc_config){
+    if(_socket_fd < 0)
+        return SC_SUCCESS;
+
+    if(_nb_rx_mbufs > 0){
+        rte_pktmbuf_free_bulk(_rx_mbufs, _nb_rx_mbufs);
+        _nb_rx_mbufs = 0;
+    }
+
+    if(_nb_rx_truncated > 0){
+        SC_THREAD_WARNING_DETAILS("%lu datagram(s) larger than the receive buffer are dropped", _nb_rx_truncated);
+    }
+
+    close(_socket_fd);
+    _socket_fd = -1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   receive a burst of datagrams through recvmmsg, each payload is
+ *          stored inside a mbuf behind synthesized eth/ipv4/udp headers,
+ *          datagrams truncated by the size of the mbuf are dropped
+ * \param   sc_config   the global configuration
+ * \param   queue_id    the queue used by current worker thread
+ * \param   pkts        the received packets
+ * \param   nb_pkts     maximum number of packets to be received
+ * \return  number of received packets
+ */
+uint16_t sc_socket_rx_burst(struct sc_config *sc_config, uint16_t queue_id, struct rte_mbuf **pkts, uint16_t nb_pkts){
+    int nb_recv;
+    uint16_t i, nb_valid = 0;
+    struct rte_mempool *mp;
+
+    if(nb_pkts > SC_SOCKET_MAX_BURST)
+        nb_pkts = SC_SOCKET_MAX_BURST;
+
+    /* refill receive buffers */
+    if(_nb_rx_mbufs < nb_pkts){
+        mp = sc_config->rx_pktmbuf_pool[RX_QUEUE_MEMORY_POOL_ID(sc_config, 0, queue_id)];
+        if(likely(0 == rte_pktmbuf_alloc_bulk(mp, &_rx_mbufs[_nb_rx_mbufs], nb_pkts - _nb_rx_mbufs))){
+            for(i=_nb_rx_mbufs; i<nb_pkts; i++){
+                _rx_iovs[i].iov_base = rte_pktmbuf_mtod_offset(_rx_mbufs[i], void*, SC_SOCKET_HDR_LEN);
+                _rx_iovs[i].iov_len = rte_pktmbuf_tailroom(_rx_mbufs[i]) - SC_SOCKET_HDR_LEN;
+            }
+            _nb_rx_mbufs = nb_pkts;
+        }
+    }
+    if(unlikely(_nb_rx_mbufs == 0))
+        return 0;
+
+    for(i=0; i<_nb_rx_mbufs; i++)
+        _rx_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+
+    nb_recv = recvmmsg(_socket_fd, _rx_msgs, _nb_rx_mbufs, MSG_DONTWAIT, NULL);
+    if(nb_recv <= 0)
+        return 0;
+
+    for(i=0; i<nb_recv; i++){
+        if(unlikely(_rx_msgs[i].msg_hdr.msg_flags & MSG_TRUNC)){
+            rte_pktmbuf_free(_rx_mbufs[i]);
+            _nb_rx_truncated += 1;
+            continue;
+        }
+        _fill_socket_pkt_hdr(_rx_mbufs[i], &_rx_addrs[i], _rx_msgs[i].msg_len);
+        pkts[nb_valid++] = _rx_mbufs[i];
+    }
+
+    /* move the unused receive buffers to the front */
+    for(i=nb_recv; i<_nb_rx_mbufs; i++){
+        _rx_mbufs[i-nb_recv] = _rx_mbufs[i];
+        _rx_iovs[i-nb_recv] = _rx_iovs[i];
+    }
+    _nb_rx_mbufs -= nb_recv;
+
+    return nb_valid;
+}
+
+/*!
+ * \brief   send a burst of packets through sendmmsg, the udp payload of each
+ *          packet is sent to the destination inside its ipv4/udp header; if the
+ *          destination is the bound address (i.e. the packet is forwarded as is),
+ *          the payload is echoed back to the source, all packets are freed
+ * \param   pkts        the packets to be sent
+ * \param   nb_pkts     number of packets to be sent
+ * \return  number of sent packets
+ */
+uint16_t sc_socket_tx_burst(struct rte_mbuf **pkts, uint16_t nb_pkts){
+    int nb_sent, total_sent = 0;
+    uint16_t i, nb_burst;
+    uint32_t hdr_len;
+    struct rte_ipv4_hdr *ipv4_hdr;
+    struct rte_udp_hdr *udp_hdr;
+
+    while(total_sent < nb_pkts){
+        nb_burst = RTE_MIN(nb_pkts - total_sent, SC_SOCKET_MAX_BURST);
+
+        for(i=0; i<nb_burst; i++){
+            ipv4_hdr = rte_pktmbuf_mtod_offset(
+                pkts[total_sent+i], struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+            hdr_len = sizeof(struct rte_ether_hdr) + rte_ipv4_hdr_len(ipv4_hdr);
+            udp_hdr = rte_pktmbuf_mtod_offset(pkts[total_sent+i], struct rte_udp_hdr*, hdr_len);
+            hdr_len += sizeof(struct rte_udp_hdr);
+
+            _tx_addrs[i].sin_family = AF_INET;
+            if(ipv4_hdr->dst_addr == _bind_addr.sin_addr.s_addr && udp_hdr->dst_port == _bind_addr.sin_port){
+                _tx_addrs[i].sin_addr.s_addr = ipv4_hdr->src_addr;
+                _tx_addrs[i].sin_port = udp_hdr->src_port;
+            } else {
+                _tx_addrs[i].sin_addr.s_addr = ipv4_hdr->dst_addr;
+                _tx_addrs[i].sin_port = udp_hdr->dst_port;
+            }
+
+            /* only the first segment is sent */
+            _tx_iovs[i].iov_base = rte_pktmbuf_mtod_offset(pkts[total_sent+i], void*, hdr_len);
+            _tx_iovs[i].iov_len = rte_pktmbuf_data_len(pkts[total_sent+i]) > hdr_len ?
+                rte_pktmbuf_data_len(pkts[total_sent+i]) - hdr_len : 0;
+        }
+
+        nb_sent = sendmmsg(_socket_fd, _tx_msgs, nb_burst, MSG_DONTWAIT);
+        if(nb_sent <= 0)
+            break;
+        total_sent += nb_sent;
+        if(nb_sent < nb_burst)
+            break;
+    }
+
+    rte_pktmbuf_free_bulk(pkts, nb_pkts);
+
+    return total_sent;
+}
+
+/*!
+ * \brief   synthesize eth/ipv4/udp headers in front of the received payload
+ * \param   pkt         the mbuf which carries the payload
+ * \param   src_addr    address of the sender
+ * \param   payload_len length of the payload
+ */
+static void _fill_socket_pkt_hdr(struct rte_mbuf *pkt, struct sockaddr_in *src_addr, uint16_t payload_len){
+    struct rte_ether_hdr *eth_hdr;
+    struct rte_ipv4_hdr *ipv4_hdr;
+    struct rte_udp_hdr *udp_hdr;
+
+    eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr*);
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+        memset(&eth_hdr->src_addr, 0, sizeof(struct rte_ether_addr));
+        rte_ether_addr_copy(&_socket_port_mac, &eth_hdr->dst_addr);
+    #else
+        memset(&eth_hdr->s_addr, 0, sizeof(struct rte_ether_addr));
+        rte_ether_addr_copy(&_socket_port_mac, &eth_hdr->d_addr);
+    #endif
+    eth_hdr->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+    ipv4_hdr = (struct rte_ipv4_hdr*)(eth_hdr + 1);
+    memset(ipv4_hdr, 0, sizeof(struct rte_ipv4_hdr));
+    ipv4_hdr->version_ihl = RTE_IPV4_VHL_DEF;
+    ipv4_hdr->total_length = rte_cpu_to_be_16(
+        sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr) + payload_len);
+    ipv4_hdr->time_to_live = 64;
+    ipv4_hdr->next_proto_id = IPPROTO_UDP;
+    ipv4_hdr->src_addr = src_addr->sin_addr.s_addr;
+    ipv4_hdr->dst_addr = _bind_addr.sin_addr.s_addr;
+
+    udp_hdr = (struct rte_udp_hdr*)(ipv4_hdr + 1);
+    udp_hdr->src_port = src_addr->sin_port;
+    udp_hdr->dst_port = _bind_addr.sin_port;
+    udp_hdr->dgram_len = rte_cpu_to_be_16(sizeof(struct rte_udp_hdr) + payload_len);
+    udp_hdr->dgram_cksum = 0;
+
+    pkt->data_len = SC_SOCKET_HDR_LEN + payload_len;
+    pkt->pkt_len = pkt->data_len;
+    pkt->nb_segs = 1;
+    pkt->port = _socket_port_id;
+}
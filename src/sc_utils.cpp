@@ -1,6 +1,7 @@
 #include "sc_global.hpp"
 #include "sc_utils.hpp"
 #include "sc_control_plane.hpp"
+#include "sc_utils/prng.hpp"
 
 /* ==================== core operation ==================== */
 
@@ -191,7 +192,7 @@ int sc_util_parse_config(
         FILE* fp, struct sc_config* sc_config, 
         int (*parse_kv_pair)(char* key, char *value, struct sc_config* sc_config)){
     char buf[512];
-    char s[64];
+    char s[512];
     char* delim = "=";
     char ch;
     char *p, *key, *value;
@@ -329,11 +330,7 @@ int sc_util_atolf(char *in, double *out){
  * \return  the generated value
  */
 uint64_t sc_util_random_unsigned_int64(){
-    uint16_t i;
-    uint64_t r=0;
-    for(i=0; i<64; i++)
-        r = r*2+rand()%2;
-    return r;
+    return (uint64_t)sc_util_rand();
 }
 
 /*!
@@ -341,11 +338,7 @@ uint64_t sc_util_random_unsigned_int64(){
  * \return  the generated value
  */
 uint32_t sc_util_random_unsigned_int32(){
-    uint16_t i;
-    uint32_t r=0;
-    for(i=0; i<32; i++)
-        r = r*2+rand()%2;
-    return r;
+    return (uint32_t)sc_util_rand();
 }
 
 /*!
@@ -353,11 +346,7 @@ uint32_t sc_util_random_unsigned_int32(){
  * \return  the generated value
  */
 uint16_t sc_util_random_unsigned_int16(){
-    uint16_t i;
-    uint16_t r=0;
-    for(i=0; i<16; i++)
-        r = r*2+rand()%2;
-    return r;
+    return (uint16_t)sc_util_rand();
 }
 
 /*!
@@ -365,11 +354,7 @@ uint16_t sc_util_random_unsigned_int16(){
  * \return  the generated value
  */
 uint8_t sc_util_random_unsigned_int8(){
-    uint16_t i;
-    uint8_t r=0;
-    for(i=0; i<16; i++)
-        r = r*2+rand()%2;
-    return r;
+    return (uint8_t)sc_util_rand();
 }
 
 
@@ -0,0 +1,73 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/alias.hpp"
+
+/*!
+ * \brief   build the alias table with Vose's method
+ * \param   weights         the (unnormalized) weight of each column, overwritten during building
+ * \param   nb_columns      number of columns
+ * \param   alias_threshold probability of picking the column itself, scaled by 2^32
+ * \param   alias_index     index of the alias column of each column
+ * \return  zero for successfully building
+ */
+int sc_util_alias_build(double *weights, uint64_t nb_columns, uint32_t *alias_threshold, uint32_t *alias_index){
+    uint64_t i, nb_small = 0, nb_large = 0;
+    uint32_t s, l, *small = NULL, *large = NULL;
+    double sum = 0.0;
+
+    for(i=0; i<nb_columns; i++) sum += weights[i];
+    if(!(sum > 0)){
+        SC_THREAD_ERROR_DETAILS("sum of weights should be positive");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    small = (uint32_t*)malloc(sizeof(uint32_t)*nb_columns);
+    large = (uint32_t*)malloc(sizeof(uint32_t)*nb_columns);
+    if(unlikely(!small || !large)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for building alias table");
+        if(small) free(small);
+        if(large) free(large);
+        return SC_ERROR_MEMORY;
+    }
+
+    /* scale the weights so that the average is 1 */
+    for(i=0; i<nb_columns; i++){
+        weights[i] = weights[i] * (double)nb_columns / sum;
+        if(weights[i] < 1.0)
+            small[nb_small++] = i;
+        else
+            large[nb_large++] = i;
+    }
+
+    while(nb_small > 0 && nb_large > 0){
+        s = small[--nb_small];
+        l = large[nb_large-1];
+
+        alias_threshold[s] = (uint32_t)(weights[s] * 4294967296.0);
+        alias_index[s] = l;
+
+        weights[l] = (weights[l] + weights[s]) - 1.0;
+        if(weights[l] < 1.0){
+            nb_large--;
+            small[nb_small++] = l;
+        }
+    }
+
+    /* the remaining columns (including those left by numerical error) keep themselves */
+    while(nb_large > 0){
+        l = large[--nb_large];
+        alias_threshold[l] = UINT32_MAX;
+        alias_index[l] = l;
+    }
+    while(nb_small > 0){
+        s = small[--nb_small];
+        alias_threshold[s] = UINT32_MAX;
+        alias_index[s] = s;
+    }
+
+    free(small);
+    free(large);
+
+    return SC_SUCCESS;
+}
@@ -0,0 +1,487 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/cksum.hpp"
+#include "sc_utils/timestamp.hpp"
+
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_byteorder.h>
+
+#if defined(RTE_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(RTE_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+/*!
+ * \note    all implementations accumulate 32-bit words into 64-bit lanes, which is equivalent
+ *          to summing 16-bit words under ones' complement arithmetic (2^16 = 1 mod 2^16-1),
+ *          and independent of the byte order as long as the words are loaded natively
+ */
+
+/*!
+ * \brief   scalar raw checksum, also used for the tails of the vectorized implementations
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial 64-bit partial sum
+ * \return  the 64-bit partial sum
+ */
+static uint64_t _cksum_raw_scalar(const uint8_t *buf, size_t len, uint64_t sum){
+    uint32_t words[4];
+    uint16_t left = 0;
+
+    for(; len >= 16; len -= 16, buf += 16){
+        memcpy(words, buf, 16);
+        sum += (uint64_t)words[0] + words[1] + words[2] + words[3];
+    }
+    for(; len >= 4; len -= 4, buf += 4){
+        memcpy(words, buf, 4);
+        sum += words[0];
+    }
+    if(len >= 2){
+        memcpy(&left, buf, 2);
+        sum += left;
+        len -= 2;
+        buf += 2;
+    }
+    /* the odd byte is padded with zero as the first byte of a 16-bit word */
+    if(len == 1){
+        left = 0;
+        *(uint8_t*)&left = *buf;
+        sum += left;
+    }
+
+    return sum;
+}
+
+#if defined(RTE_ARCH_X86)
+
+/*!
+ * \brief   raw checksum based on avx2, 64 bytes per iteration
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial 64-bit partial sum
+ * \return  the 64-bit partial sum
+ */
+__attribute__((target("avx2")))
+static uint64_t _cksum_raw_avx2(const uint8_t *buf, size_t len, uint64_t sum){
+    const __m256i mask = _mm256_set1_epi64x(0xffffffff);
+    __m256i acc_lo = _mm256_setzero_si256(), acc_hi = _mm256_setzero_si256(), v0, v1;
+    uint64_t lanes[4];
+
+    for(; len >= 64; len -= 64, buf += 64){
+        v0 = _mm256_loadu_si256((const __m256i*)buf);
+        v1 = _mm256_loadu_si256((const __m256i*)(buf + 32));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_and_si256(v0, mask));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_srli_epi64(v0, 32));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_and_si256(v1, mask));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_srli_epi64(v1, 32));
+    }
+    if(len >= 32){
+        v0 = _mm256_loadu_si256((const __m256i*)buf);
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_and_si256(v0, mask));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_srli_epi64(v0, 32));
+        len -= 32;
+        buf += 32;
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(acc_lo, acc_hi));
+    sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    return _cksum_raw_scalar(buf, len, sum);
+}
+
+/*!
+ * \brief   raw checksum based on avx-512, 128 bytes per iteration
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial 64-bit partial sum
+ * \return  the 64-bit partial sum
+ */
+__attribute__((target("avx512f")))
+static uint64_t _cksum_raw_avx512(const uint8_t *buf, size_t len, uint64_t sum){
+    const __m512i mask = _mm512_set1_epi64(0xffffffff);
+    __m512i acc_lo = _mm512_setzero_si512(), acc_hi = _mm512_setzero_si512(), v0, v1;
+
+    for(; len >= 128; len -= 128, buf += 128){
+        v0 = _mm512_loadu_si512((const void*)buf);
+        v1 = _mm512_loadu_si512((const void*)(buf + 64));
+        acc_lo = _mm512_add_epi64(acc_lo, _mm512_and_si512(v0, mask));
+        acc_hi = _mm512_add_epi64(acc_hi, _mm512_srli_epi64(v0, 32));
+        acc_lo = _mm512_add_epi64(acc_lo, _mm512_and_si512(v1, mask));
+        acc_hi = _mm512_add_epi64(acc_hi, _mm512_srli_epi64(v1, 32));
+    }
+    if(len >= 64){
+        v0 = _mm512_loadu_si512((const void*)buf);
+        acc_lo = _mm512_add_epi64(acc_lo, _mm512_and_si512(v0, mask));
+        acc_hi = _mm512_add_epi64(acc_hi, _mm512_srli_epi64(v0, 32));
+        len -= 64;
+        buf += 64;
+    }
+
+    sum += (uint64_t)_mm512_reduce_add_epi64(_mm512_add_epi64(acc_lo, acc_hi));
+
+    return _cksum_raw_scalar(buf, len, sum);
+}
+
+#elif defined(RTE_ARCH_ARM64)
+
+/*!
+ * \brief   raw checksum based on neon, 64 bytes per iteration
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial 64-bit partial sum
+ * \return  the 64-bit partial sum
+ */
+static uint64_t _cksum_raw_neon(const uint8_t *buf, size_t len, uint64_t sum){
+    uint64x2_t acc0 = vdupq_n_u64(0), acc1 = vdupq_n_u64(0);
+
+    /* pairwise add the 32-bit words and accumulate into 64-bit lanes */
+    for(; len >= 64; len -= 64, buf += 64){
+        acc0 = vpadalq_u32(acc0, vreinterpretq_u32_u8(vld1q_u8(buf)));
+        acc1 = vpadalq_u32(acc1, vreinterpretq_u32_u8(vld1q_u8(buf + 16)));
+        acc0 = vpadalq_u32(acc0, vreinterpretq_u32_u8(vld1q_u8(buf + 32)));
+        acc1 = vpadalq_u32(acc1, vreinterpretq_u32_u8(vld1q_u8(buf + 48)));
+    }
+    for(; len >= 16; len -= 16, buf += 16){
+        acc0 = vpadalq_u32(acc0, vreinterpretq_u32_u8(vld1q_u8(buf)));
+    }
+
+    sum += vaddvq_u64(vaddq_u64(acc0, acc1));
+
+    return _cksum_raw_scalar(buf, len, sum);
+}
+
+#endif
+
+/*!
+ * \brief   check whether the implementation is supported by the current cpu,
+ *          vectorized implementations are also bounded by the max simd bitwidth of dpdk
+ *          (i.e., --force-max-simd-bitwidth, avx-512 is disabled by default)
+ * \param   impl    the implementation
+ * \return  whether the implementation is supported
+ */
+bool sc_util_cksum_impl_supported(uint8_t impl){
+    switch(impl){
+        case SC_CKSUM_IMPL_SCALAR:
+            return true;
+
+    #if defined(RTE_ARCH_X86)
+        case SC_CKSUM_IMPL_AVX2:
+            return rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) > 0
+                && rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256;
+
+        case SC_CKSUM_IMPL_AVX512:
+            return rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) > 0
+                && rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512;
+    #elif defined(RTE_ARCH_ARM64)
+        case SC_CKSUM_IMPL_NEON:
+            return rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128;
+    #endif
+
+        default:
+            return false;
+    }
+}
+
+/*!
+ * \brief   obtain the name of the implementation
+ * \param   impl    the implementation
+ * \return  name of the implementation
+ */
+const char* sc_util_cksum_impl_name(uint8_t impl){
+    switch(impl){
+        case SC_CKSUM_IMPL_SCALAR:  return "scalar";
+        case SC_CKSUM_IMPL_AVX2:    return "avx2";
+        case SC_CKSUM_IMPL_AVX512:  return "avx512";
+        case SC_CKSUM_IMPL_NEON:    return "neon";
+        default:                    return "unknown";
+    }
+}
+
+/*!
+ * \brief   calculate the raw checksum by the specified implementation, the caller
+ *          should make sure the implementation is supported
+ * \param   impl    the implementation
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial partial sum
+ * \return  the 32-bit partial sum (not folded)
+ */
+uint32_t sc_util_cksum_raw_by_impl(uint8_t impl, const void *buf, size_t len, uint32_t sum){
+    uint64_t sum64;
+
+    switch(impl){
+    #if defined(RTE_ARCH_X86)
+        case SC_CKSUM_IMPL_AVX2:
+            sum64 = _cksum_raw_avx2((const uint8_t*)buf, len, sum);
+            break;
+
+        case SC_CKSUM_IMPL_AVX512:
+            sum64 = _cksum_raw_avx512((const uint8_t*)buf, len, sum);
+            break;
+    #elif defined(RTE_ARCH_ARM64)
+        case SC_CKSUM_IMPL_NEON:
+            sum64 = _cksum_raw_neon((const uint8_t*)buf, len, sum);
+            break;
+    #endif
+
+        default:
+            sum64 = _cksum_raw_scalar((const uint8_t*)buf, len, sum);
+    }
+
+    sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+    sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+
+    return (uint32_t)sum64;
+}
+
+/*!
+ * \brief   select the fastest supported implementation
+ * \return  the selected implementation
+ */
+uint8_t sc_util_cksum_selected_impl(){
+    static uint8_t selected_impl = SC_CKSUM_IMPL_UNKNOWN;
+    uint8_t impl;
+
+    /* selection is idempotent, so it's safe to be raced by multiple cores */
+    if(unlikely(selected_impl == SC_CKSUM_IMPL_UNKNOWN)){
+        impl = SC_CKSUM_IMPL_SCALAR;
+        if(sc_util_cksum_impl_supported(SC_CKSUM_IMPL_NEON)) impl = SC_CKSUM_IMPL_NEON;
+        if(sc_util_cksum_impl_supported(SC_CKSUM_IMPL_AVX2)) impl = SC_CKSUM_IMPL_AVX2;
+        if(sc_util_cksum_impl_supported(SC_CKSUM_IMPL_AVX512)) impl = SC_CKSUM_IMPL_AVX512;
+        selected_impl = impl;
+    }
+
+    return selected_impl;
+}
+
+/*!
+ * \brief   calculate the raw checksum by the fastest supported implementation
+ * \param   buf     the buffer
+ * \param   len     length of the buffer
+ * \param   sum     the initial partial sum
+ * \return  the 32-bit partial sum (not folded)
+ */
+uint32_t sc_util_cksum_raw(const void *buf, size_t len, uint32_t sum){
+    return sc_util_cksum_raw_by_impl(sc_util_cksum_selected_impl(), buf, len, sum);
+}
+
+/*!
+ * \brief   calculate the raw checksum over a range of the (multi-segment) packet
+ * \param   pkt     the packet
+ * \param   offset  offset of the range since the start of the packet
+ * \param   len     length of the range
+ * \param   sum     the partial sum, accumulated by the range
+ * \return  zero for successfully calculation
+ */
+int sc_util_cksum_raw_mbuf(const struct rte_mbuf *pkt, uint32_t offset, uint32_t len, uint32_t *sum){
+    const struct rte_mbuf *seg;
+    uint32_t seg_len, done = 0;
+    uint16_t seg_sum;
+    uint64_t sum64 = *sum;
+
+    if(unlikely((uint64_t)offset + len > rte_pktmbuf_pkt_len(pkt))){
+        SC_THREAD_ERROR_DETAILS("range [%u, %u) exceeds the packet of %u bytes",
+            offset, offset + len, rte_pktmbuf_pkt_len(pkt));
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    for(seg = pkt; seg != NULL && done < len; seg = seg->next){
+        if(offset >= seg->data_len){
+            offset -= seg->data_len;
+            continue;
+        }
+
+        seg_len = RTE_MIN((uint32_t)seg->data_len - offset, len - done);
+        seg_sum = sc_util_cksum_fold(sc_util_cksum_raw(
+            rte_pktmbuf_mtod_offset(seg, const void*, offset), seg_len, 0));
+
+        /* the segment starts at the odd byte of a 16-bit word */
+        if(done & 1){
+            seg_sum = rte_bswap16(seg_sum);
+        }
+
+        sum64 += seg_sum;
+        done += seg_len;
+        offset = 0;
+    }
+
+    sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+    *sum = (uint32_t)((sum64 & 0xffffffff) + (sum64 >> 32));
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   calculate the udp/tcp checksum over ipv4 (contiguous), the checksum field of
+ *          the l4 header should be set to zero before calling
+ * \param   ipv4_hdr    the ipv4 header
+ * \param   l4_hdr      the udp/tcp header, followed by the payload
+ * \return  the checksum to be written into the l4 header
+ */
+uint16_t sc_util_cksum_ipv4_udptcp(const struct rte_ipv4_hdr *ipv4_hdr, const void *l4_hdr){
+    uint32_t l4_len = rte_be_to_cpu_16(ipv4_hdr->total_length) - rte_ipv4_hdr_len(ipv4_hdr);
+    uint16_t cksum;
+
+    cksum = ~sc_util_cksum_fold(sc_util_cksum_raw(l4_hdr, l4_len, rte_ipv4_phdr_cksum(ipv4_hdr, 0)));
+
+    /* zero is reserved for disabled udp checksum */
+    if(cksum == 0 && ipv4_hdr->next_proto_id == IPPROTO_UDP) cksum = 0xffff;
+
+    return cksum;
+}
+
+/*!
+ * \brief   calculate the udp/tcp checksum over ipv6 (contiguous, without extension headers),
+ *          the checksum field of the l4 header should be set to zero before calling
+ * \param   ipv6_hdr    the ipv6 header
+ * \param   l4_hdr      the udp/tcp header, followed by the payload
+ * \return  the checksum to be written into the l4 header
+ */
+uint16_t sc_util_cksum_ipv6_udptcp(const struct rte_ipv6_hdr *ipv6_hdr, const void *l4_hdr){
+    uint32_t l4_len = rte_be_to_cpu_16(ipv6_hdr->payload_len);
+    uint16_t cksum;
+
+    cksum = ~sc_util_cksum_fold(sc_util_cksum_raw(l4_hdr, l4_len, rte_ipv6_phdr_cksum(ipv6_hdr, 0)));
+
+    /* zero is not allowed for udp checksum over ipv6 (RFC 8200) */
+    if(cksum == 0 && ipv6_hdr->proto == IPPROTO_UDP) cksum = 0xffff;
+
+    return cksum;
+}
+
+/*!
+ * \brief   calculate the udp/tcp checksum over ipv4 of the (multi-segment) packet,
+ *          the checksum field of the l4 header should be set to zero before calling
+ * \param   pkt         the packet
+ * \param   ipv4_hdr    the ipv4 header (inside the first segment)
+ * \param   l4_offset   offset of the udp/tcp header since the start of the packet
+ * \param   cksum       the checksum to be written into the l4 header
+ * \return  zero for successfully calculation
+ */
+int sc_util_cksum_ipv4_udptcp_mbuf(const struct rte_mbuf *pkt, const struct rte_ipv4_hdr *ipv4_hdr,
+        uint32_t l4_offset, uint16_t *cksum){
+    int result;
+    uint32_t l4_len = rte_be_to_cpu_16(ipv4_hdr->total_length) - rte_ipv4_hdr_len(ipv4_hdr);
+    uint32_t sum = rte_ipv4_phdr_cksum(ipv4_hdr, 0);
+
+    result = sc_util_cksum_raw_mbuf(pkt, l4_offset, l4_len, &sum);
+    if(unlikely(result != SC_SUCCESS)){
+        return result;
+    }
+
+    *cksum = ~sc_util_cksum_fold(sum);
+    if(*cksum == 0 && ipv4_hdr->next_proto_id == IPPROTO_UDP) *cksum = 0xffff;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   calculate the udp/tcp checksum over ipv6 of the (multi-segment) packet,
+ *          the checksum field of the l4 header should be set to zero before calling
+ * \param   pkt         the packet
+ * \param   ipv6_hdr    the ipv6 header (inside the first segment)
+ * \param   l4_offset   offset of the udp/tcp header since the start of the packet
+ * \param   cksum       the checksum to be written into the l4 header
+ * \return  zero for successfully calculation
+ */
+int sc_util_cksum_ipv6_udptcp_mbuf(const struct rte_mbuf *pkt, const struct rte_ipv6_hdr *ipv6_hdr,
+        uint32_t l4_offset, uint16_t *cksum){
+    int result;
+    uint32_t sum = rte_ipv6_phdr_cksum(ipv6_hdr, 0);
+
+    result = sc_util_cksum_raw_mbuf(pkt, l4_offset, rte_be_to_cpu_16(ipv6_hdr->payload_len), &sum);
+    if(unlikely(result != SC_SUCCESS)){
+        return result;
+    }
+
+    *cksum = ~sc_util_cksum_fold(sum);
+    if(*cksum == 0 && ipv6_hdr->proto == IPPROTO_UDP) *cksum = 0xffff;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   microbenchmark of all supported implementations against rte_raw_cksum,
+ *          results are verified against rte_raw_cksum before timing
+ * \param   lens            lengths of the buffer to be measured
+ * \param   nb_lens         number of lengths
+ * \param   nb_iterations   number of iterations per length and implementation
+ * \return  zero for all implementations produce the same checksum as rte_raw_cksum
+ */
+int sc_util_cksum_bench(const uint32_t *lens, uint32_t nb_lens, uint64_t nb_iterations){
+    int result = SC_SUCCESS;
+    uint8_t impl, *buf = NULL;
+    uint32_t i, max_len = 0;
+    uint64_t j, start_cycles, rte_cycles, cycles;
+    uint64_t tsc_hz = sc_util_tsc_hz();
+    volatile uint32_t sink = 0;
+    uint16_t expected;
+
+    if(unlikely(nb_iterations == 0)){
+        SC_ERROR_DETAILS("number of iterations of checksum benchmark should be positive");
+        result = SC_ERROR_INVALID_VALUE;
+        goto sc_util_cksum_bench_exit;
+    }
+
+    for(i=0; i<nb_lens; i++){
+        max_len = RTE_MAX(max_len, lens[i]);
+    }
+
+    /* one extra byte for measuring the unaligned buffer */
+    buf = (uint8_t*)rte_malloc(NULL, max_len + 1, RTE_CACHE_LINE_SIZE);
+    if(unlikely(!buf)){
+        SC_ERROR_DETAILS("failed to allocate memory for checksum benchmark");
+        result = SC_ERROR_MEMORY;
+        goto sc_util_cksum_bench_exit;
+    }
+    for(i=0; i<max_len+1; i++){
+        buf[i] = sc_util_random_unsigned_int8();
+    }
+
+    for(i=0; i<nb_lens; i++){
+        /* verify all implementations, on both aligned and unaligned buffer */
+        expected = rte_raw_cksum(buf, lens[i]);
+        for(impl=SC_CKSUM_IMPL_SCALAR; impl<SC_CKSUM_IMPL_UNKNOWN; impl++){
+            if(!sc_util_cksum_impl_supported(impl)) continue;
+            if(sc_util_cksum_fold(sc_util_cksum_raw_by_impl(impl, buf, lens[i], 0)) != expected
+                || sc_util_cksum_fold(sc_util_cksum_raw_by_impl(impl, buf + 1, lens[i], 0))
+                    != rte_raw_cksum(buf + 1, lens[i])){
+                SC_ERROR_DETAILS("checksum of %s implementation mismatches rte_raw_cksum on %u bytes",
+                    sc_util_cksum_impl_name(impl), lens[i]);
+                result = SC_ERROR_INTERNAL;
+                goto sc_util_cksum_bench_exit;
+            }
+        }
+
+        start_cycles = rte_rdtsc();
+        for(j=0; j<nb_iterations; j++){
+            sink += rte_raw_cksum(buf, lens[i]);
+        }
+        rte_cycles = rte_rdtsc() - start_cycles;
+        SC_LOG("checksum of %u bytes, rte_raw_cksum: %lf cycles/pkt, %lf Gbps",
+            lens[i], (double)rte_cycles / (double)nb_iterations,
+            (double)lens[i] * 8.0 * (double)nb_iterations * (double)tsc_hz / (double)rte_cycles / 1e9);
+
+        for(impl=SC_CKSUM_IMPL_SCALAR; impl<SC_CKSUM_IMPL_UNKNOWN; impl++){
+            if(!sc_util_cksum_impl_supported(impl)) continue;
+            start_cycles = rte_rdtsc();
+            for(j=0; j<nb_iterations; j++){
+                sink += sc_util_cksum_raw_by_impl(impl, buf, lens[i], 0);
+            }
+            cycles = rte_rdtsc() - start_cycles;
+            SC_LOG("checksum of %u bytes, %s: %lf cycles/pkt, %lf Gbps, speedup: %lfx",
+                lens[i], sc_util_cksum_impl_name(impl), (double)cycles / (double)nb_iterations,
+                (double)lens[i] * 8.0 * (double)nb_iterations * (double)tsc_hz / (double)cycles / 1e9,
+                (double)rte_cycles / (double)cycles);
+        }
+    }
+
+sc_util_cksum_bench_exit:
+    if(buf) rte_free(buf);
+    return result;
+}
@@ -0,0 +1,441 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/field_mod.hpp"
+
+#include <arpa/inet.h>
+
+/*!
+ * \brief name and location of each modifiable field (indexed by the field type),
+ *        offsets are based on ethernet + ipv4 + udp packets
+ */
+static const struct {
+    const char *name;
+    uint8_t width;
+    uint16_t offset;
+    bool in_ipv4_cksum;
+    bool in_l4_cksum;
+} _field_mod_fields[SC_FIELD_UNKNOWN] = {
+    { "ipv4.src", 4, sizeof(struct rte_ether_hdr) + 12, true, true },
+    { "ipv4.dst", 4, sizeof(struct rte_ether_hdr) + 16, true, true },
+    { "ipv4.id", 2, sizeof(struct rte_ether_hdr) + 4, true, false },
+    { "udp.src_port", 2, sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr), false, true },
+    { "udp.dst_port", 2, sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + 2, false, true }
+};
+
+static const char *_field_mod_op_names[] = { "inc", "rand", "list", "table" };
+
+static int _field_mod_parse_one(char *desc, struct sc_field_mod *mod);
+static int _field_mod_parse_value(struct sc_field_mod *mod, char *str, uint32_t *value);
+static int _field_mod_parse_range(struct sc_field_mod *mod, char *str);
+
+/*!
+ * \brief   parse and compile the description of field modifiers
+ * \param   desc    the description, modifiers are separated by comma, each is one of
+ *                  [1] <field>:inc:<range>[:<step>];
+ *                  [2] <field>:rand:<range>;
+ *                  [3] <field>:list:<value>|<value>|...;
+ *                  [4] <field>:table:<range>:<nb_entries>;
+ *                  field is one of ipv4.src, ipv4.dst, ipv4.id, udp.src_port, udp.dst_port,
+ *                  range is either <min>-<max>, a single value, or <addr>/<prefix_len> for addresses
+ * \param   prog    the compiled program
+ * \return  zero for successfully parsing
+ */
+int sc_util_field_mod_parse(const char *desc, struct sc_field_mod_prog *prog){
+    int result = SC_SUCCESS;
+    char *buf, *token, *saveptr;
+    struct sc_field_mod *mod;
+
+    memset(prog, 0, sizeof(struct sc_field_mod_prog));
+
+    buf = strdup(desc);
+    if(unlikely(!buf)){
+        SC_ERROR_DETAILS("failed to allocate memory for parsing field modifiers");
+        return SC_ERROR_MEMORY;
+    }
+
+    for(token = strtok_r(buf, ",", &saveptr); token; token = strtok_r(NULL, ",", &saveptr)){
+        token = sc_util_del_both_trim(token);
+        sc_util_del_change_line(token);
+        if(*token == '\0') continue;
+
+        if(prog->nb_mods == SC_FIELD_MOD_MAX_NB_MODS){
+            SC_ERROR_DETAILS("too many field modifiers, at most %u are supported", SC_FIELD_MOD_MAX_NB_MODS);
+            result = SC_ERROR_INVALID_VALUE;
+            goto sc_util_field_mod_parse_exit;
+        }
+
+        mod = &prog->mods[prog->nb_mods];
+        prog->nb_mods += 1;
+        result = _field_mod_parse_one(token, mod);
+        if(result != SC_SUCCESS){
+            goto sc_util_field_mod_parse_exit;
+        }
+
+        prog->update_ipv4_cksum |= mod->in_ipv4_cksum;
+        prog->update_l4_cksum |= mod->in_l4_cksum;
+    }
+
+    if(prog->nb_mods == 0){
+        SC_ERROR_DETAILS("no field modifier is given");
+        result = SC_ERROR_INVALID_VALUE;
+    }
+
+sc_util_field_mod_parse_exit:
+    free(buf);
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to parse field modifiers %s", desc);
+        sc_util_field_mod_free(prog);
+    }
+    return result;
+}
+
+/*!
+ * \brief   parse and compile a single modifier
+ * \param   desc    description of the modifier, formatted as <field>:<op>:<args>
+ * \param   mod     the compiled modifier
+ * \return  zero for successfully parsing
+ */
+static int _field_mod_parse_one(char *desc, struct sc_field_mod *mod){
+    int result = SC_SUCCESS;
+    uint8_t i;
+    uint64_t k;
+    char *field, *op, *arg, *extra, *saveptr, *value, *value_saveptr;
+
+    field = strtok_r(desc, ":", &saveptr);
+    op = strtok_r(NULL, ":", &saveptr);
+    arg = strtok_r(NULL, ":", &saveptr);
+    extra = strtok_r(NULL, ":", &saveptr);
+    if(!field || !op || !arg){
+        SC_ERROR_DETAILS("field modifier should be formatted as <field>:<op>:<args>");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* locate the field */
+    mod->field = SC_FIELD_UNKNOWN;
+    for(i=0; i<SC_FIELD_UNKNOWN; i++){
+        if(!strcmp(field, _field_mod_fields[i].name)){
+            mod->field = i;
+            break;
+        }
+    }
+    if(mod->field == SC_FIELD_UNKNOWN){
+        SC_ERROR_DETAILS("unknown field %s", field);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    mod->width = _field_mod_fields[i].width;
+    mod->offset = _field_mod_fields[i].offset;
+    mod->in_ipv4_cksum = _field_mod_fields[i].in_ipv4_cksum;
+    mod->in_l4_cksum = _field_mod_fields[i].in_l4_cksum;
+
+    if(!strcmp(op, "inc")){
+        mod->op = SC_FIELD_MOD_INC;
+        if(SC_SUCCESS != (result = _field_mod_parse_range(mod, arg))){ return result; }
+        mod->step = 1;
+        if(extra && (sc_util_atoui_32(extra, &mod->step) != SC_SUCCESS || mod->step == 0)){
+            SC_ERROR_DETAILS("invalid step %s of field %s", extra, field);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        /* the cursor is kept within the range by a single subtraction */
+        mod->step = (uint32_t)(mod->step % mod->range);
+    } else if(!strcmp(op, "rand")){
+        mod->op = SC_FIELD_MOD_RAND;
+        if(SC_SUCCESS != (result = _field_mod_parse_range(mod, arg))){ return result; }
+    } else if(!strcmp(op, "list")){
+        mod->op = SC_FIELD_MOD_LIST;
+        for(value = arg; *value; value++){ if(*value == '|') mod->nb_values += 1; }
+        mod->nb_values += 1;
+        mod->values = (uint32_t*)malloc(sizeof(uint32_t)*mod->nb_values);
+        if(unlikely(!mod->values)){
+            SC_ERROR_DETAILS("failed to allocate memory for values of field %s", field);
+            return SC_ERROR_MEMORY;
+        }
+        k = 0;
+        for(value = strtok_r(arg, "|", &value_saveptr); value; value = strtok_r(NULL, "|", &value_saveptr)){
+            if(SC_SUCCESS != (result = _field_mod_parse_value(mod, sc_util_del_both_trim(value), &mod->values[k]))){
+                return result;
+            }
+            k += 1;
+        }
+        if(k == 0){
+            SC_ERROR_DETAILS("no value is given for field %s", field);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        mod->nb_values = k;
+    } else if(!strcmp(op, "table")){
+        mod->op = SC_FIELD_MOD_TABLE;
+        if(SC_SUCCESS != (result = _field_mod_parse_range(mod, arg))){ return result; }
+        if(!extra || sc_util_atoui_64(extra, &mod->nb_values) != SC_SUCCESS
+            || mod->nb_values == 0 || mod->nb_values > SC_FIELD_MOD_MAX_NB_VALUES){
+            SC_ERROR_DETAILS("number of table entries of field %s should be within [1, %lu]",
+                field, SC_FIELD_MOD_MAX_NB_VALUES);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        mod->values = (uint32_t*)malloc(sizeof(uint32_t)*mod->nb_values);
+        if(unlikely(!mod->values)){
+            SC_ERROR_DETAILS("failed to allocate memory for table of field %s", field);
+            return SC_ERROR_MEMORY;
+        }
+        for(k=0; k<mod->nb_values; k++){
+            mod->values[k] = mod->min + (uint32_t)sc_util_rand_bounded(mod->range);
+        }
+    } else {
+        SC_ERROR_DETAILS("unknown operation %s of field %s", op, field);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    return result;
+}
+
+/*!
+ * \brief   parse a value of the field, addresses are in dotted-decimal notation
+ * \param   mod     the modifier
+ * \param   str     the string to be parsed
+ * \param   value   the parsed value (host byte order)
+ * \return  zero for successfully parsing
+ */
+static int _field_mod_parse_value(struct sc_field_mod *mod, char *str, uint32_t *value){
+    rte_be32_t addr;
+
+    if(mod->field == SC_FIELD_IPV4_SRC || mod->field == SC_FIELD_IPV4_DST){
+        if(inet_pton(AF_INET, str, &addr) != 1){ goto invalid_value; }
+        *value = rte_be_to_cpu_32(addr);
+        return SC_SUCCESS;
+    }
+
+    if(sc_util_atoui_32(str, value) != SC_SUCCESS || *value > UINT16_MAX){ goto invalid_value; }
+    return SC_SUCCESS;
+
+invalid_value:
+    SC_ERROR_DETAILS("invalid value %s of field %s", str, _field_mod_fields[mod->field].name);
+    return SC_ERROR_INVALID_VALUE;
+}
+
+/*!
+ * \brief   parse the range of the field
+ * \param   mod     the modifier, whose min, max and range are set
+ * \param   str     the string to be parsed
+ * \return  zero for successfully parsing
+ */
+static int _field_mod_parse_range(struct sc_field_mod *mod, char *str){
+    int result;
+    char *sep;
+    uint32_t prefix_len;
+
+    if((sep = strchr(str, '/')) != NULL){
+        *sep = '\0';
+        if(mod->width != 4 || sc_util_atoui_32(sep+1, &prefix_len) != SC_SUCCESS || prefix_len > 32){
+            SC_ERROR_DETAILS("invalid prefix %s of field %s", sep+1, _field_mod_fields[mod->field].name);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        if(SC_SUCCESS != (result = _field_mod_parse_value(mod, str, &mod->min))){ return result; }
+        mod->min &= prefix_len == 0 ? 0 : ~((1ULL << (32 - prefix_len)) - 1);
+        mod->max = mod->min | (uint32_t)((1ULL << (32 - prefix_len)) - 1);
+    } else if((sep = strchr(str, '-')) != NULL){
+        *sep = '\0';
+        if(SC_SUCCESS != (result = _field_mod_parse_value(mod, str, &mod->min))){ return result; }
+        if(SC_SUCCESS != (result = _field_mod_parse_value(mod, sep+1, &mod->max))){ return result; }
+    } else {
+        if(SC_SUCCESS != (result = _field_mod_parse_value(mod, str, &mod->min))){ return result; }
+        mod->max = mod->min;
+    }
+
+    if(mod->min > mod->max){
+        SC_ERROR_DETAILS("empty range of field %s", _field_mod_fields[mod->field].name);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    mod->range = (uint64_t)mod->max - (uint64_t)mod->min + 1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   free the program of field modifiers
+ * \param   prog    the program
+ */
+void sc_util_field_mod_free(struct sc_field_mod_prog *prog){
+    uint32_t i;
+    for(i=0; i<prog->nb_mods; i++){
+        if(prog->mods[i].values) free(prog->mods[i].values);
+    }
+    memset(prog, 0, sizeof(struct sc_field_mod_prog));
+}
+
+/*!
+ * \brief   print the program of field modifiers
+ * \param   prog    the program
+ */
+void sc_util_field_mod_print(struct sc_field_mod_prog *prog){
+    uint32_t i;
+    struct sc_field_mod *mod;
+
+    SC_LOG("field modifiers: %u modifier(s)", prog->nb_mods);
+    for(i=0; i<prog->nb_mods; i++){
+        mod = &prog->mods[i];
+        if(mod->op == SC_FIELD_MOD_LIST){
+            SC_LOG("  %s: list of %lu value(s)", _field_mod_fields[mod->field].name, mod->nb_values);
+        } else {
+            SC_LOG("  %s: %s within [%u, %u], step: %u, table entries: %lu",
+                _field_mod_fields[mod->field].name, _field_mod_op_names[mod->op],
+                mod->min, mod->max, mod->step, mod->nb_values);
+        }
+    }
+}
+
+/*!
+ * \brief   initialize the per-core state for applying the program
+ * \note    cursors of streams start from evenly-spaced positions, so that
+ *          different send cores walk through disjoint parts of the ranges
+ * \param   state               the initialized state
+ * \param   prog                the program
+ * \param   nb_pkt_per_burst    maximum number of packets within a burst
+ * \param   stream_id           index of the stream (e.g., rank of the send core)
+ * \param   nb_streams          number of streams
+ * \return  zero for successfully initialization
+ */
+int sc_util_field_mod_state_init(struct sc_field_mod_state *state, struct sc_field_mod_prog *prog,
+        uint32_t nb_pkt_per_burst, uint32_t stream_id, uint32_t nb_streams){
+    uint32_t i;
+    uint64_t nb_positions;
+    struct sc_field_mod *mod;
+
+    memset(state, 0, sizeof(struct sc_field_mod_state));
+    state->prog = prog;
+    state->nb_pkt_per_burst = nb_pkt_per_burst;
+
+    for(i=0; i<prog->nb_mods; i++){
+        mod = &prog->mods[i];
+        if(mod->op == SC_FIELD_MOD_RAND) continue;
+        nb_positions = mod->op == SC_FIELD_MOD_INC ? mod->range : mod->nb_values;
+        state->cursors[i] = nb_positions / RTE_MAX(nb_streams, 1U) * stream_id % nb_positions;
+    }
+
+    state->values = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_pkt_per_burst, 0);
+    state->rand_buf = (uint64_t*)rte_malloc(NULL, sizeof(uint64_t)*nb_pkt_per_burst, 0);
+    state->ipv4_cksum_delta = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_pkt_per_burst, 0);
+    state->l4_cksum_delta = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_pkt_per_burst, 0);
+    if(unlikely(!state->values || !state->rand_buf || !state->ipv4_cksum_delta || !state->l4_cksum_delta)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for state of field modifiers");
+        sc_util_field_mod_state_free(state);
+        return SC_ERROR_MEMORY;
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   free the per-core state of field modifiers
+ * \param   state   the state
+ */
+void sc_util_field_mod_state_free(struct sc_field_mod_state *state){
+    if(state->values) rte_free(state->values);
+    if(state->rand_buf) rte_free(state->rand_buf);
+    if(state->ipv4_cksum_delta) rte_free(state->ipv4_cksum_delta);
+    if(state->l4_cksum_delta) rte_free(state->l4_cksum_delta);
+    memset(state, 0, sizeof(struct sc_field_mod_state));
+}
+
+/*!
+ * \brief   generate the values of a modifier for the whole burst
+ * \param   state   the per-core state
+ * \param   mod_id  index of the modifier
+ * \param   nb_pkts number of packets within the burst
+ */
+static inline void _field_mod_generate_values(struct sc_field_mod_state *state, uint32_t mod_id, uint32_t nb_pkts){
+    uint32_t k, *values = state->values;
+    uint64_t cursor = state->cursors[mod_id];
+    struct sc_field_mod *mod = &state->prog->mods[mod_id];
+
+    switch(mod->op){
+    case SC_FIELD_MOD_INC:
+        for(k=0; k<nb_pkts; k++){
+            values[k] = mod->min + (uint32_t)cursor;
+            cursor += mod->step;
+            cursor = cursor >= mod->range ? cursor - mod->range : cursor;
+        }
+        break;
+
+    case SC_FIELD_MOD_RAND:
+        /* fill random values in bulk, then scale them into the range by multiply-shift */
+        sc_util_prng_fill(&perthread_prng, state->rand_buf, nb_pkts);
+        for(k=0; k<nb_pkts; k++){
+            values[k] = mod->min + (uint32_t)(((state->rand_buf[k] & 0xffffffff) * mod->range) >> 32);
+        }
+        break;
+
+    default: /* SC_FIELD_MOD_LIST, SC_FIELD_MOD_TABLE */
+        for(k=0; k<nb_pkts; k++){
+            values[k] = mod->values[cursor];
+            cursor = cursor + 1 == mod->nb_values ? 0 : cursor + 1;
+        }
+        break;
+    }
+
+    state->cursors[mod_id] = cursor;
+}
+
+/*!
+ * \brief   apply the field modifiers to a burst of ipv4/udp packets, checksums are updated
+ *          incrementally (RFC 1624) and folded once per packet after all modifiers are applied
+ * \note    modifiers are applied one after another across the whole burst, so that value
+ *          generation runs in tight loops without per-packet dispatching;
+ *          udp checksum is only updated if it's not zero (i.e., disabled)
+ * \param   state       the per-core state
+ * \param   pkts_burst  the burst of packets
+ * \param   nb_pkts     number of packets within the burst (no more than nb_pkt_per_burst of the state)
+ */
+void sc_util_field_mod_apply_burst(struct sc_field_mod_state *state, struct rte_mbuf **pkts_burst, uint32_t nb_pkts){
+    uint32_t i, k, delta;
+    uint16_t old_word;
+    uint32_t old_value;
+    uint8_t *field;
+    struct sc_field_mod *mod;
+    struct sc_field_mod_prog *prog = state->prog;
+    struct rte_ipv4_hdr *ipv4_hdr;
+    struct rte_udp_hdr *udp_hdr;
+
+    memset(state->ipv4_cksum_delta, 0, sizeof(uint32_t)*nb_pkts);
+    memset(state->l4_cksum_delta, 0, sizeof(uint32_t)*nb_pkts);
+
+    for(i=0; i<prog->nb_mods; i++){
+        mod = &prog->mods[i];
+        _field_mod_generate_values(state, i, nb_pkts);
+
+        /* write values into packets, and accumulate the checksum delta of each packet */
+        if(mod->width == 4){
+            for(k=0; k<nb_pkts; k++){
+                field = rte_pktmbuf_mtod_offset(pkts_burst[k], uint8_t*, mod->offset);
+                old_value = *(unaligned_uint32_t*)field;
+                *(unaligned_uint32_t*)field = rte_cpu_to_be_32(state->values[k]);
+                delta = sc_util_cksum_delta_32(0, old_value, *(unaligned_uint32_t*)field);
+                state->ipv4_cksum_delta[k] += mod->in_ipv4_cksum ? delta : 0;
+                state->l4_cksum_delta[k] += mod->in_l4_cksum ? delta : 0;
+            }
+        } else {
+            for(k=0; k<nb_pkts; k++){
+                field = rte_pktmbuf_mtod_offset(pkts_burst[k], uint8_t*, mod->offset);
+                old_word = *(unaligned_uint16_t*)field;
+                *(unaligned_uint16_t*)field = rte_cpu_to_be_16((uint16_t)state->values[k]);
+                delta = sc_util_cksum_delta_16(0, old_word, *(unaligned_uint16_t*)field);
+                state->ipv4_cksum_delta[k] += mod->in_ipv4_cksum ? delta : 0;
+                state->l4_cksum_delta[k] += mod->in_l4_cksum ? delta : 0;
+            }
+        }
+    }
+
+    /* fold the accumulated delta into checksums */
+    for(k=0; k<nb_pkts; k++){
+        ipv4_hdr = rte_pktmbuf_mtod_offset(pkts_burst[k], struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+        if(prog->update_ipv4_cksum){
+            ipv4_hdr->hdr_checksum = sc_util_cksum_adjust(ipv4_hdr->hdr_checksum, state->ipv4_cksum_delta[k]);
+        }
+        if(prog->update_l4_cksum){
+            udp_hdr = (struct rte_udp_hdr*)(ipv4_hdr + 1);
+            if(udp_hdr->dgram_cksum != 0){
+                udp_hdr->dgram_cksum = sc_util_cksum_adjust(udp_hdr->dgram_cksum, state->l4_cksum_delta[k]);
+                /* zero is reserved for disabled udp checksum */
+                if(udp_hdr->dgram_cksum == 0) udp_hdr->dgram_cksum = 0xffff;
+            }
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/flow_pop.hpp"
+#include "sc_utils/rss.hpp"
+#include "sc_utils/alias.hpp"
+
+#include <math.h>
+
+static int _flow_pop_init_weights(struct sc_flow_pop *pop, struct sc_flow_pop_conf *conf, double *weights);
+
+/*!
+ * \brief   create a population of random ipv4/udp flows
+ * \param   pop             the created flow population
+ * \param   nb_flows        number of flows inside the population
+ * \param   conf            configuration of the popularity distribution
+ * \param   rss_hash_field  the rss hash fields
+ * \param   rss_affinity    whether to ensure the rss result of all flows belongs to used_queue_id
+ * \param   nb_queues       number of used queues
+ * \param   used_queue_id   index of the queue which all flows belong to (if rss_affinity is enabled)
+ * \return  zero for successfully creation
+ */
+int sc_util_flow_pop_create(struct sc_flow_pop *pop, uint64_t nb_flows, struct sc_flow_pop_conf *conf,
+        uint64_t rss_hash_field, bool rss_affinity, uint32_t nb_queues, uint32_t used_queue_id){
+    int result = SC_SUCCESS;
+    uint64_t i, r;
+    uint32_t src_ipv4, dst_ipv4, rss_l3, rss_l3l4, rss_hash;
+    uint16_t src_port, dst_port;
+    bool is_l3_only, use_rss_emu;
+    double *weights = NULL;
+
+    memset(pop, 0, sizeof(struct sc_flow_pop));
+
+    if(nb_flows == 0 || nb_flows > SC_FLOW_POP_MAX_NB_FLOWS){
+        SC_THREAD_ERROR_DETAILS("invalid number of flows %lu, should be within [1, %u]",
+            nb_flows, SC_FLOW_POP_MAX_NB_FLOWS);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    pop->nb_flows = nb_flows;
+
+    pop->src_ipv4 = (rte_be32_t*)rte_malloc(NULL, sizeof(rte_be32_t)*nb_flows, 0);
+    pop->dst_ipv4 = (rte_be32_t*)rte_malloc(NULL, sizeof(rte_be32_t)*nb_flows, 0);
+    pop->src_port = (rte_be16_t*)rte_malloc(NULL, sizeof(rte_be16_t)*nb_flows, 0);
+    pop->dst_port = (rte_be16_t*)rte_malloc(NULL, sizeof(rte_be16_t)*nb_flows, 0);
+    pop->rss_hash = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_flows, 0);
+    pop->alias_threshold = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_flows, 0);
+    pop->alias_index = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_flows, 0);
+    if(unlikely(!pop->src_ipv4 || !pop->dst_ipv4 || !pop->src_port || !pop->dst_port
+        || !pop->rss_hash || !pop->alias_threshold || !pop->alias_index)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for flow table of %lu flows", nb_flows);
+        result = SC_ERROR_MEMORY;
+        goto sc_util_flow_pop_create_exit;
+    }
+
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+        is_l3_only = (rss_hash_field == RTE_ETH_RSS_IP);
+    #else
+        is_l3_only = (rss_hash_field == ETH_RSS_IP);
+    #endif
+
+    /* flows are steered into the wanted queue directly if the rss of the port is emulated */
+    use_rss_emu = rss_affinity && nb_queues > 1 && used_rss_emulator.is_initialized
+                    && used_rss_emulator.nb_queues == nb_queues;
+
+    /* generate random flows, the rss hash is precomputed for each flow */
+    for(i=0; i<nb_flows; i++){
+        if(use_rss_emu){
+            result = sc_util_rss_emu_gen_flow_ipv4(&used_rss_emulator, used_queue_id,
+                &src_ipv4, &dst_ipv4, &src_port, &dst_port, &rss_hash);
+            if(result != SC_SUCCESS){
+                SC_THREAD_ERROR_DETAILS("failed to generate flow steered to queue %u", used_queue_id);
+                goto sc_util_flow_pop_create_exit;
+            }
+        } else {
+            for(;;){
+                r = sc_util_rand();
+                src_ipv4 = (uint32_t)r;
+                dst_ipv4 = (uint32_t)(r >> 32);
+                r = sc_util_rand();
+                src_port = (uint16_t)r;
+                dst_port = (uint16_t)(r >> 16);
+
+                sc_util_get_rss_result_ipv4(src_ipv4, dst_ipv4, src_port, dst_port, 0, &rss_l3, &rss_l3l4);
+                rss_hash = is_l3_only ? rss_l3 : rss_l3l4;
+
+                /* same queue mapping as sc_util_get_rss_queue_id_ipv4 */
+                if(!rss_affinity || nb_queues <= 1 || (rss_hash & 0x7F) % nb_queues == used_queue_id)
+                    break;
+            }
+        }
+
+        pop->src_ipv4[i] = rte_cpu_to_be_32(src_ipv4);
+        pop->dst_ipv4[i] = rte_cpu_to_be_32(dst_ipv4);
+        pop->src_port[i] = rte_cpu_to_be_16(src_port);
+        pop->dst_port[i] = rte_cpu_to_be_16(dst_port);
+        pop->rss_hash[i] = rss_hash;
+    }
+
+    /* build alias table based on the popularity of each flow */
+    weights = (double*)malloc(sizeof(double)*nb_flows);
+    if(unlikely(!weights)){
+        SC_THREAD_ERROR_DETAILS("failed to allocate memory for flow weights");
+        result = SC_ERROR_MEMORY;
+        goto sc_util_flow_pop_create_exit;
+    }
+
+    result = _flow_pop_init_weights(pop, conf, weights);
+    if(result != SC_SUCCESS){
+        SC_THREAD_ERROR_DETAILS("failed to initialize weights of flows");
+        goto sc_util_flow_pop_create_exit;
+    }
+
+    result = sc_util_alias_build(weights, nb_flows, pop->alias_threshold, pop->alias_index);
+    if(result != SC_SUCCESS){
+        SC_THREAD_ERROR_DETAILS("failed to build alias table");
+        goto sc_util_flow_pop_create_exit;
+    }
+
+sc_util_flow_pop_create_exit:
+    if(weights) free(weights);
+    if(result != SC_SUCCESS) sc_util_flow_pop_free(pop);
+    return result;
+}
+
+/*!
+ * \brief   free the flow population
+ * \param   pop the flow population
+ */
+void sc_util_flow_pop_free(struct sc_flow_pop *pop){
+    if(pop->src_ipv4) rte_free(pop->src_ipv4);
+    if(pop->dst_ipv4) rte_free(pop->dst_ipv4);
+    if(pop->src_port) rte_free(pop->src_port);
+    if(pop->dst_port) rte_free(pop->dst_port);
+    if(pop->rss_hash) rte_free(pop->rss_hash);
+    if(pop->alias_threshold) rte_free(pop->alias_threshold);
+    if(pop->alias_index) rte_free(pop->alias_index);
+    memset(pop, 0, sizeof(struct sc_flow_pop));
+}
+
+/*!
+ * \brief   initialize the (unnormalized) weight of each flow
+ * \param   pop     the flow population
+ * \param   conf    configuration of the popularity distribution
+ * \param   weights the initialized weights
+ * \return  zero for successfully initialization
+ */
+static int _flow_pop_init_weights(struct sc_flow_pop *pop, struct sc_flow_pop_conf *conf, double *weights){
+    uint64_t i, nb_hot_flows;
+
+    switch(conf->distribution){
+    case SC_FLOW_POP_UNIFORM:
+        for(i=0; i<pop->nb_flows; i++) weights[i] = 1.0;
+        break;
+
+    case SC_FLOW_POP_ZIPF:
+        if(conf->zipf_skew < 0){
+            SC_THREAD_ERROR_DETAILS("invalid zipf skew %lf", conf->zipf_skew);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        for(i=0; i<pop->nb_flows; i++) weights[i] = 1.0 / pow((double)(i+1), conf->zipf_skew);
+        break;
+
+    case SC_FLOW_POP_HOTCOLD:
+        if(conf->hot_set_ratio <= 0 || conf->hot_set_ratio > 1
+            || conf->hot_traffic_ratio < 0 || conf->hot_traffic_ratio > 1){
+            SC_THREAD_ERROR_DETAILS("invalid hot set ratio %lf or hot traffic ratio %lf",
+                conf->hot_set_ratio, conf->hot_traffic_ratio);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        nb_hot_flows = RTE_MAX((uint64_t)1, (uint64_t)((double)pop->nb_flows * conf->hot_set_ratio));
+        for(i=0; i<pop->nb_flows; i++){
+            if(i < nb_hot_flows)
+                weights[i] = conf->hot_traffic_ratio / (double)nb_hot_flows;
+            else
+                weights[i] = (1.0 - conf->hot_traffic_ratio) / (double)(pop->nb_flows - nb_hot_flows);
+        }
+        break;
+
+    default:
+        SC_THREAD_ERROR_DETAILS("unknown flow popularity distribution %u", conf->distribution);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    return SC_SUCCESS;
+}
@@ -0,0 +1,231 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/hdr_hist.hpp"
+
+#include <math.h>
+
+/*!
+ * \brief   initialize the histogram
+ * \param   hist            the histogram
+ * \param   max_trackable   the largest value to be distinguished
+ * \param   sig_figs        number of significant decimal figures to be kept (1 ~ 5)
+ * \return  zero for successfully initialization
+ */
+int sc_util_hdr_hist_init(struct sc_hdr_hist *hist, uint64_t max_trackable, uint8_t sig_figs){
+    memset(hist, 0, sizeof(struct sc_hdr_hist));
+
+    if(sig_figs < SC_HDR_HIST_MIN_SIG_FIGS || sig_figs > SC_HDR_HIST_MAX_SIG_FIGS || max_trackable == 0){
+        SC_ERROR_DETAILS("invalid histogram with %u significant figures and maximum value %lu", sig_figs, max_trackable);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* sub-buckets of each power of 2 tell 2 * 10^sig_figs values apart (same as HdrHistogram) */
+    hist->sub_bits = (uint8_t)ceil(log2(2.0 * pow(10.0, sig_figs)));
+    hist->max_trackable = max_trackable;
+    hist->nb_buckets = UINT32_MAX;
+    hist->nb_buckets = sc_util_hdr_hist_index(hist, max_trackable) + 1;
+    hist->min_value = UINT64_MAX;
+
+    hist->counts = (uint64_t*)rte_zmalloc(NULL, sizeof(uint64_t)*hist->nb_buckets, 0);
+    if(unlikely(!hist->counts)){
+        SC_ERROR_DETAILS("failed to allocate memory for %u buckets of histogram", hist->nb_buckets);
+        return SC_ERROR_MEMORY;
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   free the histogram
+ * \param   hist    the histogram
+ */
+void sc_util_hdr_hist_free(struct sc_hdr_hist *hist){
+    if(hist->counts) rte_free(hist->counts);
+    hist->counts = NULL;
+}
+
+/*!
+ * \brief   clear all recorded values
+ * \param   hist    the histogram
+ */
+void sc_util_hdr_hist_reset(struct sc_hdr_hist *hist){
+    memset(hist->counts, 0, sizeof(uint64_t)*hist->nb_buckets);
+    hist->total_count = 0;
+    hist->min_value = UINT64_MAX;
+    hist->max_value = 0;
+}
+
+/*!
+ * \brief   add values of the source histogram into the destination histogram
+ * \note    the source could be recorded concurrently by its owner core, so the
+ *          total count is summed from the buckets to keep them consistent
+ * \param   dst the destination histogram
+ * \param   src the source histogram, with the same layout as the destination
+ * \return  zero for successfully merging
+ */
+int sc_util_hdr_hist_merge(struct sc_hdr_hist *dst, const struct sc_hdr_hist *src){
+    uint32_t i;
+    uint64_t count;
+
+    if(unlikely(dst->sub_bits != src->sub_bits || dst->nb_buckets != src->nb_buckets)){
+        SC_ERROR_DETAILS("failed to merge histograms with different layout");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    for(i=0; i<src->nb_buckets; i++){
+        count = src->counts[i];
+        dst->counts[i] += count;
+        dst->total_count += count;
+    }
+    dst->min_value = RTE_MIN(dst->min_value, src->min_value);
+    dst->max_value = RTE_MAX(dst->max_value, src->max_value);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   obtain values recorded since the previous snapshot, e.g., of the last interval
+ * \param   dst     the histogram of the difference
+ * \param   cur     the current snapshot
+ * \param   prev    the previous snapshot, values of which are all included by the current snapshot
+ * \return  zero for successfully calculation
+ */
+int sc_util_hdr_hist_diff(struct sc_hdr_hist *dst, const struct sc_hdr_hist *cur, const struct sc_hdr_hist *prev){
+    uint32_t i;
+    uint64_t count;
+
+    if(unlikely(dst->nb_buckets != cur->nb_buckets || dst->nb_buckets != prev->nb_buckets
+        || dst->sub_bits != cur->sub_bits || dst->sub_bits != prev->sub_bits)){
+        SC_ERROR_DETAILS("failed to diff histograms with different layout");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    sc_util_hdr_hist_reset(dst);
+    for(i=0; i<cur->nb_buckets; i++){
+        count = cur->counts[i] > prev->counts[i] ? cur->counts[i] - prev->counts[i] : 0;
+        if(count == 0){ continue; }
+        dst->counts[i] = count;
+        dst->total_count += count;
+
+        /* extremes of the difference are only known at the precision of buckets */
+        if(dst->min_value == UINT64_MAX){ dst->min_value = sc_util_hdr_hist_lowest_value(dst, i); }
+        dst->max_value = sc_util_hdr_hist_highest_value(dst, i);
+    }
+    if(dst->total_count > 0){
+        dst->max_value = RTE_MIN(dst->max_value, cur->max_value);
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   obtain the value at the percentile
+ * \param   hist        the histogram
+ * \param   percentile  the percentile (unit: %)
+ * \return  the highest equivalent value of the bucket holding the percentile (zero for empty histogram)
+ */
+uint64_t sc_util_hdr_hist_value_at_percentile(const struct sc_hdr_hist *hist, double percentile){
+    uint32_t i;
+    uint64_t target, cum = 0;
+
+    if(hist->total_count == 0){ return 0; }
+
+    percentile = RTE_MIN(RTE_MAX(percentile, (double)0.0f), (double)100.0f);
+    target = RTE_MAX((uint64_t)(percentile / 100.0 * (double)hist->total_count + 0.5), (uint64_t)1);
+
+    for(i=0; i<hist->nb_buckets; i++){
+        cum += hist->counts[i];
+        if(cum >= target){
+            return RTE_MIN(sc_util_hdr_hist_highest_value(hist, i), hist->max_value);
+        }
+    }
+    return hist->max_value;
+}
+
+/*!
+ * \brief   obtain the mean of recorded values, each value is represented by the middle of its bucket
+ * \param   hist    the histogram
+ * \return  the mean (zero for empty histogram)
+ */
+double sc_util_hdr_hist_mean(const struct sc_hdr_hist *hist){
+    uint32_t i;
+    double sum = 0;
+
+    if(hist->total_count == 0){ return 0; }
+    for(i=0; i<hist->nb_buckets; i++){
+        if(hist->counts[i] == 0){ continue; }
+        sum += (double)hist->counts[i] * ((double)sc_util_hdr_hist_lowest_value(hist, i)
+            + (double)sc_util_hdr_hist_highest_value(hist, i)) / 2.0;
+    }
+    return sum / (double)hist->total_count;
+}
+
+/*!
+ * \brief   obtain the standard deviation of recorded values
+ * \param   hist    the histogram
+ * \return  the standard deviation (zero for empty histogram)
+ */
+double sc_util_hdr_hist_stddev(const struct sc_hdr_hist *hist){
+    uint32_t i;
+    double mean = sc_util_hdr_hist_mean(hist), dev, sum = 0;
+
+    if(hist->total_count == 0){ return 0; }
+    for(i=0; i<hist->nb_buckets; i++){
+        if(hist->counts[i] == 0){ continue; }
+        dev = ((double)sc_util_hdr_hist_lowest_value(hist, i)
+            + (double)sc_util_hdr_hist_highest_value(hist, i)) / 2.0 - mean;
+        sum += (double)hist->counts[i] * dev * dev;
+    }
+    return sqrt(sum / (double)hist->total_count);
+}
+
+/*!
+ * \brief   write the percentile distribution in the format of HdrHistogram (.hgrm), which
+ *          could be plotted and compared by the tools of HdrHistogram directly
+ * \param   hist                    the histogram
+ * \param   fp                      the output file
+ * \param   ticks_per_half_distance number of reported percentiles per halving of the distance to 100%
+ * \param   value_scale             divisor of the reported values (e.g., 1000 to report ns as us)
+ * \return  zero for successfully writing
+ */
+int sc_util_hdr_hist_output_percentiles(const struct sc_hdr_hist *hist, FILE *fp,
+        uint32_t ticks_per_half_distance, double value_scale){
+    uint32_t i;
+    uint64_t cum = 0;
+    double percentile, next_percentile = 0, half_distance;
+
+    if(ticks_per_half_distance == 0 || !(value_scale > 0)){
+        SC_ERROR_DETAILS("invalid ticks_per_half_distance %u or value_scale %lf", ticks_per_half_distance, value_scale);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    fprintf(fp, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+    /* a bucket could be reported at several percentiles, the last bucket is reported once before 100% */
+    for(i=0; i<hist->nb_buckets && cum < hist->total_count; i++){
+        if(hist->counts[i] == 0){ continue; }
+        cum += hist->counts[i];
+        percentile = 100.0 * (double)cum / (double)hist->total_count;
+
+        while(next_percentile <= percentile){
+            fprintf(fp, "%12.3f %2.12f %10lu %14.2f\n",
+                (double)RTE_MIN(sc_util_hdr_hist_highest_value(hist, i), hist->max_value) / value_scale,
+                next_percentile / 100.0, cum, 1.0 / (1.0 - next_percentile / 100.0));
+
+            half_distance = pow(2.0, (double)(int64_t)(log2(100.0 / (100.0 - next_percentile)) + 1));
+            next_percentile += 100.0 / ((double)ticks_per_half_distance * half_distance);
+            if(cum >= hist->total_count){ break; }
+        }
+    }
+    fprintf(fp, "%12.3f %2.12f %10lu\n", (double)hist->max_value / value_scale, 1.0, hist->total_count);
+
+    fprintf(fp, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+        sc_util_hdr_hist_mean(hist) / value_scale, sc_util_hdr_hist_stddev(hist) / value_scale);
+    fprintf(fp, "#[Max     = %12.3f, Total count    = %12lu]\n",
+        (double)hist->max_value / value_scale, hist->total_count);
+    fprintf(fp, "#[Buckets = %12u, SubBuckets     = %12u]\n",
+        hist->nb_buckets >> hist->sub_bits, 1U << hist->sub_bits);
+
+    return SC_SUCCESS;
+}
@@ -0,0 +1,336 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/kv_workload.hpp"
+
+#include <math.h>
+
+/* names of operations (indexed by the operation type) */
+static const char *_kv_op_names[SC_KV_OP_UNKNOWN] = {
+    "get", "set", "insert", "del", "scan", "rmw"
+};
+
+/* names of workloads (indexed by the workload type) */
+static const char *_kv_workload_names[SC_KV_WORKLOAD_UNKNOWN] = {
+    "a", "b", "c", "d", "e", "f", "custom"
+};
+
+/* names of key distributions (indexed by the distribution type) */
+static const char *_kv_key_dist_names[SC_KV_KEY_DIST_UNKNOWN] = {
+    "uniform", "zipf", "latest"
+};
+
+/*!
+ * \brief operation mix and key distribution of the ycsb core workloads (indexed by the workload type),
+ *        columns of the mix are get, set, insert, del, scan, rmw
+ */
+static const struct {
+    double op_ratios[SC_KV_OP_UNKNOWN];
+    uint8_t key_dist;
+} _kv_ycsb_presets[SC_KV_WORKLOAD_CUSTOM] = {
+    { { 0.50, 0.50, 0.00, 0.00, 0.00, 0.00 }, SC_KV_KEY_DIST_ZIPF },
+    { { 0.95, 0.05, 0.00, 0.00, 0.00, 0.00 }, SC_KV_KEY_DIST_ZIPF },
+    { { 1.00, 0.00, 0.00, 0.00, 0.00, 0.00 }, SC_KV_KEY_DIST_ZIPF },
+    { { 0.95, 0.00, 0.05, 0.00, 0.00, 0.00 }, SC_KV_KEY_DIST_LATEST },
+    { { 0.00, 0.00, 0.05, 0.00, 0.95, 0.00 }, SC_KV_KEY_DIST_ZIPF },
+    { { 0.50, 0.00, 0.00, 0.00, 0.00, 0.50 }, SC_KV_KEY_DIST_ZIPF },
+};
+
+/*!
+ * \brief   parse the name of the workload
+ * \param   name        name of the workload (a ~ f for ycsb core workloads, or custom)
+ * \param   workload    the parsed workload
+ * \return  zero for successfully parsing
+ */
+int sc_util_kv_workload_parse_name(const char *name, uint8_t *workload){
+    uint8_t i;
+    for(i=0; i<SC_KV_WORKLOAD_UNKNOWN; i++){
+        if(!strcasecmp(name, _kv_workload_names[i])){
+            *workload = i;
+            return SC_SUCCESS;
+        }
+    }
+    return SC_ERROR_INVALID_VALUE;
+}
+
+/*!
+ * \brief   parse the name of the key distribution
+ * \param   name        name of the distribution (uniform, zipf or latest)
+ * \param   key_dist    the parsed distribution
+ * \return  zero for successfully parsing
+ */
+int sc_util_kv_key_dist_parse_name(const char *name, uint8_t *key_dist){
+    uint8_t i;
+    for(i=0; i<SC_KV_KEY_DIST_UNKNOWN; i++){
+        if(!strcmp(name, _kv_key_dist_names[i])){
+            *key_dist = i;
+            return SC_SUCCESS;
+        }
+    }
+    return SC_ERROR_INVALID_VALUE;
+}
+
+/*!
+ * \brief   obtain the name of the operation
+ * \param   op  the operation
+ * \return  name of the operation
+ */
+const char* sc_util_kv_op_name(uint8_t op){
+    return op < SC_KV_OP_UNKNOWN ? _kv_op_names[op] : "unknown";
+}
+
+/*!
+ * \brief   parse the operation mix, e.g., "get:0.9,set:0.09,del:0.01",
+ *          ratios are normalized while creating the workload
+ * \param   desc        the description of the mix
+ * \param   op_ratios   the parsed (unnormalized) ratio of each operation
+ * \return  zero for successfully parsing
+ */
+int sc_util_kv_op_mix_parse(const char *desc, double *op_ratios){
+    int result = SC_SUCCESS;
+    char *buf, *p, *w, *saveptr = NULL;
+    uint8_t op;
+    double ratio;
+
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++) op_ratios[op] = 0;
+
+    buf = strdup(desc);
+    if(unlikely(!buf)){
+        SC_ERROR_DETAILS("failed to allocate memory for parsing kv operation mix");
+        return SC_ERROR_MEMORY;
+    }
+
+    for(p = strtok_r(buf, ",", &saveptr); p; p = strtok_r(NULL, ",", &saveptr)){
+        w = strchr(p, ':');
+        if(!w){
+            SC_ERROR_DETAILS("ratio of kv operation %s is not given", p);
+            result = SC_ERROR_INVALID_VALUE;
+            goto sc_util_kv_op_mix_parse_exit;
+        }
+        *w = '\0';
+        w = sc_util_del_both_trim(w+1);
+        p = sc_util_del_both_trim(p);
+
+        for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+            if(!strcmp(p, _kv_op_names[op])) break;
+        }
+        if(op == SC_KV_OP_UNKNOWN){
+            SC_ERROR_DETAILS("unknown kv operation %s", p);
+            result = SC_ERROR_INVALID_VALUE;
+            goto sc_util_kv_op_mix_parse_exit;
+        }
+        if(sc_util_atolf(w, &ratio) != SC_SUCCESS || ratio < 0){
+            SC_ERROR_DETAILS("invalid ratio %s of kv operation %s", w, p);
+            result = SC_ERROR_INVALID_VALUE;
+            goto sc_util_kv_op_mix_parse_exit;
+        }
+        op_ratios[op] = ratio;
+    }
+
+sc_util_kv_op_mix_parse_exit:
+    free(buf);
+    return result;
+}
+
+/*!
+ * \brief   greatest common divisor
+ * \param   a   the first value
+ * \param   b   the second value
+ * \return  the greatest common divisor
+ */
+static uint64_t _kv_gcd(uint64_t a, uint64_t b){
+    uint64_t t;
+    while(b != 0){ t = a % b; a = b; b = t; }
+    return a;
+}
+
+/*!
+ * \brief   create the workload, the alias table of zipf ranks is shared by all send cores
+ * \param   workload    the created workload
+ * \param   conf        configuration of the workload
+ * \return  zero for successfully creation
+ */
+int sc_util_kv_workload_create(struct sc_kv_workload *workload, struct sc_kv_workload_conf *conf){
+    int result = SC_SUCCESS;
+    uint8_t op;
+    uint64_t i, nb_keys = conf->nb_keys;
+    const double *op_ratios;
+    double sum = 0, cum = 0, *weights = NULL;
+
+    memset(workload, 0, sizeof(struct sc_kv_workload));
+    workload->conf = *conf;
+
+    if(conf->workload >= SC_KV_WORKLOAD_UNKNOWN){
+        SC_ERROR_DETAILS("unknown kv workload %u", conf->workload);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(nb_keys == 0 || nb_keys > SC_KV_MAX_NB_KEYS){
+        SC_ERROR_DETAILS("invalid number of keys %lu, should be within [1, %u]", nb_keys, SC_KV_MAX_NB_KEYS);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(conf->key_len == 0 || conf->key_len > SC_KV_MAX_KEY_LEN
+        || (conf->key_len < 16 && nb_keys > (1UL << (4*conf->key_len)))){
+        SC_ERROR_DETAILS("invalid key length %u, should be within [1, %u] and hold %lu keys as hex",
+            conf->key_len, SC_KV_MAX_KEY_LEN, nb_keys);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(conf->max_scan_len == 0 || conf->max_scan_len > SC_KV_MAX_SCAN_LEN){
+        SC_ERROR_DETAILS("invalid maximum scan length %u, should be within [1, %u]",
+            conf->max_scan_len, SC_KV_MAX_SCAN_LEN);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* operation mix and key distribution */
+    if(conf->workload == SC_KV_WORKLOAD_CUSTOM){
+        op_ratios = conf->op_ratios;
+        workload->key_dist = conf->key_dist;
+    } else {
+        op_ratios = _kv_ycsb_presets[conf->workload].op_ratios;
+        workload->key_dist = _kv_ycsb_presets[conf->workload].key_dist;
+    }
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++) sum += op_ratios[op];
+    if(!(sum > 0)){
+        SC_ERROR_DETAILS("sum of kv operation ratios should be positive");
+        return SC_ERROR_INVALID_VALUE;
+    }
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+        cum += op_ratios[op];
+        workload->op_thresholds[op] = (uint64_t)(cum / sum * 4294967296.0);
+    }
+    /* absorb the rounding error into the last operation with positive ratio */
+    for(op=SC_KV_OP_UNKNOWN; op>0; op--){
+        if(op_ratios[op-1] > 0){ workload->op_thresholds[op-1] = 1UL << 32; break; }
+    }
+
+    /* scatter multiplier, which is a bijection over the key space (golden ratio hashing) */
+    workload->scatter_mult = RTE_MAX((uint64_t)1, (uint64_t)((double)nb_keys * 0.6180339887498949)) | 1;
+    while(_kv_gcd(workload->scatter_mult, nb_keys) != 1){ workload->scatter_mult += 2; }
+
+    if(workload->key_dist == SC_KV_KEY_DIST_UNIFORM){
+        goto sc_util_kv_workload_create_exit;
+    }
+    if(workload->key_dist >= SC_KV_KEY_DIST_UNKNOWN || conf->zipf_skew < 0){
+        SC_ERROR_DETAILS("invalid key distribution %u with zipf skew %lf", workload->key_dist, conf->zipf_skew);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* alias table of zipf ranks */
+    workload->alias_threshold = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_keys, 0);
+    workload->alias_index = (uint32_t*)rte_malloc(NULL, sizeof(uint32_t)*nb_keys, 0);
+    weights = (double*)malloc(sizeof(double)*nb_keys);
+    if(unlikely(!workload->alias_threshold || !workload->alias_index || !weights)){
+        SC_ERROR_DETAILS("failed to allocate memory for popularity of %lu keys", nb_keys);
+        result = SC_ERROR_MEMORY;
+        goto sc_util_kv_workload_create_exit;
+    }
+    for(i=0; i<nb_keys; i++) weights[i] = 1.0 / pow((double)(i+1), conf->zipf_skew);
+
+    result = sc_util_alias_build(weights, nb_keys, workload->alias_threshold, workload->alias_index);
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to build alias table of keys");
+        goto sc_util_kv_workload_create_exit;
+    }
+
+sc_util_kv_workload_create_exit:
+    if(weights) free(weights);
+    if(result != SC_SUCCESS){
+        sc_util_kv_workload_free(workload);
+    }
+    return result;
+}
+
+/*!
+ * \brief   free the workload
+ * \param   workload    the workload
+ */
+void sc_util_kv_workload_free(struct sc_kv_workload *workload){
+    if(workload->alias_threshold) rte_free(workload->alias_threshold);
+    if(workload->alias_index) rte_free(workload->alias_index);
+    workload->alias_threshold = NULL;
+    workload->alias_index = NULL;
+}
+
+/*!
+ * \brief   print the workload
+ * \param   workload    the workload
+ */
+void sc_util_kv_workload_print(struct sc_kv_workload *workload){
+    uint8_t op;
+    uint64_t prev = 0;
+
+    SC_LOG("kv workload %s: %lu keys, key: %u bytes, value: %u bytes, key distribution: %s (skew: %lf)",
+        _kv_workload_names[workload->conf.workload], workload->conf.nb_keys,
+        workload->conf.key_len, workload->conf.value_len,
+        _kv_key_dist_names[workload->key_dist], workload->conf.zipf_skew);
+    for(op=0; op<SC_KV_OP_UNKNOWN; op++){
+        if(workload->op_thresholds[op] > prev){
+            SC_LOG("  %s: %lf%%", _kv_op_names[op],
+                (double)(workload->op_thresholds[op] - prev) / 4294967296.0 * 100.0);
+        }
+        prev = workload->op_thresholds[op];
+    }
+}
+
+/*!
+ * \brief   initialize the per-core generator
+ * \param   gen         the generator
+ * \param   workload    the shared workload
+ * \param   stream_id   index of this core among all send cores
+ * \param   nb_streams  number of send cores
+ */
+void sc_util_kv_gen_init(struct sc_kv_gen *gen, struct sc_kv_workload *workload, uint32_t stream_id, uint32_t nb_streams){
+    gen->workload = workload;
+    gen->stream_id = stream_id;
+    gen->nb_streams = nb_streams > 0 ? nb_streams : 1;
+    gen->nb_inserted = 0;
+}
+
+/*!
+ * \brief   generate the next request
+ * \note    keys inserted by this core get ids after the loaded key space, interleaved
+ *          with other cores; under the latest distribution, the zipf rank is taken as
+ *          the recency, counted backwards from the latest key inserted by this core
+ *          and then from the end of the loaded key space
+ * \param   gen the generator
+ * \param   req the generated request
+ */
+void sc_util_kv_gen_next(struct sc_kv_gen *gen, struct sc_kv_req *req){
+    struct sc_kv_workload *workload = gen->workload;
+    uint64_t r = sc_util_rand(), rank, nb_keys = workload->conf.nb_keys;
+    uint8_t op;
+
+    for(op=0; op<SC_KV_OP_UNKNOWN-1; op++){
+        if((uint32_t)r < workload->op_thresholds[op]) break;
+    }
+    req->op = op;
+    req->value_len = sc_util_kv_op_has_value(op) ? workload->conf.value_len : 0;
+    if(op == SC_KV_OP_SCAN){
+        req->value_len = 1 + (uint32_t)(((r >> 32) * workload->conf.max_scan_len) >> 32);
+    }
+
+    if(op == SC_KV_OP_INSERT){
+        req->key_id = nb_keys + gen->nb_inserted * gen->nb_streams + gen->stream_id;
+        gen->nb_inserted += 1;
+        return;
+    }
+
+    r = sc_util_rand();
+    switch(workload->key_dist){
+    case SC_KV_KEY_DIST_ZIPF:
+        rank = sc_util_alias_sample(workload->alias_threshold, workload->alias_index, nb_keys, r);
+        req->key_id = (uint64_t)(((unsigned __int128)rank * workload->scatter_mult) % nb_keys);
+        break;
+
+    case SC_KV_KEY_DIST_LATEST:
+        rank = sc_util_alias_sample(workload->alias_threshold, workload->alias_index, nb_keys, r);
+        if(rank < gen->nb_inserted){
+            req->key_id = nb_keys + (gen->nb_inserted - 1 - rank) * gen->nb_streams + gen->stream_id;
+        } else {
+            req->key_id = nb_keys - 1 - (rank - gen->nb_inserted) % nb_keys;
+        }
+        break;
+
+    default:
+        req->key_id = (uint64_t)(((unsigned __int128)r * nb_keys) >> 64);
+    }
+}
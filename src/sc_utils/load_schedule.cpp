@@ -0,0 +1,154 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/load_schedule.hpp"
+
+/*!
+ * \brief   append a phase to the schedule
+ * \param   sched   the load schedule
+ * \param   phase   the appended phase
+ * \return  zero for successfully appending
+ */
+static int _load_schedule_append(struct sc_load_schedule *sched, struct sc_load_phase *phase){
+    struct sc_load_phase *new_phases;
+
+    /* grow the array in power of 2 */
+    if((sched->nb_phases & (sched->nb_phases - 1)) == 0){
+        new_phases = (struct sc_load_phase*)realloc(sched->phases,
+            sizeof(struct sc_load_phase)*RTE_MAX(sched->nb_phases*2, 1U));
+        if(unlikely(!new_phases)) return SC_ERROR_MEMORY;
+        sched->phases = new_phases;
+    }
+
+    sched->total_duration_ms += phase->duration_ms;
+    phase->end_ms = sched->total_duration_ms;
+    sched->phases[sched->nb_phases] = *phase;
+    sched->nb_phases += 1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   parse the load schedule file, each line describes a phase as
+ *          "<duration_ms> <pkt_rate_mpps> [ramp_to=<mpps>] [ramp_steps=<n>] [pkt_mix=<desc>] [flows=<n>]",
+ *          ramp phases are expanded into ramp_steps steps with linearly changed rate,
+ *          pkt_mix follows the description of sc_util_pkt_size_dist_parse,
+ *          lines start with # are ignored
+ * \param   path    path to the schedule file
+ * \param   sched   the parsed schedule
+ * \return  zero for successfully parsing
+ */
+int sc_util_load_schedule_parse(const char *path, struct sc_load_schedule *sched){
+    int result = SC_SUCCESS;
+    FILE *fp;
+    char line[1024], *p, *token, *saveptr;
+    uint64_t line_no = 0, nb_ramp_steps, k;
+    double ramp_to;
+    bool is_ramp;
+    struct sc_load_phase phase, step;
+
+    memset(sched, 0, sizeof(struct sc_load_schedule));
+
+    fp = fopen(path, "r");
+    if(!fp){
+        SC_ERROR_DETAILS("failed to open load schedule file %s: %s", path, strerror(errno));
+        return SC_ERROR_NOT_EXIST;
+    }
+
+    while(fgets(line, sizeof(line), fp)){
+        line_no += 1;
+        p = sc_util_del_both_trim(line);
+        sc_util_del_change_line(p);
+        if(*p == '\0' || *p == '#') continue;
+
+        memset(&phase, 0, sizeof(struct sc_load_phase));
+        is_ramp = false;
+        nb_ramp_steps = SC_LOAD_SCHED_DEFAULT_RAMP_STEPS;
+
+        /* positional fields: duration and rate */
+        token = strtok_r(p, " \t", &saveptr);
+        if(!token || sc_util_atoui_64(token, &phase.duration_ms) != SC_SUCCESS || phase.duration_ms == 0){
+            goto invalid_line;
+        }
+        token = strtok_r(NULL, " \t", &saveptr);
+        if(!token || sc_util_atolf(token, &phase.pkt_rate) != SC_SUCCESS || phase.pkt_rate < 0){
+            goto invalid_line;
+        }
+
+        /* optional fields */
+        for(token = strtok_r(NULL, " \t", &saveptr); token; token = strtok_r(NULL, " \t", &saveptr)){
+            if(!strncmp(token, "ramp_to=", 8)){
+                if(sc_util_atolf(token+8, &ramp_to) != SC_SUCCESS || ramp_to < 0){ goto invalid_line; }
+                is_ramp = true;
+            } else if(!strncmp(token, "ramp_steps=", 11)){
+                if(sc_util_atoui_64(token+11, &nb_ramp_steps) != SC_SUCCESS || nb_ramp_steps < 2){ goto invalid_line; }
+            } else if(!strncmp(token, "flows=", 6)){
+                if(sc_util_atoui_64(token+6, &phase.nb_flows) != SC_SUCCESS || phase.nb_flows == 0){ goto invalid_line; }
+            } else if(!strncmp(token, "pkt_mix=", 8)){
+                if(sc_util_pkt_size_dist_parse(token+8, &phase.pkt_size_dist) != SC_SUCCESS){ goto invalid_line; }
+                phase.enable_pkt_size_dist = true;
+            } else {
+                goto invalid_line;
+            }
+        }
+
+        if(!is_ramp){
+            result = _load_schedule_append(sched, &phase);
+        } else {
+            if(phase.duration_ms < nb_ramp_steps){ goto invalid_line; }
+            for(k=0; k<nb_ramp_steps && result == SC_SUCCESS; k++){
+                step = phase;
+                step.duration_ms = phase.duration_ms * (k+1) / nb_ramp_steps - phase.duration_ms * k / nb_ramp_steps;
+                step.pkt_rate = phase.pkt_rate + (ramp_to - phase.pkt_rate) * (double)k / (double)(nb_ramp_steps-1);
+                result = _load_schedule_append(sched, &step);
+            }
+        }
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to allocate memory for load schedule");
+            goto sc_util_load_schedule_parse_exit;
+        }
+        continue;
+
+invalid_line:
+        SC_ERROR_DETAILS("invalid line %lu inside load schedule file %s", line_no, path);
+        result = SC_ERROR_INVALID_VALUE;
+        goto sc_util_load_schedule_parse_exit;
+    }
+
+    if(sched->nb_phases == 0){
+        SC_ERROR_DETAILS("no phase is given inside load schedule file %s", path);
+        result = SC_ERROR_INVALID_VALUE;
+    }
+
+sc_util_load_schedule_parse_exit:
+    fclose(fp);
+    if(result != SC_SUCCESS){
+        sc_util_load_schedule_free(sched);
+    }
+    return result;
+}
+
+/*!
+ * \brief   free the load schedule
+ * \param   sched   the load schedule
+ */
+void sc_util_load_schedule_free(struct sc_load_schedule *sched){
+    if(sched->phases) free(sched->phases);
+    memset(sched, 0, sizeof(struct sc_load_schedule));
+}
+
+/*!
+ * \brief   print the load schedule
+ * \param   sched   the load schedule
+ */
+void sc_util_load_schedule_print(struct sc_load_schedule *sched){
+    uint32_t i;
+
+    SC_LOG("load schedule: %u phase(s), %lu ms in total", sched->nb_phases, sched->total_duration_ms);
+    for(i=0; i<sched->nb_phases; i++){
+        SC_LOG("  phase %u: [%lu, %lu) ms, %lf Mpps, %lu flow(s) per core, packet mix: %s",
+            i, sched->phases[i].end_ms - sched->phases[i].duration_ms, sched->phases[i].end_ms,
+            sched->phases[i].pkt_rate, sched->phases[i].nb_flows,
+            sched->phases[i].enable_pkt_size_dist ? "per-phase" : "default");
+    }
+}
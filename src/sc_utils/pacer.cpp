@@ -0,0 +1,96 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/pacer.hpp"
+#include "sc_utils/timestamp.hpp"
+
+/*!
+ * \brief   initialize the per-core pacer
+ * \param   pacer               the pacer to be initialized
+ * \param   arrival             arrival process of bursts
+ * \param   pkt_rate_mpps       target packet rate of this core (unit: Mpps)
+ * \param   nb_pkt_per_burst    number of packets per burst
+ * \param   bucket_depth        maximum number of bursts that could be sent back-to-back after stall
+ * \param   on_us               length of the on-period (unit: us, only for on/off arrival)
+ * \param   off_us              length of the off-period (unit: us, only for on/off arrival)
+ * \return  zero for successfully initialization
+ */
+int sc_util_pacer_init(struct sc_pacer *pacer, uint8_t arrival, double pkt_rate_mpps,
+        uint32_t nb_pkt_per_burst, uint64_t bucket_depth, uint64_t on_us, uint64_t off_us){
+    memset(pacer, 0, sizeof(struct sc_pacer));
+
+    if(pkt_rate_mpps <= 0 || nb_pkt_per_burst == 0){
+        SC_THREAD_ERROR_DETAILS("invalid packet rate %lf Mpps or burst size %u", pkt_rate_mpps, nb_pkt_per_burst);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    if(arrival == SC_PACER_ONOFF && (on_us == 0 || off_us == 0)){
+        SC_THREAD_ERROR_DETAILS("both on-period and off-period should be specified for on/off arrival");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    pacer->arrival = arrival;
+    pacer->tsc_hz = sc_util_tsc_hz();
+    pacer->nb_pkt_per_burst = nb_pkt_per_burst;
+    pacer->bucket_depth = bucket_depth > 0 ? bucket_depth : 1;
+    pacer->burst_gap_cycles = (double)pacer->tsc_hz * (double)nb_pkt_per_burst / (pkt_rate_mpps * 1000000.0);
+    pacer->on_cycles = on_us * pacer->tsc_hz / 1000000;
+    pacer->off_cycles = off_us * pacer->tsc_hz / 1000000;
+
+    pacer->start_tsc = rte_rdtsc();
+    pacer->onoff_start_tsc = pacer->start_tsc;
+    pacer->next_token_tsc = (double)pacer->start_tsc + _sc_util_pacer_next_gap(pacer);
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   change the target rate of the pacer, the next token is rescheduled from now
+ * \param   pacer           the pacer
+ * \param   pkt_rate_mpps   new target packet rate of this core (unit: Mpps, 0 for pausing)
+ */
+void sc_util_pacer_set_rate(struct sc_pacer *pacer, double pkt_rate_mpps){
+    uint64_t now_tsc = rte_rdtsc();
+
+    if(pkt_rate_mpps <= 0){
+        pacer->burst_gap_cycles = INFINITY;
+        pacer->next_token_tsc = INFINITY;
+        return;
+    }
+
+    pacer->burst_gap_cycles = (double)pacer->tsc_hz * (double)pacer->nb_pkt_per_burst / (pkt_rate_mpps * 1000000.0);
+    pacer->next_token_tsc = (double)now_tsc + _sc_util_pacer_next_gap(pacer);
+}
+
+/*!
+ * \brief   report the achieved rate and pacing error of the pacer
+ * \param   pacer                   the pacer
+ * \param   target_pkt_rate_mpps    target packet rate of this core (unit: Mpps)
+ */
+void sc_util_pacer_report(struct sc_pacer *pacer, double target_pkt_rate_mpps){
+    double duration_us, achieved_pkt_rate_mpps, cycles_per_ns;
+
+    if(pacer->tsc_hz == 0) return;
+
+    cycles_per_ns = (double)pacer->tsc_hz / 1000000000.0;
+    duration_us = (double)(rte_rdtsc() - pacer->start_tsc) * 1000000.0 / (double)pacer->tsc_hz;
+    achieved_pkt_rate_mpps = duration_us > 0
+        ? (double)(pacer->nb_released_bursts * pacer->nb_pkt_per_burst) / duration_us : 0;
+
+    /* on/off arrival only sends within the on-period */
+    if(pacer->arrival == SC_PACER_ONOFF){
+        target_pkt_rate_mpps = target_pkt_rate_mpps * (double)pacer->on_cycles 
+                                / (double)(pacer->on_cycles + pacer->off_cycles);
+    }
+
+    SC_THREAD_LOG("[pacer]: released %lu bursts, achieved rate: %lf Mpps, target rate: %lf Mpps (error: %lf%%)",
+        pacer->nb_released_bursts, achieved_pkt_rate_mpps, target_pkt_rate_mpps,
+        target_pkt_rate_mpps > 0 ? (achieved_pkt_rate_mpps - target_pkt_rate_mpps) / target_pkt_rate_mpps * 100.0 : 0
+    );
+    SC_THREAD_LOG("[pacer]: burst lateness avg: %lf ns, max: %lf ns, dropped tokens: %lu",
+        pacer->nb_released_bursts > 0 
+            ? pacer->sum_lateness_cycles / (double)pacer->nb_released_bursts / cycles_per_ns : 0,
+        (double)pacer->max_lateness_cycles / cycles_per_ns,
+        pacer->nb_dropped_tokens
+    );
+}
@@ -0,0 +1,593 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/pcap.hpp"
+#include "sc_utils/rss.hpp"
+#include "sc_utils/cksum.hpp"
+
+#include <rte_byteorder.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+/*!
+ * \brief callback invoked on each ethernet frame inside the pcap file
+ */
+typedef int (*sc_pcap_frame_handler)(void *ctx, const uint8_t *data, uint32_t cap_len, uint64_t ts_ns);
+
+/*!
+ * \brief context used while loading frames from the pcap file
+ */
+struct _pcap_load_ctx {
+    bool is_counting;
+    uint32_t nb_traces;
+    struct sc_pcap_trace *traces;
+    struct rte_mempool *mp;
+    uint32_t max_cap_len;
+    uint64_t nb_truncated;
+    bool first_ts_recorded;
+    uint64_t first_ts_ns;
+    uint64_t last_ts_ns;
+};
+
+static int _pcap_foreach_frame(FILE *fp, uint32_t magic, sc_pcap_frame_handler handler, void *ctx);
+static int _pcapng_foreach_frame(FILE *fp, sc_pcap_frame_handler handler, void *ctx);
+static int _pcap_load_frame(void *ctx, const uint8_t *data, uint32_t cap_len, uint64_t ts_ns);
+static uint32_t _pcap_get_trace_id(const uint8_t *data, uint32_t cap_len, uint32_t nb_traces);
+
+/*!
+ * \brief   check whether the ipv4 packet is a fragment
+ * \param   ipv4_hdr    the ipv4 header
+ * \return  whether the packet is a fragment
+ */
+static inline bool _pcap_is_fragmented(const struct rte_ipv4_hdr *ipv4_hdr){
+    return (rte_be_to_cpu_16(ipv4_hdr->fragment_offset) 
+        & (RTE_IPV4_HDR_MF_FLAG | RTE_IPV4_HDR_OFFSET_MASK)) != 0;
+}
+
+/*!
+ * \brief   load all ethernet frames inside a pcap / pcapng file into mbufs,
+ *          frames are spread across traces by the flow hash, so that frames
+ *          of the same flow are kept in order within a single trace
+ * \param   file_path   path to the pcap / pcapng file
+ * \param   nb_traces   number of traces (i.e., number of replay cores)
+ * \param   traces      the loaded traces
+ * \param   mp          the created mempool which stores all loaded frames
+ * \param   duration_ns duration of the whole trace
+ * \return  zero for successfully loading
+ */
+int sc_util_pcap_load(const char *file_path, uint32_t nb_traces,
+        struct sc_pcap_trace *traces, struct rte_mempool **mp, uint64_t *duration_ns){
+    int result = SC_SUCCESS;
+    uint32_t i, magic;
+    uint64_t nb_pkts = 0, nb_trace_pkts;
+    uint32_t data_room_size;
+    FILE *fp = NULL;
+    struct _pcap_load_ctx ctx;
+
+    memset(&ctx, 0, sizeof(struct _pcap_load_ctx));
+    memset(traces, 0, sizeof(struct sc_pcap_trace)*nb_traces);
+    ctx.nb_traces = nb_traces;
+    ctx.traces = traces;
+    *mp = NULL;
+
+    fp = fopen(file_path, "rb");
+    if(!fp){
+        SC_ERROR_DETAILS("failed to open pcap file %s: %s", file_path, strerror(errno));
+        result = SC_ERROR_NOT_EXIST;
+        goto sc_util_pcap_load_exit;
+    }
+
+    if(fread(&magic, sizeof(uint32_t), 1, fp) != 1){
+        SC_ERROR_DETAILS("failed to read magic number of pcap file %s", file_path);
+        result = SC_ERROR_INVALID_VALUE;
+        goto sc_util_pcap_load_exit;
+    }
+
+    /* first pass: count number of frames within each trace */
+    ctx.is_counting = true;
+    rewind(fp);
+    if(magic == SC_PCAPNG_BLOCK_SHB)
+        result = _pcapng_foreach_frame(fp, _pcap_load_frame, &ctx);
+    else
+        result = _pcap_foreach_frame(fp, magic, _pcap_load_frame, &ctx);
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to parse pcap file %s", file_path);
+        goto sc_util_pcap_load_exit;
+    }
+
+    for(i=0; i<nb_traces; i++) nb_pkts += traces[i].nb_pkts;
+    if(nb_pkts == 0){
+        SC_ERROR_DETAILS("no ethernet frame is found inside pcap file %s", file_path);
+        result = SC_ERROR_INVALID_VALUE;
+        goto sc_util_pcap_load_exit;
+    }
+
+    /* allocate per-trace arrays */
+    for(i=0; i<nb_traces; i++){
+        nb_trace_pkts = traces[i].nb_pkts;
+        if(nb_trace_pkts == 0) continue;
+
+        /* nb_pkts is reused as the cursor while copying frames */
+        traces[i].nb_pkts = 0;
+        traces[i].pkts = (struct rte_mbuf**)rte_malloc(NULL, sizeof(struct rte_mbuf*)*nb_trace_pkts, 0);
+        traces[i].ts_ns = (uint64_t*)rte_malloc(NULL, sizeof(uint64_t)*nb_trace_pkts, 0);
+        if(unlikely(!traces[i].pkts || !traces[i].ts_ns)){
+            SC_ERROR_DETAILS("failed to allocate memory for trace %u (%lu frames)", i, nb_trace_pkts);
+            result = SC_ERROR_MEMORY;
+            goto sc_util_pcap_load_exit;
+        }
+    }
+
+    /* create mempool on hugepage to store all frames */
+    data_room_size = RTE_PKTMBUF_HEADROOM + RTE_MAX(ctx.max_cap_len, (uint32_t)RTE_MBUF_DEFAULT_DATAROOM);
+    *mp = rte_pktmbuf_pool_create("sc_pcap_pool", nb_pkts, 0, 0, data_room_size, rte_socket_id());
+    if(!(*mp)){
+        SC_ERROR_DETAILS("failed to create mempool for %lu frames: %s", nb_pkts, rte_strerror(rte_errno));
+        result = SC_ERROR_MEMORY;
+        goto sc_util_pcap_load_exit;
+    }
+    ctx.mp = *mp;
+
+    /* second pass: copy frames into mbufs */
+    ctx.is_counting = false;
+    ctx.first_ts_recorded = false;
+    rewind(fp);
+    if(magic == SC_PCAPNG_BLOCK_SHB)
+        result = _pcapng_foreach_frame(fp, _pcap_load_frame, &ctx);
+    else
+        result = _pcap_foreach_frame(fp, magic, _pcap_load_frame, &ctx);
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to load pcap file %s", file_path);
+        goto sc_util_pcap_load_exit;
+    }
+
+    if(ctx.nb_truncated > 0){
+        SC_WARNING("%lu frame(s) inside %s are truncated to %u bytes",
+            ctx.nb_truncated, file_path, SC_PCAP_MAX_SNAPLEN);
+    }
+
+    *duration_ns = ctx.last_ts_ns - ctx.first_ts_ns;
+    SC_LOG("loaded %lu frame(s) from %s, duration: %lu ns", nb_pkts, file_path, *duration_ns);
+    for(i=0; i<nb_traces; i++){
+        SC_LOG("  trace %u: %lu frame(s)", i, traces[i].nb_pkts);
+    }
+
+sc_util_pcap_load_exit:
+    if(fp) fclose(fp);
+    if(result != SC_SUCCESS){
+        sc_util_pcap_free(nb_traces, traces, *mp);
+        *mp = NULL;
+    }
+    return result;
+}
+
+/*!
+ * \brief   free the loaded traces
+ * \param   nb_traces   number of traces
+ * \param   traces      the loaded traces
+ * \param   mp          the mempool which stores all loaded frames
+ */
+void sc_util_pcap_free(uint32_t nb_traces, struct sc_pcap_trace *traces, struct rte_mempool *mp){
+    uint32_t i;
+    uint64_t j;
+
+    for(i=0; i<nb_traces; i++){
+        if(traces[i].pkts){
+            for(j=0; j<traces[i].nb_pkts; j++) rte_pktmbuf_free(traces[i].pkts[j]);
+            rte_free(traces[i].pkts);
+        }
+        if(traces[i].ts_ns) rte_free(traces[i].ts_ns);
+        memset(&traces[i], 0, sizeof(struct sc_pcap_trace));
+    }
+
+    if(mp) rte_mempool_free(mp);
+}
+
+/*!
+ * \brief   rewrite addresses of the frame to be replayed
+ * \param   pkt         the frame to be rewritten
+ * \param   src_mac     new source mac address (NULL for unchanged)
+ * \param   dst_mac     new destination mac address (NULL for unchanged)
+ * \param   src_ipv4    new source ipv4 address (0 for unchanged)
+ * \param   dst_ipv4    new destination ipv4 address (0 for unchanged)
+ * \return  zero for successfully rewriting
+ */
+int sc_util_pcap_rewrite_pkt(struct rte_mbuf *pkt, struct rte_ether_addr *src_mac,
+        struct rte_ether_addr *dst_mac, rte_be32_t src_ipv4, rte_be32_t dst_ipv4){
+    struct rte_ether_hdr *eth_hdr;
+    struct rte_ipv4_hdr *ipv4_hdr;
+    struct rte_udp_hdr *udp_hdr;
+    struct rte_tcp_hdr *tcp_hdr;
+    uint16_t ether_type, l3_offset = sizeof(struct rte_ether_hdr);
+
+    if(unlikely(rte_pktmbuf_data_len(pkt) < sizeof(struct rte_ether_hdr)))
+        return SC_ERROR_INVALID_VALUE;
+
+    eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr*);
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+        if(src_mac) rte_ether_addr_copy(src_mac, &eth_hdr->src_addr);
+        if(dst_mac) rte_ether_addr_copy(dst_mac, &eth_hdr->dst_addr);
+    #else
+        if(src_mac) rte_ether_addr_copy(src_mac, &eth_hdr->s_addr);
+        if(dst_mac) rte_ether_addr_copy(dst_mac, &eth_hdr->d_addr);
+    #endif
+
+    if(!src_ipv4 && !dst_ipv4)
+        return SC_SUCCESS;
+
+    /* skip single vlan tag */
+    ether_type = rte_be_to_cpu_16(eth_hdr->ether_type);
+    if(ether_type == RTE_ETHER_TYPE_VLAN){
+        if(unlikely(rte_pktmbuf_data_len(pkt) < l3_offset + sizeof(struct rte_vlan_hdr)))
+            return SC_ERROR_INVALID_VALUE;
+        ether_type = rte_be_to_cpu_16(
+            rte_pktmbuf_mtod_offset(pkt, struct rte_vlan_hdr*, l3_offset)->eth_proto);
+        l3_offset += sizeof(struct rte_vlan_hdr);
+    }
+    if(ether_type != RTE_ETHER_TYPE_IPV4)
+        return SC_SUCCESS;
+    if(unlikely(rte_pktmbuf_data_len(pkt) < l3_offset + sizeof(struct rte_ipv4_hdr)))
+        return SC_ERROR_INVALID_VALUE;
+
+    ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr*, l3_offset);
+    if(src_ipv4) ipv4_hdr->src_addr = src_ipv4;
+    if(dst_ipv4) ipv4_hdr->dst_addr = dst_ipv4;
+    ipv4_hdr->hdr_checksum = 0;
+    ipv4_hdr->hdr_checksum = rte_ipv4_cksum(ipv4_hdr);
+
+    /* l4 checksum covers the pseudo header, only recalculate it for complete (non-fragmented) frames */
+    if(_pcap_is_fragmented(ipv4_hdr)
+        || rte_pktmbuf_data_len(pkt) < l3_offset + rte_be_to_cpu_16(ipv4_hdr->total_length)){
+        return SC_SUCCESS;
+    }
+    if(ipv4_hdr->next_proto_id == IPPROTO_UDP){
+        udp_hdr = (struct rte_udp_hdr*)((uint8_t*)ipv4_hdr + rte_ipv4_hdr_len(ipv4_hdr));
+        if(udp_hdr->dgram_cksum != 0){
+            udp_hdr->dgram_cksum = 0;
+            udp_hdr->dgram_cksum = sc_util_cksum_ipv4_udptcp(ipv4_hdr, udp_hdr);
+        }
+    } else if(ipv4_hdr->next_proto_id == IPPROTO_TCP){
+        tcp_hdr = (struct rte_tcp_hdr*)((uint8_t*)ipv4_hdr + rte_ipv4_hdr_len(ipv4_hdr));
+        tcp_hdr->cksum = 0;
+        tcp_hdr->cksum = sc_util_cksum_ipv4_udptcp(ipv4_hdr, tcp_hdr);
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   handler for counting / copying a single frame into the trace
+ * \param   ctx         the loading context
+ * \param   data        the captured frame
+ * \param   cap_len     captured length of the frame
+ * \param   ts_ns       timestamp of the frame
+ * \return  zero for successfully handling
+ */
+static int _pcap_load_frame(void *ctx, const uint8_t *data, uint32_t cap_len, uint64_t ts_ns){
+    struct _pcap_load_ctx *load_ctx = (struct _pcap_load_ctx*)ctx;
+    struct sc_pcap_trace *trace;
+    struct rte_mbuf *pkt;
+    char *pkt_data;
+    uint32_t trace_id;
+
+    if(unlikely(cap_len < sizeof(struct rte_ether_hdr)))
+        return SC_SUCCESS;
+
+    if(cap_len > SC_PCAP_MAX_SNAPLEN){
+        if(!load_ctx->is_counting) load_ctx->nb_truncated += 1;
+        cap_len = SC_PCAP_MAX_SNAPLEN;
+    }
+
+    trace_id = _pcap_get_trace_id(data, cap_len, load_ctx->nb_traces);
+    trace = &load_ctx->traces[trace_id];
+
+    if(load_ctx->is_counting){
+        trace->nb_pkts += 1;
+        if(cap_len > load_ctx->max_cap_len) load_ctx->max_cap_len = cap_len;
+        return SC_SUCCESS;
+    }
+
+    /* timestamps of all traces are relative to the first frame of the file */
+    if(!load_ctx->first_ts_recorded){
+        load_ctx->first_ts_ns = ts_ns;
+        load_ctx->first_ts_recorded = true;
+    }
+    if(unlikely(ts_ns < load_ctx->first_ts_ns)){
+        ts_ns = load_ctx->first_ts_ns;
+    }
+    /* keep timestamps within a trace monotonic */
+    if(trace->nb_pkts > 0 && unlikely(ts_ns - load_ctx->first_ts_ns < trace->ts_ns[trace->nb_pkts-1])){
+        ts_ns = trace->ts_ns[trace->nb_pkts-1] + load_ctx->first_ts_ns;
+    }
+    if(ts_ns > load_ctx->last_ts_ns) load_ctx->last_ts_ns = ts_ns;
+
+    pkt = rte_pktmbuf_alloc(load_ctx->mp);
+    if(unlikely(!pkt)){
+        SC_ERROR_DETAILS("failed to allocate mbuf for frame %lu of trace %u", trace->nb_pkts, trace_id);
+        return SC_ERROR_MEMORY;
+    }
+    pkt_data = rte_pktmbuf_append(pkt, cap_len);
+    if(unlikely(!pkt_data)){
+        SC_ERROR_DETAILS("failed to append %u bytes to mbuf", cap_len);
+        rte_pktmbuf_free(pkt);
+        return SC_ERROR_MEMORY;
+    }
+    rte_memcpy(pkt_data, data, cap_len);
+
+    trace->pkts[trace->nb_pkts] = pkt;
+    trace->ts_ns[trace->nb_pkts] = ts_ns - load_ctx->first_ts_ns;
+    trace->nb_pkts += 1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   obtain the index of the trace which the frame belongs to,
+ *          based on the toeplitz hash of the 5-tuple
+ * \param   data        the captured frame
+ * \param   cap_len     captured length of the frame
+ * \param   nb_traces   number of traces
+ * \return  index of the trace
+ */
+static uint32_t _pcap_get_trace_id(const uint8_t *data, uint32_t cap_len, uint32_t nb_traces){
+    const struct rte_ipv4_hdr *ipv4_hdr;
+    const uint8_t *l4_hdr;
+    uint16_t ether_type, sport = 0, dport = 0;
+    uint32_t l3_offset = sizeof(struct rte_ether_hdr), rss_l3, rss_l3l4;
+
+    if(nb_traces <= 1) return 0;
+
+    ether_type = rte_be_to_cpu_16(((const struct rte_ether_hdr*)data)->ether_type);
+    if(ether_type == RTE_ETHER_TYPE_VLAN && cap_len >= l3_offset + sizeof(struct rte_vlan_hdr)){
+        ether_type = rte_be_to_cpu_16(((const struct rte_vlan_hdr*)(data + l3_offset))->eth_proto);
+        l3_offset += sizeof(struct rte_vlan_hdr);
+    }
+
+    /* non-ipv4 frames are replayed by the first core */
+    if(ether_type != RTE_ETHER_TYPE_IPV4 || cap_len < l3_offset + sizeof(struct rte_ipv4_hdr))
+        return 0;
+
+    ipv4_hdr = (const struct rte_ipv4_hdr*)(data + l3_offset);
+    l4_hdr = data + l3_offset + rte_ipv4_hdr_len(ipv4_hdr);
+    if((ipv4_hdr->next_proto_id == IPPROTO_UDP || ipv4_hdr->next_proto_id == IPPROTO_TCP)
+        && !_pcap_is_fragmented(ipv4_hdr)
+        && l4_hdr + sizeof(uint32_t) <= data + cap_len){
+        /* source and destination ports are located at the same offset for both udp and tcp */
+        sport = rte_be_to_cpu_16(((const rte_be16_t*)l4_hdr)[0]);
+        dport = rte_be_to_cpu_16(((const rte_be16_t*)l4_hdr)[1]);
+    }
+
+    sc_util_get_rss_result_ipv4(
+        rte_be_to_cpu_32(ipv4_hdr->src_addr), rte_be_to_cpu_32(ipv4_hdr->dst_addr),
+        sport, dport, 0, &rss_l3, &rss_l3l4);
+
+    return (sport || dport ? rss_l3l4 : rss_l3) % nb_traces;
+}
+
+/*!
+ * \brief   convert timestamp in given resolution to nanoseconds
+ * \param   ts              the timestamp
+ * \param   units_per_sec   number of timestamp units per second
+ * \return  timestamp in nanoseconds
+ */
+static inline uint64_t _pcap_ts_to_ns(uint64_t ts, uint64_t units_per_sec){
+    return (ts / units_per_sec) * 1000000000UL
+        + (uint64_t)((long double)(ts % units_per_sec) * 1e9L / (long double)units_per_sec);
+}
+
+/*!
+ * \brief   iterate all frames inside a classic pcap file
+ * \param   fp          the opened pcap file
+ * \param   magic       magic number of the pcap file
+ * \param   handler     callback invoked on each frame
+ * \param   ctx         context passed to the callback
+ * \return  zero for successfully iteration
+ */
+static int _pcap_foreach_frame(FILE *fp, uint32_t magic, sc_pcap_frame_handler handler, void *ctx){
+    int result = SC_SUCCESS;
+    bool is_swapped, is_nano;
+    uint8_t *buf = NULL;
+    uint32_t ts_sec, ts_frac, incl_len;
+    struct {
+        uint32_t magic;
+        uint16_t version_major, version_minor;
+        int32_t thiszone;
+        uint32_t sigfigs, snaplen, linktype;
+    } file_hdr;
+    struct {
+        uint32_t ts_sec, ts_frac, incl_len, orig_len;
+    } rec_hdr;
+
+    if(magic == SC_PCAP_MAGIC_US || magic == SC_PCAP_MAGIC_NS){
+        is_swapped = false;
+        is_nano = (magic == SC_PCAP_MAGIC_NS);
+    } else if(magic == rte_bswap32(SC_PCAP_MAGIC_US) || magic == rte_bswap32(SC_PCAP_MAGIC_NS)){
+        is_swapped = true;
+        is_nano = (magic == rte_bswap32(SC_PCAP_MAGIC_NS));
+    } else {
+        SC_ERROR_DETAILS("unknown magic number 0x%x of pcap file", magic);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    if(fread(&file_hdr, sizeof(file_hdr), 1, fp) != 1){
+        SC_ERROR_DETAILS("failed to read pcap file header");
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if((is_swapped ? rte_bswap32(file_hdr.linktype) : file_hdr.linktype) != SC_PCAP_LINKTYPE_ETHERNET){
+        SC_ERROR_DETAILS("unsupported link type %u of pcap file, only ethernet is supported",
+            is_swapped ? rte_bswap32(file_hdr.linktype) : file_hdr.linktype);
+        return SC_ERROR_NOT_IMPLEMENTED;
+    }
+
+    buf = (uint8_t*)malloc(UINT16_MAX);
+    if(unlikely(!buf)){
+        SC_ERROR_DETAILS("failed to allocate memory for pcap record");
+        return SC_ERROR_MEMORY;
+    }
+
+    while(fread(&rec_hdr, sizeof(rec_hdr), 1, fp) == 1){
+        if(sc_force_quit){ break; }
+
+        ts_sec = is_swapped ? rte_bswap32(rec_hdr.ts_sec) : rec_hdr.ts_sec;
+        ts_frac = is_swapped ? rte_bswap32(rec_hdr.ts_frac) : rec_hdr.ts_frac;
+        incl_len = is_swapped ? rte_bswap32(rec_hdr.incl_len) : rec_hdr.incl_len;
+
+        /* only the loaded part of oversized frame is read, the rest is skipped */
+        if(fread(buf, 1, RTE_MIN(incl_len, (uint32_t)UINT16_MAX), fp) != RTE_MIN(incl_len, (uint32_t)UINT16_MAX)){
+            SC_WARNING("pcap file is truncated inside a record, stop loading");
+            break;
+        }
+        if(incl_len > UINT16_MAX && fseek(fp, incl_len - UINT16_MAX, SEEK_CUR) != 0){
+            SC_WARNING("pcap file is truncated inside a record, stop loading");
+            break;
+        }
+
+        result = handler(ctx, buf, incl_len,
+            (uint64_t)ts_sec * 1000000000UL + (uint64_t)ts_frac * (is_nano ? 1 : 1000));
+        if(result != SC_SUCCESS) break;
+    }
+
+    free(buf);
+    return result;
+}
+
+/*!
+ * \brief   iterate all frames inside a pcapng file, only enhanced packet blocks
+ *          and simple packet blocks of ethernet interfaces are handled
+ * \param   fp          the opened pcapng file
+ * \param   handler     callback invoked on each frame
+ * \param   ctx         context passed to the callback
+ * \return  zero for successfully iteration
+ */
+static int _pcapng_foreach_frame(FILE *fp, sc_pcap_frame_handler handler, void *ctx){
+    int result = SC_SUCCESS;
+    bool is_swapped = false;
+    uint8_t *buf = NULL, *opt;
+    uint32_t buf_len = 0, block_type, block_len, body_len, iface_id, cap_len;
+    uint16_t opt_code, opt_len, nb_ifaces = 0;
+    uint16_t linktypes[SC_PCAPNG_MAX_NB_IFACES];
+    uint64_t units_per_sec[SC_PCAPNG_MAX_NB_IFACES];
+    uint64_t ts, last_ts_ns = 0;
+    uint32_t block_hdr[2];
+
+    #define _PCAPNG_32(v) (is_swapped ? rte_bswap32(v) : (v))
+    #define _PCAPNG_16(v) (is_swapped ? rte_bswap16(v) : (v))
+
+    while(fread(block_hdr, sizeof(block_hdr), 1, fp) == 1){
+        if(sc_force_quit){ break; }
+
+        /* byte order is determined by the section header block */
+        block_type = block_hdr[0];
+        if(block_type == SC_PCAPNG_BLOCK_SHB){
+            uint32_t byte_order;
+            if(fread(&byte_order, sizeof(uint32_t), 1, fp) != 1) break;
+            if(byte_order == SC_PCAPNG_BYTE_ORDER){
+                is_swapped = false;
+            } else if(byte_order == rte_bswap32(SC_PCAPNG_BYTE_ORDER)){
+                is_swapped = true;
+            } else {
+                SC_ERROR_DETAILS("unknown byte order magic 0x%x of pcapng file", byte_order);
+                result = SC_ERROR_INVALID_VALUE;
+                break;
+            }
+            block_len = _PCAPNG_32(block_hdr[1]);
+            if(block_len < 28 || block_len % 4 != 0){
+                SC_ERROR_DETAILS("invalid section header block length %u", block_len);
+                result = SC_ERROR_INVALID_VALUE;
+                break;
+            }
+            /* interfaces are described per section */
+            nb_ifaces = 0;
+            if(fseek(fp, block_len - 12, SEEK_CUR) != 0) break;
+            continue;
+        }
+
+        block_type = _PCAPNG_32(block_type);
+        block_len = _PCAPNG_32(block_hdr[1]);
+        if(block_len < 12 || block_len % 4 != 0){
+            SC_ERROR_DETAILS("invalid block length %u of pcapng file", block_len);
+            result = SC_ERROR_INVALID_VALUE;
+            break;
+        }
+
+        /* read the block body (along with the trailing length) */
+        body_len = block_len - 8;
+        if(body_len > buf_len){
+            uint8_t *new_buf = (uint8_t*)realloc(buf, body_len);
+            if(unlikely(!new_buf)){
+                SC_ERROR_DETAILS("failed to allocate memory for pcapng block (%u bytes)", body_len);
+                result = SC_ERROR_MEMORY;
+                break;
+            }
+            buf = new_buf;
+            buf_len = body_len;
+        }
+        if(fread(buf, 1, body_len, fp) != body_len){
+            SC_WARNING("pcapng file is truncated inside a block, stop loading");
+            break;
+        }
+        body_len -= 4;
+
+        switch(block_type){
+        case SC_PCAPNG_BLOCK_IDB:
+            if(body_len < 8 || nb_ifaces == SC_PCAPNG_MAX_NB_IFACES){
+                SC_ERROR_DETAILS("invalid interface description block");
+                result = SC_ERROR_INVALID_VALUE;
+                goto pcapng_foreach_frame_exit;
+            }
+            linktypes[nb_ifaces] = _PCAPNG_16(*(uint16_t*)buf);
+            units_per_sec[nb_ifaces] = 1000000;
+
+            /* parse if_tsresol option */
+            opt = buf + 8;
+            while(opt + 4 <= buf + body_len){
+                opt_code = _PCAPNG_16(*(uint16_t*)opt);
+                opt_len = _PCAPNG_16(*(uint16_t*)(opt + 2));
+                if(opt_code == 0) break;
+                if(opt_code == 9 && opt_len == 1 && opt + 5 <= buf + body_len){
+                    uint8_t tsresol = opt[4];
+                    if((tsresol & 0x80) && (tsresol & 0x7F) < 64)
+                        units_per_sec[nb_ifaces] = 1UL << (tsresol & 0x7F);
+                    else if(!(tsresol & 0x80) && tsresol <= 19){
+                        units_per_sec[nb_ifaces] = 1;
+                        while(tsresol--) units_per_sec[nb_ifaces] *= 10;
+                    }
+                }
+                opt += 4 + RTE_ALIGN_CEIL(opt_len, 4);
+            }
+            nb_ifaces += 1;
+            break;
+
+        case SC_PCAPNG_BLOCK_EPB:
+            if(body_len < 20) break;
+            iface_id = _PCAPNG_32(((uint32_t*)buf)[0]);
+            ts = ((uint64_t)_PCAPNG_32(((uint32_t*)buf)[1]) << 32) | _PCAPNG_32(((uint32_t*)buf)[2]);
+            cap_len = _PCAPNG_32(((uint32_t*)buf)[3]);
+            if(iface_id >= nb_ifaces || linktypes[iface_id] != SC_PCAP_LINKTYPE_ETHERNET) break;
+            if(cap_len > body_len - 20) cap_len = body_len - 20;
+            last_ts_ns = _pcap_ts_to_ns(ts, units_per_sec[iface_id]);
+            result = handler(ctx, buf + 20, cap_len, last_ts_ns);
+            if(result != SC_SUCCESS) goto pcapng_foreach_frame_exit;
+            break;
+
+        case SC_PCAPNG_BLOCK_SPB:
+            /* simple packet block carries no timestamp, reuse the previous one */
+            if(body_len < 4 || nb_ifaces == 0 || linktypes[0] != SC_PCAP_LINKTYPE_ETHERNET) break;
+            cap_len = RTE_MIN(_PCAPNG_32(((uint32_t*)buf)[0]), body_len - 4);
+            result = handler(ctx, buf + 4, cap_len, last_ts_ns);
+            if(result != SC_SUCCESS) goto pcapng_foreach_frame_exit;
+            break;
+
+        default:
+            /* skip other blocks */
+            break;
+        }
+    }
+
+    #undef _PCAPNG_32
+    #undef _PCAPNG_16
+
+pcapng_foreach_frame_exit:
+    if(buf) free(buf);
+    return result;
+}
@@ -0,0 +1,298 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/pkt_size.hpp"
+
+#include <algorithm>
+
+/*!
+ * \brief simple imix (7:4:1 of 60/590/1514 bytes frames, excluding fcs)
+ */
+static uint32_t _simple_imix_sizes[] = { 60, 590, 1514 };
+static double _simple_imix_weights[] = { 7, 4, 1 };
+
+/*!
+ * \brief internet imix, a multi-modal mix with more mass on small and full-sized frames
+ */
+static uint32_t _inet_imix_sizes[] = { 60, 128, 256, 512, 590, 1024, 1514 };
+static double _inet_imix_weights[] = { 50, 6, 4, 5, 10, 5, 20 };
+
+static int _pkt_size_load_cdf(const char *path, uint32_t **sizes, double **weights, uint32_t *nb_sizes);
+static int _pkt_size_parse_list(const char *desc, uint32_t **sizes, double **weights, uint32_t *nb_sizes);
+
+/*!
+ * \brief   parse the description of packet size distribution
+ * \param   desc    the description, one of
+ *                  [1] imix / inet_imix: named mixes;
+ *                  [2] size:weight,size:weight,...: weighted size list;
+ *                  [3] cdf:path: empirical cdf file, each line is "size cumulative_probability"
+ * \param   dist    the parsed distribution
+ * \return  zero for successfully parsing
+ */
+int sc_util_pkt_size_dist_parse(const char *desc, struct sc_pkt_size_dist *dist){
+    int result = SC_SUCCESS;
+    uint32_t *sizes = NULL, nb_sizes = 0;
+    double *weights = NULL;
+
+    if(!strcmp(desc, "imix")){
+        return sc_util_pkt_size_dist_init(dist, _simple_imix_sizes, _simple_imix_weights,
+            sizeof(_simple_imix_sizes) / sizeof(uint32_t));
+    } else if(!strcmp(desc, "inet_imix")){
+        return sc_util_pkt_size_dist_init(dist, _inet_imix_sizes, _inet_imix_weights,
+            sizeof(_inet_imix_sizes) / sizeof(uint32_t));
+    } else if(!strncmp(desc, "cdf:", 4)){
+        result = _pkt_size_load_cdf(desc + 4, &sizes, &weights, &nb_sizes);
+    } else {
+        result = _pkt_size_parse_list(desc, &sizes, &weights, &nb_sizes);
+    }
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to parse packet size distribution %s", desc);
+        goto sc_util_pkt_size_dist_parse_exit;
+    }
+
+    result = sc_util_pkt_size_dist_init(dist, sizes, weights, nb_sizes);
+
+sc_util_pkt_size_dist_parse_exit:
+    if(sizes) free(sizes);
+    if(weights) free(weights);
+    return result;
+}
+
+/*!
+ * \brief   initialize the packet size distribution by weighted sizes, sizes are merged
+ *          into at most SC_PKT_SIZE_MAX_NB_BUCKETS buckets, the size of each merged
+ *          bucket is the weighted mean of its members (so the mean size is preserved)
+ * \param   dist        the initialized distribution
+ * \param   sizes       the sizes (unit: bytes)
+ * \param   weights     the (unnormalized) weight of each size
+ * \param   nb_sizes    number of sizes
+ * \return  zero for successfully initialization
+ */
+int sc_util_pkt_size_dist_init(struct sc_pkt_size_dist *dist, uint32_t *sizes, double *weights, uint32_t nb_sizes){
+    int result = SC_SUCCESS;
+    uint32_t i, *order = NULL;
+    double sum = 0.0, acc_weight = 0.0, acc_bytes = 0.0, cum_weight = 0.0, target;
+    double alias_weights[SC_PKT_SIZE_MAX_NB_BUCKETS];
+
+    memset(dist, 0, sizeof(struct sc_pkt_size_dist));
+
+    if(nb_sizes == 0){
+        SC_ERROR_DETAILS("no packet size is given");
+        return SC_ERROR_INVALID_VALUE;
+    }
+    for(i=0; i<nb_sizes; i++){
+        if(sizes[i] == 0 || weights[i] < 0){
+            SC_ERROR_DETAILS("invalid packet size %u with weight %lf", sizes[i], weights[i]);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        sum += weights[i];
+    }
+    if(!(sum > 0)){
+        SC_ERROR_DETAILS("sum of packet size weights should be positive");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    /* sort sizes in ascending order */
+    order = (uint32_t*)malloc(sizeof(uint32_t)*nb_sizes);
+    if(unlikely(!order)){
+        SC_ERROR_DETAILS("failed to allocate memory for sorting packet sizes");
+        return SC_ERROR_MEMORY;
+    }
+    for(i=0; i<nb_sizes; i++) order[i] = i;
+    std::stable_sort(order, order+nb_sizes, [sizes](uint32_t a, uint32_t b){ return sizes[a] < sizes[b]; });
+
+    /*
+     * merge sizes into buckets with nearly equal probability mass, bucket k is closed
+     * once the accumulated mass reaches (k+1)/SC_PKT_SIZE_MAX_NB_BUCKETS, every size
+     * owns its bucket if there are few enough of them
+     */
+    for(i=0; i<nb_sizes; i++){
+        if(weights[order[i]] == 0) continue;
+        acc_weight += weights[order[i]];
+        acc_bytes += weights[order[i]] * (double)sizes[order[i]];
+        cum_weight += weights[order[i]];
+
+        /* sizes equal to the next one always fall into the same bucket */
+        if(i+1 < nb_sizes && sizes[order[i+1]] == sizes[order[i]]) continue;
+
+        target = sum * (double)(dist->nb_buckets + 1) / (double)SC_PKT_SIZE_MAX_NB_BUCKETS;
+        if(nb_sizes <= SC_PKT_SIZE_MAX_NB_BUCKETS
+                || (cum_weight >= target && dist->nb_buckets < SC_PKT_SIZE_MAX_NB_BUCKETS-1)){
+            dist->sizes[dist->nb_buckets] = (uint32_t)(acc_bytes / acc_weight + 0.5);
+            dist->probs[dist->nb_buckets] = acc_weight / sum;
+            dist->nb_buckets += 1;
+            acc_weight = acc_bytes = 0.0;
+        }
+    }
+    if(acc_weight > 0){
+        dist->sizes[dist->nb_buckets] = (uint32_t)(acc_bytes / acc_weight + 0.5);
+        dist->probs[dist->nb_buckets] = acc_weight / sum;
+        dist->nb_buckets += 1;
+    }
+
+    /* statistics and alias table */
+    dist->min_size = UINT32_MAX;
+    for(i=0; i<dist->nb_buckets; i++){
+        dist->mean_size += dist->probs[i] * (double)dist->sizes[i];
+        dist->min_size = RTE_MIN(dist->min_size, dist->sizes[i]);
+        dist->max_size = RTE_MAX(dist->max_size, dist->sizes[i]);
+        alias_weights[i] = dist->probs[i];
+    }
+    result = sc_util_alias_build(alias_weights, dist->nb_buckets, dist->alias_threshold, dist->alias_index);
+    if(result != SC_SUCCESS){
+        SC_ERROR_DETAILS("failed to build alias table of packet size distribution");
+    }
+
+    free(order);
+    return result;
+}
+
+/*!
+ * \brief   print the packet size distribution
+ * \param   dist    the packet size distribution
+ */
+void sc_util_pkt_size_dist_print(struct sc_pkt_size_dist *dist){
+    uint32_t i;
+
+    SC_LOG("packet size distribution: %u bucket(s), mean %lf bytes, range [%u, %u] bytes",
+        dist->nb_buckets, dist->mean_size, dist->min_size, dist->max_size);
+    for(i=0; i<dist->nb_buckets; i++){
+        SC_LOG("  %u bytes: %lf", dist->sizes[i], dist->probs[i]);
+    }
+}
+
+/*!
+ * \brief   append a weighted size to the dynamic arrays
+ * \param   sizes       the size array
+ * \param   weights     the weight array
+ * \param   nb_sizes    number of sizes inside the arrays
+ * \param   size        the appended size
+ * \param   weight      the appended weight
+ * \return  zero for successfully appending
+ */
+static int _pkt_size_append(uint32_t **sizes, double **weights, uint32_t *nb_sizes, uint32_t size, double weight){
+    uint32_t *new_sizes;
+    double *new_weights;
+
+    /* grow the arrays in power of 2 */
+    if((*nb_sizes & (*nb_sizes - 1)) == 0){
+        new_sizes = (uint32_t*)realloc(*sizes, sizeof(uint32_t)*RTE_MAX(*nb_sizes*2, 1U));
+        if(unlikely(!new_sizes)) return SC_ERROR_MEMORY;
+        *sizes = new_sizes;
+        new_weights = (double*)realloc(*weights, sizeof(double)*RTE_MAX(*nb_sizes*2, 1U));
+        if(unlikely(!new_weights)) return SC_ERROR_MEMORY;
+        *weights = new_weights;
+    }
+
+    (*sizes)[*nb_sizes] = size;
+    (*weights)[*nb_sizes] = weight;
+    *nb_sizes += 1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   parse the weighted size list, e.g., 64:7,576:4,1500:1 (weight is 1 if omitted)
+ * \param   desc        the weighted size list
+ * \param   sizes       the parsed sizes (allocated inside)
+ * \param   weights     the parsed weights (allocated inside)
+ * \param   nb_sizes    number of parsed sizes
+ * \return  zero for successfully parsing
+ */
+static int _pkt_size_parse_list(const char *desc, uint32_t **sizes, double **weights, uint32_t *nb_sizes){
+    int result = SC_SUCCESS;
+    char *buf, *p, *w, *saveptr = NULL;
+    uint32_t size;
+    double weight;
+
+    buf = strdup(desc);
+    if(unlikely(!buf)){
+        SC_ERROR_DETAILS("failed to allocate memory for parsing packet size list");
+        return SC_ERROR_MEMORY;
+    }
+
+    for(p = strtok_r(buf, ",", &saveptr); p; p = strtok_r(NULL, ",", &saveptr)){
+        weight = 1.0;
+        w = strchr(p, ':');
+        if(w){
+            *w = '\0';
+            w = sc_util_del_both_trim(w+1);
+            if(sc_util_atolf(w, &weight) != SC_SUCCESS){
+                SC_ERROR_DETAILS("invalid weight %s inside packet size list", w);
+                result = SC_ERROR_INVALID_VALUE;
+                goto _pkt_size_parse_list_exit;
+            }
+        }
+        p = sc_util_del_both_trim(p);
+        if(sc_util_atoui_32(p, &size) != SC_SUCCESS){
+            SC_ERROR_DETAILS("invalid size %s inside packet size list", p);
+            result = SC_ERROR_INVALID_VALUE;
+            goto _pkt_size_parse_list_exit;
+        }
+
+        result = _pkt_size_append(sizes, weights, nb_sizes, size, weight);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to allocate memory for packet size list");
+            goto _pkt_size_parse_list_exit;
+        }
+    }
+
+_pkt_size_parse_list_exit:
+    free(buf);
+    return result;
+}
+
+/*!
+ * \brief   load the empirical cdf of packet size from file, each line is
+ *          "size cumulative_probability" in ascending order, lines start with # are ignored
+ * \param   path        path to the cdf file
+ * \param   sizes       the loaded sizes (allocated inside)
+ * \param   weights     the probability mass of each size (allocated inside)
+ * \param   nb_sizes    number of loaded sizes
+ * \return  zero for successfully loading
+ */
+static int _pkt_size_load_cdf(const char *path, uint32_t **sizes, double **weights, uint32_t *nb_sizes){
+    int result = SC_SUCCESS;
+    FILE *fp;
+    char line[256], *p;
+    unsigned long size, last_size = 0;
+    double cdf, last_cdf = 0.0;
+    uint64_t line_no = 0;
+
+    fp = fopen(path, "r");
+    if(!fp){
+        SC_ERROR_DETAILS("failed to open packet size cdf file %s: %s", path, strerror(errno));
+        return SC_ERROR_NOT_EXIST;
+    }
+
+    while(fgets(line, sizeof(line), fp)){
+        line_no += 1;
+        p = sc_util_del_both_trim(line);
+        sc_util_del_change_line(p);
+        if(*p == '\0' || *p == '#') continue;
+
+        if(sscanf(p, "%lu %lf", &size, &cdf) != 2 || size == 0 || size > UINT32_MAX
+                || size <= last_size || cdf < last_cdf || cdf > 1.0 + 1e-9){
+            SC_ERROR_DETAILS("invalid line %lu inside cdf file %s, sizes and probabilities should be ascending",
+                line_no, path);
+            result = SC_ERROR_INVALID_VALUE;
+            goto _pkt_size_load_cdf_exit;
+        }
+
+        result = _pkt_size_append(sizes, weights, nb_sizes, (uint32_t)size, cdf - last_cdf);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to allocate memory for packet size cdf");
+            goto _pkt_size_load_cdf_exit;
+        }
+        last_size = size;
+        last_cdf = cdf;
+    }
+
+    if(*nb_sizes == 0 || last_cdf < 1.0 - 1e-6){
+        SC_WARNING_DETAILS("cdf file %s ends at probability %lf, the remaining mass is dropped", path, last_cdf);
+    }
+
+_pkt_size_load_cdf_exit:
+    fclose(fp);
+    return result;
+}
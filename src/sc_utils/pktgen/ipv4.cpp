@@ -4,6 +4,7 @@
 #include "sc_control_plane.hpp"
 #include "sc_utils/rss.hpp"
 #include "sc_utils/timestamp.hpp"
+#include "sc_utils/cksum.hpp"
 
 /*!
  * \brief   generate random ipv4 address
@@ -46,9 +47,6 @@ int sc_util_generate_ipv4_addr(uint8_t *specified_addr, uint32_t *result_addr){
  */
 int sc_util_initialize_ipv4_header_proto(struct rte_ipv4_hdr *ip_hdr, uint32_t src_addr,
 		uint32_t dst_addr, uint16_t pkt_data_len, uint8_t proto, uint16_t *pkt_len){
-	unaligned_uint16_t *ptr16;
-	uint32_t ip_cksum;
-
 	/*
 	 * Initialize IP header.
 	 */
@@ -67,24 +65,7 @@ int sc_util_initialize_ipv4_header_proto(struct rte_ipv4_hdr *ip_hdr, uint32_t s
 	/*
 	 * Compute IP header checksum.
 	 */
-	ptr16 = (unaligned_uint16_t *)ip_hdr;
-	ip_cksum = 0;
-	ip_cksum += ptr16[0]; ip_cksum += ptr16[1];
-	ip_cksum += ptr16[2]; ip_cksum += ptr16[3];
-	ip_cksum += ptr16[4];
-	ip_cksum += ptr16[6]; ip_cksum += ptr16[7];
-	ip_cksum += ptr16[8]; ip_cksum += ptr16[9];
-
-	/*
-	 * Reduce 32 bit checksum to 16 bits and complement it.
-	 */
-	ip_cksum = ((ip_cksum & 0xFFFF0000) >> 16) +
-		(ip_cksum & 0x0000FFFF);
-	ip_cksum %= 65536;
-	ip_cksum = (~ip_cksum) & 0x0000FFFF;
-	if (ip_cksum == 0)
-		ip_cksum = 0xFFFF;
-	ip_hdr->hdr_checksum = (uint16_t) ip_cksum;
+	ip_hdr->hdr_checksum = sc_util_cksum_ipv4_hdr(ip_hdr);
 
 	return SC_SUCCESS;
 }
\ No newline at end of file
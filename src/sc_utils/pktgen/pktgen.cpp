@@ -4,6 +4,7 @@
 #include "sc_control_plane.hpp"
 #include "sc_utils/rss.hpp"
 #include "sc_utils/timestamp.hpp"
+#include "sc_utils/prng.hpp"
 
 
 /*!
@@ -53,6 +54,26 @@ int sc_util_generate_random_pkt_hdr(
 	/* initialize the _pkt_len as the length of the l4 payload */
     _pkt_len = payload_len;
 
+	/* steer the ipv4 flow into the wanted queue directly by the rss emulator */
+	if(rss_affinity && l3_type == RTE_ETHER_TYPE_IPV4 && used_rss_emulator.is_initialized
+			&& used_rss_emulator.nb_queues == nb_queues){
+		uint32_t rss_hash;
+		result = sc_util_rss_emu_gen_flow_ipv4(
+			/* emu */ &used_rss_emulator,
+			/* queue_id */ used_queue_id,
+			/* src_ipv4 */ &sc_pkt_hdr->src_ipv4_addr,
+			/* dst_ipv4 */ &sc_pkt_hdr->dst_ipv4_addr,
+			/* sport */ &sc_pkt_hdr->src_port,
+			/* dport */ &sc_pkt_hdr->dst_port,
+			/* rss_hash */ &rss_hash
+		);
+		if(result != SC_SUCCESS){
+			SC_THREAD_ERROR("failed to generate flow steered to queue %u", used_queue_id);
+			goto sc_util_generate_random_pkt_hdr_exit;
+		}
+		goto sc_util_generate_random_pkt_hdr_assemble;
+	}
+
     /* generate random port and ipv4 address */
     while(!sc_force_quit){
 		/* generate random layer 4 addresses */
@@ -106,7 +127,8 @@ int sc_util_generate_random_pkt_hdr(
 			break;
 		}
     }
-    
+
+sc_util_generate_random_pkt_hdr_assemble:
     /* assemble layer 4 header */
 	if(l4_type == IPPROTO_UDP){
 		if(SC_SUCCESS != sc_util_initialize_udp_header(
@@ -361,6 +383,95 @@ copy_payload_to_packet_burst_exit:
 	return result;
 }
 
+/*!
+ * \brief   assemble single-segmented ipv4 + udp packet using given header info
+ * \param	hdr		the metadata of the generated packet
+ * \param	pkt		the assembled mbuf
+ */
+static inline void _assemble_packet_mbuf_fast_v4_udp(struct sc_pkt_hdr *hdr, struct rte_mbuf *pkt){
+	size_t eth_hdr_size = sizeof(struct rte_ether_hdr);
+	uint32_t l3_l4_hdr_len = sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr);
+
+	/* assign data_len of the first segment (root segment) of the packet to send */
+	pkt->data_len = hdr->pkt_len;
+
+	/* copy ethernet header to pkt */
+	sc_util_copy_buf_to_pkt(&(hdr->pkt_eth_hdr), eth_hdr_size, pkt, 0);
+
+	/* copy ip and transport header to pkt */
+	sc_util_copy_buf_to_pkt(
+		&(hdr->pkt_ipv4_hdr), sizeof(struct rte_ipv4_hdr), pkt, eth_hdr_size);
+	sc_util_copy_buf_to_pkt(
+		&(hdr->pkt_udp_hdr), sizeof(struct rte_udp_hdr), pkt, eth_hdr_size + sizeof(struct rte_ipv4_hdr));
+
+	/* copy payload */
+	if(hdr->payload != nullptr)
+		sc_util_copy_buf_to_pkt(hdr->payload, hdr->payload_len, pkt, eth_hdr_size + l3_l4_hdr_len);
+
+	/*
+	 * Complete first mbuf of packet and append it to the
+	 * burst of packets to be transmitted.
+	 */
+	pkt->nb_segs = 1;
+	pkt->pkt_len = hdr->pkt_len;
+	pkt->l2_len = eth_hdr_size;
+	pkt->vlan_tci  = RTE_ETHER_TYPE_IPV4;
+	pkt->l3_len = sizeof(struct rte_ipv4_hdr);
+
+	hdr->payload_offset = eth_hdr_size + l3_l4_hdr_len;
+}
+
+/*!
+ * \brief   assemble ipv4 + udp packet which exceeds the data room of a single mbuf
+ *          into a chain of mbufs, all headers are located inside the first segment
+ * \param	mp		memory buffer pool for allocating the following segments
+ * \param	hdr		the metadata of the generated packet
+ * \param	pkt		the first segment of the assembled packet
+ * \return  0 for successfully assembling
+ */
+static int _assemble_packet_mbuf_segs_v4_udp(struct rte_mempool *mp, struct sc_pkt_hdr *hdr, struct rte_mbuf *pkt){
+	size_t eth_hdr_size = sizeof(struct rte_ether_hdr);
+	uint32_t l3_l4_hdr_len = sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr);
+	uint32_t remained_len;
+	struct rte_mbuf *seg, *last_seg;
+
+	/* chain segments, each segment except the last one is filled up to the data room */
+	pkt->data_len = RTE_MBUF_DEFAULT_DATAROOM;
+	pkt->nb_segs = 1;
+	remained_len = hdr->pkt_len - RTE_MBUF_DEFAULT_DATAROOM;
+	last_seg = pkt;
+	while(remained_len > 0){
+		seg = rte_pktmbuf_alloc(mp);
+		if (unlikely(seg == NULL)) {
+			SC_ERROR_DETAILS("failed to allocate memory for rte_mbuf segment");
+			return SC_ERROR_MEMORY;
+		}
+		seg->data_len = RTE_MIN(remained_len, (uint32_t)RTE_MBUF_DEFAULT_DATAROOM);
+		remained_len -= seg->data_len;
+		last_seg->next = seg;
+		last_seg = seg;
+		pkt->nb_segs += 1;
+	}
+	pkt->pkt_len = hdr->pkt_len;
+
+	/* copy headers and payload, the payload might span multiple segments */
+	sc_util_copy_buf_to_pkt(&(hdr->pkt_eth_hdr), eth_hdr_size, pkt, 0);
+	sc_util_copy_buf_to_pkt(
+		&(hdr->pkt_ipv4_hdr), sizeof(struct rte_ipv4_hdr), pkt, eth_hdr_size);
+	sc_util_copy_buf_to_pkt(
+		&(hdr->pkt_udp_hdr), sizeof(struct rte_udp_hdr), pkt, eth_hdr_size + sizeof(struct rte_ipv4_hdr));
+	if(hdr->payload != nullptr)
+		sc_util_copy_buf_to_pkt(hdr->payload, hdr->payload_len, pkt, eth_hdr_size + l3_l4_hdr_len);
+
+	pkt->l2_len = eth_hdr_size;
+	pkt->vlan_tci  = RTE_ETHER_TYPE_IPV4;
+	pkt->l3_len = sizeof(struct rte_ipv4_hdr);
+
+	hdr->payload_offset = eth_hdr_size + l3_l4_hdr_len;
+
+	return SC_SUCCESS;
+}
+
 /*!
  * \brief   generate packet brust using given header info
  * \note	fast version:
@@ -377,12 +488,10 @@ copy_payload_to_packet_burst_exit:
 int sc_util_generate_packet_burst_mbufs_fast_v4_udp(
 	struct rte_mempool *mp, struct sc_pkt_hdr *hdr, struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst
 ){
-	int i, result = SC_SUCCESS;
-	size_t eth_hdr_size;
+	int result = SC_SUCCESS;
 	struct rte_mbuf *pkt;
-	uint32_t assembled_pkt_len = 0;
-	uint32_t l3_l4_hdr_len = 28;
 	uint32_t nb_pkt;
+	bool is_multi_seg = hdr->pkt_len > RTE_MBUF_DEFAULT_DATAROOM;
 
 	// assert(
 	// 	hdr->pkt_len <= RTE_MBUF_DEFAULT_DATAROOM
@@ -400,46 +509,94 @@ int sc_util_generate_packet_burst_mbufs_fast_v4_udp(
 			result = SC_ERROR_MEMORY;
 			goto generate_packet_burst_mbufs_fast_exit;
 		}
+		if(unlikely(is_multi_seg)){
+			result = _assemble_packet_mbuf_segs_v4_udp(mp, hdr, pkt);
+			if(unlikely(result != SC_SUCCESS)){
+				rte_pktmbuf_free(pkt);
+				goto generate_packet_burst_mbufs_fast_exit;
+			}
+		} else {
+			_assemble_packet_mbuf_fast_v4_udp(hdr, pkt);
+		}
+		pkts_burst[nb_pkt] = pkt;
+	}
 
-		/* assign data_len of the first segment (root segment) of the packet to send */
-		pkt->data_len = hdr->pkt_len;
-		assembled_pkt_len += hdr->pkt_len;
-		
-		/* copy ethernet header to pkt */
-		eth_hdr_size = sizeof(struct rte_ether_hdr);
-		sc_util_copy_buf_to_pkt(&(hdr->pkt_eth_hdr), eth_hdr_size, pkt, 0);
-		
-		/* copy ip and transport header to pkt */
-		sc_util_copy_buf_to_pkt(
-			&(hdr->pkt_ipv4_hdr), sizeof(struct rte_ipv4_hdr), pkt, eth_hdr_size);
-		l3_l4_hdr_len = sizeof(struct rte_ipv4_hdr);
-		sc_util_copy_buf_to_pkt(
-			&(hdr->pkt_udp_hdr), sizeof(struct rte_udp_hdr), pkt, eth_hdr_size + sizeof(struct rte_ipv4_hdr));
-		l3_l4_hdr_len += sizeof(struct rte_udp_hdr);
-
-		/* copy payload */
-		if(hdr->payload != nullptr)
-			sc_util_copy_buf_to_pkt(hdr->payload, hdr->payload_len, pkt, eth_hdr_size + l3_l4_hdr_len);
+generate_packet_burst_mbufs_fast_exit:
+	return result;
+}
 
-		/*
-		 * Complete first mbuf of packet and append it to the
-		 * burst of packets to be transmitted.
-		 */
-		pkt->nb_segs = 1;
-		pkt->pkt_len = hdr->pkt_len;
-		pkt->l2_len = eth_hdr_size;
-		pkt->vlan_tci  = RTE_ETHER_TYPE_IPV4;
-		pkt->l3_len = sizeof(struct rte_ipv4_hdr);
+/*!
+ * \brief   generate packet brust with mixed packet sizes, the size of each packet
+ *          is sampled from the given distribution
+ * \note	fast version, see sc_util_generate_packet_burst_mbufs_fast_v4_udp
+ * \param   mp					memory buffer pool
+ * \param	hdrs				the metadata of the generated packet, one per size bucket
+ *								of the distribution (see sc_util_resize_pkt_hdr_v4_udp)
+ * \param	dist				the packet size distribution
+ * \param   pkts_burst 			produced packet burst
+ * \param	nb_pkt_per_burst 	number of packets within the produced burst
+ * \return  0 for successfully generation
+ */
+int sc_util_generate_packet_burst_mbufs_fast_v4_udp_mixed(
+	struct rte_mempool *mp, struct sc_pkt_hdr *hdrs, struct sc_pkt_size_dist *dist,
+	struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst
+){
+	int result = SC_SUCCESS;
+	struct rte_mbuf *pkt;
+	struct sc_pkt_hdr *hdr;
+	uint32_t nb_pkt;
 
+	for (nb_pkt = 0; nb_pkt < nb_pkt_per_burst; nb_pkt++) {
+		pkt = rte_pktmbuf_alloc(mp);
+		if (unlikely(pkt == NULL)) {
+			SC_ERROR_DETAILS("failed to allocate memory for rte_mbuf");
+			result = SC_ERROR_MEMORY;
+			goto generate_packet_burst_mbufs_fast_mixed_exit;
+		}
+		hdr = &hdrs[sc_util_pkt_size_sample_bucket(dist, sc_util_rand())];
+		if(unlikely(hdr->pkt_len > RTE_MBUF_DEFAULT_DATAROOM)){
+			result = _assemble_packet_mbuf_segs_v4_udp(mp, hdr, pkt);
+			if(unlikely(result != SC_SUCCESS)){
+				rte_pktmbuf_free(pkt);
+				goto generate_packet_burst_mbufs_fast_mixed_exit;
+			}
+		} else {
+			_assemble_packet_mbuf_fast_v4_udp(hdr, pkt);
+		}
 		pkts_burst[nb_pkt] = pkt;
 	}
 
-	hdr->payload_offset = eth_hdr_size + l3_l4_hdr_len;
-
-generate_packet_burst_mbufs_fast_exit:
+generate_packet_burst_mbufs_fast_mixed_exit:
 	return result;
 }
 
+/*!
+ * \brief   resize the ipv4 + udp packet header, lengths inside ip and udp header
+ *          and the ip checksum are updated accordingly
+ * \param	hdr			the metadata of the packet
+ * \param	pkt_len		new length of the packet (unit: bytes)
+ * \return  0 for successfully resizing
+ */
+int sc_util_resize_pkt_hdr_v4_udp(struct sc_pkt_hdr *hdr, uint32_t pkt_len){
+	uint32_t l3_len = pkt_len - sizeof(struct rte_ether_hdr);
+	uint32_t l4_len = l3_len - sizeof(struct rte_ipv4_hdr);
+
+	if(pkt_len < sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr)
+		|| l3_len > UINT16_MAX){
+		SC_ERROR_DETAILS("invalid packet length %u for ipv4 + udp packet", pkt_len);
+		return SC_ERROR_INVALID_VALUE;
+	}
+
+	hdr->pkt_len = pkt_len;
+	hdr->pkt_ipv4_hdr.total_length = rte_cpu_to_be_16((uint16_t)l3_len);
+	hdr->pkt_udp_hdr.dgram_len = rte_cpu_to_be_16((uint16_t)l4_len);
+	hdr->pkt_udp_hdr.dgram_cksum = 0;
+	hdr->pkt_ipv4_hdr.hdr_checksum = 0;
+	hdr->pkt_ipv4_hdr.hdr_checksum = rte_ipv4_cksum(&hdr->pkt_ipv4_hdr);
+
+	return SC_SUCCESS;
+}
+
 /*!
  * \brief   generate packet brust using given header info
  * \note	this function will allocate new mbufs
@@ -484,6 +641,7 @@ int sc_util_generate_packet_burst_mbufs(
 		}
 		
 		/* assign data_len of the first segment (root segment) of the packet to send */
+		assembled_pkt_len = 0;
 		if(hdr->pkt_len > RTE_MBUF_DEFAULT_DATAROOM){
 			pkt->data_len = RTE_MBUF_DEFAULT_DATAROOM;
 			assembled_pkt_len += RTE_MBUF_DEFAULT_DATAROOM;
@@ -504,7 +662,7 @@ int sc_util_generate_packet_burst_mbufs(
 				goto generate_packet_burst_proto_exit;
 			}
 			pkt_seg = pkt_seg->next;
-			if (i != nb_pkt_segs){
+			if (i != nb_pkt_segs - 1){
 				/* not the last segment, the length is still RTE_MBUF_DEFAULT_DATAROOM */
 				pkt_seg->data_len = RTE_MBUF_DEFAULT_DATAROOM;
 				assembled_pkt_len += RTE_MBUF_DEFAULT_DATAROOM;
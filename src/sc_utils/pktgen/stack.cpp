@@ -0,0 +1,580 @@
+#include "sc_global.hpp"
+#include "sc_utils/pktgen.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/prng.hpp"
+#include "sc_utils/cksum.hpp"
+
+/* name of each protocol inside the stack description */
+static const char *_proto_names[SC_PROTO_UNKNOWN] = {
+	"eth", "vlan", "qinq", "ipv4", "ipv6", "udp", "tcp", "vxlan", "gre", "geneve"
+};
+
+/* length of the (option-less) header of each protocol */
+static const uint16_t _proto_hdr_lens[SC_PROTO_UNKNOWN] = {
+	/* eth */ sizeof(struct rte_ether_hdr),
+	/* vlan */ sizeof(struct rte_vlan_hdr),
+	/* qinq */ sizeof(struct rte_vlan_hdr),
+	/* ipv4 */ sizeof(struct rte_ipv4_hdr),
+	/* ipv6 */ sizeof(struct rte_ipv6_hdr),
+	/* udp */ sizeof(struct rte_udp_hdr),
+	/* tcp */ sizeof(struct rte_tcp_hdr),
+	/* vxlan */ 8,
+	/* gre */ 4,
+	/* geneve */ 8
+};
+
+/*!
+ * \brief   check whether the protocol could be stacked upon the previous one
+ * \param	prev	type of the previous protocol
+ * \param	next	type of the next protocol
+ * \return  whether the stacking is valid
+ */
+static bool _proto_is_valid_next(uint8_t prev, uint8_t next){
+	switch(prev){
+	case SC_PROTO_ETH:
+		return next == SC_PROTO_VLAN || next == SC_PROTO_QINQ || next == SC_PROTO_IPV4 || next == SC_PROTO_IPV6;
+	case SC_PROTO_QINQ:
+	case SC_PROTO_VLAN:
+		return next == SC_PROTO_VLAN || next == SC_PROTO_IPV4 || next == SC_PROTO_IPV6;
+	case SC_PROTO_IPV4:
+	case SC_PROTO_IPV6:
+		return next == SC_PROTO_UDP || next == SC_PROTO_TCP || next == SC_PROTO_GRE;
+	case SC_PROTO_UDP:
+		return next == SC_PROTO_VXLAN || next == SC_PROTO_GENEVE;
+	case SC_PROTO_VXLAN:
+	case SC_PROTO_GENEVE:
+		return next == SC_PROTO_ETH;
+	case SC_PROTO_GRE:
+		return next == SC_PROTO_ETH || next == SC_PROTO_IPV4 || next == SC_PROTO_IPV6;
+	default:
+		return false;
+	}
+}
+
+/*!
+ * \brief   obtain the ether type which identifies the protocol
+ * \param	type	type of the protocol
+ * \return  the ether type (host byte order), 0 for not identified by ether type
+ */
+static uint16_t _proto_get_ether_type(uint8_t type){
+	switch(type){
+	case SC_PROTO_ETH:	return SC_PROTO_ETHER_TYPE_TEB;
+	case SC_PROTO_VLAN:	return RTE_ETHER_TYPE_VLAN;
+	case SC_PROTO_QINQ:	return RTE_ETHER_TYPE_QINQ;
+	case SC_PROTO_IPV4:	return RTE_ETHER_TYPE_IPV4;
+	case SC_PROTO_IPV6:	return RTE_ETHER_TYPE_IPV6;
+	default:			return 0;
+	}
+}
+
+/*!
+ * \brief   obtain the protocol identified by the ether type
+ * \param	ether_type	the ether type (host byte order)
+ * \return  type of the protocol
+ */
+static uint8_t _proto_get_type_by_ether_type(uint16_t ether_type){
+	switch(ether_type){
+	case SC_PROTO_ETHER_TYPE_TEB:	return SC_PROTO_ETH;
+	case RTE_ETHER_TYPE_VLAN:		return SC_PROTO_VLAN;
+	case RTE_ETHER_TYPE_QINQ:		return SC_PROTO_QINQ;
+	case RTE_ETHER_TYPE_IPV4:		return SC_PROTO_IPV4;
+	case RTE_ETHER_TYPE_IPV6:		return SC_PROTO_IPV6;
+	default:						return SC_PROTO_UNKNOWN;
+	}
+}
+
+/*!
+ * \brief   obtain the protocol identified by the ip protocol number
+ * \param	ip_proto	the ip protocol number
+ * \return  type of the protocol
+ */
+static uint8_t _proto_get_type_by_ip_proto(uint8_t ip_proto){
+	switch(ip_proto){
+	case IPPROTO_UDP:	return SC_PROTO_UDP;
+	case IPPROTO_TCP:	return SC_PROTO_TCP;
+	case IPPROTO_GRE:	return SC_PROTO_GRE;
+	default:			return SC_PROTO_UNKNOWN;
+	}
+}
+
+/*!
+ * \brief   obtain the ip protocol number of the protocol
+ * \param	type	type of the protocol, SC_PROTO_UNKNOWN for no upper layer
+ * \return  the ip protocol number
+ */
+static uint8_t _proto_get_ip_proto(uint8_t type){
+	switch(type){
+	case SC_PROTO_UDP:	return IPPROTO_UDP;
+	case SC_PROTO_TCP:	return IPPROTO_TCP;
+	case SC_PROTO_GRE:	return IPPROTO_GRE;
+	default:			return 253;	/* RFC 3692 experimental */
+	}
+}
+
+/*!
+ * \brief   append a layer to the protocol stack, and maintain the indices of inner layers
+ * \param	stack	the protocol stack
+ * \param	type	type of the appended layer
+ * \param	offset	offset of the appended layer
+ * \param	len		header length of the appended layer
+ */
+static void _proto_stack_append(struct sc_proto_stack *stack, uint8_t type, uint16_t offset, uint16_t len){
+	stack->layers[stack->nb_layers].type = type;
+	stack->layers[stack->nb_layers].offset = offset;
+	stack->layers[stack->nb_layers].len = len;
+
+	if(type == SC_PROTO_IPV4 || type == SC_PROTO_IPV6){
+		stack->inner_l3_idx = stack->nb_layers;
+		stack->inner_l4_idx = -1;
+	} else if(type == SC_PROTO_UDP || type == SC_PROTO_TCP){
+		stack->inner_l4_idx = stack->nb_layers;
+	}
+
+	stack->nb_layers += 1;
+	stack->hdr_len = offset + len;
+}
+
+/*!
+ * \brief   parse the compact description of protocol stack, e.g., eth/vlan/ipv6/udp/vxlan/eth/ipv4/tcp
+ * \param	desc	the description string
+ * \param	stack	the parsed protocol stack
+ * \return  0 for successfully parsing
+ */
+int sc_util_parse_proto_stack_desc(const char *desc, struct sc_proto_stack *stack){
+	int result = SC_SUCCESS;
+	char buf[SC_PROTO_STACK_MAX_HDR_LEN];
+	char *p, *saveptr = NULL;
+	uint8_t i, type, prev_type = SC_PROTO_UNKNOWN;
+	uint16_t offset = 0;
+
+	memset(stack, 0, sizeof(struct sc_proto_stack));
+	stack->inner_l3_idx = stack->inner_l4_idx = stack->tunnel_udp_idx = -1;
+
+	if(strlen(desc) >= sizeof(buf)){
+		SC_ERROR_DETAILS("protocol stack description is too long");
+		return SC_ERROR_INVALID_VALUE;
+	}
+	strcpy(buf, desc);
+
+	for(p = strtok_r(buf, "/", &saveptr); p; p = strtok_r(NULL, "/", &saveptr)){
+		p = sc_util_del_both_trim(p);
+		sc_util_del_change_line(p);
+
+		for(type=0; type<SC_PROTO_UNKNOWN; type++){
+			if(!strcmp(p, _proto_names[type])) break;
+		}
+		if(type == SC_PROTO_UNKNOWN){
+			SC_ERROR_DETAILS("unknown protocol %s inside protocol stack %s", p, desc);
+			result = SC_ERROR_INVALID_VALUE;
+			goto sc_util_parse_proto_stack_desc_exit;
+		}
+
+		if(prev_type == SC_PROTO_UNKNOWN ? type != SC_PROTO_ETH : !_proto_is_valid_next(prev_type, type)){
+			SC_ERROR_DETAILS("%s couldn't be stacked upon %s inside protocol stack %s", p,
+				prev_type == SC_PROTO_UNKNOWN ? "nothing" : _proto_names[prev_type], desc);
+			result = SC_ERROR_INVALID_VALUE;
+			goto sc_util_parse_proto_stack_desc_exit;
+		}
+
+		if(stack->nb_layers == SC_PROTO_STACK_MAX_NB_LAYERS){
+			SC_ERROR_DETAILS("too many layers inside protocol stack %s, maximum is %u",
+				desc, SC_PROTO_STACK_MAX_NB_LAYERS);
+			result = SC_ERROR_INVALID_VALUE;
+			goto sc_util_parse_proto_stack_desc_exit;
+		}
+
+		_proto_stack_append(stack, type, offset, _proto_hdr_lens[type]);
+		offset += _proto_hdr_lens[type];
+		prev_type = type;
+	}
+
+	/* the stack should be ended with a l3 / l4 protocol */
+	if(stack->nb_layers == 0 || (prev_type != SC_PROTO_IPV4 && prev_type != SC_PROTO_IPV6
+			&& prev_type != SC_PROTO_UDP && prev_type != SC_PROTO_TCP)){
+		SC_ERROR_DETAILS("protocol stack %s should be ended with ipv4, ipv6, udp or tcp", desc);
+		result = SC_ERROR_INVALID_VALUE;
+		goto sc_util_parse_proto_stack_desc_exit;
+	}
+
+	/* record the outermost udp layer which carries tunnel */
+	for(i=0; i+1<stack->nb_layers; i++){
+		if(stack->layers[i].type == SC_PROTO_UDP){
+			stack->tunnel_udp_idx = i;
+			break;
+		}
+	}
+
+sc_util_parse_proto_stack_desc_exit:
+	return result;
+}
+
+/*!
+ * \brief   build the header template of the parsed protocol stack,
+ * 			all addresses / ports / tags are randomly generated
+ * \param	stack		the parsed protocol stack
+ * \param	pkt_len		length of the generated packet
+ * \param	src_mac		source mac address of the outermost ethernet header (NULL for random)
+ * \param	dst_mac		destination mac address of the outermost ethernet header (NULL for random)
+ * \return  0 for successfully building
+ */
+int sc_util_build_proto_stack_template(struct sc_proto_stack *stack, uint32_t pkt_len,
+		struct rte_ether_addr *src_mac, struct rte_ether_addr *dst_mac){
+	uint8_t i, next_type;
+	uint8_t *hdr;
+	uint64_t r;
+	struct rte_ether_hdr *eth_hdr;
+	struct rte_vlan_hdr *vlan_hdr;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_ipv6_hdr *ipv6_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+
+	if(pkt_len < stack->hdr_len || pkt_len > UINT16_MAX){
+		SC_THREAD_ERROR_DETAILS("invalid packet length %u, should be within [%u, %u]",
+			pkt_len, stack->hdr_len, UINT16_MAX);
+		return SC_ERROR_INVALID_VALUE;
+	}
+	stack->pkt_len = pkt_len;
+	memset(stack->hdr_template, 0, sizeof(stack->hdr_template));
+
+	for(i=0; i<stack->nb_layers; i++){
+		hdr = stack->hdr_template + stack->layers[i].offset;
+		next_type = i+1 < stack->nb_layers ? stack->layers[i+1].type : SC_PROTO_UNKNOWN;
+		r = sc_util_rand();
+
+		switch(stack->layers[i].type){
+		case SC_PROTO_ETH:
+			eth_hdr = (struct rte_ether_hdr*)hdr;
+			#if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+				if(i == 0 && src_mac) rte_ether_addr_copy(src_mac, &eth_hdr->src_addr);
+				else rte_eth_random_addr(eth_hdr->src_addr.addr_bytes);
+				if(i == 0 && dst_mac) rte_ether_addr_copy(dst_mac, &eth_hdr->dst_addr);
+				else rte_eth_random_addr(eth_hdr->dst_addr.addr_bytes);
+			#else
+				if(i == 0 && src_mac) rte_ether_addr_copy(src_mac, &eth_hdr->s_addr);
+				else rte_eth_random_addr(eth_hdr->s_addr.addr_bytes);
+				if(i == 0 && dst_mac) rte_ether_addr_copy(dst_mac, &eth_hdr->d_addr);
+				else rte_eth_random_addr(eth_hdr->d_addr.addr_bytes);
+			#endif
+			eth_hdr->ether_type = rte_cpu_to_be_16(_proto_get_ether_type(next_type));
+			break;
+
+		case SC_PROTO_VLAN:
+		case SC_PROTO_QINQ:
+			vlan_hdr = (struct rte_vlan_hdr*)hdr;
+			vlan_hdr->vlan_tci = rte_cpu_to_be_16((uint16_t)(r % 4094) + 1);
+			vlan_hdr->eth_proto = rte_cpu_to_be_16(_proto_get_ether_type(next_type));
+			break;
+
+		case SC_PROTO_IPV4:
+			ipv4_hdr = (struct rte_ipv4_hdr*)hdr;
+			ipv4_hdr->version_ihl = RTE_IPV4_VHL_DEF;
+			ipv4_hdr->time_to_live = IP_DEFTTL;
+			ipv4_hdr->next_proto_id = _proto_get_ip_proto(next_type);
+			ipv4_hdr->total_length = rte_cpu_to_be_16(pkt_len - stack->layers[i].offset);
+			ipv4_hdr->src_addr = (rte_be32_t)r;
+			ipv4_hdr->dst_addr = (rte_be32_t)(r >> 32);
+			ipv4_hdr->hdr_checksum = 0;
+			ipv4_hdr->hdr_checksum = rte_ipv4_cksum(ipv4_hdr);
+			break;
+
+		case SC_PROTO_IPV6:
+			ipv6_hdr = (struct rte_ipv6_hdr*)hdr;
+			ipv6_hdr->vtc_flow = rte_cpu_to_be_32(6 << 28);
+			ipv6_hdr->payload_len = rte_cpu_to_be_16(pkt_len - stack->layers[i].offset - sizeof(struct rte_ipv6_hdr));
+			ipv6_hdr->proto = _proto_get_ip_proto(next_type);
+			ipv6_hdr->hop_limits = IP_DEFTTL;
+			sc_util_generate_random_ipv6_addr(ipv6_hdr->src_addr);
+			sc_util_generate_random_ipv6_addr(ipv6_hdr->dst_addr);
+			break;
+
+		case SC_PROTO_UDP:
+			udp_hdr = (struct rte_udp_hdr*)hdr;
+			udp_hdr->src_port = (rte_be16_t)r;
+			if(next_type == SC_PROTO_VXLAN)
+				udp_hdr->dst_port = rte_cpu_to_be_16(SC_PROTO_VXLAN_UDP_PORT);
+			else if(next_type == SC_PROTO_GENEVE)
+				udp_hdr->dst_port = rte_cpu_to_be_16(SC_PROTO_GENEVE_UDP_PORT);
+			else
+				udp_hdr->dst_port = (rte_be16_t)(r >> 16);
+			udp_hdr->dgram_len = rte_cpu_to_be_16(pkt_len - stack->layers[i].offset);
+			udp_hdr->dgram_cksum = 0;
+			break;
+
+		case SC_PROTO_TCP:
+			tcp_hdr = (struct rte_tcp_hdr*)hdr;
+			tcp_hdr->src_port = (rte_be16_t)r;
+			tcp_hdr->dst_port = (rte_be16_t)(r >> 16);
+			tcp_hdr->sent_seq = (rte_be32_t)(r >> 32);
+			tcp_hdr->data_off = (sizeof(struct rte_tcp_hdr) >> 2) << 4;
+			tcp_hdr->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG;
+			tcp_hdr->rx_win = rte_cpu_to_be_16(UINT16_MAX);
+			break;
+
+		case SC_PROTO_VXLAN:
+			/* flags (I bit) + vni */
+			*(rte_be32_t*)hdr = rte_cpu_to_be_32(0x08000000);
+			*(rte_be32_t*)(hdr + 4) = rte_cpu_to_be_32((uint32_t)(r & 0xFFFFFF) << 8);
+			break;
+
+		case SC_PROTO_GRE:
+			/* no checksum / key / sequence */
+			*(rte_be16_t*)(hdr + 2) = rte_cpu_to_be_16(_proto_get_ether_type(next_type));
+			break;
+
+		case SC_PROTO_GENEVE:
+			/* no option, protocol type + vni */
+			*(rte_be16_t*)(hdr + 2) = rte_cpu_to_be_16(_proto_get_ether_type(next_type));
+			*(rte_be32_t*)(hdr + 4) = rte_cpu_to_be_32((uint32_t)(r & 0xFFFFFF) << 8);
+			break;
+
+		default:
+			SC_THREAD_ERROR_DETAILS("unknown protocol type %u", stack->layers[i].type);
+			return SC_ERROR_INVALID_VALUE;
+		}
+	}
+
+	return SC_SUCCESS;
+}
+
+/*!
+ * \brief   generate packet burst using the template of protocol stack
+ * \note	[1] only support single-segmented mbuf;
+ * 			[2] l4 checksum of tcp / udp over ipv6 is calculated per packet, so bytes
+ * 				written into the payload after generation are not covered
+ * \param   mp					memory buffer pool
+ * \param	stack				the protocol stack with built template
+ * \param   pkts_burst 			produced packet burst
+ * \param	nb_pkt_per_burst 	number of packets within the produced burst
+ * \param	vary_fields			whether to vary the innermost flow (ports / source address)
+ * 								and the tunnel entropy per packet
+ * \return  0 for successfully generation
+ */
+int sc_util_generate_packet_burst_mbufs_stack(struct rte_mempool *mp, struct sc_proto_stack *stack,
+		struct rte_mbuf **pkts_burst, uint32_t nb_pkt_per_burst, bool vary_fields){
+	int result = SC_SUCCESS;
+	uint32_t nb_pkt;
+	uint64_t r;
+	uint8_t *data, *l3_hdr, *l4_hdr;
+	uint8_t inner_l3_type, inner_l4_type = SC_PROTO_UNKNOWN;
+	struct rte_mbuf *pkt;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	bool need_l4_cksum;
+
+	inner_l3_type = stack->layers[stack->inner_l3_idx].type;
+	if(stack->inner_l4_idx >= 0)
+		inner_l4_type = stack->layers[stack->inner_l4_idx].type;
+	need_l4_cksum = inner_l4_type == SC_PROTO_TCP
+		|| (inner_l4_type == SC_PROTO_UDP && inner_l3_type == SC_PROTO_IPV6);
+
+	for (nb_pkt = 0; nb_pkt < nb_pkt_per_burst; nb_pkt++) {
+		pkt = rte_pktmbuf_alloc(mp);
+		if (unlikely(pkt == NULL)) {
+			SC_THREAD_ERROR_DETAILS("failed to allocate memory for rte_mbuf");
+			result = SC_ERROR_MEMORY;
+			goto generate_packet_burst_mbufs_stack_exit;
+		}
+
+		data = (uint8_t*)rte_pktmbuf_append(pkt, stack->pkt_len);
+		if (unlikely(data == NULL)) {
+			SC_THREAD_ERROR_DETAILS("packet length %u exceeds the tailroom of rte_mbuf", stack->pkt_len);
+			rte_pktmbuf_free(pkt);
+			result = SC_ERROR_INVALID_VALUE;
+			goto generate_packet_burst_mbufs_stack_exit;
+		}
+		rte_memcpy(data, stack->hdr_template, stack->hdr_len);
+
+		l3_hdr = data + stack->layers[stack->inner_l3_idx].offset;
+		l4_hdr = stack->inner_l4_idx >= 0 ? data + stack->layers[stack->inner_l4_idx].offset : NULL;
+
+		if(vary_fields){
+			r = sc_util_rand();
+			if(l4_hdr){
+				/* source and destination ports are located at the same offset for both udp and tcp */
+				((rte_be16_t*)l4_hdr)[0] = (rte_be16_t)r;
+				((rte_be16_t*)l4_hdr)[1] = (rte_be16_t)(r >> 16);
+			} else if(inner_l3_type == SC_PROTO_IPV4){
+				ipv4_hdr = (struct rte_ipv4_hdr*)l3_hdr;
+				ipv4_hdr->src_addr = (rte_be32_t)r;
+				ipv4_hdr->hdr_checksum = 0;
+				ipv4_hdr->hdr_checksum = rte_ipv4_cksum(ipv4_hdr);
+			} else {
+				*(uint32_t*)&((struct rte_ipv6_hdr*)l3_hdr)->src_addr[12] = (uint32_t)r;
+			}
+
+			/* entropy of the tunnel is carried by the source port of the outer udp (RFC 7348) */
+			if(stack->tunnel_udp_idx >= 0){
+				udp_hdr = (struct rte_udp_hdr*)(data + stack->layers[stack->tunnel_udp_idx].offset);
+				udp_hdr->src_port = rte_cpu_to_be_16(0xC000 | ((uint16_t)(r ^ (r >> 16)) & 0x3FFF));
+			}
+		}
+
+		if(need_l4_cksum){
+			if(inner_l4_type == SC_PROTO_TCP){
+				tcp_hdr = (struct rte_tcp_hdr*)l4_hdr;
+				tcp_hdr->cksum = 0;
+				tcp_hdr->cksum = inner_l3_type == SC_PROTO_IPV4
+					? sc_util_cksum_ipv4_udptcp((struct rte_ipv4_hdr*)l3_hdr, l4_hdr)
+					: sc_util_cksum_ipv6_udptcp((struct rte_ipv6_hdr*)l3_hdr, l4_hdr);
+			} else {
+				udp_hdr = (struct rte_udp_hdr*)l4_hdr;
+				udp_hdr->dgram_cksum = 0;
+				udp_hdr->dgram_cksum = sc_util_cksum_ipv6_udptcp((struct rte_ipv6_hdr*)l3_hdr, l4_hdr);
+			}
+		}
+
+		/* offload metadata describes the outermost headers */
+		pkt->l2_len = stack->layers[0].len;
+		for(uint8_t i=1; i<stack->nb_layers; i++){
+			if(stack->layers[i].type != SC_PROTO_VLAN && stack->layers[i].type != SC_PROTO_QINQ){
+				pkt->l2_len = stack->layers[i].offset;
+				pkt->l3_len = stack->layers[i].len;
+				break;
+			}
+		}
+
+		pkts_burst[nb_pkt] = pkt;
+	}
+
+generate_packet_burst_mbufs_stack_exit:
+	if(result != SC_SUCCESS){
+		while(nb_pkt > 0) rte_pktmbuf_free(pkts_burst[--nb_pkt]);
+	}
+	return result;
+}
+
+/*!
+ * \brief   parse the protocol stack of a received packet
+ * \param	pkt		the received packet
+ * \param	stack	the parsed protocol stack (the header template is not filled)
+ * \return  0 for successfully parsing (at least the ethernet header is parsed)
+ */
+int sc_util_parse_pkt_proto_stack(struct rte_mbuf *pkt, struct sc_proto_stack *stack){
+	const uint8_t *data = rte_pktmbuf_mtod(pkt, const uint8_t*);
+	uint32_t data_len = rte_pktmbuf_data_len(pkt);
+	uint16_t offset = 0, hdr_len, flags;
+	uint8_t type = SC_PROTO_ETH, next_type;
+	const struct rte_ipv4_hdr *ipv4_hdr;
+
+	stack->nb_layers = 0;
+	stack->hdr_len = 0;
+	stack->pkt_len = rte_pktmbuf_pkt_len(pkt);
+	stack->inner_l3_idx = stack->inner_l4_idx = stack->tunnel_udp_idx = -1;
+
+	while(type != SC_PROTO_UNKNOWN && stack->nb_layers < SC_PROTO_STACK_MAX_NB_LAYERS){
+		hdr_len = _proto_hdr_lens[type];
+		if(offset + hdr_len > data_len) break;
+
+		switch(type){
+		case SC_PROTO_ETH:
+			next_type = _proto_get_type_by_ether_type(
+				rte_be_to_cpu_16(((const struct rte_ether_hdr*)(data + offset))->ether_type));
+			break;
+
+		case SC_PROTO_VLAN:
+		case SC_PROTO_QINQ:
+			next_type = _proto_get_type_by_ether_type(
+				rte_be_to_cpu_16(((const struct rte_vlan_hdr*)(data + offset))->eth_proto));
+			break;
+
+		case SC_PROTO_IPV4:
+			ipv4_hdr = (const struct rte_ipv4_hdr*)(data + offset);
+			hdr_len = rte_ipv4_hdr_len(ipv4_hdr);
+			if(hdr_len < sizeof(struct rte_ipv4_hdr) || offset + hdr_len > data_len) goto parse_pkt_proto_stack_exit;
+			/* non-first fragments carry no upper layer header */
+			if(rte_be_to_cpu_16(ipv4_hdr->fragment_offset) & RTE_IPV4_HDR_OFFSET_MASK)
+				next_type = SC_PROTO_UNKNOWN;
+			else
+				next_type = _proto_get_type_by_ip_proto(ipv4_hdr->next_proto_id);
+			break;
+
+		case SC_PROTO_IPV6:
+			/* extension headers are not parsed */
+			next_type = _proto_get_type_by_ip_proto(((const struct rte_ipv6_hdr*)(data + offset))->proto);
+			break;
+
+		case SC_PROTO_UDP:
+			switch(rte_be_to_cpu_16(((const struct rte_udp_hdr*)(data + offset))->dst_port)){
+			case SC_PROTO_VXLAN_UDP_PORT:	next_type = SC_PROTO_VXLAN; break;
+			case SC_PROTO_GENEVE_UDP_PORT:	next_type = SC_PROTO_GENEVE; break;
+			default:						next_type = SC_PROTO_UNKNOWN; break;
+			}
+			if(next_type != SC_PROTO_UNKNOWN && stack->tunnel_udp_idx < 0)
+				stack->tunnel_udp_idx = stack->nb_layers;
+			break;
+
+		case SC_PROTO_TCP:
+			hdr_len = (((const struct rte_tcp_hdr*)(data + offset))->data_off >> 4) << 2;
+			if(hdr_len < sizeof(struct rte_tcp_hdr) || offset + hdr_len > data_len) goto parse_pkt_proto_stack_exit;
+			next_type = SC_PROTO_UNKNOWN;
+			break;
+
+		case SC_PROTO_VXLAN:
+			next_type = SC_PROTO_ETH;
+			break;
+
+		case SC_PROTO_GRE:
+			/* checksum, key and sequence number are optional */
+			flags = rte_be_to_cpu_16(*(const rte_be16_t*)(data + offset));
+			hdr_len += (flags & 0x8000 ? 4 : 0) + (flags & 0x2000 ? 4 : 0) + (flags & 0x1000 ? 4 : 0);
+			if(offset + hdr_len > data_len) goto parse_pkt_proto_stack_exit;
+			next_type = _proto_get_type_by_ether_type(rte_be_to_cpu_16(*(const rte_be16_t*)(data + offset + 2)));
+			break;
+
+		case SC_PROTO_GENEVE:
+			hdr_len += (data[offset] & 0x3F) << 2;
+			if(offset + hdr_len > data_len) goto parse_pkt_proto_stack_exit;
+			next_type = _proto_get_type_by_ether_type(rte_be_to_cpu_16(*(const rte_be16_t*)(data + offset + 2)));
+			break;
+
+		default:
+			goto parse_pkt_proto_stack_exit;
+		}
+
+		_proto_stack_append(stack, type, offset, hdr_len);
+		offset += hdr_len;
+		type = next_type;
+	}
+
+parse_pkt_proto_stack_exit:
+	return stack->nb_layers > 0 ? SC_SUCCESS : SC_ERROR_INVALID_VALUE;
+}
+
+/*!
+ * \brief   obtain the signature of the protocol stack, stacks with the same
+ * 			sequence of protocols share the same signature
+ * \param	stack	the protocol stack
+ * \return  the signature
+ */
+uint64_t sc_util_proto_stack_signature(struct sc_proto_stack *stack){
+	uint8_t i;
+	uint64_t signature = (uint64_t)stack->nb_layers << 56;
+
+	for(i=0; i<stack->nb_layers; i++){
+		signature |= (uint64_t)(stack->layers[i].type & 0xF) << (i << 2);
+	}
+
+	return signature;
+}
+
+/*!
+ * \brief   convert the protocol stack to the compact description
+ * \param	stack	the protocol stack
+ * \param	str		the output string
+ * \param	str_len	length of the output string buffer
+ */
+void sc_util_proto_stack_to_str(struct sc_proto_stack *stack, char *str, uint32_t str_len){
+	uint8_t i;
+	uint32_t len = 0;
+
+	if(str_len == 0) return;
+	str[0] = '\0';
+
+	for(i=0; i<stack->nb_layers && len < str_len; i++){
+		len += snprintf(str + len, str_len - len, "%s%s", i == 0 ? "" : "/",
+			stack->layers[i].type < SC_PROTO_UNKNOWN ? _proto_names[stack->layers[i].type] : "unknown");
+	}
+}
@@ -0,0 +1,103 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/prng.hpp"
+
+/*!
+ * \brief global seed, every thread derives its own stream from it
+ */
+static uint64_t _prng_global_seed = 0;
+
+__thread struct sc_prng perthread_prng;
+
+/*!
+ * \brief   splitmix64 generator, used for expanding seed into states
+ * \param   x   state of the splitmix64 generator
+ * \return  the generated value
+ */
+static inline uint64_t _prng_splitmix64(uint64_t *x){
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*!
+ * \brief   set the global seed
+ * \param   seed    the global seed
+ */
+void sc_util_prng_set_global_seed(uint64_t seed){
+    _prng_global_seed = seed;
+}
+
+/*!
+ * \brief   obtain the global seed
+ * \return  the global seed
+ */
+uint64_t sc_util_prng_get_global_seed(){
+    return _prng_global_seed;
+}
+
+/*!
+ * \brief   seed the generator, generators with the same seed and stream produce the same sequence
+ * \param   prng        the generator
+ * \param   seed        the seed
+ * \param   stream_id   index of the stream (e.g., index of the thread)
+ */
+void sc_util_prng_seed(struct sc_prng *prng, uint64_t seed, uint64_t stream_id){
+    uint64_t i, j, x;
+
+    x = seed;
+    x ^= _prng_splitmix64(&x) ^ (stream_id * 0xD1B54A32D192ED03ULL);
+
+    for(i=0; i<4; i++) prng->s[i] = _prng_splitmix64(&x);
+    for(i=0; i<4; i++){
+        for(j=0; j<SC_PRNG_NB_LANES; j++) prng->lanes[i][j] = _prng_splitmix64(&x);
+    }
+
+    prng->is_seeded = true;
+}
+
+/*!
+ * \brief   seed the generator of current thread by the global seed
+ * \param   stream_id   index of the stream, logical index of the lcore for worker thread
+ */
+void sc_util_prng_seed_thread(uint64_t stream_id){
+    sc_util_prng_seed(&perthread_prng, _prng_global_seed, stream_id);
+}
+
+/*!
+ * \brief   fill the buffer with random values, the interleaved generators are
+ *          stored as structure of arrays so that the compiler could vectorize them
+ * \param   prng        the generator
+ * \param   buf         the buffer to be filled
+ * \param   nb_values   number of filled values
+ */
+void sc_util_prng_fill(struct sc_prng *prng, uint64_t *buf, uint64_t nb_values){
+    uint64_t i, j, m, t;
+    uint64_t * __restrict s0 = prng->lanes[0];
+    uint64_t * __restrict s1 = prng->lanes[1];
+    uint64_t * __restrict s2 = prng->lanes[2];
+    uint64_t * __restrict s3 = prng->lanes[3];
+
+    for(i=0; i+SC_PRNG_NB_LANES<=nb_values; i+=SC_PRNG_NB_LANES){
+        for(j=0; j<SC_PRNG_NB_LANES; j++){
+            /* multiplications by 5 and 9 are expressed as shift-add */
+            m = (s1[j] << 2) + s1[j];
+            m = (m << 7) | (m >> 57);
+            buf[i+j] = (m << 3) + m;
+
+            t = s1[j] << 17;
+            s2[j] ^= s0[j];
+            s3[j] ^= s1[j];
+            s1[j] ^= s2[j];
+            s0[j] ^= s3[j];
+            s2[j] ^= t;
+            s3[j] = (s3[j] << 45) | (s3[j] >> 19);
+        }
+    }
+
+    for(; i<nb_values; i++){
+        buf[i] = sc_util_prng_next(prng);
+    }
+}
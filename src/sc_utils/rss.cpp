@@ -3,6 +3,15 @@
 #include "sc_utils/rss.hpp"
 #include "sc_control_plane.hpp"
 #include "sc_utils.hpp"
+#include "sc_utils/prng.hpp"
+
+/*!
+ * \brief emulator of the rss on the first used port, used for steering generated flows
+ */
+struct sc_rss_emulator used_rss_emulator;
+
+static uint32_t _rss_emu_key_window(struct sc_rss_emulator *emu, uint32_t bit_pos);
+static int _rss_emu_solve(struct sc_rss_emulator *emu, uint32_t diff, uint16_t *adjust_bits);
 
 /*!
  * \brief   calculate the queue id based on ipv4 packet
@@ -44,6 +53,14 @@ int sc_util_get_rss_queue_id_ipv4(
             *queue_id = (rss_l3l4_original & 0x7F) % nb_queues;
         }
 
+    /* prefer the redirection table obtained from the port */
+    if(used_rss_emulator.is_initialized && used_rss_emulator.nb_queues == nb_queues){
+        *queue_id = used_rss_emulator.reta[
+            (used_rss_emulator.is_l3_only ? rss_l3_original : rss_l3l4_original)
+            & (used_rss_emulator.reta_size - 1)
+        ];
+    }
+
     return SC_SUCCESS;
 }
 
@@ -87,6 +104,14 @@ int sc_util_get_rss_queue_id_ipv6(
             *queue_id = (rss_l3l4_original & 0x7F) % nb_queues;
         }
 
+    /* prefer the redirection table obtained from the port */
+    if(used_rss_emulator.is_initialized && used_rss_emulator.nb_queues == nb_queues){
+        *queue_id = used_rss_emulator.reta[
+            (used_rss_emulator.is_l3_only ? rss_l3_original : rss_l3l4_original)
+            & (used_rss_emulator.reta_size - 1)
+        ];
+    }
+
     return SC_SUCCESS;
 }
 
@@ -182,3 +207,291 @@ int sc_util_get_rss_result_ipv6(
     return SC_SUCCESS;
 }
 
+
+/*!
+ * \brief   initialize the rss emulator by the rss key and redirection table of the port,
+ *          the default emulation (128 entries, round-robin) is used if the port doesn't
+ *          expose its redirection table
+ * \param   emu                 the rss emulator
+ * \param   port_id             index of the emulated port
+ * \param   nb_queues           number of used rx queues of the port
+ * \param   rss_hash_field      the rss hash fields
+ * \param   expected_key        the rss key configured to the port
+ * \param   expected_key_len    length of the configured rss key
+ * \return  zero for successfully initialization
+ */
+int sc_util_rss_emu_init(struct sc_rss_emulator *emu, uint16_t port_id, uint32_t nb_queues,
+        uint64_t rss_hash_field, const uint8_t *expected_key, uint8_t expected_key_len){
+    int ret;
+    uint32_t i, j, v, bit, pivot, vec, queue_id, sample_hash;
+    uint32_t src_ipv4, dst_ipv4;
+    uint16_t sport, dport, bits;
+    uint64_t r;
+    uint32_t nb_entries[RTE_MAX_QUEUES_PER_PORT] = {0};
+    struct rte_eth_dev_info dev_info;
+    struct rte_eth_rss_conf rss_conf;
+    union rte_thash_tuple tuple;
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+        struct rte_eth_rss_reta_entry64 reta_conf[SC_RSS_EMU_MAX_RETA_SIZE / RTE_ETH_RETA_GROUP_SIZE];
+    #else
+        struct rte_eth_rss_reta_entry64 reta_conf[SC_RSS_EMU_MAX_RETA_SIZE / RTE_RETA_GROUP_SIZE];
+    #endif
+
+    memset(emu, 0, sizeof(struct sc_rss_emulator));
+
+    if(nb_queues == 0 || nb_queues > RTE_MAX_QUEUES_PER_PORT){
+        SC_ERROR_DETAILS("invalid number of queues %u", nb_queues);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    if(expected_key_len > SC_RSS_EMU_MAX_KEY_LEN){
+        SC_ERROR_DETAILS("rss key length %u exceeds the maximum %u", expected_key_len, SC_RSS_EMU_MAX_KEY_LEN);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    emu->nb_queues = nb_queues;
+
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+        emu->is_l3_only = (rss_hash_field == RTE_ETH_RSS_IP);
+    #else
+        emu->is_l3_only = (rss_hash_field == ETH_RSS_IP);
+    #endif
+
+    /* verify the rss key actually used by the port */
+    memcpy(emu->key, expected_key, expected_key_len);
+    emu->key_len = expected_key_len;
+    memset(&rss_conf, 0, sizeof(rss_conf));
+    rss_conf.rss_key = emu->key;
+    rss_conf.rss_key_len = SC_RSS_EMU_MAX_KEY_LEN;
+    ret = rte_eth_dev_rss_hash_conf_get(port_id, &rss_conf);
+    if(ret != 0 || rss_conf.rss_key_len == 0){
+        SC_WARNING_DETAILS("failed to obtain rss key of port %u (%s), assume the configured key is used",
+            port_id, ret != 0 ? rte_strerror(-ret) : "empty key");
+        memcpy(emu->key, expected_key, expected_key_len);
+    } else {
+        if(rss_conf.rss_key_len != expected_key_len || memcmp(emu->key, expected_key, expected_key_len)){
+            SC_WARNING_DETAILS("rss key of port %u differs from the configured one, emulate the key of the port",
+                port_id);
+        }
+        emu->key_len = RTE_MIN(rss_conf.rss_key_len, (uint8_t)SC_RSS_EMU_MAX_KEY_LEN);
+    }
+
+    /* obtain the redirection table of the port */
+    ret = rte_eth_dev_info_get(port_id, &dev_info);
+    if(ret == 0 && dev_info.reta_size > 0 && dev_info.reta_size <= SC_RSS_EMU_MAX_RETA_SIZE
+            && rte_is_power_of_2(dev_info.reta_size)){
+        memset(reta_conf, 0, sizeof(reta_conf));
+        #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+            for(i=0; i<dev_info.reta_size/RTE_ETH_RETA_GROUP_SIZE; i++) reta_conf[i].mask = UINT64_MAX;
+        #else
+            for(i=0; i<dev_info.reta_size/RTE_RETA_GROUP_SIZE; i++) reta_conf[i].mask = UINT64_MAX;
+        #endif
+        ret = rte_eth_dev_rss_reta_query(port_id, reta_conf, dev_info.reta_size);
+    } else if(ret == 0){
+        ret = -ENOTSUP;
+    }
+    if(ret == 0){
+        emu->reta_size = dev_info.reta_size;
+        for(i=0; i<emu->reta_size; i++){
+            #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 255, 255)
+                emu->reta[i] = reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE];
+            #else
+                emu->reta[i] = reta_conf[i / RTE_RETA_GROUP_SIZE].reta[i % RTE_RETA_GROUP_SIZE];
+            #endif
+            if(emu->reta[i] >= nb_queues){
+                SC_ERROR_DETAILS("entry %u of the redirection table of port %u points to unused queue %u",
+                    i, port_id, emu->reta[i]);
+                return SC_ERROR_INVALID_VALUE;
+            }
+        }
+    } else {
+        SC_WARNING_DETAILS("failed to obtain redirection table of port %u (%s), emulate with 128 entries",
+            port_id, rte_strerror(-ret));
+        emu->reta_size = 128;
+        for(i=0; i<emu->reta_size; i++) emu->reta[i] = i % nb_queues;
+    }
+
+    /* group reta entries by queue */
+    for(i=0; i<emu->reta_size; i++) nb_entries[emu->reta[i]] += 1;
+    for(i=0; i<nb_queues; i++) emu->queue_entry_offset[i+1] = emu->queue_entry_offset[i] + nb_entries[i];
+    memset(nb_entries, 0, sizeof(nb_entries));
+    for(i=0; i<emu->reta_size; i++){
+        queue_id = emu->reta[i];
+        emu->queue_entries[emu->queue_entry_offset[queue_id] + nb_entries[queue_id]] = i;
+        nb_entries[queue_id] += 1;
+    }
+
+    /* build per-byte lookup tables, the toeplitz hash is linear over GF(2) */
+    for(i=0; i<RTE_THASH_V4_L4_LEN*4; i++){
+        for(v=0; v<256; v++){
+            emu->v4_lut[i][v] = 0;
+            for(bit=0; bit<8; bit++){
+                if(v & (0x80 >> bit)) emu->v4_lut[i][v] ^= _rss_emu_key_window(emu, i*8 + bit);
+            }
+        }
+    }
+
+    /* eliminate the hash of each adjusted bit into the basis of reta index */
+    for(i=0; i<SC_RSS_EMU_NB_ADJUST_BITS; i++){
+        if(emu->is_l3_only)
+            vec = sc_util_rss_emu_hash_ipv4(emu, 1U << i, 0, 0, 0);
+        else
+            vec = sc_util_rss_emu_hash_ipv4(emu, 0, 0, 1U << i, 0);
+        vec &= emu->reta_size - 1;
+        bits = 1U << i;
+
+        for(pivot=32; pivot>0 && vec; pivot--){
+            if(!(vec & (1U << (pivot-1)))) continue;
+            if(!emu->basis_hash[pivot-1]){
+                emu->basis_hash[pivot-1] = vec;
+                emu->basis_bits[pivot-1] = bits;
+                break;
+            }
+            vec ^= emu->basis_hash[pivot-1];
+            bits ^= emu->basis_bits[pivot-1];
+        }
+    }
+
+    /* self-check: the lookup tables should agree with the reference implementation */
+    for(i=0; i<64; i++){
+        r = sc_util_rand();
+        src_ipv4 = (uint32_t)r; dst_ipv4 = (uint32_t)(r >> 32);
+        r = sc_util_rand();
+        sport = (uint16_t)r; dport = (uint16_t)(r >> 16);
+
+        tuple.v4.src_addr = src_ipv4;
+        tuple.v4.dst_addr = dst_ipv4;
+        tuple.v4.sport = sport;
+        tuple.v4.dport = dport;
+        sample_hash = rte_softrss((uint32_t *)&tuple,
+            emu->is_l3_only ? RTE_THASH_V4_L3_LEN : RTE_THASH_V4_L4_LEN, emu->key);
+        if(sample_hash != sc_util_rss_emu_hash_ipv4(emu, src_ipv4, dst_ipv4, sport, dport)){
+            SC_ERROR_DETAILS("emulated rss hash mismatches rte_softrss");
+            return SC_ERROR_INTERNAL;
+        }
+    }
+
+    /* count the reta bits that could be steered */
+    for(i=0, j=0; i<32; i++) if(emu->basis_hash[i]) j++;
+    SC_LOG("rss emulator of port %u: %u reta entries, %u queues, %u of %u index bits are steerable",
+        port_id, emu->reta_size, nb_queues, j, (uint32_t)__builtin_ctz(emu->reta_size));
+
+    emu->is_initialized = true;
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   calculate the rss hash of the ipv4 flow using the lookup tables
+ * \param   emu         the rss emulator
+ * \param   src_ipv4    source ipv4 address
+ * \param   dst_ipv4    destination ipv4 address
+ * \param   sport       source port
+ * \param   dport       destination port
+ * \return  the rss hash
+ */
+uint32_t sc_util_rss_emu_hash_ipv4(struct sc_rss_emulator *emu,
+        uint32_t src_ipv4, uint32_t dst_ipv4, uint16_t sport, uint16_t dport){
+    uint32_t hash;
+
+    hash = emu->v4_lut[0][src_ipv4 >> 24] ^ emu->v4_lut[1][(src_ipv4 >> 16) & 0xFF]
+        ^ emu->v4_lut[2][(src_ipv4 >> 8) & 0xFF] ^ emu->v4_lut[3][src_ipv4 & 0xFF]
+        ^ emu->v4_lut[4][dst_ipv4 >> 24] ^ emu->v4_lut[5][(dst_ipv4 >> 16) & 0xFF]
+        ^ emu->v4_lut[6][(dst_ipv4 >> 8) & 0xFF] ^ emu->v4_lut[7][dst_ipv4 & 0xFF];
+
+    if(!emu->is_l3_only){
+        hash ^= emu->v4_lut[8][sport >> 8] ^ emu->v4_lut[9][sport & 0xFF]
+            ^ emu->v4_lut[10][dport >> 8] ^ emu->v4_lut[11][dport & 0xFF];
+    }
+
+    return hash;
+}
+
+/*!
+ * \brief   generate a random ipv4 flow which is steered to the given queue, the reta
+ *          entries of the queue are picked uniformly, so that the load is evenly spread
+ * \param   emu         the rss emulator
+ * \param   queue_id    index of the target queue
+ * \param   src_ipv4    generated source ipv4 address
+ * \param   dst_ipv4    generated destination ipv4 address
+ * \param   sport       generated source port
+ * \param   dport       generated destination port
+ * \param   rss_hash    rss hash of the generated flow
+ * \return  zero for successfully generation
+ */
+int sc_util_rss_emu_gen_flow_ipv4(struct sc_rss_emulator *emu, uint32_t queue_id,
+        uint32_t *src_ipv4, uint32_t *dst_ipv4, uint16_t *sport, uint16_t *dport, uint32_t *rss_hash){
+    uint32_t nb_entries, entry, hash, retry;
+    uint16_t adjust_bits;
+    uint64_t r;
+
+    if(unlikely(!emu->is_initialized || queue_id >= emu->nb_queues)){
+        SC_THREAD_ERROR_DETAILS("rss emulator isn't initialized or invalid queue %u", queue_id);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    nb_entries = emu->queue_entry_offset[queue_id+1] - emu->queue_entry_offset[queue_id];
+    if(unlikely(nb_entries == 0)){
+        SC_THREAD_ERROR_DETAILS("no entry of the redirection table points to queue %u", queue_id);
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    for(retry=0; retry<64; retry++){
+        r = sc_util_rand();
+        *src_ipv4 = (uint32_t)r;
+        *dst_ipv4 = (uint32_t)(r >> 32);
+        r = sc_util_rand();
+        *sport = (uint16_t)r;
+        *dport = (uint16_t)(r >> 16);
+        entry = emu->queue_entries[emu->queue_entry_offset[queue_id] + (uint32_t)((r >> 32) % nb_entries)];
+
+        hash = sc_util_rss_emu_hash_ipv4(emu, *src_ipv4, *dst_ipv4, *sport, *dport);
+        if(_rss_emu_solve(emu, (hash ^ entry) & (emu->reta_size - 1), &adjust_bits) != SC_SUCCESS)
+            continue;
+
+        if(emu->is_l3_only)
+            *src_ipv4 ^= adjust_bits;
+        else
+            *sport ^= adjust_bits;
+        *rss_hash = sc_util_rss_emu_hash_ipv4(emu, *src_ipv4, *dst_ipv4, *sport, *dport);
+        return SC_SUCCESS;
+    }
+
+    SC_THREAD_ERROR_DETAILS("failed to steer flow into queue %u, the rss key can't address the reta", queue_id);
+    return SC_ERROR_INTERNAL;
+}
+
+/*!
+ * \brief   obtain the 32-bit window of the rss key starting at the given bit
+ * \param   emu     the rss emulator
+ * \param   bit_pos the starting bit
+ * \return  the key window
+ */
+static uint32_t _rss_emu_key_window(struct sc_rss_emulator *emu, uint32_t bit_pos){
+    uint32_t i, byte_pos = bit_pos >> 3;
+    uint64_t window = 0;
+
+    for(i=0; i<5; i++){
+        window = (window << 8) | (byte_pos+i < emu->key_len ? emu->key[byte_pos+i] : 0);
+    }
+
+    return (uint32_t)(window >> (8 - (bit_pos & 7)));
+}
+
+/*!
+ * \brief   solve the adjusted bits which flip the given bits of the reta index
+ * \param   emu         the rss emulator
+ * \param   diff        bits of reta index to be flipped
+ * \param   adjust_bits the solved adjusted bits
+ * \return  zero for solvable
+ */
+static int _rss_emu_solve(struct sc_rss_emulator *emu, uint32_t diff, uint16_t *adjust_bits){
+    uint32_t pivot;
+
+    *adjust_bits = 0;
+    for(pivot=32; pivot>0 && diff; pivot--){
+        if(!(diff & (1U << (pivot-1)))) continue;
+        if(!emu->basis_hash[pivot-1]) return SC_ERROR_INVALID_VALUE;
+        diff ^= emu->basis_hash[pivot-1];
+        *adjust_bits ^= emu->basis_bits[pivot-1];
+    }
+
+    return SC_SUCCESS;
+}
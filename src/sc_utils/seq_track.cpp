@@ -0,0 +1,39 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/seq_track.hpp"
+
+/*!
+ * \brief   add the source statistics into the destination statistics
+ * \note    the source could be updated concurrently by its owner core, each counter
+ *          is read once so that the merged statistics stay within the final values
+ * \param   dst the destination statistics
+ * \param   src the source statistics
+ */
+void sc_util_seq_stat_merge(struct sc_seq_stat *dst, const struct sc_seq_stat *src){
+    dst->nb_received += src->nb_received;
+    dst->nb_gaps += src->nb_gaps;
+    dst->nb_missing += src->nb_missing;
+    dst->nb_reordered += src->nb_reordered;
+    dst->nb_late += src->nb_late;
+    dst->nb_duplicated += src->nb_duplicated;
+    dst->max_reorder_depth = RTE_MAX(dst->max_reorder_depth, src->max_reorder_depth);
+}
+
+/*!
+ * \brief   obtain statistics since the previous snapshot, e.g., of the last interval
+ * \note    the maximum reorder depth couldn't be differentiated, so the one of the
+ *          current snapshot is kept if it grows during the interval, otherwise zero
+ * \param   dst     the statistics of the difference
+ * \param   cur     the current snapshot
+ * \param   prev    the previous snapshot
+ */
+void sc_util_seq_stat_diff(struct sc_seq_stat *dst, const struct sc_seq_stat *cur, const struct sc_seq_stat *prev){
+    dst->nb_received = cur->nb_received - RTE_MIN(cur->nb_received, prev->nb_received);
+    dst->nb_gaps = cur->nb_gaps - RTE_MIN(cur->nb_gaps, prev->nb_gaps);
+    dst->nb_missing = cur->nb_missing - RTE_MIN(cur->nb_missing, prev->nb_missing);
+    dst->nb_reordered = cur->nb_reordered - RTE_MIN(cur->nb_reordered, prev->nb_reordered);
+    dst->nb_late = cur->nb_late - RTE_MIN(cur->nb_late, prev->nb_late);
+    dst->nb_duplicated = cur->nb_duplicated - RTE_MIN(cur->nb_duplicated, prev->nb_duplicated);
+    dst->max_reorder_depth = cur->max_reorder_depth > prev->max_reorder_depth ? cur->max_reorder_depth : 0;
+}
@@ -0,0 +1,55 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/stage_stamp.hpp"
+#include "sc_utils/timestamp.hpp"
+
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+
+bool sc_stage_stamp_enabled = false;
+
+/*!
+ * \brief   stamp the rx stage of the burst (server side), only ipv4/udp packets are
+ *          stamped, whose udp checksum is cleared as the payload is changed afterwards
+ * \param   pkts    the received packets
+ * \param   nb_pkts number of packets
+ * \param   rx_tsc  tsc right after the burst is received
+ */
+void sc_util_stage_stamp_rx_burst(struct rte_mbuf **pkts, uint16_t nb_pkts, uint64_t rx_tsc){
+    uint16_t i;
+    struct rte_ether_hdr *eth_hdr;
+    struct rte_ipv4_hdr *ipv4_hdr;
+    struct rte_udp_hdr *udp_hdr;
+    struct sc_stage_trailer *trailer;
+
+    for(i=0; i<nb_pkts; i++){
+        trailer = sc_util_stage_trailer_of(pkts[i]);
+        if(!trailer){ continue; }
+
+        eth_hdr = rte_pktmbuf_mtod(pkts[i], struct rte_ether_hdr*);
+        if(eth_hdr->ether_type != rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4)){ continue; }
+        ipv4_hdr = (struct rte_ipv4_hdr*)(eth_hdr + 1);
+        if(ipv4_hdr->next_proto_id != IPPROTO_UDP){ continue; }
+        udp_hdr = (struct rte_udp_hdr*)((uint8_t*)ipv4_hdr + rte_ipv4_hdr_len(ipv4_hdr));
+
+        /* zero checksum of udp over ipv4 stands for no checksum */
+        udp_hdr->dgram_cksum = 0;
+        trailer->tsc_hz = rte_cpu_to_be_64(sc_util_tsc_hz());
+        trailer->stamps[SC_STAGE_RX] = rte_cpu_to_be_64(rx_tsc);
+    }
+}
+
+/*!
+ * \brief   obtain the name of the stage
+ * \param   stage   the stage
+ * \return  name of the stage
+ */
+const char* sc_util_stage_name(uint8_t stage){
+    switch(stage){
+        case SC_STAGE_RX:   return "rx";
+        case SC_STAGE_TX:   return "tx";
+        default:            return "unknown";
+    }
+}
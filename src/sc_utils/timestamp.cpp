@@ -0,0 +1,47 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_control_plane.hpp"
+#include "sc_utils/timestamp.hpp"
+
+#include <rte_cpuflags.h>
+
+/* calibrated tsc frequency, and the fixed-point factor of converting cycles to ns */
+uint64_t sc_tsc_hz;
+uint64_t sc_tsc_ns_mult;
+
+/*!
+ * \brief   calibrate the tsc frequency against the monotonic clock, the frequency reported
+ *          by dpdk is derived from the nominal frequency of cpu, which could drift by
+ *          hundreds of ppm from the actual tsc rate
+ * \param   duration_ms duration of the calibration (unit: ms)
+ * \return  zero for successfully calibration
+ */
+int sc_util_tsc_calibrate(uint32_t duration_ms){
+    uint64_t start_ns, end_ns, start_tsc, end_tsc, eal_hz = rte_get_tsc_hz();
+
+    #if defined(RTE_ARCH_X86)
+        if(!rte_cpu_get_flag_enabled(RTE_CPUFLAG_INVTSC)){
+            SC_WARNING_DETAILS("tsc isn't invariant, timestamps could drift with the frequency of cpu");
+        }
+    #endif // defined(RTE_ARCH_X86)
+
+    start_tsc = rte_rdtsc_precise();
+    start_ns = sc_util_timestamp_ns();
+    do {
+        end_ns = sc_util_timestamp_ns();
+    } while(end_ns - start_ns < (uint64_t)duration_ms * 1000000UL);
+    end_tsc = rte_rdtsc_precise();
+
+    if(unlikely(end_tsc <= start_tsc)){
+        SC_ERROR_DETAILS("tsc isn't monotonic during calibration");
+        return SC_ERROR_INTERNAL;
+    }
+
+    sc_tsc_hz = (uint64_t)((unsigned __int128)(end_tsc - start_tsc) * 1000000000UL / (end_ns - start_ns));
+    sc_tsc_ns_mult = (uint64_t)(((unsigned __int128)1000000000UL << 32) / sc_tsc_hz);
+
+    SC_LOG("calibrated tsc frequency: %lu Hz (eal: %lu Hz, deviation: %lf ppm)",
+        sc_tsc_hz, eal_hz, ((double)sc_tsc_hz - (double)eal_hz) / (double)eal_hz * 1000000.0);
+
+    return SC_SUCCESS;
+}
@@ -0,0 +1,612 @@
+#include "sc_global.hpp"
+#include "sc_utils.hpp"
+#include "sc_vdev.hpp"
+#include "sc_utils/timestamp.hpp"
+
+static int _append_eal_arg(int *rte_argc, char **rte_argv, const char *fmt, ...);
+static int _init_memif_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv);
+static int _init_vhost_user_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv);
+static int _init_af_xdp_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv);
+static int _init_socket_backend_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv);
+static int _record_vdev_name(const char *vdev_name);
+static bool _is_vdev_port(uint16_t port_id, const char **driver_name);
+static void _print_vdev_xstats(uint16_t port_id);
+
+/*!
+ * \brief names of the virtual device drivers
+ */
+static const char *_vdev_driver_names[] = {
+    "net_memif",
+    "net_vhost",
+    "net_virtio_user",
+    SC_AF_XDP_DRIVER_NAME,
+    "net_null",
+};
+
+/*!
+ * \brief names of the virtual devices that are selected as used ports
+ *        without specifying their MAC addresses
+ */
+static char _vdev_names[SC_MAX_NB_VDEVS][RTE_ETH_NAME_MAX_LEN];
+static uint16_t _nb_vdev_names = 0;
+
+/*!
+ * \brief sub-strings of names of the extended statistics to be reported,
+ *        e.g. vring kicks and notification (suppression) counters
+ */
+static const char *_vdev_xstats_keywords[] = {
+    "kick",
+    "notification",
+    "notify",
+};
+
+/*!
+ * \brief the time when the statistics of virtual devices are reset
+ */
+static struct timeval _vdev_stats_start_time;
+
+/*!
+ * \brief   append eal parameters for creating virtual devices
+ * \param   sc_config   the global configuration
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \return  zero for successfully initialization
+ */
+int init_vdev_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv){
+    int result = SC_SUCCESS;
+
+    if(sc_config->enable_memif){
+        result = _init_memif_eal_args(sc_config, rte_argc, rte_argv);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to generate eal parameters for memif port");
+            goto init_vdev_eal_args_exit;
+        }
+    }
+
+    if(sc_config->enable_vhost_user){
+        result = _init_vhost_user_eal_args(sc_config, rte_argc, rte_argv);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to generate eal parameters for vhost-user port");
+            goto init_vdev_eal_args_exit;
+        }
+    }
+
+    if(sc_config->enable_af_xdp){
+        result = _init_af_xdp_eal_args(sc_config, rte_argc, rte_argv);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to generate eal parameters for af_xdp port");
+            goto init_vdev_eal_args_exit;
+        }
+    }
+
+    if(sc_config->enable_socket_backend){
+        result = _init_socket_backend_eal_args(sc_config, rte_argc, rte_argv);
+        if(result != SC_SUCCESS){
+            SC_ERROR_DETAILS("failed to generate eal parameters for kernel socket backend");
+            goto init_vdev_eal_args_exit;
+        }
+    }
+
+init_vdev_eal_args_exit:
+    return result;
+}
+
+/*!
+ * \brief   initialize virtual device specific settings of the port, should be
+ *          invoked before the port is configured
+ * \param   sc_config   the global configuration
+ * \param   port_id     index of the port
+ * \return  zero for successfully initialization
+ */
+int init_vdev_port(struct sc_config *sc_config, uint16_t port_id){
+    int ret;
+    struct rte_eth_dev_info dev_info;
+    struct rte_ether_addr mac;
+
+    if(rte_eth_dev_info_get(port_id, &dev_info) != 0)
+        return SC_SUCCESS;
+
+    /* the null port of kernel socket backend uses a fixed mac address */
+    if(sc_config->enable_socket_backend && !strcmp(dev_info.driver_name, "net_null")){
+        if(rte_ether_unformat_addr(SC_SOCKET_PORT_MAC, &mac) != 0){
+            SC_ERROR_DETAILS("invalid mac address %s", SC_SOCKET_PORT_MAC);
+            return SC_ERROR_INVALID_VALUE;
+        }
+        ret = rte_eth_dev_default_mac_addr_set(port_id, &mac);
+        if(ret != 0){
+            SC_ERROR_DETAILS("failed to set mac address of port %u: %s", port_id, rte_strerror(-ret));
+            return SC_ERROR_INTERNAL;
+        }
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   check whether the port is a virtual device which is selected
+ *          by its name
+ * \param   port_id     index of the port
+ * \return  whether the port is used
+ */
+bool sc_vdev_is_port_choosed(uint16_t port_id){
+    uint16_t i;
+    char name[RTE_ETH_NAME_MAX_LEN];
+
+    if(_nb_vdev_names == 0) return false;
+
+    if(rte_eth_dev_get_name_by_port(port_id, name) != 0)
+        return false;
+
+    for(i=0; i<_nb_vdev_names; i++){
+        if(!strcmp(name, _vdev_names[i])) return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief   check whether the port is driven by the AF_XDP PMD
+ * \param   port_id     index of the port
+ * \return  whether the port is an AF_XDP port
+ */
+bool sc_vdev_is_af_xdp_port(uint16_t port_id){
+    struct rte_eth_dev_info dev_info;
+
+    if(rte_eth_dev_info_get(port_id, &dev_info) != 0)
+        return false;
+
+    return !strcmp(dev_info.driver_name, SC_AF_XDP_DRIVER_NAME);
+}
+
+/*!
+ * \brief   reset statistics of all used virtual devices, should be invoked
+ *          right before launching worker threads
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully initialization
+ */
+int init_vdev_stats(struct sc_config *sc_config){
+    uint16_t i;
+
+    for(i=0; i<sc_config->nb_used_ports; i++){
+        if(!_is_vdev_port(sc_config->sc_port[i].port_id, NULL))
+            continue;
+        rte_eth_stats_reset(sc_config->sc_port[i].port_id);
+        rte_eth_xstats_reset(sc_config->sc_port[i].port_id);
+    }
+
+    if(unlikely(-1 == gettimeofday(&_vdev_stats_start_time, NULL))){
+        SC_ERROR_DETAILS("failed to obtain start time of virtual device statistics");
+        return SC_ERROR_INTERNAL;
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   print throughput of all used virtual devices
+ * \param   sc_config   the global configuration
+ * \return  zero for successfully reporting
+ */
+int report_vdev_stats(struct sc_config *sc_config){
+    int ret;
+    uint16_t i, port_id;
+    const char *driver_name;
+    struct rte_eth_stats stats;
+    struct timeval end_time;
+    double duration_s;
+
+    if(unlikely(-1 == gettimeofday(&end_time, NULL))){
+        SC_ERROR_DETAILS("failed to obtain end time of virtual device statistics");
+        return SC_ERROR_INTERNAL;
+    }
+    duration_s = (double)(
+        SC_UTIL_TIME_INTERVL_US(end_time.tv_sec, end_time.tv_usec)
+        - SC_UTIL_TIME_INTERVL_US(_vdev_stats_start_time.tv_sec, _vdev_stats_start_time.tv_usec)
+    ) / (double)1000000.0;
+    if(duration_s <= 0) return SC_SUCCESS;
+
+    for(i=0; i<sc_config->nb_used_ports; i++){
+        port_id = sc_config->sc_port[i].port_id;
+        if(!_is_vdev_port(port_id, &driver_name))
+            continue;
+
+        ret = rte_eth_stats_get(port_id, &stats);
+        if(ret != 0){
+            SC_WARNING_DETAILS("failed to obtain statistics of port %u: %s", port_id, rte_strerror(-ret));
+            continue;
+        }
+
+        SC_LOG("[%s] port %u (%.2lf s): rx %lu pkts (%.4lf Mpps, %.4lf Gbps), tx %lu pkts (%.4lf Mpps, %.4lf Gbps), "
+            "missed %lu, rx errors %lu, tx errors %lu",
+            driver_name, port_id, duration_s,
+            stats.ipackets, (double)stats.ipackets / duration_s / (double)1000000.0,
+            (double)stats.ibytes * 8 / duration_s / (double)1000000000.0,
+            stats.opackets, (double)stats.opackets / duration_s / (double)1000000.0,
+            (double)stats.obytes * 8 / duration_s / (double)1000000000.0,
+            stats.imissed, stats.ierrors, stats.oerrors
+        );
+
+        _print_vdev_xstats(port_id);
+    }
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   generate eal parameters for the memif port
+ * \param   sc_config   the global configuration
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \return  zero for successfully initialization
+ */
+static int _init_memif_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv){
+    int result = SC_SUCCESS;
+    uint32_t ring_size, log2_ring_size;
+    bool zero_copy = sc_config->enable_memif_zero_copy;
+    char *memif_mac;
+    const char *role;
+
+    #if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 0, 0)
+        role = sc_config->memif_is_server ? "server" : "client";
+    #else
+        role = sc_config->memif_is_server ? "master" : "slave";
+    #endif
+
+    /* memif uses a single ring size for both directions, in unit of log2 */
+    ring_size = RTE_MAX(sc_config->rx_queue_len, sc_config->tx_queue_len);
+    log2_ring_size = rte_log2_u32(ring_size);
+    if(log2_ring_size == 0) log2_ring_size = 1;
+    if(log2_ring_size > SC_MEMIF_MAX_LOG2_RING_SIZE){
+        SC_WARNING_DETAILS("queue length %u exceeds the maximum ring size of memif, use %u instead",
+            ring_size, 1 << SC_MEMIF_MAX_LOG2_RING_SIZE);
+        log2_ring_size = SC_MEMIF_MAX_LOG2_RING_SIZE;
+    }
+
+    /* zero-copy is only supported by the client side */
+    if(zero_copy && sc_config->memif_is_server){
+        SC_WARNING_DETAILS("memif zero-copy is only supported on the client side, disabled");
+        zero_copy = false;
+    }
+
+    /* generate mac address of the memif port */
+    memif_mac = (char*)malloc(RTE_ETHER_ADDR_FMT_SIZE);
+    if(unlikely(!memif_mac)){
+        SC_ERROR_DETAILS("failed to allocate memory for memif_mac");
+        result = SC_ERROR_MEMORY;
+        goto init_memif_eal_args_exit;
+    }
+    sprintf(memif_mac, SC_MEMIF_MAC_FMT,
+        (sc_config->memif_id >> 8) & 0xFF, sc_config->memif_id & 0xFF, sc_config->memif_is_server ? 0 : 1);
+
+    /* create the memif port */
+    result = _append_eal_arg(rte_argc, rte_argv, "--vdev");
+    if(result != SC_SUCCESS) goto free_memif_mac;
+    result = _append_eal_arg(rte_argc, rte_argv, "net_memif%u,role=%s,id=%u,socket=%s,rsize=%u,mac=%s%s",
+        sc_config->memif_id, role, sc_config->memif_id, sc_config->memif_socket,
+        log2_ring_size, memif_mac, zero_copy ? ",zero-copy=yes" : "");
+    if(result != SC_SUCCESS) goto free_memif_mac;
+
+    /* co-located processes must use different prefix of hugepage files */
+    result = _append_eal_arg(rte_argc, rte_argv, "--file-prefix=sc_memif_%s_%u", role, sc_config->memif_id);
+    if(result != SC_SUCCESS) goto free_memif_mac;
+
+    /* zero-copy requires the memory being exposed as a single file per segment list */
+    if(zero_copy){
+        result = _append_eal_arg(rte_argc, rte_argv, "--single-file-segments");
+        if(result != SC_SUCCESS) goto free_memif_mac;
+    }
+
+    /* select the memif port as used port */
+    if(sc_config->nb_conf_ports >= SC_MAX_NB_PORTS){
+        SC_ERROR_DETAILS("too many ports specified, unable to add memif port");
+        result = SC_ERROR_INVALID_VALUE;
+        goto free_memif_mac;
+    }
+    sc_config->port_mac[sc_config->nb_conf_ports] = memif_mac;
+    sc_config->nb_conf_ports += 1;
+    SC_LOG("memif port (%s, id %u, ring size %u) uses mac address %s",
+        role, sc_config->memif_id, 1 << log2_ring_size, memif_mac);
+
+    goto init_memif_eal_args_exit;
+
+free_memif_mac:
+    free(memif_mac);
+
+init_memif_eal_args_exit:
+    return result;
+}
+
+/*!
+ * \brief   generate eal parameters for the vhost-user port, the backend creates
+ *          a net_vhost port while the frontend creates a net_virtio_user port
+ * \param   sc_config   the global configuration
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \return  zero for successfully initialization
+ */
+static int _init_vhost_user_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv){
+    int result = SC_SUCCESS;
+    uint16_t nb_queues;
+    char vdev_name[RTE_ETH_NAME_MAX_LEN];
+
+    /* the number of queue pairs must cover both rx and tx rings */
+    nb_queues = RTE_MAX(sc_config->nb_rx_rings_per_port, sc_config->nb_tx_rings_per_port);
+    if(sc_config->nb_rx_rings_per_port != sc_config->nb_tx_rings_per_port){
+        SC_WARNING_DETAILS("number of rx rings (%u) and tx rings (%u) are different, use %u vhost-user queue pairs",
+            sc_config->nb_rx_rings_per_port, sc_config->nb_tx_rings_per_port, nb_queues);
+    }
+
+    result = _append_eal_arg(rte_argc, rte_argv, "--vdev");
+    if(result != SC_SUCCESS) goto init_vhost_user_eal_args_exit;
+
+    if(sc_config->vhost_user_is_backend){
+        sprintf(vdev_name, "net_vhost0");
+        result = _append_eal_arg(rte_argc, rte_argv, "%s,iface=%s,queues=%u,client=0",
+            vdev_name, sc_config->vhost_user_socket, nb_queues);
+    } else {
+        /* the vring size of virtio must be power of 2 */
+        if(!rte_is_power_of_2(sc_config->rx_queue_len)){
+            SC_ERROR_DETAILS("rx_queue_len (%u) must be power of 2 while using virtio-user", 
+                sc_config->rx_queue_len);
+            result = SC_ERROR_INVALID_VALUE;
+            goto init_vhost_user_eal_args_exit;
+        }
+        sprintf(vdev_name, "net_virtio_user0");
+        result = _append_eal_arg(rte_argc, rte_argv, "%s,path=%s,queues=%u,queue_size=%u,mac=%s",
+            vdev_name, sc_config->vhost_user_socket, nb_queues, sc_config->rx_queue_len, SC_VIRTIO_USER_MAC);
+    }
+    if(result != SC_SUCCESS) goto init_vhost_user_eal_args_exit;
+
+    /* co-located processes must use different prefix of hugepage files */
+    result = _append_eal_arg(rte_argc, rte_argv, "--file-prefix=sc_vhost_%s",
+        sc_config->vhost_user_is_backend ? "backend" : "frontend");
+    if(result != SC_SUCCESS) goto init_vhost_user_eal_args_exit;
+
+    /* 
+     * the frontend shares all its memory with the backend, use a single file per
+     * segment list to not exceed the maximum number of vhost memory regions
+     */
+    if(!sc_config->vhost_user_is_backend){
+        result = _append_eal_arg(rte_argc, rte_argv, "--single-file-segments");
+        if(result != SC_SUCCESS) goto init_vhost_user_eal_args_exit;
+    }
+
+    /* select the vhost-user port as used port */
+    result = _record_vdev_name(vdev_name);
+    if(result != SC_SUCCESS) goto init_vhost_user_eal_args_exit;
+
+    SC_LOG("vhost-user %s port %s (%u queue pairs) connects through %s",
+        sc_config->vhost_user_is_backend ? "backend" : "frontend",
+        vdev_name, nb_queues, sc_config->vhost_user_socket);
+
+init_vhost_user_eal_args_exit:
+    return result;
+}
+
+/*!
+ * \brief   generate eal parameters for the AF_XDP port, rx queue i of the port
+ *          is bound to the XSK on kernel queue (af_xdp_start_queue + i) of the interface
+ * \param   sc_config   the global configuration
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \return  zero for successfully initialization
+ */
+static int _init_af_xdp_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv){
+    int result = SC_SUCCESS;
+    uint16_t i, nb_queues;
+    char vdev_name[RTE_ETH_NAME_MAX_LEN];
+    char busy_poll_arg[32] = "";
+    char xdp_prog_arg[SC_VDEV_EAL_ARG_STRLEN/2] = "";
+
+    /* each XSK is a pair of rx and tx rings */
+    nb_queues = RTE_MAX(sc_config->nb_rx_rings_per_port, sc_config->nb_tx_rings_per_port);
+
+    /* the rings of XSK must be power of 2 */
+    if(!rte_is_power_of_2(sc_config->rx_queue_len) || !rte_is_power_of_2(sc_config->tx_queue_len)){
+        SC_ERROR_DETAILS("rx_queue_len (%u) and tx_queue_len (%u) must be power of 2 while using af_xdp",
+            sc_config->rx_queue_len, sc_config->tx_queue_len);
+        result = SC_ERROR_INVALID_VALUE;
+        goto init_af_xdp_eal_args_exit;
+    }
+
+    /* busy polling, 0 for disabling it */
+    #if RTE_VERSION >= RTE_VERSION_NUM(21, 5, 0, 0)
+        sprintf(busy_poll_arg, ",busy_budget=%u", sc_config->af_xdp_busy_budget);
+    #else
+        if(sc_config->af_xdp_busy_budget != 0){
+            SC_WARNING_DETAILS("busy polling of af_xdp isn't supported by current DPDK version");
+        }
+    #endif
+
+    /* customized xdp program (if specified) */
+    if(sc_config->af_xdp_prog){
+        snprintf(xdp_prog_arg, sizeof(xdp_prog_arg), ",xdp_prog=%s", sc_config->af_xdp_prog);
+    }
+
+    result = _append_eal_arg(rte_argc, rte_argv, "--vdev");
+    if(result != SC_SUCCESS) goto init_af_xdp_eal_args_exit;
+
+    sprintf(vdev_name, "net_af_xdp0");
+    result = _append_eal_arg(rte_argc, rte_argv, "%s,iface=%s,start_queue=%u,queue_count=%u%s%s",
+        vdev_name, sc_config->af_xdp_iface, sc_config->af_xdp_start_queue, nb_queues,
+        busy_poll_arg, xdp_prog_arg);
+    if(result != SC_SUCCESS) goto init_af_xdp_eal_args_exit;
+
+    /* processes on both sides of a veth pair must use different prefix of hugepage files */
+    result = _append_eal_arg(rte_argc, rte_argv, "--file-prefix=sc_af_xdp_%s", sc_config->af_xdp_iface);
+    if(result != SC_SUCCESS) goto init_af_xdp_eal_args_exit;
+
+    /* select the af_xdp port as used port */
+    result = _record_vdev_name(vdev_name);
+    if(result != SC_SUCCESS) goto init_af_xdp_eal_args_exit;
+
+    for(i=0; i<nb_queues; i++){
+        SC_LOG("af_xdp port %s: queue %u -> XSK on %s kernel queue %u",
+            vdev_name, i, sc_config->af_xdp_iface, sc_config->af_xdp_start_queue + i);
+    }
+    if(sc_config->af_xdp_busy_budget != 0){
+        SC_LOG("af_xdp busy polling is enabled (budget %u), consider tuning "
+            "/sys/class/net/%s/napi_defer_hard_irqs and gro_flush_timeout",
+            sc_config->af_xdp_busy_budget, sc_config->af_xdp_iface);
+    }
+
+init_af_xdp_eal_args_exit:
+    return result;
+}
+
+/*!
+ * \brief   generate eal parameters for the kernel socket backend, a null port is
+ *          created to carry mbuf pools and port configurations of the application,
+ *          while packets are actually received / sent through kernel sockets
+ * \param   sc_config   the global configuration
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \return  zero for successfully initialization
+ */
+static int _init_socket_backend_eal_args(struct sc_config *sc_config, int *rte_argc, char **rte_argv){
+    int result = SC_SUCCESS;
+    char vdev_name[RTE_ETH_NAME_MAX_LEN];
+
+    result = _append_eal_arg(rte_argc, rte_argv, "--vdev");
+    if(result != SC_SUCCESS) goto init_socket_backend_eal_args_exit;
+
+    sprintf(vdev_name, "net_null0");
+    result = _append_eal_arg(rte_argc, rte_argv, "%s,no-rx=1", vdev_name);
+    if(result != SC_SUCCESS) goto init_socket_backend_eal_args_exit;
+
+    /* no physical port is needed */
+    result = _append_eal_arg(rte_argc, rte_argv, "--no-pci");
+    if(result != SC_SUCCESS) goto init_socket_backend_eal_args_exit;
+
+    /* the client could be a dpdk process on the same host */
+    result = _append_eal_arg(rte_argc, rte_argv, "--file-prefix=sc_socket");
+    if(result != SC_SUCCESS) goto init_socket_backend_eal_args_exit;
+
+    /* select the null port as used port */
+    result = _record_vdev_name(vdev_name);
+    if(result != SC_SUCCESS) goto init_socket_backend_eal_args_exit;
+
+    SC_LOG("kernel socket backend uses null port %s (mac %s)", vdev_name, SC_SOCKET_PORT_MAC);
+
+init_socket_backend_eal_args_exit:
+    return result;
+}
+
+/*!
+ * \brief   record the name of a created virtual device, so that it's
+ *          selected as used port
+ * \param   vdev_name   name of the virtual device
+ * \return  zero for successfully recording
+ */
+static int _record_vdev_name(const char *vdev_name){
+    if(_nb_vdev_names >= SC_MAX_NB_VDEVS){
+        SC_ERROR_DETAILS("too many virtual devices, try modify macro SC_MAX_NB_VDEVS (%d)", SC_MAX_NB_VDEVS);
+        return SC_ERROR_INVALID_VALUE;
+    }
+    snprintf(_vdev_names[_nb_vdev_names], RTE_ETH_NAME_MAX_LEN, "%s", vdev_name);
+    _nb_vdev_names += 1;
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   print extended statistics of the virtual device which are related
+ *          to vring kicks and notification suppression
+ * \param   port_id     index of the port
+ */
+static void _print_vdev_xstats(uint16_t port_id){
+    int i, nb_xstats;
+    uint32_t j;
+    struct rte_eth_xstat *xstats = NULL;
+    struct rte_eth_xstat_name *xstats_names = NULL;
+    bool has_matched = false;
+
+    nb_xstats = rte_eth_xstats_get_names(port_id, NULL, 0);
+    if(nb_xstats <= 0) return;
+
+    xstats = (struct rte_eth_xstat*)malloc(sizeof(struct rte_eth_xstat) * nb_xstats);
+    xstats_names = (struct rte_eth_xstat_name*)malloc(sizeof(struct rte_eth_xstat_name) * nb_xstats);
+    if(unlikely(!xstats || !xstats_names)){
+        SC_WARNING_DETAILS("failed to allocate memory for extended statistics of port %u", port_id);
+        goto print_vdev_xstats_exit;
+    }
+
+    if(rte_eth_xstats_get_names(port_id, xstats_names, nb_xstats) != nb_xstats
+        || rte_eth_xstats_get(port_id, xstats, nb_xstats) != nb_xstats){
+        SC_WARNING_DETAILS("failed to obtain extended statistics of port %u", port_id);
+        goto print_vdev_xstats_exit;
+    }
+
+    for(i=0; i<nb_xstats; i++){
+        for(j=0; j<RTE_DIM(_vdev_xstats_keywords); j++){
+            if(strstr(xstats_names[xstats[i].id].name, _vdev_xstats_keywords[j])){
+                SC_LOG("\tport %u %s: %lu", port_id, xstats_names[xstats[i].id].name, xstats[i].value);
+                has_matched = true;
+                break;
+            }
+        }
+    }
+
+    if(!has_matched){
+        SC_LOG("\tport %u doesn't expose vring kick / notification counters", port_id);
+    }
+
+print_vdev_xstats_exit:
+    if(xstats) free(xstats);
+    if(xstats_names) free(xstats_names);
+}
+
+/*!
+ * \brief   append a formatted eal parameter
+ * \param   rte_argc    number of eal parameters
+ * \param   rte_argv    eal parameters
+ * \param   fmt         format of the parameter
+ * \return  zero for successfully appending
+ */
+static int _append_eal_arg(int *rte_argc, char **rte_argv, const char *fmt, ...){
+    va_list args;
+    char *arg;
+
+    if(*rte_argc >= SC_RTE_ARGC_MAX){
+        SC_ERROR_DETAILS("too many eal parameters, try modify macro SC_RTE_ARGC_MAX");
+        return SC_ERROR_INVALID_VALUE;
+    }
+
+    arg = (char*)malloc(SC_VDEV_EAL_ARG_STRLEN);
+    if(unlikely(!arg)){
+        SC_ERROR_DETAILS("failed to allocate memory for eal parameter");
+        return SC_ERROR_MEMORY;
+    }
+    memset(arg, 0, SC_VDEV_EAL_ARG_STRLEN);
+
+    va_start(args, fmt);
+    vsnprintf(arg, SC_VDEV_EAL_ARG_STRLEN, fmt, args);
+    va_end(args);
+
+    rte_argv[*rte_argc] = arg;
+    *rte_argc += 1;
+
+    return SC_SUCCESS;
+}
+
+/*!
+ * \brief   check whether the port is a virtual device created by SoConnect
+ * \param   port_id     index of the port
+ * \param   driver_name name of the driver of the port (could be NULL)
+ * \return  whether the port is a virtual device
+ */
+static bool _is_vdev_port(uint16_t port_id, const char **driver_name){
+    uint16_t i;
+    struct rte_eth_dev_info dev_info;
+
+    if(rte_eth_dev_info_get(port_id, &dev_info) != 0)
+        return false;
+
+    for(i=0; i<RTE_DIM(_vdev_driver_names); i++){
+        if(!strcmp(dev_info.driver_name, _vdev_driver_names[i])){
+            if(driver_name) *driver_name = _vdev_driver_names[i];
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -3,6 +3,10 @@
 #include "sc_utils.hpp"
 #include "sc_mbuf.hpp"
 #include "sc_control_plane.hpp"
+#include "sc_socket.hpp"
+#include "sc_utils/prng.hpp"
+#include "sc_utils/timestamp.hpp"
+#include "sc_utils/stage_stamp.hpp"
 
 extern volatile bool sc_force_quit;
 
@@ -14,6 +18,15 @@ __thread uint32_t perthread_lcore_logical_id;
  * \return  zero for successfully initialization
  */
 int __worker_loop_init(struct sc_config *sc_config) {
+    /* seed per-thread random generator */
+    sc_util_prng_seed_thread(perthread_lcore_logical_id);
+
+    /* create per-thread socket (if kernel socket backend is used) */
+    if(sc_socket_init_worker(sc_config) != SC_SUCCESS){
+        SC_THREAD_ERROR("failed to initialize socket of worker thread");
+        return SC_ERROR_INTERNAL;
+    }
+
     return SC_SUCCESS;
 }
 
@@ -91,9 +104,18 @@ int _worker_loop(void* param){
         #if defined(ROLE_SERVER)
             for(i=0; i<sc_config->nb_used_ports; i++){
 
-                nb_rx = rte_eth_rx_burst(sc_config->sc_port[i].port_id, queue_id, pkt, SC_MAX_RX_PKT_BURST);
+                if(unlikely(sc_socket_backend_enabled)){
+                    nb_rx = sc_socket_rx_burst(sc_config, queue_id, pkt, SC_MAX_RX_PKT_BURST);
+                } else {
+                    nb_rx = rte_eth_rx_burst(sc_config->sc_port[i].port_id, queue_id, pkt, SC_MAX_RX_PKT_BURST);
+                }
                 
                 if(nb_rx == 0) continue;
+
+                /* stamp rx into trailers of received packets (if enabled) */
+                if(unlikely(sc_stage_stamp_enabled)){
+                    sc_util_stage_stamp_rx_burst(pkt, nb_rx, sc_util_timestamp_tsc());
+                }
                 
                 /* Hook Point: Packet Processing */
                 if(unlikely(
@@ -126,6 +148,9 @@ exit_callback:
     if(SC_SUCCESS != process_exit_func(sc_config)){
         SC_THREAD_WARNING("error occurs while executing exit callback\n");
     }
+
+    /* close per-thread socket (if kernel socket backend is used) */
+    sc_socket_exit_worker(sc_config);
     
 worker_exit:
     SC_THREAD_WARNING("worker thread exit\n");
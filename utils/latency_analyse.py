@@ -1,25 +1,28 @@
 import numpy as np
 import sys
 
-data = np.loadtxt(sys.argv[1])
-
-core = t1s = data[:,0]
-t1s = data[:,1]
-t2s = data[:,2]
-
-latency = t2s - t1s
-
-for i in range(0, len(latency)):
-    if t2s[i] < t1s[i]:
-        print(f"{core[i]} {t2s[i]}, {t1s[i]}")
+# percentile distribution written by echo client in the format of HdrHistogram (latency.hgrm, unit: us)
+values = []
+percentiles = []
+mean = np.nan
+with open(sys.argv[1]) as f:
+    for line in f:
+        if line.startswith("#[Mean"):
+            mean = float(line.split("=")[1].split(",")[0])
+            continue
+        fields = line.split()
+        if len(fields) < 3 or fields[0] == "Value" or line.startswith("#"):
+            continue
+        values.append(float(fields[0]))
+        percentiles.append(float(fields[1]) * 100)
 
 print("%8s\t%8s\t%8s\t%8s\t%8s\t%8s\t%8s" % ("Average", "5%", "25%", "50%", "99%", "99.9%", "Max."))
 print("%8.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f" % (
-    np.mean(latency),
-    np.percentile(latency, 5),
-    np.percentile(latency, 25),
-    np.percentile(latency, 50),
-    np.percentile(latency, 99),
-    np.percentile(latency, 99.9),
-    np.amax(latency)
+    mean,
+    np.interp(5, percentiles, values),
+    np.interp(25, percentiles, values),
+    np.interp(50, percentiles, values),
+    np.interp(99, percentiles, values),
+    np.interp(99.9, percentiles, values),
+    values[-1]
 ))